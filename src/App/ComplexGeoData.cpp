@@ -1299,6 +1299,11 @@ void ComplexGeoData::getFacesFromSubElement(const Segment*,
     (void)faces;
 }
 
+Base::BoundBox3d ComplexGeoData::getBoundBoxFromSubElement(const Segment*) const
+{
+    return Base::BoundBox3d();
+}
+
 Base::Vector3d ComplexGeoData::getPointFromLineIntersection(const Base::Vector3f& base,
                                                             const Base::Vector3f& dir) const
 {
@@ -2371,6 +2376,12 @@ void ComplexGeoData::beforeSave() const
         this->_ElementMap->beforeSave(Hasher);
 }
 
+void ComplexGeoData::resetElementMapIds()
+{
+    _ElementMapToId.clear();
+    _IdToElementMap.clear();
+}
+
 void ComplexGeoData::hashChildMaps()
 {
     flushElementMap();
@@ -128,6 +128,10 @@ public:
         std::vector<Base::Vector3d> &Points,
         std::vector<Base::Vector3d> &PointNormals,
         std::vector<Facet> &faces) const;
+    /** Get the bound box of a segment without triangulating it
+     * @return the bound box or an invalid one if not supported
+     */
+    virtual Base::BoundBox3d getBoundBoxFromSubElement(const Segment*) const;
     //@}
 
     /** @name Placement control */
@@ -453,6 +457,13 @@ public:
     virtual void beforeSave() const;
     bool isRestoreFailed() const { return _restoreFailed; }
     void resetRestoreFailure() const { _restoreFailed = true; }
+    /** Reset the ids used for sharing child element maps on save and restore
+     *
+     * It is called automatically on document save and restore. Call this
+     * function before and after saving or restoring element maps outside of
+     * any document, e.g. into a cache.
+     */
+    static void resetElementMapIds();
     //@}
 
     virtual bool isSame(const ComplexGeoData &other) const = 0;
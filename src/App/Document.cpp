@@ -83,6 +83,10 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include <QCoreApplication>
 #include <QCryptographicHash>
 #include <QCoreApplication>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 #include <App/DocumentPy.h>
 #include <Base/Console.h>
@@ -930,6 +934,12 @@ Document::Document(const char* documentName)
             "Prefer binary format when saving object data.\n"
             "This can result in smaller file but bad for version control.");
     PreferBinary.setValue(DocumentParams::getPreferBinary());
+    ADD_PROPERTY_TYPE(StoreUncompressed,(0),"Format",Prop_None,
+            "Size threshold in MB for storing file entries without compression.\n"
+            "Negative to always compress. Zero to only store already compressed\n"
+            "data, such as images. Only effective when saving document as archive\n"
+            "with parallel saving enabled.");
+    StoreUncompressed.setValue(DocumentParams::getStoreUncompressed());
 }
 
 Document::~Document()
@@ -1240,105 +1250,99 @@ void Document::exportObjects(const std::vector<App::DocumentObject*>& obj, std::
 void Document::writeObjects(const std::vector<App::DocumentObject*>& obj,
                             Base::Writer &writer) const
 {
-    // writing the features types
+    // writing the features types. Note that the structured writer API is
+    // used here as it is much faster when writing binary XML.
     writer.incInd(); // indentation for 'Objects count'
-    writer.Stream() << writer.ind() << "<Objects Count=\"" << obj.size();
+    writer.startElement("Objects").addAttribute("Count", obj.size());
     if(!isExporting(nullptr))
-        writer.Stream() << "\" " FC_ATTR_DEPENDENCIES "=\"1";
-    writer.Stream() << "\">\n";
-
-    writer.incInd(); // indentation for 'Object type'
+        writer.addAttribute(FC_ATTR_DEPENDENCIES, 1);
+    writer.endStartTag();
 
     if(!isExporting(nullptr)) {
         for(auto o : obj) {
             const auto &outList = o->getOutList(DocumentObject::OutListNoHidden
                                                 | DocumentObject::OutListNoXLinked);
             std::set<App::DocumentObject*> outSet(outList.begin(),outList.end());
-            writer.Stream() << writer.ind() 
-                << "<" FC_ELEMENT_OBJECT_DEPS " " FC_ATTR_DEP_OBJ_NAME "=\""
-                << o->getNameInDocument() << "\" " FC_ATTR_DEP_COUNT "=\"" << outSet.size();
+            writer.startElement(FC_ELEMENT_OBJECT_DEPS)
+                  .addAttribute(FC_ATTR_DEP_OBJ_NAME, o->getNameInDocument())
+                  .addAttribute(FC_ATTR_DEP_COUNT, outSet.size());
             if(outSet.empty()) {
-                writer.Stream() << "\"/>\n";
+                writer.endStartTag(true);
                 continue;
             }
             int partial = o->canLoadPartial();
             if(partial>0)
-                writer.Stream() << "\" " FC_ATTR_DEP_ALLOW_PARTIAL << "=\"" << partial;
-            writer.Stream() << "\">\n";
-            writer.incInd();
+                writer.addAttribute(FC_ATTR_DEP_ALLOW_PARTIAL, partial);
+            writer.endStartTag();
             for(auto dep : outSet) {
                 auto name = dep?dep->getNameInDocument():"";
-                writer.Stream() << writer.ind() << "<" FC_ELEMENT_OBJECT_DEP " "
-                    FC_ATTR_DEP_OBJ_NAME "=\"" << (name?name:"") << "\"/>\n";
+                writer.startElement(FC_ELEMENT_OBJECT_DEP)
+                      .addAttribute(FC_ATTR_DEP_OBJ_NAME, name?name:"")
+                      .endStartTag(true);
             }
-            writer.decInd();
-            writer.Stream() << writer.ind() << "</" FC_ELEMENT_OBJECT_DEPS ">\n";
+            writer.endElement(FC_ELEMENT_OBJECT_DEPS);
         }
     }
 
     std::vector<DocumentObject*>::const_iterator it;
     for (it = obj.begin(); it != obj.end(); ++it) {
-        writer.Stream() << writer.ind() << "<Object "
-        << "type=\"" << (*it)->getTypeId().getName()     << "\" "
-        << "name=\"" << (*it)->getExportName()       << "\" "
-        << "id=\"" << (*it)->getID()       << "\" "
-        << "revision=\"" << (*it)->getRevision() << "\" ";
+        writer.startElement("Object")
+              .addAttribute("type", (*it)->getTypeId().getName())
+              .addAttribute("name", (*it)->getExportName())
+              .addAttribute("id", (*it)->getID())
+              .addAttribute("revision", (*it)->getRevision());
 
         // Only write out custom view provider types
         std::string viewType = (*it)->getViewProviderNameStored();
         if (viewType != (*it)->getViewProviderName())
-            writer.Stream() << "ViewType=\"" << viewType << "\" ";
+            writer.addAttribute("ViewType", viewType);
 
         // See DocumentObjectPy::getState
         if ((*it)->testStatus(ObjectStatus::Touch))
-            writer.Stream() << "Touched=\"1\" ";
+            writer.addAttribute("Touched", 1);
         if ((*it)->testStatus(ObjectStatus::Error)) {
-            writer.Stream() << "Invalid=\"1\" ";
+            writer.addAttribute("Invalid", 1);
             auto desc = getErrorDescription(*it);
             if(desc)
-                writer.Stream() << "Error=\"" << Property::encodeAttribute(desc) << "\" ";
+                writer.addAttribute("Error", desc);
         }
 
         if(writer.isSplitXML()) {
             std::string name((*it)->getNameInDocument());
             if(name == "Document" || name == "GuiDocument")
                 name += "-Obj";
-            writer.Stream() << "file=\"" 
-                << writer.addFile(name+".xml",this) << "\" ";
+            writer.addAttribute("file", writer.addFile(name+".xml",this));
         }
 
-        writer.Stream() << "/>\n";
+        writer.endStartTag(true);
     }
 
-    writer.decInd();  // indentation for 'Object type'
-    writer.Stream() << writer.ind() << "</Objects>\n";
+    writer.endElement("Objects");
 
     // writing the features itself
-    writer.Stream() << writer.ind() << "<ObjectData Count=\"";
-    if(writer.isSplitXML())
-        writer.Stream() << "0\">\n";
-    else {
-        writer.Stream() << obj.size() <<"\">\n";
-
-        writer.incInd(); // indentation for 'Object name'
+    writer.startElement("ObjectData")
+          .addAttribute("Count", writer.isSplitXML() ? 0 : obj.size())
+          .endStartTag();
+    if(!writer.isSplitXML()) {
         for (it = obj.begin(); it != obj.end(); ++it) 
             writeObject(writer,*it);
-        writer.decInd(); // indentation for 'Object name'
     }
-    writer.Stream() << writer.ind() << "</ObjectData>\n";
+    writer.endElement("ObjectData");
     writer.decInd();  // indentation for 'Objects count'
     writer.Stream() << "</Document>\n";
 }
 
 void Document::writeObject(Base::Writer &writer, DocumentObject *obj) const 
 {
-    writer.Stream() << writer.ind() << "<Object name=\"" << obj->getExportName() << "\"";
+    writer.startElement("Object").addAttribute("name", obj->getExportName());
     if(obj->canSaveExtension())
-        writer.Stream() << " Extensions=\"True\"";
-
-    writer.Stream() << ">\n";
+        writer.addAttribute("Extensions", "True");
+    writer.endStartTag();
+    // PropertyContainer::Save() indents its content by itself
+    writer.decInd();
     obj->Save(writer);
-    writer.Stream() << writer.ind() << "</Object>\n";
+    writer.incInd();
+    writer.endElement("Object");
 }
 
 void Document::SaveDocFile(Base::Writer &writer) const {
@@ -2141,6 +2145,12 @@ bool Document::saveToFile(const char* filename) const
             _writer.reset(zipwriter);
             zipwriter->setComment("FreeCAD Document");
             zipwriter->setLevel(compression);
+            if (DocumentParams::getParallelSave()) {
+                int count = DocumentParams::getSaveThreadCount();
+                zipwriter->setThreadCount(count > 0 ? count : QThread::idealThreadCount());
+                long long threshold = StoreUncompressed.getValue();
+                zipwriter->setStoreThreshold(threshold > 0 ? threshold*1024*1024 : threshold);
+            }
         } else {
             _writer.reset(new Base::FileWriter(tmp.filePath().c_str()));
         }
@@ -2216,7 +2226,14 @@ void Document::save(Base::Writer &writer, bool archive) const {
         writer.setSplitXML(SplitXML.getValue());
     }
 
-    writer.putNextEntry("Document.xml");
+    auto zipWriter = archive ? dynamic_cast<Base::ZipWriter*>(&writer) : nullptr;
+    if (zipWriter && DocumentParams::getBinaryDocument()) {
+        // The document content is encoded in binary and converted back to a
+        // plain Document.xml put in front of it, so that older versions,
+        // which read the first entry, can still open the file.
+        zipWriter->putNextBinaryEntry("Document.fcbx", nullptr, "Document.xml");
+    } else
+        writer.putNextEntry("Document.xml");
 
     if (PreferBinary.getValue()) {
         writer.setMode("BinaryBrep");
@@ -2236,6 +2253,10 @@ void Document::save(Base::Writer &writer, bool archive) const {
     // write additional files
     writer.writeFiles();
 
+    // wait for any entries still being compressed
+    if (zipWriter)
+        zipWriter->finishEntries();
+
     if (writer.hasErrors()) {
         throw Base::FileException("Failed to write all data to file");
     }
@@ -2276,7 +2297,20 @@ void Document::restore (const char *filename,
         // buf->pubseekoff(0, std::ios::beg, std::ios::in);
         // if (size < 22) // an empty zip archive has 22 bytes
         //     throw Base::FileException("Invalid project file",filename);
+        bool binary = false;
+        try {
+            zipios::ZipFile zip(filename);
+            if (zip.getEntry("Document.fcbx", zipios::FileCollection::IGNORE))
+                binary = true;
+        } catch (...) {
+        }
         zipstream.reset(new zipios::ZipInputStream(filename));
+        if (binary) {
+            // Skip the XML copy of the document saved for older versions
+            auto entry = zipstream->getNextEntry();
+            if (!entry || entry->getName() != "Document.fcbx")
+                throw Base::FileException("Invalid binary project file", filename);
+        }
         _reader.reset(new Base::ZipReader(*zipstream,filename));
         _xmlReader.reset(new Base::XMLReader(*_reader));
     }
@@ -2341,6 +2375,10 @@ void Document::restore(Base::XMLReader &reader,
     // without GUI. But if available then follow after all data files of the App document.
     signalRestoreDocument(reader);
 
+    if (DocumentParams::getParallelRestore()) {
+        int threadCount = DocumentParams::getRestoreThreadCount();
+        reader.setRestoreThreadCount(threadCount > 0 ? threadCount : QThread::idealThreadCount());
+    }
     reader.readFiles();
 
     for(auto &f : reader.getFilenames()) {
@@ -2718,6 +2756,15 @@ std::vector<App::DocumentObject*> Document::getDependencyList(
         return ret;
     }
 
+    // Objects of a single document can be sorted using its cached dependency order
+    for (auto obj : objectArray) {
+        if (obj && obj->getNameInDocument()) {
+            if (obj->getDocument()->d->getDependencyList(objectArray, ret))
+                return ret;
+            break;
+        }
+    }
+
     DependencyList depList;
     std::map<DocumentObject*,Vertex> objectMap;
     std::map<Vertex,DocumentObject*> vertexMap;
@@ -2958,6 +3005,25 @@ public:
         --_Recomputing;
     }
 };
+
+// Task being executed by the current thread if it is a parallel recompute worker
+thread_local RecomputeTask *_RecomputeTask;
+
+class RecomputeRunnable : public QRunnable
+{
+public:
+    explicit RecomputeRunnable(std::function<void()> func)
+        : func(std::move(func))
+    {
+    }
+    void run() override
+    {
+        func();
+    }
+
+private:
+    std::function<void()> func;
+};
 } // anonymous namespace
 
 bool Document::isAnyRecomputing()
@@ -2965,6 +3031,91 @@ bool Document::isAnyRecomputing()
     return _Recomputing != 0;
 }
 
+bool Document::isInRecomputeThread()
+{
+    return _RecomputeTask != nullptr;
+}
+
+bool Document::_queuePropertySignal(const DocumentObject *Who, const Property *What, PropertySignal type)
+{
+    if (!_RecomputeTask)
+        return false;
+
+    if (type == PropertySignal::BeforeChange) {
+        // Listeners (e.g. undo transaction) expect to see the value before
+        // change, so signal it synchronously in the main thread while the
+        // worker waits.
+        _runInMainThread([this, Who, What]() {
+            onBeforeChangeProperty(Who, What);
+            Who->signalBeforeChange(*Who, *What);
+        });
+        return true;
+    }
+    _RecomputeTask->queuedSignals.push_back({Who, What, type});
+    return true;
+}
+
+void Document::_runInMainThread(const std::function<void()> &func)
+{
+    if (!_RecomputeTask) {
+        func();
+        return;
+    }
+    QMutexLocker locker(&d->recomputeMutex);
+    _RecomputeTask->request = func;
+    d->recomputeRequests.push_back(_RecomputeTask);
+    d->recomputeCondition.wakeAll();
+    while (_RecomputeTask->request)
+        d->recomputeCondition.wait(&d->recomputeMutex);
+}
+
+void Document::_serveRecomputeThreads()
+{
+    QMutexLocker locker(&d->recomputeMutex);
+    for (;;) {
+        if (d->recomputeRequests.empty()) {
+            if (d->recomputeRunning == 0)
+                break;
+            d->recomputeCondition.wait(&d->recomputeMutex);
+            continue;
+        }
+        auto task = d->recomputeRequests.front();
+        d->recomputeRequests.pop_front();
+        locker.unlock();
+        try {
+            task->request();
+        }
+        catch (Base::Exception &e) {
+            e.ReportException();
+        }
+        catch (std::exception &e) {
+            FC_ERR("Exception in recompute request: " << e.what());
+        }
+        catch (...) {
+            FC_ERR("Unknown exception in recompute request");
+        }
+        locker.relock();
+        task->request = nullptr;
+        d->recomputeCondition.wakeAll();
+    }
+}
+
+void Document::_dependencyChanged(const DocumentObject *Who)
+{
+    // May be called by the recompute workers, so check the flag under the
+    // lock as well
+    QMutexLocker locker(&d->recomputeMutex);
+    if (d->dependencyOrderValid)
+        d->dependencyPending.insert(Who);
+}
+
+void Document::_objectTouched(DocumentObject *Who)
+{
+    QMutexLocker locker(&d->recomputeMutex);
+    if (d->dependencyOrderValid)
+        d->recomputeCandidates.insert(Who);
+}
+
 int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool force, bool *hasError, int options)
 {
     RecomputeCounter counter;
@@ -3024,7 +3175,13 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     }
     std::reverse(topoSortedObjects.begin(),topoSortedObjects.end());
 #else
-    auto topoSortedObjects = getDependencyList(objs.empty()?d->objectArray:objs,DepSort|options);
+    // With no objects given, only the touched objects and their dependents
+    // are recomputed. Use the cached dependency order to avoid sorting all
+    // objects if possible.
+    std::vector<DocumentObject*> topoSortedObjects;
+    bool incremental = objs.empty() && d->getRecomputeObjects(topoSortedObjects);
+    if (!incremental)
+        topoSortedObjects = getDependencyList(objs.empty()?d->objectArray:objs,DepSort|options);
 #endif
     for(auto obj : topoSortedObjects)
         obj->setStatus(ObjectStatus::PendingRecompute,true);
@@ -3036,61 +3193,173 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
 
     FC_TIME_INIT(t2);
 
+    // Post process an object after its recomputation. Return false if the
+    // user aborts.
+    std::unique_ptr<Base::SequencerLauncher> seq;
+    auto finishObject = [&](DocumentObject *obj, bool doRecompute, int res) {
+        if(res) {
+            if(hasError)
+                *hasError = true;
+            if(res < 0)
+                return false;
+            // if something happened filter all object in its
+            // inListRecursive from the queue then proceed
+            obj->getInListEx(filter,true);
+            filter.insert(obj);
+            return true;
+        }
+        if(obj->isTouched() || doRecompute) {
+            signalRecomputedObject(*obj);
+            GetApplication().signalRecomputedObject(*this, *obj);
+            obj->purgeTouched();
+            // Mark all dependent object with ObjectStatus::Enforce.
+            // Note that We don't call enforceRecompute() here in order
+            // to enable recomputation optimization (see
+            // _recomputeFeature())
+            for (auto inObjIt : obj->getInList()) {
+                inObjIt->StatusBits.set(ObjectStatus::Enforce);
+                inObjIt->StatusBits.set(ObjectStatus::Touch);
+                _objectTouched(inObjIt);
+                if (obj->getDocument())
+                    obj->getDocument()->signalTouchedObject(*obj);
+            }
+
+            // give the object a chance to revert the above touching,
+            // because for example, new objects are created with
+            // object's execute(), and it will be safe to not touch
+            // those objects.
+            obj->afterRecompute();
+        }
+        if (seq)
+            seq->next(true);
+        return true;
+    };
+
+    // Recompute each set of independent objects in turn. Objects that
+    // support it are executed concurrently in worker threads, the rest are
+    // executed in the main thread afterwards. Signals and errors are
+    // reported in the original order. Return false if the user aborts.
+    auto recomputeParallel = [&](const std::vector<std::vector<DocumentObject*>> &levels) {
+        static QThreadPool pool;
+        int threadCount = DocumentParams::getRecomputeThreadCount();
+        pool.setMaxThreadCount(threadCount > 0 ? threadCount : QThread::idealThreadCount());
+
+        for (const auto &level : levels) {
+            std::vector<RecomputeTask> tasks;
+            tasks.reserve(level.size());
+            int threadedCount = 0;
+            for (auto obj : level) {
+                if(!obj->getNameInDocument() || filter.find(obj)!=filter.end())
+                    continue;
+                tasks.emplace_back(obj);
+                auto &task = tasks.back();
+                // Objects with a Python proxy (including Python extensions)
+                // may run Python code on execution, so they are never threaded.
+                if (!obj->canRecomputeInThread()
+                        || obj->getPropertyByName("Proxy")
+                        || !obj->mustRecompute())
+                    continue;
+                ++objectCount;
+                task.threaded = true;
+                _beginRecomputeFeature(task);
+                if (task.execute)
+                    ++threadedCount;
+            }
+
+            if (threadedCount == 1) {
+                // not worth the trouble of queuing signals
+                for (auto &task : tasks) {
+                    if (task.threaded && task.execute)
+                        _executeRecomputeFeature(task);
+                }
+            }
+            else if (threadedCount > 1) {
+                d->recomputeRunning = threadedCount;
+                for (auto &task : tasks) {
+                    if (!task.threaded || !task.execute)
+                        continue;
+                    pool.start(new RecomputeRunnable([this, &task]() {
+                        _RecomputeTask = &task;
+                        _executeRecomputeFeature(task);
+                        _RecomputeTask = nullptr;
+                        QMutexLocker locker(&d->recomputeMutex);
+                        --d->recomputeRunning;
+                        d->recomputeCondition.wakeAll();
+                    }));
+                }
+                // Run requests from the workers until all of them are done
+                _serveRecomputeThreads();
+            }
+
+            for (auto &task : tasks) {
+                auto obj = task.object;
+                bool doRecompute = false;
+                int res = 0;
+                if (task.threaded) {
+                    doRecompute = true;
+                    res = _endRecomputeFeature(task);
+                }
+                else if(!obj->getNameInDocument() || filter.find(obj)!=filter.end())
+                    continue;
+                else if (obj->mustRecompute()) {
+                    doRecompute = true;
+                    ++objectCount;
+                    res = _recomputeFeature(obj);
+                }
+                if (!finishObject(obj, doRecompute, res))
+                    return false;
+            }
+        }
+        return true;
+    };
+
     bool aborted = false;
     try {
         // maximum two passes to allow some form of dependency inversion
         for(int passes=0; passes<2 && idx<topoSortedObjects.size(); ++passes) {
-            std::unique_ptr<Base::SequencerLauncher> seq;
             if(canAbort)
                 seq.reset(new Base::SequencerLauncher("Recompute...", topoSortedObjects.size()));
             FC_LOG("Recompute pass " << passes);
+            std::vector<std::vector<DocumentObject*>> levels;
+            if (passes == 0 && DocumentParams::getParallelRecompute())
+                levels = DocumentP::getRecomputeLevels(topoSortedObjects);
+            if (!levels.empty()) {
+                if (!recomputeParallel(levels))
+                    passes = 2;
+                idx = topoSortedObjects.size();
+            }
             for (; idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
                 if(!obj->getNameInDocument() || filter.find(obj)!=filter.end())
                     continue;
                 // ask the object if it should be recomputed
                 bool doRecompute = false;
+                int res = 0;
                 if (obj->mustRecompute()) {
                     doRecompute = true;
                     ++objectCount;
-                    int res = _recomputeFeature(obj);
-                    if(res) {
-                        if(hasError)
-                            *hasError = true;
-                        if(res < 0) {
-                            passes = 2;
-                            break;
-                        }
-                        // if something happened filter all object in its
-                        // inListRecursive from the queue then proceed
-                        obj->getInListEx(filter,true);
-                        filter.insert(obj);
-                        continue;
-                    }
+                    res = _recomputeFeature(obj);
                 }
-                if(obj->isTouched() || doRecompute) {
-                    signalRecomputedObject(*obj);
-                    GetApplication().signalRecomputedObject(*this, *obj);
-                    obj->purgeTouched();
-                    // Mark all dependent object with ObjectStatus::Enforce.
-                    // Note that We don't call enforceRecompute() here in order
-                    // to enable recomputation optimization (see
-                    // _recomputeFeature())
-                    for (auto inObjIt : obj->getInList()) {
-                        inObjIt->StatusBits.set(ObjectStatus::Enforce);
-                        inObjIt->StatusBits.set(ObjectStatus::Touch);
-                        if (obj->getDocument())
-                            obj->getDocument()->signalTouchedObject(*obj);
+                if (!finishObject(obj, doRecompute, res)) {
+                    passes = 2;
+                    break;
+                }
+            }
+            // Objects outside of the recompute list may have been touched
+            // by others during recompute, refresh the list before checking
+            if (incremental && passes == 0) {
+                std::vector<DocumentObject*> objects;
+                if (d->getRecomputeObjects(objects)) {
+                    std::unordered_set<DocumentObject*> objSet(objects.begin(), objects.end());
+                    for (auto obj : objects)
+                        obj->setStatus(ObjectStatus::PendingRecompute,true);
+                    for (auto obj : topoSortedObjects) {
+                        if (!objSet.count(obj))
+                            objects.push_back(obj);
                     }
-
-                    // give the object a chance to revert the above touching,
-                    // because for example, new objects are created with
-                    // object's execute(), and it will be safe to not touch
-                    // those objects.
-                    obj->afterRecompute();
+                    topoSortedObjects = std::move(objects);
+                    idx = topoSortedObjects.size();
                 }
-                if (seq)
-                    seq->next(true);
             }
             // check if all objects are recomputed but still thouched
             for (size_t i=0;i<topoSortedObjects.size();++i) {
@@ -3109,6 +3378,7 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
                     }
                 }
             }
+            seq.reset();
         }
     }
     catch(Base::AbortException &e){
@@ -3273,6 +3543,272 @@ std::vector<App::DocumentObject*> DocumentP::partialTopologicalSort(
     return ret;
 }
 
+std::vector<std::vector<App::DocumentObject*>>
+DocumentP::getRecomputeLevels(const std::vector<App::DocumentObject*>& objects)
+{
+    std::vector<std::vector<App::DocumentObject*>> levels;
+    std::unordered_set<App::DocumentObject*> objSet(objects.begin(), objects.end());
+    std::unordered_map<App::DocumentObject*, std::size_t> levelMap;
+    levelMap.reserve(objects.size());
+
+    for (auto obj : objects) {
+        std::size_t level = 0;
+        for (auto dep : obj->getOutList()) {
+            auto it = levelMap.find(dep);
+            if (it != levelMap.end())
+                level = std::max(level, it->second + 1);
+            else if (objSet.count(dep)) {
+                // dependency not yet visited, either cyclic or not sorted
+                return {};
+            }
+        }
+        if (!levelMap.emplace(obj, level).second)
+            continue;
+        if (level >= levels.size())
+            levels.resize(level + 1);
+        levels[level].push_back(obj);
+    }
+    return levels;
+}
+
+bool DocumentP::rebuildDependencyOrder()
+{
+    resetDependencyOrder();
+
+    // Kahn's algorithm, only counting dependencies inside this document
+    std::unordered_map<const DocumentObject*, std::size_t> counts;
+    std::unordered_map<const DocumentObject*, std::vector<DocumentObject*>> dependents;
+    counts.reserve(objectArray.size());
+    for (auto obj : objectArray)
+        counts[obj] = 0;
+    for (auto obj : objectArray) {
+        for (auto dep : obj->getOutList()) {
+            if (!dep)
+                continue;
+            if (dep->getDocument() != obj->getDocument()) {
+                externalLinked.insert(obj);
+                continue;
+            }
+            if (!counts.count(dep))
+                continue;
+            ++counts[obj];
+            dependents[dep].push_back(obj);
+        }
+    }
+
+    dependencyOrder.reserve(objectArray.size());
+    for (auto obj : objectArray) {
+        if (!counts[obj])
+            dependencyOrder.push_back(obj);
+    }
+    for (std::size_t i=0; i<dependencyOrder.size(); ++i) {
+        auto it = dependents.find(dependencyOrder[i]);
+        if (it == dependents.end())
+            continue;
+        for (auto obj : it->second) {
+            if (--counts[obj] == 0)
+                dependencyOrder.push_back(obj);
+        }
+    }
+
+    if (dependencyOrder.size() != objectArray.size()) {
+        FC_LOG("cyclic dependency, skip dependency order caching");
+        resetDependencyOrder();
+        return false;
+    }
+
+    dependencyIndex.reserve(dependencyOrder.size());
+    for (std::size_t i=0; i<dependencyOrder.size(); ++i)
+        dependencyIndex[dependencyOrder[i]] = i;
+
+    // Touched objects are tracked incrementally from now on
+    for (auto obj : objectArray) {
+        if (obj->isTouched() || obj->mustRecompute())
+            recomputeCandidates.insert(obj);
+    }
+    QMutexLocker locker(&recomputeMutex);
+    dependencyOrderValid = true;
+    return true;
+}
+
+bool DocumentP::reorderDependency(const DocumentObject *obj, const DocumentObject *dep)
+{
+    std::size_t lower = dependencyIndex[obj];
+    std::size_t upper = dependencyIndex[dep];
+    if (upper <= lower)
+        return true;
+
+    // Collect 'dep' and its dependencies placed in between, which are to be
+    // moved in front of 'obj'. Only follow the links that agree with the
+    // current order, so that any pending change of other objects stays
+    // pending, and the rest of the order stays valid.
+    std::unordered_set<const DocumentObject*> moving;
+    std::vector<const DocumentObject*> stack;
+    moving.insert(dep);
+    stack.push_back(dep);
+    while (!stack.empty()) {
+        auto o = stack.back();
+        stack.pop_back();
+        std::size_t pos = dependencyIndex[o];
+        for (auto link : o->getOutList()) {
+            auto it = dependencyIndex.find(link);
+            if (it == dependencyIndex.end() || it->second < lower || it->second >= pos)
+                continue;
+            if (link == obj)
+                return false; // cyclic dependency
+            if (moving.insert(link).second)
+                stack.push_back(link);
+        }
+    }
+
+    std::vector<DocumentObject*> rest;
+    rest.reserve(upper - lower + 1 - moving.size());
+    std::size_t pos = lower;
+    for (std::size_t i=lower; i<=upper; ++i) {
+        auto o = dependencyOrder[i];
+        if (o && moving.count(o)) {
+            dependencyOrder[pos] = o;
+            dependencyIndex[o] = pos++;
+        }
+        else
+            rest.push_back(o);
+    }
+    for (auto o : rest) {
+        dependencyOrder[pos] = o;
+        if (o)
+            dependencyIndex[o] = pos;
+        ++pos;
+    }
+    return true;
+}
+
+bool DocumentP::updateDependencyOrder()
+{
+    if (!DocumentParams::getCacheDependencyOrder()) {
+        resetDependencyOrder();
+        return false;
+    }
+
+    // Rebuild if there are too many changes, e.g. after restore or large
+    // scale editing, or to compact the holes left by removed objects.
+    if (!dependencyOrderValid
+            || dependencyPending.size() * 4 > dependencyOrder.size()
+            || dependencyHoles * 2 > dependencyOrder.size())
+        return rebuildDependencyOrder();
+
+    auto pending = std::move(dependencyPending);
+    dependencyPending.clear();
+    for (auto obj : pending) {
+        if (!dependencyIndex.count(obj))
+            continue;
+        bool external = false;
+        for (auto dep : obj->getOutList()) {
+            if (!dep)
+                continue;
+            if (dep == obj) {
+                resetDependencyOrder();
+                return false;
+            }
+            if (dep->getDocument() != obj->getDocument()) {
+                external = true;
+                continue;
+            }
+            auto it = dependencyIndex.find(dep);
+            if (it != dependencyIndex.end()
+                    && it->second > dependencyIndex[obj]
+                    && !reorderDependency(obj, dep))
+            {
+                FC_LOG("cyclic dependency, skip dependency order caching");
+                resetDependencyOrder();
+                return false;
+            }
+        }
+        if (external)
+            externalLinked.insert(obj);
+        else
+            externalLinked.erase(obj);
+    }
+    return true;
+}
+
+bool DocumentP::getRecomputeObjects(std::vector<App::DocumentObject*> &objects)
+{
+    // Objects linking to other documents require recomputing the external
+    // dependencies as well, which is not covered by the cached order.
+    if (!updateDependencyOrder() || !externalLinked.empty())
+        return false;
+
+    std::vector<std::size_t> indices;
+    std::vector<DocumentObject*> stack;
+    std::unordered_set<const DocumentObject*> visited;
+    // Drop the candidates that are no longer touched, they will be added
+    // back on the next change.
+    for (auto it = recomputeCandidates.begin(); it != recomputeCandidates.end();) {
+        auto obj = *it;
+        if (obj->isTouched() || obj->mustRecompute()) {
+            stack.push_back(obj);
+            ++it;
+        }
+        else
+            it = recomputeCandidates.erase(it);
+    }
+    while (!stack.empty()) {
+        auto obj = stack.back();
+        stack.pop_back();
+        auto it = dependencyIndex.find(obj);
+        if (it == dependencyIndex.end() || !visited.insert(obj).second)
+            continue;
+        indices.push_back(it->second);
+        const auto &inList = obj->getInList();
+        stack.insert(stack.end(), inList.begin(), inList.end());
+    }
+
+    std::sort(indices.begin(), indices.end());
+    objects.clear();
+    objects.reserve(indices.size());
+    for (auto i : indices)
+        objects.push_back(dependencyOrder[i]);
+    return true;
+}
+
+bool DocumentP::getDependencyList(const std::vector<App::DocumentObject*> &objects,
+                                  std::vector<App::DocumentObject*> &res)
+{
+    if (!updateDependencyOrder() || !externalLinked.empty())
+        return false;
+
+    std::vector<std::size_t> indices;
+    std::vector<DocumentObject*> stack;
+    std::unordered_set<const DocumentObject*> visited;
+    for (auto obj : objects) {
+        if (!obj || !obj->getNameInDocument())
+            continue;
+        // object from other document
+        if (!dependencyIndex.count(obj))
+            return false;
+        stack.push_back(obj);
+    }
+    while (!stack.empty()) {
+        auto obj = stack.back();
+        stack.pop_back();
+        if (!obj || !obj->getNameInDocument() || !visited.insert(obj).second)
+            continue;
+        auto it = dependencyIndex.find(obj);
+        if (it == dependencyIndex.end())
+            return false;
+        indices.push_back(it->second);
+        const auto &outList = obj->getOutList();
+        stack.insert(stack.end(), outList.begin(), outList.end());
+    }
+
+    std::sort(indices.begin(), indices.end());
+    res.clear();
+    res.reserve(indices.size());
+    for (auto i : indices)
+        res.push_back(dependencyOrder[i]);
+    return true;
+}
+
 std::vector<App::DocumentObject*> DocumentP::topologicalSort(const std::vector<App::DocumentObject*>& objects) const
 {
     // topological sort algorithm described here:
@@ -3354,41 +3890,105 @@ void Document::setErrorDescription(App::Property *Prop, const char *msg)
 // call the recompute of the Feature and handle the exceptions and errors.
 int Document::_recomputeFeature(DocumentObject* Feat)
 {
-    DocumentObjectExecReturn  *returnCode = DocumentObject::StdReturn;
+    RecomputeTask task(Feat);
+    _beginRecomputeFeature(task);
+    if (task.execute)
+        _executeRecomputeFeature(task);
+    return _endRecomputeFeature(task);
+}
+
+void Document::_beginRecomputeFeature(RecomputeTask &task)
+{
+    auto Feat = task.object;
 
     // delete recompute log
     d->clearRecomputeLog(Feat);
 
     try {
-        returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
-        if (returnCode == DocumentObject::StdReturn) {
-            bool doRecompute = Feat->isError() || Feat->_enforceRecompute
-                                               || !DocumentParams::getOptimizeRecompute()
-                                               || testStatus(Status::Restoring);
-            if(!doRecompute) {
-                static unsigned long long mask = (1<<Property::Output)
-                                               | (1<<Property::PropOutput)
-                                               | (1<<Property::NoRecompute)
-                                               | (1<<Property::PropNoRecompute);
-                auto prop = Feat->testPropertyStatus(Property::Touched, mask);
-                if(prop) {
-                    FC_LOG("recompute on touched " << prop->getFullName());
-                    doRecompute = true;
-                }
-            }
+        task.returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+        if (task.returnCode != DocumentObject::StdReturn)
+            return;
 
-            if(!doRecompute && Feat->skipRecompute()) {
-                d->skippedObjs.push_back(Feat);
-                FC_LOG("Skip recomputing " << Feat->getFullName());
-            } else {
-                Feat->_enforceRecompute = false;
-                returnCode = Feat->recompute();
+        bool doRecompute = Feat->isError() || Feat->_enforceRecompute
+                                           || !DocumentParams::getOptimizeRecompute()
+                                           || testStatus(Status::Restoring);
+        if(!doRecompute) {
+            static unsigned long long mask = (1<<Property::Output)
+                                           | (1<<Property::PropOutput)
+                                           | (1<<Property::NoRecompute)
+                                           | (1<<Property::PropNoRecompute);
+            auto prop = Feat->testPropertyStatus(Property::Touched, mask);
+            if(prop) {
+                FC_LOG("recompute on touched " << prop->getFullName());
+                doRecompute = true;
             }
+        }
 
-            if(returnCode == DocumentObject::StdReturn)
-                returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
+        if(!doRecompute && Feat->skipRecompute()) {
+            d->skippedObjs.push_back(Feat);
+            FC_LOG("Skip recomputing " << Feat->getFullName());
+        } else {
+            Feat->_enforceRecompute = false;
+            task.execute = true;
         }
     }
+    catch (...) {
+        task.exception = std::current_exception();
+    }
+}
+
+void Document::_executeRecomputeFeature(RecomputeTask &task)
+{
+    FC_TIME_INIT(t);
+    try {
+        task.returnCode = task.object->recompute();
+    }
+    catch (...) {
+        task.exception = std::current_exception();
+    }
+    FC_DURATION_PLUS(task.duration, t);
+}
+
+int Document::_endRecomputeFeature(RecomputeTask &task)
+{
+    auto Feat = task.object;
+    DocumentObjectExecReturn *returnCode = task.returnCode;
+
+    // signal the property changes made in the worker thread
+    for (const auto &entry : task.queuedSignals) {
+        auto obj = entry.object;
+        auto prop = entry.property;
+        switch (entry.type) {
+        case PropertySignal::BeforeChange:
+            // signaled synchronously, see _queuePropertySignal()
+            break;
+        case PropertySignal::EarlyChange:
+            obj->signalEarlyChanged(*obj, *prop);
+            break;
+        case PropertySignal::Change:
+            onChangedProperty(obj, prop);
+            obj->signalChanged(*obj, *prop);
+            if (!prop->testStatus(Property::Busy)) {
+                auto p = const_cast<Property*>(prop);
+                Base::BitsetLocker<Property::StatusBits> guard(p->_StatusBits, Property::Busy);
+                p->signalChanged(*p);
+            }
+            break;
+        }
+    }
+    task.queuedSignals.clear();
+
+    if (task.execute) {
+        FC_DURATION_LOG(task.duration, "Recompute " << Feat->getFullName()
+                << (task.threaded ? " (threaded)" : ""));
+    }
+
+    try {
+        if (task.exception)
+            std::rethrow_exception(task.exception);
+        if (returnCode == DocumentObject::StdReturn)
+            returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
+    }
     catch(Base::AbortException &e){
         FC_LOG("Failed to recompute " << Feat->getFullName() << ": " << e.what());
         d->addRecomputeLog("User abort",Feat);
@@ -3806,6 +4406,7 @@ void Document::removeObject(const char* sName)
             break;
         }
     }
+    d->removeDependencyOrder(pos->second);
 
     // In case the object gets deleted the pointer must be nullified
     if (tobedestroyed) {
@@ -3881,6 +4482,7 @@ void Document::_removeObject(DocumentObject* pcObject)
             break;
         }
     }
+    d->removeDependencyOrder(pcObject);
 
     // for a rollback delete the object
     if (d->rollback) {
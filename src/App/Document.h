@@ -28,6 +28,7 @@
 #include "PropertyStandard.h"
 #include "PropertyFile.h"
 
+#include <functional>
 #include <memory>
 #include <map>
 #include <vector>
@@ -48,6 +49,7 @@ namespace App
     class DocumentPy; // the python document class
     class Application;
     class Transaction;
+    struct RecomputeTask;
 }
 
 namespace App
@@ -120,6 +122,8 @@ public:
     PropertyBool SplitXML;
     /// Prefer binary format when saving
     PropertyBool PreferBinary;
+    /// Size threshold in MB for storing file entries without compression
+    PropertyInteger StoreUncompressed;
     /// Specify user defined thumbnail
     PropertyFile ThumbnailFile;
     /// Indicate whether to auto update thumbnail on saving document
@@ -579,6 +583,16 @@ public:
     /// Indicate if there is any document recomputing
     static bool isAnyRecomputing();
 
+    /// Indicate if the calling thread is a worker thread of a parallel recompute
+    static bool isInRecomputeThread();
+
+    /// Type of property change notification queued during parallel recompute
+    enum class PropertySignal {
+        BeforeChange,
+        EarlyChange,
+        Change,
+    };
+
     long getLastObjectId() const;
     void setLastObjectId(long id); 
 
@@ -628,6 +642,35 @@ protected:
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
+    /** @name Split stages of _recomputeFeature()
+     *
+     * The first and last stage must be called in the main thread. The middle
+     * stage executes the object, and can be called in a worker thread if the
+     * object supports it (see DocumentObject::canRecomputeInThread()).
+     */
+    //@{
+    void _beginRecomputeFeature(RecomputeTask &task);
+    static void _executeRecomputeFeature(RecomputeTask &task);
+    int _endRecomputeFeature(RecomputeTask &task);
+    //@}
+    /** Queue a property change notification raised in a recompute worker thread
+     * @return Return true if the notification is queued, false if the caller
+     * shall signal the change as usual.
+     */
+    bool _queuePropertySignal(const DocumentObject *Who, const Property *What, PropertySignal type);
+    /** Run a function in the main thread
+     *
+     * If called in a recompute worker thread, the function is posted to the
+     * main thread, and the call blocks until it is done. Otherwise, the
+     * function is called directly.
+     */
+    void _runInMainThread(const std::function<void()> &func);
+    /// Run the requests posted by recompute workers until all workers are done
+    void _serveRecomputeThreads();
+    /// Called when the out list of an object is changed to update the cached dependency order
+    void _dependencyChanged(const DocumentObject *Who);
+    /// Called when an object is touched or changed to track the objects to be recomputed
+    void _objectTouched(DocumentObject *Who);
     void _clearRedos();
 
     /// refresh the internal dependency graph
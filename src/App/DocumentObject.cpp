@@ -207,6 +207,11 @@ App::DocumentObjectExecReturn* DocumentObject::executeExtensions()
     return StdReturn;
 }
 
+bool DocumentObject::canRecomputeInThread() const
+{
+    return false;
+}
+
 bool DocumentObject::recomputeFeature(bool recursive)
 {
     Document* doc = this->getDocument();
@@ -234,8 +239,10 @@ void DocumentObject::touch(bool noRecompute)
             ++_revision;
     }
     StatusBits.set(ObjectStatus::Touch);
-    if (_pDoc)
+    if (_pDoc) {
+        _pDoc->_objectTouched(this);
         _pDoc->signalTouchedObject(*this);
+    }
 }
 
 /**
@@ -789,8 +796,11 @@ void DocumentObject::onBeforeChange(const Property* prop)
     if (prop == &Label)
         oldLabel = Label.getStrValue();
 
-    if (_pDoc)
+    if (_pDoc) {
+        if (_pDoc->_queuePropertySignal(this, prop, Document::PropertySignal::BeforeChange))
+            return;
         onBeforeChangeProperty(_pDoc, prop);
+    }
 
     signalBeforeChange(*this,*prop);
 }
@@ -800,6 +810,9 @@ void DocumentObject::onEarlyChange(const Property *prop)
     if(GetApplication().isClosingAll())
         return;
 
+    if(_pDoc && _pDoc->_queuePropertySignal(this, prop, Document::PropertySignal::EarlyChange))
+        return;
+
     if(!GetApplication().isRestoring() && 
        !prop->testStatus(Property::PartialTrigger) &&
        getDocument() && 
@@ -857,6 +870,14 @@ void DocumentObject::onChanged(const Property* prop)
     //call the parent for appropriate handling
     TransactionalObject::onChanged(prop);
 
+    // Any change may affect mustExecute(), so track it for the next recompute
+    if (_pDoc)
+        _pDoc->_objectTouched(this);
+
+    // Signals raised in a parallel recompute worker thread are delayed
+    if (_pDoc && _pDoc->_queuePropertySignal(this, prop, Document::PropertySignal::Change))
+        return;
+
     // Now signal the view provider
     if (_pDoc)
         _pDoc->onChangedProperty(this,prop);
@@ -868,6 +889,8 @@ void DocumentObject::clearOutListCache() const {
     _outList.clear();
     _outListMap.clear();
     _outListCached = false;
+    if (_pDoc)
+        _pDoc->_dependencyChanged(this);
 }
 
 PyObject *DocumentObject::getPyObject()
@@ -659,6 +659,20 @@ protected:
      * @return Return false to force recompute
      */
     virtual bool skipRecompute();
+    /** Called by Document::recompute() to check if this object can be executed in a worker thread
+     *
+     * It is only consulted when parallel recompute is enabled. By returning
+     * true, the object promises that its execute() only reads from its
+     * dependencies and modifies its own properties, and never touches Python
+     * or the GUI. The before change signal of a property is emitted in the
+     * main thread while the worker waits, any other property change signal
+     * raised during execution will be delayed until the object is done, and
+     * then emitted in the main thread.
+     *
+     * @return The default implementation returns false, so that the object
+     * is always recomputed in the main thread.
+     */
+    virtual bool canRecomputeInThread() const;
     /// recompute only this object
     virtual App::DocumentObjectExecReturn *recompute();
     /** get called by the document to recompute this feature
@@ -78,6 +78,15 @@ public:
         signalParamChanged("RelativeStringID");
         signalParamChanged("HashIndexedName");
         signalParamChanged("EnableMaterialEdit");
+        signalParamChanged("ParallelRecompute");
+        signalParamChanged("RecomputeThreadCount");
+        signalParamChanged("CacheDependencyOrder");
+        signalParamChanged("ParallelRestore");
+        signalParamChanged("RestoreThreadCount");
+        signalParamChanged("BinaryDocument");
+        signalParamChanged("ParallelSave");
+        signalParamChanged("SaveThreadCount");
+        signalParamChanged("StoreUncompressed");
 
     // Auto generated code (Tools/params_utils.py:232)
     }
@@ -113,6 +122,15 @@ public:
     bool RelativeStringID;
     bool HashIndexedName;
     bool EnableMaterialEdit;
+    bool ParallelRecompute;
+    long RecomputeThreadCount;
+    bool CacheDependencyOrder;
+    bool ParallelRestore;
+    long RestoreThreadCount;
+    bool BinaryDocument;
+    bool ParallelSave;
+    long SaveThreadCount;
+    long StoreUncompressed;
 
     // Auto generated code (Tools/params_utils.py:245)
     DocumentParamsP() {
@@ -183,6 +201,24 @@ public:
         funcs["HashIndexedName"] = &DocumentParamsP::updateHashIndexedName;
         EnableMaterialEdit = handle->GetBool("EnableMaterialEdit", true);
         funcs["EnableMaterialEdit"] = &DocumentParamsP::updateEnableMaterialEdit;
+        ParallelRecompute = handle->GetBool("ParallelRecompute", false);
+        funcs["ParallelRecompute"] = &DocumentParamsP::updateParallelRecompute;
+        RecomputeThreadCount = handle->GetInt("RecomputeThreadCount", 0);
+        funcs["RecomputeThreadCount"] = &DocumentParamsP::updateRecomputeThreadCount;
+        CacheDependencyOrder = handle->GetBool("CacheDependencyOrder", true);
+        funcs["CacheDependencyOrder"] = &DocumentParamsP::updateCacheDependencyOrder;
+        ParallelRestore = handle->GetBool("ParallelRestore", false);
+        funcs["ParallelRestore"] = &DocumentParamsP::updateParallelRestore;
+        RestoreThreadCount = handle->GetInt("RestoreThreadCount", 0);
+        funcs["RestoreThreadCount"] = &DocumentParamsP::updateRestoreThreadCount;
+        BinaryDocument = handle->GetBool("BinaryDocument", false);
+        funcs["BinaryDocument"] = &DocumentParamsP::updateBinaryDocument;
+        ParallelSave = handle->GetBool("ParallelSave", false);
+        funcs["ParallelSave"] = &DocumentParamsP::updateParallelSave;
+        SaveThreadCount = handle->GetInt("SaveThreadCount", 0);
+        funcs["SaveThreadCount"] = &DocumentParamsP::updateSaveThreadCount;
+        StoreUncompressed = handle->GetInt("StoreUncompressed", 0);
+        funcs["StoreUncompressed"] = &DocumentParamsP::updateStoreUncompressed;
     }
 
     // Auto generated code (Tools/params_utils.py:263)
@@ -329,6 +365,42 @@ public:
     static void updateEnableMaterialEdit(DocumentParamsP *self) {
         self->EnableMaterialEdit = self->handle->GetBool("EnableMaterialEdit", true);
     }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateParallelRecompute(DocumentParamsP *self) {
+        self->ParallelRecompute = self->handle->GetBool("ParallelRecompute", false);
+    }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateRecomputeThreadCount(DocumentParamsP *self) {
+        self->RecomputeThreadCount = self->handle->GetInt("RecomputeThreadCount", 0);
+    }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateCacheDependencyOrder(DocumentParamsP *self) {
+        self->CacheDependencyOrder = self->handle->GetBool("CacheDependencyOrder", true);
+    }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateParallelRestore(DocumentParamsP *self) {
+        self->ParallelRestore = self->handle->GetBool("ParallelRestore", false);
+    }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateRestoreThreadCount(DocumentParamsP *self) {
+        self->RestoreThreadCount = self->handle->GetInt("RestoreThreadCount", 0);
+    }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateBinaryDocument(DocumentParamsP *self) {
+        self->BinaryDocument = self->handle->GetBool("BinaryDocument", false);
+    }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateParallelSave(DocumentParamsP *self) {
+        self->ParallelSave = self->handle->GetBool("ParallelSave", false);
+    }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateSaveThreadCount(DocumentParamsP *self) {
+        self->SaveThreadCount = self->handle->GetInt("SaveThreadCount", 0);
+    }
+    // Auto generated code (Tools/params_utils.py:288)
+    static void updateStoreUncompressed(DocumentParamsP *self) {
+        self->StoreUncompressed = self->handle->GetInt("StoreUncompressed", 0);
+    }
 };
 
 // Auto generated code (Tools/params_utils.py:310)
@@ -1220,4 +1292,270 @@ void DocumentParams::setEnableMaterialEdit(const bool &v) {
 void DocumentParams::removeEnableMaterialEdit() {
     instance()->handle->RemoveBool("EnableMaterialEdit");
 }
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *DocumentParams::docParallelRecompute() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Enable recomputing independent objects in worker threads. Only objects\n"
+"that declare themselves thread safe are executed in parallel, the rest\n"
+"are still recomputed in the main thread.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const bool & DocumentParams::getParallelRecompute() {
+    return instance()->ParallelRecompute;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const bool & DocumentParams::defaultParallelRecompute() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void DocumentParams::setParallelRecompute(const bool &v) {
+    instance()->handle->SetBool("ParallelRecompute",v);
+    instance()->ParallelRecompute = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void DocumentParams::removeParallelRecompute() {
+    instance()->handle->RemoveBool("ParallelRecompute");
+}
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *DocumentParams::docRecomputeThreadCount() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Maximum number of worker threads used by parallel recompute. Zero means\n"
+"using the number of available CPU cores.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const long & DocumentParams::getRecomputeThreadCount() {
+    return instance()->RecomputeThreadCount;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const long & DocumentParams::defaultRecomputeThreadCount() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void DocumentParams::setRecomputeThreadCount(const long &v) {
+    instance()->handle->SetInt("RecomputeThreadCount",v);
+    instance()->RecomputeThreadCount = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void DocumentParams::removeRecomputeThreadCount() {
+    instance()->handle->RemoveInt("RecomputeThreadCount");
+}
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *DocumentParams::docCacheDependencyOrder() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Maintain a cached dependency order of all objects in a document that is\n"
+"updated incrementally on link changes. Speeds up recompute and dependency\n"
+"sorting of large documents.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const bool & DocumentParams::getCacheDependencyOrder() {
+    return instance()->CacheDependencyOrder;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const bool & DocumentParams::defaultCacheDependencyOrder() {
+    const static bool def = true;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void DocumentParams::setCacheDependencyOrder(const bool &v) {
+    instance()->handle->SetBool("CacheDependencyOrder",v);
+    instance()->CacheDependencyOrder = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void DocumentParams::removeCacheDependencyOrder() {
+    instance()->handle->RemoveBool("CacheDependencyOrder");
+}
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *DocumentParams::docParallelRestore() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Enable decoding shape, mesh and point data in worker threads when opening\n"
+"a project file.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const bool & DocumentParams::getParallelRestore() {
+    return instance()->ParallelRestore;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const bool & DocumentParams::defaultParallelRestore() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void DocumentParams::setParallelRestore(const bool &v) {
+    instance()->handle->SetBool("ParallelRestore",v);
+    instance()->ParallelRestore = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void DocumentParams::removeParallelRestore() {
+    instance()->handle->RemoveBool("ParallelRestore");
+}
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *DocumentParams::docRestoreThreadCount() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Maximum number of worker threads used by parallel restore. Zero means\n"
+"using the number of available CPU cores.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const long & DocumentParams::getRestoreThreadCount() {
+    return instance()->RestoreThreadCount;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const long & DocumentParams::defaultRestoreThreadCount() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void DocumentParams::setRestoreThreadCount(const long &v) {
+    instance()->handle->SetInt("RestoreThreadCount",v);
+    instance()->RestoreThreadCount = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void DocumentParams::removeRestoreThreadCount() {
+    instance()->handle->RemoveInt("RestoreThreadCount");
+}
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *DocumentParams::docBinaryDocument() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Save the document content of project files in compact binary format for faster\n"
+"loading. A plain XML copy of the content is also saved, so that the files can\n"
+"still be opened by older versions of FreeCAD.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const bool & DocumentParams::getBinaryDocument() {
+    return instance()->BinaryDocument;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const bool & DocumentParams::defaultBinaryDocument() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void DocumentParams::setBinaryDocument(const bool &v) {
+    instance()->handle->SetBool("BinaryDocument",v);
+    instance()->BinaryDocument = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void DocumentParams::removeBinaryDocument() {
+    instance()->handle->RemoveBool("BinaryDocument");
+}
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *DocumentParams::docParallelSave() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Enable compressing the entries of project files in worker threads on saving.\n"
+"This also applies to compressed auto recovery files, which are then finished\n"
+"in background.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const bool & DocumentParams::getParallelSave() {
+    return instance()->ParallelSave;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const bool & DocumentParams::defaultParallelSave() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void DocumentParams::setParallelSave(const bool &v) {
+    instance()->handle->SetBool("ParallelSave",v);
+    instance()->ParallelSave = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void DocumentParams::removeParallelSave() {
+    instance()->handle->RemoveBool("ParallelSave");
+}
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *DocumentParams::docSaveThreadCount() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Maximum number of entries compressed concurrently by parallel saving. Zero\n"
+"means using the number of available CPU cores.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const long & DocumentParams::getSaveThreadCount() {
+    return instance()->SaveThreadCount;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const long & DocumentParams::defaultSaveThreadCount() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void DocumentParams::setSaveThreadCount(const long &v) {
+    instance()->handle->SetInt("SaveThreadCount",v);
+    instance()->SaveThreadCount = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void DocumentParams::removeSaveThreadCount() {
+    instance()->handle->RemoveInt("SaveThreadCount");
+}
+
+// Auto generated code (Tools/params_utils.py:350)
+const char *DocumentParams::docStoreUncompressed() {
+    return QT_TRANSLATE_NOOP("DocumentParams",
+"Default size threshold in MB for storing entries of project files without\n"
+"compression. Negative to always compress. Zero to only store entries of already\n"
+"compressed data, such as images. Only effective with parallel saving.");
+}
+
+// Auto generated code (Tools/params_utils.py:358)
+const long & DocumentParams::getStoreUncompressed() {
+    return instance()->StoreUncompressed;
+}
+
+// Auto generated code (Tools/params_utils.py:366)
+const long & DocumentParams::defaultStoreUncompressed() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:375)
+void DocumentParams::setStoreUncompressed(const long &v) {
+    instance()->handle->SetInt("StoreUncompressed",v);
+    instance()->StoreUncompressed = v;
+}
+
+// Auto generated code (Tools/params_utils.py:384)
+void DocumentParams::removeStoreUncompressed() {
+    instance()->handle->RemoveInt("StoreUncompressed");
+}
 //[[[end]]]
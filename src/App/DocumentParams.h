@@ -394,6 +394,128 @@ public:
     static const char *docEnableMaterialEdit();
     //@}
 
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter ParallelRecompute
+    ///
+    /// Enable recomputing independent objects in worker threads. Only objects
+    /// that declare themselves thread safe are executed in parallel, the rest
+    /// are still recomputed in the main thread.
+    static const bool & getParallelRecompute();
+    static const bool & defaultParallelRecompute();
+    static void removeParallelRecompute();
+    static void setParallelRecompute(const bool &v);
+    static const char *docParallelRecompute();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter RecomputeThreadCount
+    ///
+    /// Maximum number of worker threads used by parallel recompute. Zero means
+    /// using the number of available CPU cores.
+    static const long & getRecomputeThreadCount();
+    static const long & defaultRecomputeThreadCount();
+    static void removeRecomputeThreadCount();
+    static void setRecomputeThreadCount(const long &v);
+    static const char *docRecomputeThreadCount();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter CacheDependencyOrder
+    ///
+    /// Maintain a cached dependency order of all objects in a document that is
+    /// updated incrementally on link changes. Speeds up recompute and dependency
+    /// sorting of large documents.
+    static const bool & getCacheDependencyOrder();
+    static const bool & defaultCacheDependencyOrder();
+    static void removeCacheDependencyOrder();
+    static void setCacheDependencyOrder(const bool &v);
+    static const char *docCacheDependencyOrder();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter ParallelRestore
+    ///
+    /// Enable decoding shape, mesh and point data in worker threads when opening
+    /// a project file.
+    static const bool & getParallelRestore();
+    static const bool & defaultParallelRestore();
+    static void removeParallelRestore();
+    static void setParallelRestore(const bool &v);
+    static const char *docParallelRestore();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter RestoreThreadCount
+    ///
+    /// Maximum number of worker threads used by parallel restore. Zero means
+    /// using the number of available CPU cores.
+    static const long & getRestoreThreadCount();
+    static const long & defaultRestoreThreadCount();
+    static void removeRestoreThreadCount();
+    static void setRestoreThreadCount(const long &v);
+    static const char *docRestoreThreadCount();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter BinaryDocument
+    ///
+    /// Save the document content of project files in compact binary format for faster
+    /// loading. A plain XML copy of the content is also saved, so that the files can
+    /// still be opened by older versions of FreeCAD.
+    static const bool & getBinaryDocument();
+    static const bool & defaultBinaryDocument();
+    static void removeBinaryDocument();
+    static void setBinaryDocument(const bool &v);
+    static const char *docBinaryDocument();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter ParallelSave
+    ///
+    /// Enable compressing the entries of project files in worker threads on saving.
+    /// This also applies to compressed auto recovery files, which are then finished
+    /// in background.
+    static const bool & getParallelSave();
+    static const bool & defaultParallelSave();
+    static void removeParallelSave();
+    static void setParallelSave(const bool &v);
+    static const char *docParallelSave();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter SaveThreadCount
+    ///
+    /// Maximum number of entries compressed concurrently by parallel saving. Zero
+    /// means using the number of available CPU cores.
+    static const long & getSaveThreadCount();
+    static const long & defaultSaveThreadCount();
+    static void removeSaveThreadCount();
+    static void setSaveThreadCount(const long &v);
+    static const char *docSaveThreadCount();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:138)
+    //@{
+    /// Accessor for parameter StoreUncompressed
+    ///
+    /// Default size threshold in MB for storing entries of project files without
+    /// compression. Negative to always compress. Zero to only store entries of already
+    /// compressed data, such as images. Only effective with parallel saving.
+    static const long & getStoreUncompressed();
+    static const long & defaultStoreUncompressed();
+    static void removeStoreUncompressed();
+    static void setStoreUncompressed(const long &v);
+    static const char *docStoreUncompressed();
+    //@}
+
 // Auto generated code (Tools/params_utils.py:178)
 }; // class DocumentParams
 } // namespace App
@@ -71,6 +71,38 @@ Params = [
         doc='Enable special encoding of indexes name in toponaming. Disabled by\n'
             'default for backward compatibility'),
     ParamBool('EnableMaterialEdit', True),
+    ParamBool('ParallelRecompute', False,
+        doc='Enable recomputing independent objects in worker threads. Only objects\n'
+            'that declare themselves thread safe are executed in parallel, the rest\n'
+            'are still recomputed in the main thread.'),
+    ParamInt('RecomputeThreadCount', 0,
+        doc='Maximum number of worker threads used by parallel recompute. Zero means\n'
+            'using the number of available CPU cores.'),
+    ParamBool('CacheDependencyOrder', True,
+        doc='Maintain a cached dependency order of all objects in a document that is\n'
+            'updated incrementally on link changes. Speeds up recompute and dependency\n'
+            'sorting of large documents.'),
+    ParamBool('ParallelRestore', False,
+        doc='Enable decoding shape, mesh and point data in worker threads when opening\n'
+            'a project file.'),
+    ParamInt('RestoreThreadCount', 0,
+        doc='Maximum number of worker threads used by parallel restore. Zero means\n'
+            'using the number of available CPU cores.'),
+    ParamBool('BinaryDocument', False,
+        doc='Save the document content of project files in compact binary format for faster\n'
+            'loading. A plain XML copy of the content is also saved, so that the files can\n'
+            'still be opened by older versions of FreeCAD.'),
+    ParamBool('ParallelSave', False,
+        doc='Enable compressing the entries of project files in worker threads on saving.\n'
+            'This also applies to compressed auto recovery files, which are then finished\n'
+            'in background.'),
+    ParamInt('SaveThreadCount', 0,
+        doc='Maximum number of entries compressed concurrently by parallel saving. Zero\n'
+            'means using the number of available CPU cores.'),
+    ParamInt('StoreUncompressed', 0,
+        doc='Default size threshold in MB for storing entries of project files without\n'
+            'compression. Negative to always compress. Zero to only store entries of already\n'
+            'compressed data, such as images. Only effective with parallel saving.'),
 ]
 
 def declare():
@@ -299,14 +299,14 @@ void DynamicProperty::save(const Property *prop, Base::Writer &writer) const
     auto it = index.find(const_cast<Property*>(prop));
     if(it != index.end()) {
         auto &data = *it;
-        writer.Stream() << "\" group=\"" << Base::Persistence::encodeAttribute(data.group)
-                        << "\" attr=\"" << data.attr 
-                        << "\" ro=\"" << data.readonly
-                        << "\" hide=\"" << data.hidden;
+        writer.addAttribute("group", data.group)
+              .addAttribute("attr", data.attr)
+              .addAttribute("ro", static_cast<int>(data.readonly))
+              .addAttribute("hide", static_cast<int>(data.hidden));
         if(writer.getFileVersion()>1 && data.docID)
-            writer.Stream() << "\" docID=\"" << data.docID.value();
+            writer.addAttribute("docID", data.docID.value());
         else
-            writer.Stream() << "\" doc=\"" << Base::Persistence::encodeAttribute(data.getDoc());
+            writer.addAttribute("doc", data.getDoc());
     }
 }
 
@@ -212,6 +212,10 @@ public:
     bool skipRecompute() override {
         return imp->skipRecompute() && FeatureT::skipRecompute();
     }
+    /// Python feature is always recomputed in the main thread
+    bool canRecomputeInThread() const override {
+        return false;
+    }
     /// recalculate the Feature
     const char* getViewProviderNameOverride() const override {
         viewProviderName = imp->getViewProviderName();
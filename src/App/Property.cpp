@@ -241,13 +241,14 @@ struct PropertyCleaner {
 
     Property *prop;
 
-    static std::vector<Property*> _RemovedProps;
-    static int _PropCleanerCounter;
+    // thread local for parallel recompute, see Document::recompute()
+    static thread_local std::vector<Property*> _RemovedProps;
+    static thread_local int _PropCleanerCounter;
 };
 }
 
-std::vector<Property*> PropertyCleaner::_RemovedProps;
-int PropertyCleaner::_PropCleanerCounter = 0;
+thread_local std::vector<Property*> PropertyCleaner::_RemovedProps;
+thread_local int PropertyCleaner::_PropCleanerCounter = 0;
 
 void Property::destroy(Property *p) {
     if (p) {
@@ -272,7 +273,8 @@ void Property::touch()
                   && !Document::isRemoving(this)) {
         father->onEarlyChange(this);
         father->onChanged(this);
-        if(!testStatus(Busy)) {
+        // signal is delayed to the main thread if inside a recompute worker
+        if(!testStatus(Busy) && !Document::isInRecomputeThread()) {
             Base::BitsetLocker<StatusBits> guard(_StatusBits,Busy);
             signalChanged(*this);
         }
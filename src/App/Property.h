@@ -292,6 +292,7 @@ public:
     friend class PropertyContainer;
     friend struct PropertyData;
     friend class DynamicProperty;
+    friend class Document;
 
 private:
     /** Status bits of the property
@@ -327,18 +327,23 @@ void PropertyContainer::Save (Base::Writer &writer) const
     auto & Map = _pimpl->propertyMap;
     auto & transients = _pimpl->transients;
 
+    // The structured writer API is used for the elements written for each
+    // property, as it is much faster when writing binary XML.
     writer.incInd(); // indentation for 'Properties Count'
-    writer.Stream() << writer.ind() << "<Properties Count=\"" << Map.size()
-                    << "\" TransientCount=\"" << transients.size() << "\">\n";
+    writer.startElement("Properties")
+          .addAttribute("Count", Map.size())
+          .addAttribute("TransientCount", transients.size())
+          .endStartTag();
 
     // First store transient properties to persist their status value. We use
     // a new element named "_Property" so that the save file can be opened by
     // older versions of FC.
-    writer.incInd();
     for(auto prop : transients) {
-        writer.Stream() << writer.ind() << "<_Property name=\"" << prop->getName() 
-            << "\" type=\"" << prop->getTypeId().getName() 
-            << "\" status=\"" << prop->getStatus() << "\"/>\n";
+        writer.startElement("_Property")
+              .addAttribute("name", prop->getName())
+              .addAttribute("type", prop->getTypeId().getName())
+              .addAttribute("status", prop->getStatus())
+              .endStartTag(true);
     }
     writer.decInd();
 
@@ -346,27 +351,25 @@ void PropertyContainer::Save (Base::Writer &writer) const
     for (auto it = Map.begin(); it != Map.end(); ++it)
     {
         writer.incInd(); // indentation for 'Property name'
-        writer.Stream() << writer.ind() << "<Property name=\"" << it->first << "\" type=\"" 
-                        << it->second->getTypeId().getName();
+        writer.startElement("Property")
+              .addAttribute("name", it->first)
+              .addAttribute("type", it->second->getTypeId().getName());
 
         dynamicProps.save(it->second,writer);
 
         auto status = it->second->getStatus();
         if(status)
-            writer.Stream() << "\" status=\"" << status;
-        writer.Stream() << "\">";
+            writer.addAttribute("status", status);
 
         if(it->second->testStatus(Property::Transient) 
                 || it->second->getType() & Prop_Transient) 
         {
-            writer.Stream() << "</Property>\n";
+            writer.endStartTag(true);
             writer.decInd();
             continue;
         }
 
-        writer.Stream() << '\n';
-
-        writer.incInd(); // indentation for the actual property
+        writer.endStartTag(); // indentation for the actual property
 
         try {
             // We must make sure to handle all exceptions accordingly so that
@@ -388,11 +391,11 @@ void PropertyContainer::Save (Base::Writer &writer) const
             Base::Console().Error("PropertyContainer::Save: Unknown C++ exception thrown. Try to continue...\n");
         }
 #endif
-        writer.decInd(); // indentation for the actual property
-        writer.Stream() << writer.ind() << "</Property>\n";    
+        writer.endElement("Property");
         writer.decInd(); // indentation for 'Property name'
     }
-    writer.Stream() << writer.ind() << "</Properties>\n";
+    writer.incInd();
+    writer.endElement("Properties");
     writer.decInd(); // indentation for 'Properties Count'
 }
 
@@ -1011,23 +1011,23 @@ void PropertyPlacement::Save (Base::Writer &writer) const
     double rfAngle;
     _cPos.getRotation().getRawValue(axis, rfAngle);
 
-    writer.Stream() << writer.ind() << "<PropertyPlacement"
-                    << " Px=\"" <<  _cPos.getPosition().x 
-                    << "\" Py=\"" <<  _cPos.getPosition().y
-                    << "\" Pz=\"" <<  _cPos.getPosition().z
+    writer.startElement("PropertyPlacement")
+          .addAttribute("Px", _cPos.getPosition().x)
+          .addAttribute("Py", _cPos.getPosition().y)
+          .addAttribute("Pz", _cPos.getPosition().z)
 
-                    << "\" Q0=\"" <<  _cPos.getRotation()[0]
-                    << "\" Q1=\"" <<  _cPos.getRotation()[1]
-                    << "\" Q2=\"" <<  _cPos.getRotation()[2]
-                    << "\" Q3=\"" <<  _cPos.getRotation()[3]
+          .addAttribute("Q0", _cPos.getRotation()[0])
+          .addAttribute("Q1", _cPos.getRotation()[1])
+          .addAttribute("Q2", _cPos.getRotation()[2])
+          .addAttribute("Q3", _cPos.getRotation()[3])
 
-                    << "\" A=\"" <<  rfAngle
+          .addAttribute("A", rfAngle)
 
-                    << "\" Ox=\"" <<  axis.x
-                    << "\" Oy=\"" <<  axis.y
-                    << "\" Oz=\"" <<  axis.z 
+          .addAttribute("Ox", axis.x)
+          .addAttribute("Oy", axis.y)
+          .addAttribute("Oz", axis.z)
 
-                    << "\"/>\n";
+          .endStartTag(true);
 }
 
 void PropertyPlacement::Restore(Base::XMLReader &reader)
@@ -712,7 +712,9 @@ void PropertyLink::purgeTouched() {
 
 void PropertyLink::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Link value=\"" <<  (_pcLink?_pcLink->getExportName():"") <<"\"/>\n";
+    writer.startElement("Link")
+          .addAttribute("value", _pcLink?_pcLink->getExportName():std::string())
+          .endStartTag(true);
 }
 
 void PropertyLink::Restore(Base::XMLReader &reader)
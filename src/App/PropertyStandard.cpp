@@ -116,7 +116,7 @@ void PropertyInteger::setPyObject(PyObject *value)
 
 void PropertyInteger::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Integer value=\"" <<  _lValue <<"\"/>\n";
+    writer.startElement("Integer").addAttribute("value", _lValue).endStartTag(true);
 }
 
 void PropertyInteger::Restore(Base::XMLReader &reader)
@@ -398,10 +398,10 @@ bool PropertyEnumeration::isValid() const
 
 void PropertyEnumeration::Save(Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Integer value=\"" <<  _enum.getInt() <<"\"";
+    writer.startElement("Integer").addAttribute("value", _enum.getInt());
     if (persistEnums && _enum.isCustom())
-        writer.Stream() << " CustomEnum=\"true\"";
-    writer.Stream() << "/>\n";
+        writer.addAttribute("CustomEnum", "true");
+    writer.endStartTag(true);
     if (persistEnums && _enum.isCustom()) {
         std::vector<std::string> items = getEnumVector();
         writer.Stream() << writer.ind() << "<CustomEnumList count=\"" <<  items.size() <<"\">\n";
@@ -1073,7 +1073,7 @@ void PropertyFloat::setPyObject(PyObject *value)
 
 void PropertyFloat::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Float value=\"" <<  _dValue <<"\"/>\n";
+    writer.startElement("Float").addAttribute("value", _dValue).endStartTag(true);
 }
 
 void PropertyFloat::Restore(Base::XMLReader &reader)
@@ -1681,24 +1681,21 @@ void PropertyString::setPyObject(PyObject *value)
 
 void PropertyString::Save (Base::Writer &writer) const
 {
-    std::string val;
     auto obj = dynamic_cast<DocumentObject*>(getContainer());
-    writer.Stream() << writer.ind() << "<String ";
-    bool exported = false;
+    writer.startElement("String");
     if(obj && obj->getNameInDocument() &&
        obj->isExporting() && &obj->Label==this)
     {
         if(obj->allowDuplicateLabel())
-            writer.Stream() <<"restore=\"1\" ";
+            writer.addAttribute("restore", 1);
         else if(_cValue==obj->getNameInDocument()) {
-            writer.Stream() <<"restore=\"0\" ";
-            val = encodeAttribute(obj->getExportName());
-            exported = true;
+            writer.addAttribute("restore", 0)
+                  .addAttribute("value", obj->getExportName())
+                  .endStartTag(true);
+            return;
         }
     }
-    if(!exported)
-        val = encodeAttribute(_cValue);
-    writer.Stream() <<"value=\"" << val <<"\"/>\n";
+    writer.addAttribute("value", _cValue).endStartTag(true);
 }
 
 void PropertyString::Restore(Base::XMLReader &reader)
@@ -2249,12 +2246,7 @@ void PropertyBool::setPyObject(PyObject *value)
 
 void PropertyBool::Save (Base::Writer &writer) const
 {
-    writer.Stream() << writer.ind() << "<Bool value=\"" ;
-    if (_lValue)
-        writer.Stream() << "true" <<"\"/>" ;
-    else
-        writer.Stream() << "false" <<"\"/>" ;
-    writer.Stream() << '\n';
+    writer.startElement("Bool").addAttribute("value", _lValue ? "true" : "false").endStartTag(true);
 }
 
 void PropertyBool::Restore(Base::XMLReader &reader)
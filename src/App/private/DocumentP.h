@@ -23,13 +23,20 @@
 #ifndef APP_DOCUMENTP_H
 #define APP_DOCUMENTP_H
 
+#include <App/Document.h>
 #include <App/DocumentObject.h>
 #include <App/DocumentObserver.h>
+#include <Base/Console.h>
 #include <CXX/Objects.hxx>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/bimap.hpp>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
+#include <QMutex>
+#include <QWaitCondition>
 
 // using VertexProperty = boost::property<boost::vertex_root_t, DocumentObject* >;
 using DependencyList = boost::adjacency_list <
@@ -52,6 +59,37 @@ class Transaction;
 
 using HasherMap = boost::bimap<StringHasherRef,int>;
 
+/// State of a single object recompute, see Document::_beginRecomputeFeature()
+struct RecomputeTask
+{
+    explicit RecomputeTask(DocumentObject *obj)
+        : object(obj)
+    {
+        FC_DURATION_INIT(duration);
+    }
+
+    struct QueuedSignal
+    {
+        const DocumentObject *object;
+        const Property *property;
+        Document::PropertySignal type;
+    };
+
+    DocumentObject *object;
+    DocumentObjectExecReturn *returnCode = DocumentObject::StdReturn;
+    /// exception thrown by any stage, rethrown in Document::_endRecomputeFeature()
+    std::exception_ptr exception;
+    /// whether the object is (to be) executed
+    bool execute = false;
+    /// whether the object is executed in a worker thread
+    bool threaded = false;
+    /// property change notifications raised while executing in a worker thread
+    std::vector<QueuedSignal> queuedSignals;
+    /// call posted by the worker thread to be run in the main thread
+    std::function<void()> request;
+    FC_DURATION_DECLARE(duration);
+};
+
 // Pimpl class
 struct DocumentP
 {
@@ -89,6 +127,29 @@ struct DocumentP
 #endif //USE_OLD_DAG
     std::multimap<const App::DocumentObject*,
         std::unique_ptr<App::DocumentObjectExecReturn> > _RecomputeLog;
+    /// guards the shared states below against concurrent recompute workers,
+    /// including dependencyOrderValid and the sets updated by the workers
+    QMutex recomputeMutex;
+    /// signaled when a worker posts a request or finishes, or a request is done
+    QWaitCondition recomputeCondition;
+    /// tasks waiting for the main thread to run their request
+    std::deque<RecomputeTask*> recomputeRequests;
+    /// number of workers still running
+    int recomputeRunning = 0;
+
+    /// Cached dependency order of all objects, dependencies first. Removed
+    /// objects leave a null hole. See updateDependencyOrder().
+    std::vector<DocumentObject*> dependencyOrder;
+    std::unordered_map<const DocumentObject*, std::size_t> dependencyIndex;
+    /// objects whose out list changed since the last update of the order
+    std::unordered_set<const DocumentObject*> dependencyPending;
+    /// objects linking to objects in other documents
+    std::unordered_set<const DocumentObject*> externalLinked;
+    /// objects touched or changed since the last recompute, a superset of the
+    /// objects to be recomputed. Only maintained with a valid dependency order.
+    std::unordered_set<DocumentObject*> recomputeCandidates;
+    std::size_t dependencyHoles = 0;
+    bool dependencyOrderValid = false;
 
     StringHasherRef Hasher;
 
@@ -110,9 +171,43 @@ struct DocumentP
         }
         ++revision;
         this->objectArray.push_back(pcObject);
+        QMutexLocker locker(&recomputeMutex);
+        if (dependencyOrderValid) {
+            // no dependency yet, any position is fine
+            dependencyIndex[pcObject] = dependencyOrder.size();
+            dependencyOrder.push_back(pcObject);
+            dependencyPending.insert(pcObject);
+            recomputeCandidates.insert(pcObject);
+        }
         return id ? id : this->lastObjectId;
     }
 
+    void removeDependencyOrder(const App::DocumentObject *pcObject) {
+        QMutexLocker locker(&recomputeMutex);
+        if (!dependencyOrderValid)
+            return;
+        auto it = dependencyIndex.find(pcObject);
+        if (it != dependencyIndex.end()) {
+            dependencyOrder[it->second] = nullptr;
+            ++dependencyHoles;
+            dependencyIndex.erase(it);
+        }
+        dependencyPending.erase(pcObject);
+        externalLinked.erase(pcObject);
+        recomputeCandidates.erase(const_cast<App::DocumentObject*>(pcObject));
+    }
+
+    void resetDependencyOrder() {
+        QMutexLocker locker(&recomputeMutex);
+        dependencyOrderValid = false;
+        dependencyOrder.clear();
+        dependencyIndex.clear();
+        dependencyPending.clear();
+        externalLinked.clear();
+        recomputeCandidates.clear();
+        dependencyHoles = 0;
+    }
+
     void addRecomputeLog(const char *why, App::DocumentObject *obj) {
         addRecomputeLog(new DocumentObjectExecReturn(why, obj));
     }
@@ -140,6 +235,7 @@ struct DocumentP
     void clearDocument() {
         activeObject = nullptr;
         objectArray.clear();
+        resetDependencyOrder();
         decltype(objectMap) map = std::move(objectMap);
         objectMap.clear();
         objectIdMap.clear();
@@ -163,6 +259,46 @@ struct DocumentP
     topologicalSort(const std::vector<App::DocumentObject*>& objects) const;
     std::vector<App::DocumentObject*>
     static partialTopologicalSort(const std::vector<App::DocumentObject*>& objects);
+    /** Group a dependency sorted object list into sets of mutually independent objects
+     *
+     * @param objects: objects sorted with dependencies first, as returned by
+     * Document::getDependencyList() with DepSort
+     *
+     * @return Return the ready sets in execution order. Objects in each set
+     * only depend on objects of earlier sets, and keep their relative order
+     * in \a objects. Empty if \a objects is not properly sorted, e.g. due to
+     * cyclic dependency.
+     */
+    static std::vector<std::vector<App::DocumentObject*>>
+    getRecomputeLevels(const std::vector<App::DocumentObject*>& objects);
+
+    /** Bring the cached dependency order up to date
+     *
+     * The order is built once with a full topological sort, and afterwards
+     * repaired locally for each object whose out list has changed, by only
+     * moving objects in between the affected positions.
+     *
+     * @return Return false if the order is not available, e.g. due to cyclic
+     * dependency.
+     */
+    bool updateDependencyOrder();
+    bool rebuildDependencyOrder();
+    bool reorderDependency(const App::DocumentObject *obj, const App::DocumentObject *dep);
+    /** Obtain the objects to be recomputed, i.e. the touched objects and their
+     * dependents, sorted using the cached dependency order
+     *
+     * @return Return false if the cached order cannot be used, in which case
+     * the caller shall fall back to sort all objects.
+     */
+    bool getRecomputeObjects(std::vector<App::DocumentObject*> &objects);
+    /** Obtain the given objects and all their dependencies sorted using the
+     * cached dependency order
+     *
+     * @return Return false if the cached order cannot be used, e.g. when
+     * any object is from or links to other document.
+     */
+    bool getDependencyList(const std::vector<App::DocumentObject*> &objects,
+                           std::vector<App::DocumentObject*> &res);
 };
 
 } // namespace App
@@ -0,0 +1,686 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <cstdlib>
+# include <cstring>
+# include <limits>
+#endif
+
+#include "BinaryXML.h"
+
+using namespace Base;
+
+// Maximum length of attribute value to be put into the value table
+static const std::size_t _MaxValueLength = 64;
+// Maximum number of entries in the value table
+static const std::size_t _MaxValueCount = 1024*1024;
+// Output buffer size before flushing to the underlying stream
+static const std::size_t _OutputBufferSize = 64*1024;
+
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+static void appendUtf8(std::uint32_t code, std::string &res)
+{
+    if (code < 0x80)
+        res.push_back(static_cast<char>(code));
+    else if (code < 0x800) {
+        res.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        res.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else if (code < 0x10000) {
+        res.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        res.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        res.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else {
+        res.push_back(static_cast<char>(0xF0 | ((code >> 18) & 0x07)));
+        res.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        res.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        res.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+bool BinaryXML::isBinary(std::istream &stream)
+{
+    auto buf = stream.rdbuf();
+    return buf && buf->sgetc() == std::char_traits<char>::to_int_type(Magic[0]);
+}
+
+static void writeEscaped(std::ostream &out, const std::string &s, bool attribute)
+{
+    for (char c : s) {
+        switch(c) {
+        case '<': out << "&lt;"; break;
+        case '>': out << "&gt;"; break;
+        case '&': out << "&amp;"; break;
+        case '\r': out << "&#13;"; break;
+        case '"':
+            if (attribute)
+                out << "&quot;";
+            else
+                out << c;
+            break;
+        case '\n':
+            if (attribute)
+                out << "&#10;";
+            else
+                out << c;
+            break;
+        case '\t':
+            if (attribute)
+                out << "&#9;";
+            else
+                out << c;
+            break;
+        default:
+            out << c;
+        }
+    }
+}
+
+bool BinaryXML::toXML(std::istream &in, std::ostream &out)
+{
+    BinaryXMLDecoder decoder(in);
+    if (!decoder.readHeader())
+        return false;
+
+    out << "<?xml version='1.0' encoding='utf-8'?>";
+
+    std::string name, chars;
+    std::map<std::string, std::string> attrs;
+    std::string indent;
+    // Formatting white space is only added between tags, because any white
+    // space next to character data would become part of it.
+    bool newLine = true;
+    for (;;) {
+        auto token = decoder.next(name, attrs, chars);
+        switch(token) {
+        case BinaryXML::StartElement:
+        case BinaryXML::StartEndElement:
+            if (newLine)
+                out << '\n' << indent;
+            out << '<' << name;
+            for (const auto &v : attrs) {
+                out << ' ' << v.first << "=\"";
+                writeEscaped(out, v.second, true);
+                out << '"';
+            }
+            if (token == BinaryXML::StartEndElement)
+                out << "/>";
+            else {
+                out << '>';
+                indent.append(2, ' ');
+            }
+            newLine = true;
+            break;
+        case BinaryXML::EndElement:
+            if (indent.size() >= 2)
+                indent.resize(indent.size() - 2);
+            if (newLine)
+                out << '\n' << indent;
+            out << "</" << name << '>';
+            newLine = true;
+            break;
+        case BinaryXML::Characters:
+            writeEscaped(out, chars, false);
+            newLine = false;
+            break;
+        case BinaryXML::EndDocument:
+            out << '\n';
+            return true;
+        default:
+            return false;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+BinaryXMLEncoder::BinaryXMLEncoder(std::ostream &out, bool header)
+    : _out(out), _buffer(4096)
+{
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    if (header) {
+        _output.append(BinaryXML::Magic, BinaryXML::MagicSize);
+        _output.push_back(static_cast<char>(BinaryXML::Version));
+    }
+}
+
+BinaryXMLEncoder::~BinaryXMLEncoder()
+{
+    finish();
+}
+
+void BinaryXMLEncoder::finish()
+{
+    if (_finished)
+        return;
+    process(pbase(), pptr() - pbase());
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    flushText();
+    _output.push_back(static_cast<char>(BinaryXML::EndDocument));
+    flushOutput();
+    _finished = true;
+}
+
+void BinaryXMLEncoder::syncText()
+{
+    process(pbase(), pptr() - pbase());
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    flushText();
+}
+
+void BinaryXMLEncoder::startElement(const char *name,
+                                    const Attribute *attrs,
+                                    std::size_t count,
+                                    bool empty)
+{
+    if (_finished)
+        return;
+    syncText();
+    _output.push_back(static_cast<char>(
+                empty ? BinaryXML::StartEndElement : BinaryXML::StartElement));
+    // reuse the string buffers to avoid allocation on lookup
+    _name.assign(name);
+    writeName(_name);
+    writeVarInt(count);
+    for (std::size_t i=0; i<count; ++i) {
+        _name.assign(attrs[i].first);
+        writeName(_name);
+        writeValue(attrs[i].second);
+    }
+    if (_output.size() >= _OutputBufferSize)
+        flushOutput();
+}
+
+void BinaryXMLEncoder::endElement()
+{
+    if (_finished)
+        return;
+    syncText();
+    _output.push_back(static_cast<char>(BinaryXML::EndElement));
+}
+
+BinaryXMLEncoder::int_type BinaryXMLEncoder::overflow(int_type c)
+{
+    process(pbase(), pptr() - pbase());
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int BinaryXMLEncoder::sync()
+{
+    process(pbase(), pptr() - pbase());
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    flushOutput();
+    return _out ? 0 : -1;
+}
+
+void BinaryXMLEncoder::process(const char *s, std::size_t n)
+{
+    if (_finished)
+        return;
+    const char *end = s + n;
+    while (s < end) {
+        // Fast path to copy runs of ordinary characters in bulk
+        const char *p = s;
+        if (!_lastCR) {
+            switch(_state) {
+            case Text:
+                while (p < end && *p != '<' && *p != '\r')
+                    ++p;
+                _raw.append(s, p);
+                break;
+            case Tag:
+                if (_quote) {
+                    while (p < end && *p != _quote && *p != '\r')
+                        ++p;
+                }
+                else if (_tag.size() >= 8) {
+                    while (p < end && *p != '>' && *p != '"' && *p != '\'' && *p != '\r')
+                        ++p;
+                }
+                _tag.append(s, p);
+                break;
+            case CData:
+                while (p < end && *p != '>' && *p != '\r')
+                    ++p;
+                _text.append(s, p);
+                break;
+            default:
+                break;
+            }
+        }
+        if (p < end)
+            feed(*p++);
+        s = p;
+    }
+    if (_output.size() >= _OutputBufferSize)
+        flushOutput();
+}
+
+void BinaryXMLEncoder::feed(char c)
+{
+    // XML end of line normalization
+    if (c == '\r') {
+        _lastCR = true;
+        c = '\n';
+    }
+    else if (c == '\n' && _lastCR) {
+        _lastCR = false;
+        return;
+    }
+    else
+        _lastCR = false;
+
+    switch(_state) {
+    case Text:
+        if (c == '<') {
+            _state = Tag;
+            _tag.clear();
+            _quote = 0;
+        }
+        else
+            _raw.push_back(c);
+        break;
+    case Tag:
+        if (_quote) {
+            if (c == _quote)
+                _quote = 0;
+            _tag.push_back(c);
+            break;
+        }
+        if (c == '>') {
+            parseTag();
+            _state = Text;
+            break;
+        }
+        if (c == '"' || c == '\'')
+            _quote = c;
+        _tag.push_back(c);
+        if (_tag.size() == 1 && c == '?')
+            _state = ProcessingInstruction;
+        else if (_tag.size() == 3 && _tag == "!--") {
+            _state = Comment;
+            _tag.clear();
+        }
+        else if (_tag.size() == 8 && _tag == "![CDATA[") {
+            decodeRaw(_raw, _text, false);
+            _raw.clear();
+            _hasData = true;
+            _cdataStart = _text.size();
+            _state = CData;
+        }
+        break;
+    case CData:
+        if (c == '>'
+                && _text.size() >= _cdataStart + 2
+                && _text[_text.size()-1] == ']'
+                && _text[_text.size()-2] == ']')
+        {
+            _text.resize(_text.size()-2);
+            _state = Text;
+        }
+        else
+            _text.push_back(c);
+        break;
+    case Comment:
+        if (c == '>' && _tag.size() == 2 && _tag[0] == '-' && _tag[1] == '-') {
+            _tag.clear();
+            _state = Text;
+            break;
+        }
+        if (_tag.size() == 2)
+            _tag.erase(_tag.begin());
+        _tag.push_back(c);
+        break;
+    case ProcessingInstruction:
+        if (c == '>' && _tag.back() == '?') {
+            _tag.clear();
+            _state = Text;
+        }
+        else
+            _tag.push_back(c);
+        break;
+    }
+}
+
+void BinaryXMLEncoder::flushText()
+{
+    if (_raw.size()) {
+        decodeRaw(_raw, _text, false);
+        _raw.clear();
+    }
+    if (_text.empty())
+        return;
+    bool significant = _hasData;
+    if (!significant) {
+        for (char c : _text) {
+            if (!isSpace(c)) {
+                significant = true;
+                break;
+            }
+        }
+    }
+    if (significant) {
+        _output.push_back(static_cast<char>(BinaryXML::Characters));
+        writeString(_text);
+    }
+    _text.clear();
+    _hasData = false;
+}
+
+void BinaryXMLEncoder::parseTag()
+{
+    flushText();
+
+    if (_tag.empty() || _tag[0] == '!' || _tag[0] == '?')
+        return;
+
+    if (_tag[0] == '/') {
+        _output.push_back(static_cast<char>(BinaryXML::EndElement));
+        return;
+    }
+
+    std::size_t end = _tag.size();
+    bool empty = false;
+    if (_tag[end-1] == '/') {
+        empty = true;
+        --end;
+    }
+
+    std::size_t i = 0;
+    while (i < end && !isSpace(_tag[i]))
+        ++i;
+    _name.assign(_tag, 0, i);
+
+    std::size_t count = 0;
+    for (;;) {
+        while (i < end && isSpace(_tag[i]))
+            ++i;
+        if (i >= end)
+            break;
+        std::size_t start = i;
+        while (i < end && _tag[i] != '=' && !isSpace(_tag[i]))
+            ++i;
+        std::size_t nameEnd = i;
+        while (i < end && isSpace(_tag[i]))
+            ++i;
+        if (i >= end || _tag[i] != '=')
+            break;
+        ++i;
+        while (i < end && isSpace(_tag[i]))
+            ++i;
+        if (i >= end || (_tag[i] != '"' && _tag[i] != '\''))
+            break;
+        char quote = _tag[i++];
+        std::size_t valueStart = i;
+        while (i < end && _tag[i] != quote)
+            ++i;
+        if (count == _attrs.size())
+            _attrs.emplace_back();
+        auto &attr = _attrs[count++];
+        attr.first.assign(_tag, start, nameEnd - start);
+        _value.assign(_tag, valueStart, i - valueStart);
+        attr.second.clear();
+        decodeRaw(_value, attr.second, true);
+        ++i;
+    }
+
+    _output.push_back(static_cast<char>(
+                empty ? BinaryXML::StartEndElement : BinaryXML::StartElement));
+    writeName(_name);
+    writeVarInt(count);
+    for (std::size_t j=0; j<count; ++j) {
+        writeName(_attrs[j].first);
+        writeValue(_attrs[j].second);
+    }
+}
+
+void BinaryXMLEncoder::decodeRaw(const std::string &raw, std::string &res, bool attribute)
+{
+    for (std::size_t i=0, size=raw.size(); i<size; ++i) {
+        char c = raw[i];
+        if (c == '&') {
+            std::size_t pos = raw.find(';', i+1);
+            if (pos != std::string::npos && pos - i <= 12) {
+                const char *entity = raw.c_str() + i + 1;
+                std::size_t len = pos - i - 1;
+                if (len == 2 && entity[0] == 'l' && entity[1] == 't')
+                    res.push_back('<');
+                else if (len == 2 && entity[0] == 'g' && entity[1] == 't')
+                    res.push_back('>');
+                else if (len == 3 && std::strncmp(entity, "amp", 3) == 0)
+                    res.push_back('&');
+                else if (len == 4 && std::strncmp(entity, "quot", 4) == 0)
+                    res.push_back('"');
+                else if (len == 4 && std::strncmp(entity, "apos", 4) == 0)
+                    res.push_back('\'');
+                else if (len > 1 && entity[0] == '#') {
+                    bool hex = entity[1] == 'x';
+                    std::uint32_t code = static_cast<std::uint32_t>(
+                            std::strtoul(entity + (hex ? 2 : 1), nullptr, hex ? 16 : 10));
+                    appendUtf8(code, res);
+                }
+                else {
+                    res.append(raw, i, pos - i + 1);
+                }
+                i = pos;
+                continue;
+            }
+        }
+        else if (attribute && (c == '\n' || c == '\t')) {
+            // XML attribute value normalization
+            c = ' ';
+        }
+        res.push_back(c);
+    }
+}
+
+void BinaryXMLEncoder::writeVarInt(std::uint64_t v)
+{
+    while (v >= 0x80) {
+        _output.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    _output.push_back(static_cast<char>(v));
+}
+
+void BinaryXMLEncoder::writeString(const std::string &s)
+{
+    writeVarInt(s.size());
+    _output.append(s);
+}
+
+void BinaryXMLEncoder::writeName(const std::string &name)
+{
+    auto it = _names.find(name);
+    if (it != _names.end()) {
+        writeVarInt(it->second + 1);
+        return;
+    }
+    _names.emplace(name, static_cast<std::uint32_t>(_names.size()));
+    writeVarInt(0);
+    writeString(name);
+}
+
+void BinaryXMLEncoder::writeValue(const std::string &value)
+{
+    if (value.size() <= _MaxValueLength) {
+        auto it = _values.find(value);
+        if (it != _values.end()) {
+            writeVarInt(it->second + 2);
+            return;
+        }
+        if (_values.size() < _MaxValueCount) {
+            _values.emplace(value, static_cast<std::uint32_t>(_values.size()));
+            writeVarInt(1);
+            writeString(value);
+            return;
+        }
+    }
+    writeVarInt(0);
+    writeString(value);
+}
+
+void BinaryXMLEncoder::flushOutput()
+{
+    if (_output.empty())
+        return;
+    _out.write(_output.data(), static_cast<std::streamsize>(_output.size()));
+    _output.clear();
+}
+
+// ---------------------------------------------------------------------------
+
+BinaryXMLDecoder::BinaryXMLDecoder(std::istream &in)
+    : _buf(in.rdbuf())
+{
+}
+
+bool BinaryXMLDecoder::readHeader()
+{
+    char magic[BinaryXML::MagicSize];
+    if (!_buf
+            || _buf->sgetn(magic, BinaryXML::MagicSize) != BinaryXML::MagicSize
+            || std::memcmp(magic, BinaryXML::Magic, BinaryXML::MagicSize) != 0)
+        return false;
+    auto v = _buf->sbumpc();
+    if (v == std::char_traits<char>::eof())
+        return false;
+    _version = v;
+    return _version > 0 && _version <= BinaryXML::Version;
+}
+
+bool BinaryXMLDecoder::readVarInt(std::uint64_t &v)
+{
+    v = 0;
+    for (int shift=0; shift<64; shift+=7) {
+        auto c = _buf->sbumpc();
+        if (c == std::char_traits<char>::eof())
+            return false;
+        v |= static_cast<std::uint64_t>(c & 0x7F) << shift;
+        if (!(c & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool BinaryXMLDecoder::readString(std::string &s)
+{
+    std::uint64_t size;
+    if (!readVarInt(size)
+            || size > static_cast<std::uint64_t>(std::numeric_limits<std::streamsize>::max()))
+        return false;
+    s.resize(size);
+    return !size || _buf->sgetn(&s[0], static_cast<std::streamsize>(size))
+                        == static_cast<std::streamsize>(size);
+}
+
+bool BinaryXMLDecoder::readName(std::uint32_t &index)
+{
+    std::uint64_t v;
+    if (!readVarInt(v))
+        return false;
+    if (v == 0) {
+        _names.emplace_back();
+        index = static_cast<std::uint32_t>(_names.size() - 1);
+        return readString(_names.back());
+    }
+    if (v > _names.size())
+        return false;
+    index = static_cast<std::uint32_t>(v - 1);
+    return true;
+}
+
+bool BinaryXMLDecoder::readValue(std::string &value)
+{
+    std::uint64_t v;
+    if (!readVarInt(v))
+        return false;
+    if (v == 0)
+        return readString(value);
+    if (v == 1) {
+        if (!readString(value))
+            return false;
+        _values.push_back(value);
+        return true;
+    }
+    if (v - 2 >= _values.size())
+        return false;
+    value = _values[v - 2];
+    return true;
+}
+
+BinaryXML::Token BinaryXMLDecoder::next(std::string &name,
+                                        std::map<std::string, std::string> &attrs,
+                                        std::string &chars)
+{
+    auto c = _buf->sbumpc();
+    if (c == std::char_traits<char>::eof())
+        return BinaryXML::Invalid;
+
+    switch(c) {
+    case BinaryXML::EndDocument:
+        return BinaryXML::EndDocument;
+    case BinaryXML::StartElement:
+    case BinaryXML::StartEndElement: {
+        std::uint32_t index;
+        std::uint64_t count;
+        if (!readName(index) || !readVarInt(count))
+            return BinaryXML::Invalid;
+        name = _names[index];
+        attrs.clear();
+        for (std::uint64_t i=0; i<count; ++i) {
+            std::uint32_t attr;
+            if (!readName(attr) || !readValue(attrs[_names[attr]]))
+                return BinaryXML::Invalid;
+        }
+        if (c == BinaryXML::StartElement)
+            _stack.push_back(index);
+        return static_cast<BinaryXML::Token>(c);
+    }
+    case BinaryXML::EndElement:
+        if (_stack.empty())
+            return BinaryXML::Invalid;
+        name = _names[_stack.back()];
+        _stack.pop_back();
+        return BinaryXML::EndElement;
+    case BinaryXML::Characters:
+        if (!readString(chars))
+            return BinaryXML::Invalid;
+        return BinaryXML::Characters;
+    default:
+        return BinaryXML::Invalid;
+    }
+}
@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef BASE_BINARY_XML_H
+#define BASE_BINARY_XML_H
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <FCGlobal.h>
+
+namespace Base
+{
+
+/** Compact binary encoding of the XML content written by Persistence::Save()
+ *
+ * The binary stream carries the same element/attribute/character events as
+ * the XML text, so that all existing Save() and Restore() implementations
+ * work unchanged. The stream starts with a fixed magic header followed by a
+ * format version byte. The rest of the stream is a sequence of tagged tokens.
+ * Element and attribute names are stored once in a name table and referred
+ * to by index afterwards. Short attribute values (e.g. property type names,
+ * object names, link sub element names) are likewise deduplicated. All
+ * integers are encoded as LEB128 variable length integers.
+ *
+ * \see BinaryXMLEncoder, BinaryXMLDecoder
+ */
+namespace BinaryXML
+{
+/// Magic header identifying a binary XML stream
+static constexpr char Magic[] = "\x89" "FCBXML\n";
+/// Size of the magic header excluding the trailing zero
+static constexpr std::size_t MagicSize = sizeof(Magic) - 1;
+/// Current format version
+static constexpr unsigned char Version = 1;
+
+/// Token tags
+enum Token : unsigned char {
+    EndDocument = 0,
+    StartElement = 1,
+    StartEndElement = 2,
+    EndElement = 3,
+    Characters = 4,
+    Invalid = 0xff,
+};
+
+/** Check whether the stream contains binary XML
+ * Only the first byte is peeked, so no input is consumed. Note that a
+ * valid XML stream never starts with this byte.
+ */
+BaseExport bool isBinary(std::istream &stream);
+
+/** Convert a binary XML stream back to indented XML text
+ * @param in: input stream starting with the magic header
+ * @param out: output stream for the XML text
+ * @return Return false if the input is not a valid binary XML stream.
+ *
+ * This is used to keep a plain XML copy of a binary document for readers
+ * that do not understand the binary format.
+ */
+BaseExport bool toXML(std::istream &in, std::ostream &out);
+
+} // namespace BinaryXML
+
+/** Stream buffer for converting XML text into binary XML
+ *
+ * The encoder parses the XML text fed through the stream on the fly, and
+ * writes the corresponding binary tokens to the output stream. XML
+ * declaration, processing instructions and comments are skipped. Character
+ * data consisting only of white spaces outside of any CDATA section is
+ * considered as formatting and dropped. Entity and character references are
+ * resolved before encoding.
+ *
+ * Elements can also be encoded directly with startElement() and
+ * endElement(), which is used by Writer::startElement() to avoid formatting
+ * and parsing the XML text.
+ */
+class BaseExport BinaryXMLEncoder : public std::streambuf
+{
+public:
+    /** Constructor
+     * @param out: output stream for the binary data
+     * @param header: whether to write the magic header
+     */
+    explicit BinaryXMLEncoder(std::ostream &out, bool header=true);
+    ~BinaryXMLEncoder() override;
+
+    /// Flush any pending data and write the end of document token
+    void finish();
+
+    /// Attribute name and (unescaped) value
+    using Attribute = std::pair<const char*, std::string>;
+
+    /** Encode the start of an element
+     * @param name: element name
+     * @param attrs: attribute array
+     * @param count: number of attributes
+     * @param empty: whether the element is empty, i.e. no endElement() follows
+     *
+     * Any XML text fed through the stream before is encoded first, so that
+     * text and direct encoding can be mixed.
+     */
+    void startElement(const char *name, const Attribute *attrs, std::size_t count, bool empty);
+    /// Encode the end of the current element
+    void endElement();
+
+protected:
+    int_type overflow(int_type c) override;
+    int sync() override;
+
+private:
+    void process(const char *s, std::size_t n);
+    void syncText();
+    void feed(char c);
+    void flushText();
+    void parseTag();
+    void decodeRaw(const std::string &raw, std::string &res, bool attribute);
+    void writeVarInt(std::uint64_t v);
+    void writeString(const std::string &s);
+    void writeName(const std::string &name);
+    void writeValue(const std::string &value);
+    void flushOutput();
+
+    BinaryXMLEncoder(const BinaryXMLEncoder&) = delete;
+    BinaryXMLEncoder& operator=(const BinaryXMLEncoder&) = delete;
+
+private:
+    enum State {
+        Text,
+        Tag,
+        Comment,
+        CData,
+        ProcessingInstruction,
+    };
+
+    std::ostream &_out;
+    std::string _output;
+    std::vector<char> _buffer;
+    State _state = Text;
+    char _quote = 0;
+    bool _lastCR = false;
+    bool _hasData = false;
+    bool _finished = false;
+    std::string _tag;
+    std::string _raw;
+    std::string _text;
+    std::string _name;
+    std::string _value;
+    std::size_t _cdataStart = 0;
+    std::vector<std::pair<std::string, std::string>> _attrs;
+    std::unordered_map<std::string, std::uint32_t> _names;
+    std::unordered_map<std::string, std::uint32_t> _values;
+};
+
+/** Decoder of the binary XML stream produced by BinaryXMLEncoder
+ */
+class BaseExport BinaryXMLDecoder
+{
+public:
+    explicit BinaryXMLDecoder(std::istream &in);
+
+    /** Read and check the magic header and format version
+     * @return Return true if the header is valid and the version is supported.
+     */
+    bool readHeader();
+
+    /// Return the format version of the stream
+    int version() const {return _version;}
+
+    /** Decode the next token
+     *
+     * @param name: output the element name for token StartElement,
+     *              StartEndElement, and EndElement.
+     * @param attrs: output the attributes for token StartElement and
+     *               StartEndElement
+     * @param chars: output the character data for token Characters
+     *
+     * @return Return the decoded token, or BinaryXML::Invalid on error.
+     */
+    BinaryXML::Token next(std::string &name,
+                          std::map<std::string, std::string> &attrs,
+                          std::string &chars);
+
+private:
+    bool readVarInt(std::uint64_t &v);
+    bool readString(std::string &s);
+    bool readName(std::uint32_t &index);
+    bool readValue(std::string &value);
+
+private:
+    std::streambuf *_buf;
+    int _version = 0;
+    std::vector<std::string> _names;
+    std::vector<std::string> _values;
+    std::vector<std::uint32_t> _stack;
+};
+
+} // namespace Base
+
+#endif // BASE_BINARY_XML_H
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef BASE_FUNCTIONAL_H
+#define BASE_FUNCTIONAL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace Base
+{
+
+/// Returns the number of indices per chunk used by forEachChunk()
+inline std::size_t chunkSize(std::size_t count, std::size_t minChunkSize = 10000)
+{
+    std::size_t ctChunks = std::max(1U, std::thread::hardware_concurrency()) * std::size_t(4);
+    return std::max<std::size_t>((count + ctChunks - 1) / ctChunks,
+                                 std::max<std::size_t>(minChunkSize, 1));
+}
+
+/// Returns the number of chunks forEachChunk() splits the index range [0, count) into
+inline std::size_t countChunks(std::size_t count, std::size_t minChunkSize = 10000)
+{
+    std::size_t size = chunkSize(count, minChunkSize);
+    return (count + size - 1) / size;
+}
+
+/*!
+ Splits the index range [0, count) into chunks of consecutive indices and calls
+ \a func(chunk, begin, end) for each of them, where \a chunk is the number of the
+ chunk in ascending order of the indices.
+
+ If there is more than one chunk, they are handled by worker threads up to the
+ number of available cores, with the calling thread taking part as well. A chunk
+ holds at least \a minChunkSize indices, so that small ranges are handled in the
+ calling thread only. An exception thrown by \a func is rethrown once all threads
+ are finished.
+
+ @return the number of chunks, see countChunks()
+*/
+template<typename Func>
+std::size_t forEachChunk(std::size_t count, Func func, std::size_t minChunkSize = 10000)
+{
+    std::size_t size = chunkSize(count, minChunkSize);
+    std::size_t ctChunks = (count + size - 1) / size;
+    if (ctChunks <= 1) {
+        if (count > 0) {
+            func(std::size_t(0), std::size_t(0), count);
+        }
+        return ctChunks;
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto run = [&]() {
+        for (std::size_t chunk = next++; chunk < ctChunks; chunk = next++) {
+            std::size_t begin = chunk * size;
+            func(chunk, begin, std::min(begin + size, count));
+        }
+    };
+
+    std::size_t ctThreads = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<std::future<void>> workers;
+    for (std::size_t i = 1; i < std::min(ctThreads, ctChunks); i++) {
+        workers.push_back(std::async(std::launch::async, run));
+    }
+    try {
+        run();
+        for (auto& worker : workers) {
+            worker.get();
+        }
+    }
+    catch (...) {
+        // let the other threads stop after their current chunk
+        next = ctChunks;
+        for (auto& worker : workers) {
+            if (worker.valid()) {
+                worker.wait();
+            }
+        }
+        throw;
+    }
+    return ctChunks;
+}
+
+}  // namespace Base
+
+#endif  // BASE_FUNCTIONAL_H
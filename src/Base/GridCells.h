@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef BASE_GRIDCELLS_H
+#define BASE_GRIDCELLS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "Functional.h"
+
+namespace Base
+{
+
+/*!
+ Compact storage of the element indices of the cells of a spatial grid.
+
+ The indices of all cells are kept in one array ordered by cell, and an offset
+ array holds the start of each cell (compressed sparse row layout). Compared to
+ a std::set per cell this needs one index per entry instead of a tree node, and
+ an empty cell costs a single offset.
+
+ The cells are filled at once from lists of (cell, index) entries with a
+ counting sort. The lists can be created concurrently, e.g. one per chunk of
+ elements. Within a cell the indices keep the order of the entries, so if the
+ lists are passed in ascending order of the element indices, each cell is
+ sorted as a std::set would be.
+ @code
+ std::vector<GridCells<unsigned long>::Entries> chunks(2);
+ chunks[0].push_back({3, 0}); // element 0 in cell 3
+ chunks[1].push_back({3, 1}); // element 1 in cell 3
+
+ GridCells<unsigned long> cells;
+ cells.assign(8, chunks);
+ for (auto index : cells[3])
+     ...
+ @endcode
+*/
+template<typename Index>
+class GridCells
+{
+public:
+    /// An element index to add to a cell
+    struct Entry
+    {
+        Index cell;
+        Index index;
+    };
+    using Entries = std::vector<Entry>;
+
+    /// The indices of a single cell
+    class Cell
+    {
+    public:
+        using value_type = Index;
+        using const_iterator = const Index*;
+
+        Cell(const Index* first, const Index* last)
+            : first(first), last(last)
+        {}
+        const_iterator begin() const
+        {
+            return first;
+        }
+        const_iterator end() const
+        {
+            return last;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(last - first);
+        }
+        bool empty() const
+        {
+            return first == last;
+        }
+
+    private:
+        const Index* first;
+        const Index* last;
+    };
+
+    /// Removes all cells and releases the memory
+    void clear()
+    {
+        std::vector<Index>().swap(offsets);
+        std::vector<Index>().swap(indices);
+    }
+    /// Sets the number of cells, all of them are empty
+    void resize(std::size_t numCells)
+    {
+        indices.clear();
+        offsets.assign(numCells + 1, 0);
+    }
+    /// Returns the number of cells
+    std::size_t size() const
+    {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+    /// Returns the total number of indices in all cells
+    std::size_t countIndices() const
+    {
+        return indices.size();
+    }
+    /// Returns the number of bytes allocated for the cells
+    std::size_t memoryUsage() const
+    {
+        return (offsets.capacity() + indices.capacity()) * sizeof(Index);
+    }
+    Cell operator[](std::size_t cell) const
+    {
+        const Index* data = indices.data();
+        return Cell(data + offsets[cell], data + offsets[cell + 1]);
+    }
+
+    /// Fills \a numCells cells with the entries of all lists, in the order of the lists
+    void assign(std::size_t numCells, const std::vector<Entries>& lists)
+    {
+        // count the indices of each cell at the position of the following cell
+        offsets.assign(numCells + 1, 0);
+        for (const auto& list : lists) {
+            for (const auto& entry : list) {
+                ++offsets[entry.cell + 1];
+            }
+        }
+        for (std::size_t i = 1; i <= numCells; i++) {
+            offsets[i] += offsets[i - 1];
+        }
+
+        // use the start of each cell as insert position, afterwards it points to the
+        // start of the next cell
+        std::vector<Index>().swap(indices);
+        indices.resize(offsets[numCells]);
+        for (const auto& list : lists) {
+            for (const auto& entry : list) {
+                indices[offsets[entry.cell]++] = entry.index;
+            }
+        }
+        std::copy_backward(offsets.begin(), offsets.end() - 1, offsets.end());
+        offsets[0] = 0;
+    }
+
+    /*!
+     Fills \a numCells cells with the elements 0 to \a count - 1. The elements are split
+     into chunks of consecutive indices that are handled in parallel, see forEachChunk().
+     \a addElement(index, entries) must append the cells of the element to \a entries and
+     may be called from several threads at once. Each cell ends up sorted by index.
+    */
+    template<typename AddElement>
+    void fill(std::size_t numCells, std::size_t count, AddElement addElement)
+    {
+        std::vector<Entries> lists(countChunks(count));
+        forEachChunk(count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            Entries& entries = lists[chunk];
+            entries.reserve(end - begin);
+            for (std::size_t i = begin; i < end; i++) {
+                addElement(static_cast<Index>(i), entries);
+            }
+        });
+        assign(numCells, lists);
+    }
+
+private:
+    std::vector<Index> offsets;
+    std::vector<Index> indices;
+};
+
+}  // namespace Base
+
+#endif  // BASE_GRIDCELLS_H
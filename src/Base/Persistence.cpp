@@ -75,6 +75,16 @@ void Persistence::RestoreDocFile(Reader &/*reader*/)
 {
 }
 
+bool Persistence::canRestoreDocFileInThread() const
+{
+    return false;
+}
+
+std::function<void()> Persistence::restoreDocFileInThread(Reader &/*reader*/)
+{
+    return {};
+}
+
 std::string Persistence::encodeAttribute(const std::string& str)
 {
     std::string tmp;
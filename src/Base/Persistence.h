@@ -24,6 +24,7 @@
 #ifndef APP_PERSISTENCE_H
 #define APP_PERSISTENCE_H
 
+#include <functional>
 #include "BaseClass.h"
 
 namespace Base
@@ -142,6 +143,26 @@ public:
      */
     virtual void RestoreDocFile(Reader &/*reader*/);
 
+    /** Check whether the additional file can be decoded in a worker thread
+     *
+     * If true, and parallel restore is enabled in the XMLReader (see
+     * XMLReader::setRestoreThreadCount()), the file content is read into
+     * memory, and restoreDocFileInThread() is called in a worker thread
+     * instead of RestoreDocFile(). The default implementation returns false.
+     */
+    virtual bool canRestoreDocFileInThread() const;
+
+    /** Decode an additional file in a worker thread
+     *
+     * The function must not modify any state that is visible to other
+     * objects. It returns a function that is called later in the main thread
+     * to apply the decoded data, before XMLReader::readFiles() returns. The
+     * returned functions are called in the order of the files, but there is
+     * no ordering guarantee with respect to files restored by
+     * RestoreDocFile().
+     */
+    virtual std::function<void()> restoreDocFileInThread(Reader &/*reader*/);
+
     /// Called by reader to set restoring error
     virtual void SetRestoreError(const char *) {}
 
@@ -28,6 +28,9 @@
 # include <xercesc/sax2/XMLReaderFactory.hpp>
 #endif
 
+#include <deque>
+#include <future>
+#include <iterator>
 #include <locale>
 
 #include <boost/ref.hpp>
@@ -35,6 +38,7 @@
 
 #include "Reader.h"
 #include "Base64.h"
+#include "BinaryXML.h"
 #include "Console.h"
 #include "InputSource.h"
 #include "Persistence.h"
@@ -118,6 +122,19 @@ void Base::XMLReader::init(std::size_t bufsize) {
     _reader->imbue(std::locale::classic());
 #endif
 
+    parser = nullptr;
+
+    if (BinaryXML::isBinary(*_reader)) {
+        BinaryDecoder.reset(new BinaryXMLDecoder(*_reader));
+        _valid = BinaryDecoder->readHeader();
+        if (_valid)
+            ReadType = StartDocument;
+        else
+            cerr << "Unsupported binary XML format version "
+                 << BinaryDecoder->version() << "\n";
+        return;
+    }
+
     // create the parser
     parser = XMLReaderFactory::createXMLReader();
     //parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, false);
@@ -218,6 +235,11 @@ void Base::XMLReader::read()
 
     ReadType = None;
 
+    if (BinaryDecoder) {
+        readBinary();
+        return;
+    }
+
     try {
         parser->parseNext(token);
     }
@@ -259,6 +281,41 @@ void Base::XMLReader::read()
     }
 }
 
+void Base::XMLReader::readBinary()
+{
+    switch(BinaryDecoder->next(LocalName, AttrMap, BinaryCharacters)) {
+    case BinaryXML::StartElement:
+        Level++;
+        ReadType = StartElement;
+        return;
+    case BinaryXML::StartEndElement:
+        // Same as the SAX parser, which reports both the start and end of an
+        // empty element in one parseNext() call.
+        ReadType = StartEndElement;
+        break;
+    case BinaryXML::EndElement:
+        Level--;
+        ReadType = EndElement;
+        break;
+    case BinaryXML::Characters:
+        ReadType = Chars;
+        if(CharacterOffset>=0) {
+            Characters.erase(Characters.begin(), Characters.begin()+CharacterOffset);
+            Characters += BinaryCharacters;
+            CharacterOffset = 0;
+        }
+        return;
+    case BinaryXML::EndDocument:
+        ReadType = EndDocument;
+        return;
+    default:
+        FC_READER_THROW("Invalid binary XML data");
+    }
+
+    if(Guards.size() && Level<*Guards.back())
+        *Guards.back() = INT_MAX;
+}
+
 void Base::XMLReader::readElement(const char* ElementName, int *guard)
 {
     endCharStream();
@@ -441,6 +498,18 @@ void Base::XMLReader::readFiles()
     }
 }
 
+void Base::XMLReader::setRestoreThreadCount(int count)
+{
+    RestoreThreadCount = count;
+}
+
+int Base::XMLReader::getRestoreThreadCount() const
+{
+    if(_reader->getParent())
+        return _reader->getParent()->getRestoreThreadCount();
+    return RestoreThreadCount;
+}
+
 const char *Base::XMLReader::addFile(const char* Name, Base::Persistence *Object)
 {
     if(_reader->getParent())
@@ -693,6 +762,90 @@ Base::XMLReader *Base::Reader::getParent() const {
 
 // ----------------------------------------------------------
 
+namespace {
+
+// Helper class to decode registered files in worker threads. The decoded
+// content is applied in the main thread in the original file order.
+class ThreadedFileRestorer
+{
+public:
+    explicit ThreadedFileRestorer(Base::XMLReader &reader)
+        : xmlReader(reader)
+        , maxPending(static_cast<std::size_t>(std::max(1, reader.getRestoreThreadCount())))
+    {
+    }
+
+    bool accept(const Base::XMLReader::FileEntry &entry) const
+    {
+        return xmlReader.getRestoreThreadCount() > 0
+            && entry.Object->canRestoreDocFileInThread();
+    }
+
+    void add(const Base::XMLReader::FileEntry &entry, std::istream &stream)
+    {
+        // Reading the (compressed) stream is sequential, so copy the file
+        // content into memory and hand it to a worker for decoding
+        auto data = std::make_shared<std::string>(std::istreambuf_iterator<char>(stream),
+                                                  std::istreambuf_iterator<char>());
+        Base::XMLReader *parent = &xmlReader;
+        Base::Persistence *object = entry.Object;
+        std::string name = entry.FileName;
+
+        Task task;
+        task.name = name;
+        task.future = std::async(std::launch::async, [=]() {
+            Base::Streambuf buf(*data);
+            std::istream str(&buf);
+            Base::Reader reader(str, name, parent);
+            return object->restoreDocFileInThread(reader);
+        });
+        pending.push_back(std::move(task));
+
+        while (pending.size() >= maxPending)
+            applyNext();
+    }
+
+    void finish()
+    {
+        while (!pending.empty())
+            applyNext();
+    }
+
+private:
+    void applyNext()
+    {
+        Task task = std::move(pending.front());
+        pending.pop_front();
+        try {
+            auto func = task.future.get();
+            if (func)
+                func();
+        } catch(Base::AbortException &e) {
+            e.ReportException();
+            FC_ERR("User abort when reading embedded file: " << task.name);
+            throw;
+        } catch(Base::Exception &e) {
+            e.ReportException();
+            FC_ERR("Reading failed from embedded file: " << task.name);
+        } catch(...) {
+            FC_ERR("Reading failed from embedded file: " << task.name);
+        }
+    }
+
+private:
+    struct Task {
+        std::string name;
+        std::future<std::function<void()>> future;
+    };
+    Base::XMLReader &xmlReader;
+    std::size_t maxPending;
+    std::deque<Task> pending;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------
+
 Base::ZipReader::ZipReader(zipios::ZipInputStream &str, const std::string &name, Base::XMLReader *parent)
     :Base::Reader(str,name,parent),_stream(str)
 {
@@ -719,6 +872,7 @@ void Base::ZipReader::readFiles(XMLReader &xmlReader)
     }
     const auto &FileList = xmlReader.getFileList();
     std::size_t it = 0;
+    ThreadedFileRestorer restorer(xmlReader);
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     while (entry->isValid() && it < FileList.size()) {
         auto jt = it;
@@ -730,8 +884,12 @@ void Base::ZipReader::readFiles(XMLReader &xmlReader)
         // no file name for the current entry in the zip was registered.
         if (jt < FileList.size()) {
             try {
-                Base::ZipReader zipreader(_stream, FileList[jt].FileName, &xmlReader);
-                FileList[jt].Object->RestoreDocFile(zipreader);
+                if (restorer.accept(FileList[jt]))
+                    restorer.add(FileList[jt], _stream);
+                else {
+                    Base::ZipReader zipreader(_stream, FileList[jt].FileName, &xmlReader);
+                    FileList[jt].Object->RestoreDocFile(zipreader);
+                }
             } catch(Base::AbortException &e) {
                 e.ReportException();
                 FC_ERR("User abort when reading embedded file: " << FileList[jt].FileName);
@@ -762,6 +920,8 @@ void Base::ZipReader::readFiles(XMLReader &xmlReader)
             break;
         }
     }
+
+    restorer.finish();
 }
 
 
@@ -780,6 +940,7 @@ void Base::FileReader::readFiles(Base::XMLReader &xmlReader) {
     const auto &FileList = xmlReader.getFileList();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     std::string dirname = Base::FileInfo(_dir).fileName();
+    ThreadedFileRestorer restorer(xmlReader);
     for(size_t i=0; i<FileList.size(); ++i) {
         const auto &entry = FileList[i];
         Base::FileInfo fi(_dir+'/'+entry.FileName);
@@ -790,7 +951,9 @@ void Base::FileReader::readFiles(Base::XMLReader &xmlReader) {
                 msg += fi.filePath();
                 FC_ERR(msg);
                 entry.Object->SetRestoreError(msg.c_str());
-            } else
+            } else if (restorer.accept(entry))
+                restorer.add(entry, freader);
+            else
                 entry.Object->RestoreDocFile(freader);
         } catch(Base::AbortException &e) {
             e.ReportException();
@@ -810,4 +973,6 @@ void Base::FileReader::readFiles(Base::XMLReader &xmlReader) {
         }
         seq.next();
     }
+
+    restorer.finish();
 }
@@ -52,6 +52,7 @@ namespace Base
 {
 
 class Reader;
+class BinaryXMLDecoder;
 
 /** The XML reader class
  * This is an important helper class for the store and retrieval system
@@ -240,6 +241,17 @@ public:
     /// process the requested file writes
     void readFiles();
 
+    /** Set the number of worker threads used by readFiles()
+     * @param count: maximum number of files decoded concurrently. Zero
+     * disables parallel decoding.
+     *
+     * Only files of objects returning true from
+     * Persistence::canRestoreDocFileInThread() are decoded in worker threads.
+     */
+    void setRestoreThreadCount(int count);
+    /// Return the number of worker threads used by readFiles()
+    int getRestoreThreadCount() const;
+
     struct FileEntry {
         std::string FileName;
         Base::Persistence *Object;
@@ -280,6 +292,9 @@ protected:
 
     void init(std::size_t bufsize);
 
+    /// read the next token from binary XML stream
+    void readBinary();
+
     // -----------------------------------------------------------------------
     //  Handlers for the SAX ContentHandler interface
     // -----------------------------------------------------------------------
@@ -350,8 +365,13 @@ protected:
 
     std::bitset<32> StatusBits;
 
+    int RestoreThreadCount = 0;
+
     std::unique_ptr<std::istream> CharStream;
 
+    std::unique_ptr<BinaryXMLDecoder> BinaryDecoder;
+    std::string BinaryCharacters;
+
     Base::Reader *_reader;
     bool _ownReader;
 };
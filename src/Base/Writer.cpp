@@ -23,12 +23,19 @@
 
 #include "PreCompiled.h"
 
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <deque>
+#include <future>
 #include <limits>
 #include <locale>
 #include <iomanip>
+#include <zlib.h>
 
 #include "Writer.h"
 #include "Base64.h"
+#include "BinaryXML.h"
 #include "Exception.h"
 #include "FileInfo.h"
 #include "Persistence.h"
@@ -289,6 +296,112 @@ const std::vector<std::string>& Writer::getFilenames() const
     return FileNames;
 }
 
+Writer &Writer::startElement(const char *name)
+{
+    ElementEncoder = getBinaryEncoder();
+    if (ElementEncoder) {
+        ElementName = name;
+        ElementAttrCount = 0;
+    }
+    else
+        Stream() << ind() << '<' << name;
+    return *this;
+}
+
+Writer &Writer::addAttribute(const char *name, const std::string &value)
+{
+    if (ElementEncoder) {
+        if (ElementAttrCount == ElementAttrs.size())
+            ElementAttrs.emplace_back();
+        auto &attr = ElementAttrs[ElementAttrCount++];
+        attr.first = name;
+        attr.second = value;
+    }
+    else
+        Stream() << ' ' << name << "=\"" << Persistence::encodeAttribute(value) << '"';
+    return *this;
+}
+
+Writer &Writer::addAttribute(const char *name, const char *value)
+{
+    if (ElementEncoder) {
+        if (ElementAttrCount == ElementAttrs.size())
+            ElementAttrs.emplace_back();
+        auto &attr = ElementAttrs[ElementAttrCount++];
+        attr.first = name;
+        attr.second = value ? value : "";
+        return *this;
+    }
+    return addAttribute(name, std::string(value ? value : ""));
+}
+
+Writer &Writer::addAttribute(const char *name, long long value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%lld", value);
+    if (ElementEncoder)
+        return addAttribute(name, static_cast<const char*>(buf));
+    Stream() << ' ' << name << "=\"" << buf << '"';
+    return *this;
+}
+
+Writer &Writer::addAttribute(const char *name, unsigned long long value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%llu", value);
+    if (ElementEncoder)
+        return addAttribute(name, static_cast<const char*>(buf));
+    Stream() << ' ' << name << "=\"" << buf << '"';
+    return *this;
+}
+
+Writer &Writer::addAttribute(const char *name, double value)
+{
+    if (!ElementEncoder) {
+        Stream() << ' ' << name << "=\"" << value << '"';
+        return *this;
+    }
+    // Format the same way as std::ostream does with the stream settings
+    std::ostream &stream = Stream();
+    int precision = static_cast<int>(stream.precision());
+    const char *format;
+    switch (stream.flags() & std::ios::floatfield) {
+    case std::ios::fixed:
+        format = "%.*f";
+        break;
+    case std::ios::scientific:
+        format = "%.*e";
+        break;
+    default:
+        format = "%.*g";
+        break;
+    }
+    char buf[400];
+    snprintf(buf, sizeof(buf), format, precision, value);
+    return addAttribute(name, static_cast<const char*>(buf));
+}
+
+void Writer::endStartTag(bool empty)
+{
+    if (ElementEncoder) {
+        ElementEncoder->startElement(ElementName.c_str(), ElementAttrs.data(), ElementAttrCount, empty);
+        ElementEncoder = nullptr;
+    }
+    else
+        Stream() << (empty ? "/>\n" : ">\n");
+    if (!empty)
+        incInd();
+}
+
+void Writer::endElement(const char *name)
+{
+    decInd();
+    if (auto encoder = getBinaryEncoder())
+        encoder->endElement();
+    else
+        Stream() << ind() << "</" << name << ">\n";
+}
+
 void Writer::incInd()
 {
     int pos = sizeof(indBuf)-1;
@@ -318,6 +431,224 @@ void Writer::putNextEntry(const char *file, const char *obj) {
 
 // ----------------------------------------------------------------------------
 
+namespace {
+
+// Output stream buffer collecting the content of a zip entry in memory
+class EntryStreambuf : public std::streambuf
+{
+public:
+    EntryStreambuf()
+        : buffer(64*1024)
+    {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    std::string take()
+    {
+        sync();
+        std::string res;
+        res.swap(data);
+        return res;
+    }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        sync();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n) override
+    {
+        if (n > epptr() - pptr()) {
+            sync();
+            data.append(s, static_cast<std::size_t>(n));
+        }
+        else {
+            std::memcpy(pptr(), s, static_cast<std::size_t>(n));
+            pbump(static_cast<int>(n));
+        }
+        return n;
+    }
+
+    int sync() override
+    {
+        data.append(pbase(), pptr());
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return 0;
+    }
+
+private:
+    std::string data;
+    std::vector<char> buffer;
+};
+
+// Check the signature of some common compressed file formats
+bool isCompressedData(const std::string &data)
+{
+    static const char *signatures[] = {
+        "\x89PNG",             // PNG
+        "\xFF\xD8\xFF",        // JPEG
+        "GIF8",                 // GIF
+        "PK\x03\x04",          // zip
+        "\x1F\x8B",            // gzip
+        "BZh",                  // bzip2
+        "\xFD" "7zXZ",          // xz
+        "7z\xBC\xAF",          // 7z
+        "\x28\xB5\x2F\xFD",    // zstd
+    };
+    for (const char *signature : signatures) {
+        std::size_t len = std::strlen(signature);
+        if (data.size() >= len && data.compare(0, len, signature, len) == 0)
+            return true;
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+/* Compresses the zip entries in worker threads
+ *
+ * The content of each entry is collected in memory, and then deflated
+ * asynchronously. The compressed entries are written to the zip stream
+ * strictly in the order they are created, so that the archive layout is
+ * deterministic. The number of pending entries is bounded by the thread
+ * count to limit memory usage.
+ */
+class ZipWriter::EntryCompressor
+{
+public:
+    EntryCompressor(ZipWriter &writer)
+        : writer(writer), stream(&streambuf)
+    {
+        // Use the same locale and number formatting as the zip stream
+        stream.copyfmt(writer.ZipStream);
+    }
+
+    std::ostream &begin(const char *name)
+    {
+        end();
+        entryName = name;
+        active = true;
+        return stream;
+    }
+
+    std::ostream &getStream()
+    {
+        return stream;
+    }
+
+    bool isActive() const
+    {
+        return active;
+    }
+
+    void end()
+    {
+        if (!active)
+            return;
+        active = false;
+        stream.flush();
+
+        std::string data = streambuf.take();
+        long long threshold = writer.StoreThreshold;
+        bool store = writer.Level == Z_NO_COMPRESSION
+            || (threshold >= 0 && isCompressedData(data))
+            || (threshold > 0 && static_cast<long long>(data.size()) > threshold);
+        int level = writer.Level;
+        // Small entries are not worth a thread, and are compressed on
+        // demand when being written.
+        auto policy = data.size() < 64*1024 ? std::launch::deferred : std::launch::async;
+        pending.emplace_back(std::move(entryName),
+                std::async(policy, [level, store](std::string data) {
+                    return compress(data, level, store);
+                }, std::move(data)));
+
+        while (static_cast<int>(pending.size()) > writer.ThreadCount)
+            writeNext();
+    }
+
+    void finish()
+    {
+        end();
+        while (!pending.empty())
+            writeNext();
+    }
+
+private:
+    struct Result
+    {
+        std::string data;
+        uLong crc = 0;
+        std::size_t size = 0;
+        bool stored = true;
+    };
+
+    static Result compress(std::string &data, int level, bool store)
+    {
+        Result res;
+        res.size = data.size();
+        res.crc = crc32(crc32(0L, Z_NULL, 0),
+                        reinterpret_cast<const Bytef*>(data.data()),
+                        static_cast<uInt>(data.size()));
+        if (!store && !data.empty()) {
+            z_stream zs;
+            std::memset(&zs, 0, sizeof(zs));
+            // Negative window bits for raw deflate stream as required by zip
+            if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK) {
+                res.data.resize(deflateBound(&zs, static_cast<uLong>(data.size())));
+                zs.next_in = reinterpret_cast<Bytef*>(&data[0]);
+                zs.avail_in = static_cast<uInt>(data.size());
+                zs.next_out = reinterpret_cast<Bytef*>(&res.data[0]);
+                zs.avail_out = static_cast<uInt>(res.data.size());
+                int ret = deflate(&zs, Z_FINISH);
+                deflateEnd(&zs);
+                // Fall back to store if the data is not compressible
+                if (ret == Z_STREAM_END && zs.total_out < data.size()) {
+                    res.data.resize(zs.total_out);
+                    res.stored = false;
+                    return res;
+                }
+            }
+        }
+        res.data = std::move(data);
+        return res;
+    }
+
+    void writeNext()
+    {
+        auto entry = std::move(pending.front());
+        pending.pop_front();
+        try {
+            Result res = entry.second.get();
+            zipios::ZipCDirEntry zipEntry(entry.first);
+            zipEntry.setMethod(res.stored ? zipios::STORED : zipios::DEFLATED);
+            zipEntry.setSize(static_cast<zipios::uint32>(res.size));
+            zipEntry.setCompressedSize(static_cast<zipios::uint32>(res.data.size()));
+            zipEntry.setCrc(static_cast<zipios::uint32>(res.crc));
+            writer.ZipStream.putRawEntry(zipEntry, res.data.c_str(),
+                                         static_cast<std::streamsize>(res.data.size()));
+        }
+        catch (std::exception &e) {
+            writer.addError(entry.first + ": " + e.what());
+        }
+    }
+
+private:
+    ZipWriter &writer;
+    EntryStreambuf streambuf;
+    std::ostream stream;
+    std::string entryName;
+    bool active = false;
+    std::deque<std::pair<std::string, std::future<Result>>> pending;
+};
+
+// ----------------------------------------------------------------------------
+
 ZipWriter::ZipWriter(const char* FileName)
   : ZipStream(FileName)
 {
@@ -342,10 +673,76 @@ ZipWriter::ZipWriter(std::ostream& os)
     ZipStream.setf(ios::fixed,ios::floatfield);
 }
 
+std::ostream &ZipWriter::Stream() {
+    if (BinaryStream)
+        return *BinaryStream;
+    if (Compressor && Compressor->isActive())
+        return Compressor->getStream();
+    return ZipStream;
+}
+
+void ZipWriter::setThreadCount(int count) {
+#ifdef ZIPIOS_HAS_RAW_ENTRY
+    ThreadCount = std::max(0, count);
+#else
+    (void)count;
+#endif
+}
+
 void ZipWriter::putNextEntry(const char *file, const char *obj) {
+    endBinaryEntry();
+
     Writer::putNextEntry(file,obj);
 
-    ZipStream.putNextEntry(file);
+    if (ThreadCount > 0) {
+        if (!Compressor)
+            Compressor.reset(new EntryCompressor(*this));
+        Compressor->begin(file);
+    }
+    else
+        ZipStream.putNextEntry(file);
+}
+
+void ZipWriter::putNextBinaryEntry(const char *file, const char *obj, const char *xmlName) {
+    std::ostream *stream;
+    if (xmlName && xmlName[0]) {
+        // Hold the binary content back, because the XML copy must come first
+        endBinaryEntry();
+        Writer::putNextEntry(file, obj);
+        BinaryFileName = file;
+        BinaryXMLName = xmlName;
+        BinaryBuffer.reset(new std::stringstream);
+        stream = BinaryBuffer.get();
+    }
+    else {
+        putNextEntry(file, obj);
+        stream = &Stream();
+    }
+
+    BinaryEncoder.reset(new BinaryXMLEncoder(*stream));
+    BinaryStream.reset(new std::ostream(BinaryEncoder.get()));
+    // Use the same locale and number formatting as the zip stream
+    BinaryStream->copyfmt(ZipStream);
+}
+
+void ZipWriter::endBinaryEntry() {
+    if (!BinaryStream)
+        return;
+    BinaryStream->flush();
+    BinaryEncoder->finish();
+    BinaryStream.reset();
+    BinaryEncoder.reset();
+
+    if (!BinaryBuffer)
+        return;
+    auto buffer = std::move(BinaryBuffer);
+    putNextEntry(BinaryXMLName.c_str());
+    if (!BinaryXML::toXML(*buffer, Stream()))
+        addError(BinaryXMLName + ": failed to convert binary content");
+    buffer->clear();
+    buffer->seekg(0);
+    putNextEntry(BinaryFileName.c_str());
+    Stream() << buffer->rdbuf();
 }
 
 void ZipWriter::writeFiles()
@@ -361,10 +758,23 @@ void ZipWriter::writeFiles()
         entry.Object->SaveDocFile(*this);
         index++;
     }
+
+    // Submit the last entry for compression without waiting
+    endBinaryEntry();
+    if (Compressor)
+        Compressor->end();
+}
+
+void ZipWriter::finishEntries()
+{
+    endBinaryEntry();
+    if (Compressor)
+        Compressor->finish();
 }
 
 ZipWriter::~ZipWriter()
 {
+    finishEntries();
     ZipStream.close();
 }
 
@@ -49,6 +49,7 @@ namespace Base
 {
 
 class Persistence;
+class BinaryXMLEncoder;
 
 
 /** The Writer class
@@ -142,6 +143,51 @@ public:
 
     virtual std::ostream &Stream()=0;
 
+    /** @name Structured XML output
+     *
+     * Write an element without formatting the XML text by hand, e.g.
+     * \code
+     * writer.startElement("Property").addAttribute("name", name).endStartTag();
+     * ...
+     * writer.endElement("Property");
+     * \endcode
+     * The text output is the same as writing to Stream() at the current
+     * indentation. But when writing binary XML, the element is encoded
+     * directly without formatting and parsing the text. Text written to
+     * Stream() can be freely mixed with these calls.
+     */
+    //@{
+    /// Begin the start tag of an element, to be followed by any addAttribute() and endStartTag()
+    Writer &startElement(const char *name);
+    /// Add an attribute to the current start tag, the value is escaped as required
+    Writer &addAttribute(const char *name, const char *value);
+    Writer &addAttribute(const char *name, const std::string &value);
+    Writer &addAttribute(const char *name, long long value);
+    Writer &addAttribute(const char *name, unsigned long long value);
+    Writer &addAttribute(const char *name, int value) {
+        return addAttribute(name, static_cast<long long>(value));
+    }
+    Writer &addAttribute(const char *name, long value) {
+        return addAttribute(name, static_cast<long long>(value));
+    }
+    Writer &addAttribute(const char *name, unsigned value) {
+        return addAttribute(name, static_cast<unsigned long long>(value));
+    }
+    Writer &addAttribute(const char *name, unsigned long value) {
+        return addAttribute(name, static_cast<unsigned long long>(value));
+    }
+    /// Add a floating point attribute using the number format of Stream()
+    Writer &addAttribute(const char *name, double value);
+    /** End the start tag
+     * @param empty: if true, the element is ended as well. Otherwise, the
+     * content follows at an increased indentation, and the element must be
+     * ended by endElement().
+     */
+    void endStartTag(bool empty=false);
+    /// End the element started with endStartTag(false)
+    void endElement(const char *name);
+    //@}
+
     /** Create an output stream for storing character content
      * @param base64: If true, the input will be base64 encoded before storing.
      *                If false, the input is assumed to be valid character with
@@ -163,6 +209,8 @@ public:
 
 protected:
     std::string getUniqueFileName(const char *Name);
+    /// Return the encoder if the current entry is written as binary XML
+    virtual BinaryXMLEncoder *getBinaryEncoder() const {return nullptr;}
     struct FileEntry {
         std::string FileName;
         const Base::Persistence *Object;
@@ -189,6 +237,12 @@ private:
     std::unique_ptr<std::ostream> CharStream;
     bool CharBase64 = false;
 
+    // pending start tag when writing binary XML
+    std::string ElementName;
+    std::vector<std::pair<const char*, std::string>> ElementAttrs;
+    std::size_t ElementAttrCount = 0;
+    BinaryXMLEncoder *ElementEncoder = nullptr;
+
 private:
     Writer(const Writer&);
     Writer& operator=(const Writer&);
@@ -210,14 +264,85 @@ public:
 
     void writeFiles() override;
 
-    std::ostream &Stream() override{return ZipStream;}
+    std::ostream &Stream() override;
 
     void setComment(const char* str){ZipStream.setComment(str);}
-    void setLevel(int level){ZipStream.setLevel( level );}
+    void setLevel(int level){ZipStream.setLevel( level ); Level = level;}
     void putNextEntry(const char *filename, const char *objName=nullptr) override;
 
+    /** Set the number of entries that can be compressed concurrently
+     *
+     * @param count: if greater than zero, the content of each entry is
+     * written into a memory buffer first, which is then compressed by a
+     * worker thread while the next entry is being written. The entries are
+     * still put into the archive in the order they are created. Zero to
+     * compress the entries in the calling thread.
+     *
+     * Must be called before putting the first entry.
+     */
+    void setThreadCount(int count);
+    /// Return the number of entries that can be compressed concurrently
+    int getThreadCount() const {return ThreadCount;}
+
+    /** Set the size threshold for storing entries without compression
+     *
+     * @param size: negative to always compress. Zero to store entries
+     * containing already compressed data, such as images, zip or gzip
+     * files. Positive to store any entry larger than the given size in bytes
+     * as well.
+     *
+     * Only effective if thread count is set.
+     */
+    void setStoreThreshold(long long size) {StoreThreshold = size;}
+    /// Return the size threshold for storing entries without compression
+    long long getStoreThreshold() const {return StoreThreshold;}
+
+    /** Wait for all pending compression and write the entries to the archive
+     *
+     * This function is called on destruction. It may be called by a thread
+     * other than the one that has been putting the entries, as long as the
+     * latter does not access the writer any more.
+     */
+    void finishEntries();
+
+    /** Put the next entry in compact binary XML format
+     *
+     * All XML content written to Stream() until the next call of
+     * putNextEntry() or writeFiles() is converted to binary XML, which can
+     * be read back transparently by XMLReader.
+     *
+     * @param filename: entry name of the binary content
+     * @param objName: optional object name for error reporting
+     * @param xmlName: if not empty, the binary content is held in memory
+     *                 until the entry is finished, and then put into the
+     *                 archive after an entry of this name containing the
+     *                 same content as XML text. This allows readers that do
+     *                 not understand the binary format to still read the
+     *                 archive.
+     *
+     * \see BinaryXMLEncoder, BinaryXML::toXML()
+     */
+    void putNextBinaryEntry(const char *filename, const char *objName=nullptr,
+                            const char *xmlName=nullptr);
+
+    BinaryXMLEncoder *getBinaryEncoder() const override {return BinaryEncoder.get();}
+
+private:
+    void endBinaryEntry();
+
 private:
     zipios::ZipOutputStream ZipStream;
+    std::unique_ptr<BinaryXMLEncoder> BinaryEncoder;
+    std::unique_ptr<std::ostream> BinaryStream;
+    std::unique_ptr<std::stringstream> BinaryBuffer;
+    std::string BinaryFileName;
+    std::string BinaryXMLName;
+
+    class EntryCompressor;
+    std::unique_ptr<EntryCompressor> Compressor;
+    int ThreadCount = 0;
+    int Level = 6;
+    long long StoreThreshold = -1;
 };
 
 /** The StringWriter class
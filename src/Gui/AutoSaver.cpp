@@ -29,12 +29,16 @@
 # include <QDir>
 # include <QRunnable>
 # include <QTextStream>
+# include <QThread>
 # include <QThreadPool>
 #endif
 
+#include <memory>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObject.h>
+#include <App/DocumentParams.h>
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
 #include <Base/Stream.h>
@@ -128,6 +132,80 @@ void AutoSaver::slotDeleteDocument(const App::Document& Doc)
     }
 }
 
+namespace Gui {
+
+// Finishes a compressed recovery file in a worker thread
+class RecoveryArchiveRunnable : public QRunnable
+{
+public:
+    RecoveryArchiveRunnable(const QString& dir, const QString& file)
+        : dirName(dir)
+        , fileName(file)
+    {
+        tmpName = QStringLiteral("%1.tmp%2").arg(fileName).arg(rand());
+        Base::FileInfo fi((dirName + QLatin1Char('/') + tmpName).toUtf8().constData());
+        stream.reset(new Base::ofstream(fi, std::ios::out | std::ios::binary));
+        if (stream->is_open())
+            writer.reset(new Base::ZipWriter(*stream));
+    }
+
+    Base::ZipWriter* getWriter() const
+    {
+        return writer.get();
+    }
+
+    void run() override
+    {
+        bool ok = false;
+        try {
+            writer->finishEntries();
+            ok = !writer->hasErrors();
+        }
+        catch (...) {
+        }
+        writer.reset();
+        stream->close();
+
+        QDir dir(dirName);
+        if (!ok) {
+            dir.remove(tmpName);
+            return;
+        }
+
+        // Let the main thread do the renaming, same as RecoveryRunnable
+        QMetaObject::invokeMethod(AutoSaver::instance(), "renameFile",
+                Qt::QueuedConnection, Q_ARG(QString,dirName)
+                ,Q_ARG(QString,fileName),Q_ARG(QString,tmpName));
+    }
+
+private:
+    QString dirName;
+    QString fileName;
+    QString tmpName;
+    std::unique_ptr<Base::ofstream> stream;
+    std::unique_ptr<Base::ZipWriter> writer;
+};
+
+}
+
+static void saveRecoveryArchive(App::Document* doc, Base::ZipWriter& writer, bool binaryBrep)
+{
+    if (binaryBrep)
+        writer.setMode("BinaryBrep");
+
+    writer.setComment("AutoRecovery file");
+    writer.setLevel(1); // apparently the fastest compression
+    writer.putNextEntry("Document.xml");
+
+    doc->Save(writer);
+
+    // Special handling for Gui document.
+    doc->signalSaveDocument(writer);
+
+    // write additional files
+    writer.writeFiles();
+}
+
 void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
 {
     Gui::WaitCursor wc;
@@ -193,27 +271,33 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
             }
             // only create the file if something has changed
             else if (!saver.touched.empty()) {
-                std::string fn = doc->TransientDir.getValue();
-                fn += "/fc_recovery_file.fcstd";
-                Base::FileInfo tmp(fn);
-                Base::ofstream file(tmp, std::ios::out | std::ios::binary);
-                if (file.is_open())
-                {
-                    Base::ZipWriter writer(file);
-                    if (hGrp->GetBool("SaveBinaryBrep", true))
-                        writer.setMode("BinaryBrep");
-
-                    writer.setComment("AutoRecovery file");
-                    writer.setLevel(1); // apparently the fastest compression
-                    writer.putNextEntry("Document.xml");
-
-                    doc->Save(writer);
-
-                    // Special handling for Gui document.
-                    doc->signalSaveDocument(writer);
-
-                    // write additional files
-                    writer.writeFiles();
+                bool binaryBrep = hGrp->GetBool("SaveBinaryBrep", true);
+                if (App::DocumentParams::getParallelSave()) {
+                    // Serialize the document here, and leave the compression
+                    // and writing of the archive to worker threads so that
+                    // the UI is not blocked.
+                    std::unique_ptr<RecoveryArchiveRunnable> runnable(
+                            new RecoveryArchiveRunnable(QString::fromUtf8(doc->TransientDir.getValue()),
+                                                        QStringLiteral("fc_recovery_file.fcstd")));
+                    if (auto writer = runnable->getWriter()) {
+                        int count = App::DocumentParams::getSaveThreadCount();
+                        writer->setThreadCount(count > 0 ? count : QThread::idealThreadCount());
+                        long long threshold = doc->StoreUncompressed.getValue();
+                        writer->setStoreThreshold(threshold > 0 ? threshold*1024*1024 : threshold);
+                        saveRecoveryArchive(doc, *writer, binaryBrep);
+                        QThreadPool::globalInstance()->start(runnable.release());
+                    }
+                }
+                else {
+                    std::string fn = doc->TransientDir.getValue();
+                    fn += "/fc_recovery_file.fcstd";
+                    Base::FileInfo tmp(fn);
+                    Base::ofstream file(tmp, std::ios::out | std::ios::binary);
+                    if (file.is_open())
+                    {
+                        Base::ZipWriter writer(file);
+                        saveRecoveryArchive(doc, writer, binaryBrep);
+                    }
                 }
             }
         }
@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+#endif
+
+#include "ElementIdBuffer.h"
+
+using namespace Gui;
+
+// Depth offset of lines and points, so that they win over the faces they
+// bound, similar to the polygon offset used when rendering
+static const float LineDepthBias = 1e-4f;
+
+ElementIdBuffer::ElementIdBuffer(const Base::Polygon2d &polygon,
+                                 int width, int height, bool depthTest)
+    : width(width), height(height), depthTest(depthTest)
+{
+    std::size_t count = polygon.GetCtVectors();
+    if (count < 3 || width <= 0 || height <= 0)
+        return;
+
+    auto bbox = polygon.CalcBoundBox();
+    x0 = std::max(0, (int)std::floor(bbox.MinX * width));
+    y0 = std::max(0, (int)std::floor(bbox.MinY * height));
+    int x1 = std::min(width, (int)std::ceil(bbox.MaxX * width));
+    int y1 = std::min(height, (int)std::ceil(bbox.MaxY * height));
+    if (x1 <= x0 || y1 <= y0)
+        return;
+    w = x1 - x0;
+    h = y1 - y0;
+
+    // Scan convert the polygon with the even-odd rule at pixel centers
+    mask.resize((std::size_t)w * h, 0);
+    std::vector<double> crossings;
+    for (int y = 0; y < h; ++y) {
+        double py = (y0 + y + 0.5) / height;
+        crossings.clear();
+        for (std::size_t i = 0, j = count - 1; i < count; j = i++) {
+            const auto &a = polygon[i];
+            const auto &b = polygon[j];
+            if ((a.y > py) != (b.y > py))
+                crossings.push_back((a.x + (py - a.y) / (b.y - a.y) * (b.x - a.x)) * width);
+        }
+        std::sort(crossings.begin(), crossings.end());
+        char *row = &mask[(std::size_t)y * w];
+        for (std::size_t i = 0; i + 1 < crossings.size(); i += 2) {
+            int start = std::max(0, (int)std::ceil(crossings[i] - 0.5) - x0);
+            int end = std::min(w, (int)std::ceil(crossings[i+1] - 0.5) - x0);
+            for (int x = start; x < end; ++x)
+                row[x] = 1;
+        }
+    }
+
+    if (depthTest) {
+        ids.resize(mask.size(), 0);
+        depths.resize(mask.size(), 1.0f);
+    }
+}
+
+bool ElementIdBuffer::intersects(const Base::BoundBox2d &bbox) const
+{
+    if (mask.empty())
+        return false;
+    return bbox.MaxX * width >= x0 && bbox.MinX * width <= x0 + w
+        && bbox.MaxY * height >= y0 && bbox.MinY * height <= y0 + h;
+}
+
+void ElementIdBuffer::setPixel(int x, int y, float z, uint32_t id)
+{
+    x -= x0;
+    y -= y0;
+    if (x < 0 || y < 0 || x >= w || y >= h || z < 0.0f || z > 1.0f)
+        return;
+    std::size_t index = (std::size_t)y * w + x;
+    if (!mask[index])
+        return;
+    if (depthTest) {
+        if (z < depths[index]) {
+            depths[index] = z;
+            ids[index] = id;
+        }
+    }
+    else {
+        if (id >= hits.size())
+            hits.resize(id + 1, 0);
+        hits[id] = 1;
+    }
+}
+
+void ElementIdBuffer::addTriangle(const Base::Vector3d &p1,
+                                  const Base::Vector3d &p2,
+                                  const Base::Vector3d &p3,
+                                  uint32_t id)
+{
+    if (mask.empty())
+        return;
+
+    double ax = p1.x * width, ay = p1.y * height;
+    double bx = p2.x * width, by = p2.y * height;
+    double cx = p3.x * width, cy = p3.y * height;
+
+    int xmin = std::max(x0, (int)std::floor(std::min({ax, bx, cx})));
+    int xmax = std::min(x0 + w - 1, (int)std::ceil(std::max({ax, bx, cx})));
+    int ymin = std::max(y0, (int)std::floor(std::min({ay, by, cy})));
+    int ymax = std::min(y0 + h - 1, (int)std::ceil(std::max({ay, by, cy})));
+    if (xmin > xmax || ymin > ymax)
+        return;
+
+    double area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+    if (std::abs(area) < 1e-12) {
+        // Degenerated into a line, e.g. a face seen edge on
+        addLine(p1, p2, id);
+        addLine(p2, p3, id);
+        return;
+    }
+
+    bool covered = false;
+    for (int y = ymin; y <= ymax; ++y) {
+        double py = y + 0.5;
+        for (int x = xmin; x <= xmax; ++x) {
+            double px = x + 0.5;
+            double w1 = ((bx - px) * (cy - py) - (by - py) * (cx - px)) / area;
+            double w2 = ((cx - px) * (ay - py) - (cy - py) * (ax - px)) / area;
+            double w3 = 1.0 - w1 - w2;
+            if (w1 < 0.0 || w2 < 0.0 || w3 < 0.0)
+                continue;
+            covered = true;
+            setPixel(x, y, (float)(w1 * p1.z + w2 * p2.z + w3 * p3.z), id);
+        }
+    }
+
+    // Make sure triangles smaller than a pixel still show up
+    if (!covered) {
+        Base::Vector3d center = (p1 + p2 + p3) / 3.0;
+        setPixel((int)std::floor(center.x * width),
+                 (int)std::floor(center.y * height),
+                 (float)center.z, id);
+    }
+}
+
+void ElementIdBuffer::addLine(const Base::Vector3d &p1, const Base::Vector3d &p2, uint32_t id)
+{
+    if (mask.empty())
+        return;
+
+    double ax = p1.x * width, ay = p1.y * height;
+    double dx = p2.x * width - ax, dy = p2.y * height - ay;
+
+    // Clip the segment to the buffer (Liang-Barsky), so that long lines
+    // outside of the region are cheap
+    double t0 = 0.0, t1 = 1.0;
+    auto clip = [&](double p, double q) {
+        if (p == 0.0)
+            return q >= 0.0;
+        double r = q / p;
+        if (p < 0.0) {
+            if (r > t1)
+                return false;
+            t0 = std::max(t0, r);
+        }
+        else {
+            if (r < t0)
+                return false;
+            t1 = std::min(t1, r);
+        }
+        return true;
+    };
+    if (!clip(-dx, ax - x0) || !clip(dx, x0 + w - ax)
+            || !clip(-dy, ay - y0) || !clip(dy, y0 + h - ay))
+        return;
+
+    double z1 = p1.z - LineDepthBias;
+    double dz = p2.z - p1.z;
+    double length = std::max(std::abs(dx), std::abs(dy)) * (t1 - t0);
+    int steps = std::max(1, (int)std::ceil(length * 2.0));
+    for (int i = 0; i <= steps; ++i) {
+        double t = t0 + (t1 - t0) * i / steps;
+        setPixel((int)std::floor(ax + dx * t),
+                 (int)std::floor(ay + dy * t),
+                 (float)(z1 + dz * t), id);
+    }
+}
+
+void ElementIdBuffer::addPoint(const Base::Vector3d &p, uint32_t id)
+{
+    if (mask.empty())
+        return;
+    setPixel((int)std::floor(p.x * width),
+             (int)std::floor(p.y * height),
+             (float)p.z - LineDepthBias, id);
+}
+
+std::vector<uint32_t> ElementIdBuffer::getIds() const
+{
+    std::vector<uint32_t> res;
+    if (depthTest) {
+        for (std::size_t i = 0, count = mask.size(); i < count; ++i) {
+            if (ids[i])
+                res.push_back(ids[i]);
+        }
+        std::sort(res.begin(), res.end());
+        res.erase(std::unique(res.begin(), res.end()), res.end());
+    }
+    else {
+        for (std::size_t i = 1, count = hits.size(); i < count; ++i) {
+            if (hits[i])
+                res.push_back((uint32_t)i);
+        }
+    }
+    return res;
+}
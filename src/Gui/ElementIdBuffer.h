@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef GUI_ELEMENT_ID_BUFFER_H
+#define GUI_ELEMENT_ID_BUFFER_H
+
+#include <cstdint>
+#include <vector>
+#include <Base/Tools2D.h>
+#include <Base/Vector3D.h>
+#include <FCGlobal.h>
+
+namespace Gui {
+
+/** Software rasterized buffer of element IDs for box and lasso selection
+ *
+ * The elements are drawn with an ID each into a pixel buffer covering the
+ * bounding box of the selection polygon, and the selected elements are read
+ * back from the pixels inside the polygon. This makes the cost of testing an
+ * element proportional to the pixels it covers instead of the size of the
+ * polygon, and with depth test enabled only the elements visible inside the
+ * polygon are reported. It does not need any OpenGL context.
+ *
+ * All coordinates are given in normalized viewport coordinates as returned
+ * by ViewVolumeProjection, i.e. x and y in [0, 1] and z as the depth in
+ * [0, 1] with 0 on the near plane.
+ */
+class GuiExport ElementIdBuffer
+{
+public:
+    /** Constructor
+     * @param polygon: the selection polygon
+     * @param width: viewport width in pixels
+     * @param height: viewport height in pixels
+     * @param depthTest: if true, only keep the closest element of each pixel
+     */
+    ElementIdBuffer(const Base::Polygon2d &polygon, int width, int height, bool depthTest);
+
+    /// Check if the buffer covers any pixel
+    bool isEmpty() const {
+        return mask.empty();
+    }
+    /// Check whether a projected bounding box touches the buffer
+    bool intersects(const Base::BoundBox2d &bbox) const;
+
+    /// Draw a triangle with the given ID, which must not be zero
+    void addTriangle(const Base::Vector3d &p1,
+                     const Base::Vector3d &p2,
+                     const Base::Vector3d &p3,
+                     uint32_t id);
+    /// Draw a line segment with the given ID, which must not be zero
+    void addLine(const Base::Vector3d &p1, const Base::Vector3d &p2, uint32_t id);
+    /// Draw a point with the given ID, which must not be zero
+    void addPoint(const Base::Vector3d &p, uint32_t id);
+
+    /// Return the sorted IDs drawn on any pixel inside the polygon
+    std::vector<uint32_t> getIds() const;
+
+private:
+    void setPixel(int x, int y, float z, uint32_t id);
+
+private:
+    int x0 = 0;
+    int y0 = 0;
+    int w = 0;
+    int h = 0;
+    double width;
+    double height;
+    bool depthTest;
+    std::vector<char> mask;
+    std::vector<uint32_t> ids;
+    std::vector<float> depths;
+    std::vector<char> hits;
+};
+
+} // namespace Gui
+
+#endif // GUI_ELEMENT_ID_BUFFER_H
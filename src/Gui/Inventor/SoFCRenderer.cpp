@@ -45,6 +45,7 @@
 # include <Inventor/C/glue/gl.h>
 
 #include <algorithm>
+#include <cmath>
 #include <unordered_map>
 
 #include <Inventor/actions/SoGLRenderAction.h>
@@ -159,6 +160,22 @@ struct DrawEntryIndex {
   {}
 };
 
+// Node of the bounding volume hierarchy over the draw entries used for culling
+struct CullNode {
+  SbBox3f bbox;
+  int first = 0; // index of the first entry in SoFCRendererP::cullindices
+  int count = 0;
+  int child = 0; // index of the left child followed by the right one, zero for leaf
+};
+
+enum CullState {
+  CullNone    = 0,
+  CullFrustum = 1,
+  CullSmall   = 2,
+};
+
+static const int CullLeafSize = 8;
+
 enum RenderPass {
   RenderPassNormal            = 0,
   RenderPassLineSolid         = 1,
@@ -222,13 +239,25 @@ public:
                        SoGLRenderAction *action,
                        const int arrays = SoFCVertexCache::ALL,
                        int part = -1,
-                       const SbPlane *plane = nullptr);
+                       const SbPlane *plane = nullptr,
+                       int lod = 0);
 
   void renderOpaque(SoGLRenderAction * action,
                     SbFCVector<DrawEntry> & draw_entries,
                     SbFCVector<std::size_t> & indices,
                     int pass = RenderPassNormal);
 
+  std::size_t countInstances(const SbFCVector<DrawEntry> & draw_entries,
+                             const SbFCVector<std::size_t> & indices,
+                             std::size_t pos,
+                             int pass) const;
+  void renderInstances(SoGLRenderAction * action,
+                       const SbFCVector<DrawEntry> & draw_entries,
+                       const SbFCVector<std::size_t> & indices,
+                       std::size_t pos,
+                       std::size_t count,
+                       int array);
+
   void renderTransparency(SoGLRenderAction * action,
                           SbFCVector<DrawEntry> & draw_entries,
                           SbFCVector<DrawEntryIndex> & indices,
@@ -237,6 +266,23 @@ public:
   void applyKeys(const CacheKeySet &keys, int skip=1);
   void changeKey(const CacheKeySet &keys, int idx, int skip);
 
+  void updateCullTree();
+  void buildCullTree(int index);
+  void cullDrawEntries(SoGLRenderAction * action);
+  void cullNode(int index, int mask);
+  void cullEntries(const CullNode & node, int mask, bool allsmall);
+  bool isSmall(const SbBox3f & bbox) const;
+  float getProjectedSize(const SbBox3f & bbox) const;
+  int getLevelOfDetail(const SbFCVector<DrawEntry> & draw_entries,
+                       const DrawEntry & draw_entry,
+                       int pass);
+  bool isCulled(const SbFCVector<DrawEntry> & draw_entries, std::size_t idx) const
+  {
+    return &draw_entries == &this->drawentries
+      && idx < this->cullstates.size()
+      && this->cullstates[idx] != CullNone;
+  }
+
   SbFCVector<DrawEntry> drawentries;
   SbFCVector<DrawEntry> slentries;
   SbFCVector<DrawEntry> hlentries; 
@@ -313,6 +359,24 @@ public:
   char stats[512];
   int drawcallcount;
 
+  SbFCVector<CullNode> cullnodes;
+  SbFCVector<std::size_t> cullindices; // cullable draw entries in the order of the leaves
+  SbFCVector<const SoFCVertexCache *> cullcaches; // to detect structural scene change
+  SbFCVector<unsigned char> cullstates;
+  bool hasviewvolume = false;
+  SbViewVolume cullvolume; // view volume in the local space of the entries
+  SbPlane cullplanes[6];
+  float cullpixels = 0.f;
+  float cullsize = 0.f;
+  float lodsize = 0.f;
+  int lodcount = 0;
+  int culledfrustum = 0;
+  int culledsmall = 0;
+
+  SbFCVector<SbMatrix> instancematrices;
+  int batchcount = 0;
+  int instancecount = 0;
+
   CoinPtr<SoNode> dummynode;
   SbColor sbcolor;
   SbColor *fromPackedColor(uint32_t col)
@@ -848,6 +912,11 @@ SoFCRenderer::clear()
   PRIVATE(this)->highlightkeys.clear();
 
   PRIVATE(this)->cachetable.clear();
+
+  PRIVATE(this)->cullnodes.clear();
+  PRIVATE(this)->cullindices.clear();
+  PRIVATE(this)->cullcaches.clear();
+  PRIVATE(this)->cullstates.clear();
 }
 
 void
@@ -1001,11 +1070,268 @@ SoFCRenderer::setScene(const RenderCachePtr &cache)
         << PRIVATE(this)->drawentries.size() << " entries, "
         << mergecount << " after merge");
 
+  PRIVATE(this)->updateCullTree();
+
   PRIVATE(this)->applyKeys(PRIVATE(this)->highlightkeys);
   PRIVATE(this)->selectionkeys.clear();
   PRIVATE(this)->updateselection = true;
 }
 
+static inline bool
+isCullable(const DrawEntry & draw_entry)
+{
+  // Auto zoomed or matrix reset entries are placed independent of their
+  // bounding box, so never cull them.
+  return !draw_entry.material->autozoom.getNum()
+    && !draw_entry.ventry->resetmatrix
+    && isValidBBox(draw_entry.bbox);
+}
+
+void
+SoFCRendererP::updateCullTree()
+{
+  bool refit = !this->cullnodes.empty()
+               && this->cullcaches.size() == this->drawentries.size();
+
+  SbFCVector<const SoFCVertexCache *> caches;
+  caches.reserve(this->drawentries.size());
+  for (const auto & draw_entry : this->drawentries) {
+    caches.push_back(isCullable(draw_entry) ? draw_entry.ventry->cache.get() : nullptr);
+    if (refit && this->cullcaches[caches.size()-1] != caches.back())
+      refit = false;
+  }
+  this->cullcaches = std::move(caches);
+  this->cullstates.clear();
+
+  if (refit) {
+    // Same entries as before, probably with changed transformation. Keep the
+    // tree and only update the node boxes. The children are always stored
+    // after their parent, so the boxes can be updated in reverse order.
+    for (auto it = this->cullnodes.rbegin(); it != this->cullnodes.rend(); ++it) {
+      auto & node = *it;
+      node.bbox = SbBox3f();
+      if (node.child) {
+        node.bbox.extendBy(this->cullnodes[node.child].bbox);
+        node.bbox.extendBy(this->cullnodes[node.child+1].bbox);
+      } else {
+        for (int i=node.first; i<node.first+node.count; ++i)
+          node.bbox.extendBy(this->drawentries[this->cullindices[i]].bbox);
+      }
+    }
+    FC_TRACE("refit cull tree " << this->cullnodes.size() << " nodes");
+    return;
+  }
+
+  this->cullnodes.clear();
+  this->cullindices.clear();
+  for (std::size_t i=0; i<this->cullcaches.size(); ++i) {
+    if (this->cullcaches[i])
+      this->cullindices.push_back(i);
+  }
+  if (this->cullindices.empty())
+    return;
+
+  this->cullnodes.reserve(2 * this->cullindices.size() / CullLeafSize + 1);
+  this->cullnodes.emplace_back();
+  this->cullnodes.back().count = static_cast<int>(this->cullindices.size());
+  buildCullTree(0);
+  FC_TRACE("build cull tree " << this->cullnodes.size() << " nodes, "
+      << this->cullindices.size() << " entries");
+}
+
+void
+SoFCRendererP::buildCullTree(int index)
+{
+  // Only access the nodes by index, because the array grows below
+  int first = this->cullnodes[index].first;
+  int count = this->cullnodes[index].count;
+
+  SbBox3f bbox, centers;
+  for (int i=first; i<first+count; ++i) {
+    const SbBox3f & box = this->drawentries[this->cullindices[i]].bbox;
+    bbox.extendBy(box);
+    centers.extendBy(box.getCenter());
+  }
+  this->cullnodes[index].bbox = bbox;
+  if (count <= CullLeafSize)
+    return;
+
+  // Split at the median of the entry centers along the longest axis
+  float dx, dy, dz;
+  centers.getSize(dx, dy, dz);
+  int axis = (dx >= dy && dx >= dz) ? 0 : (dy >= dz ? 1 : 2);
+  auto begin = this->cullindices.begin() + first;
+  std::nth_element(begin, begin + count/2, begin + count,
+    [this, axis](std::size_t a, std::size_t b) {
+      return this->drawentries[a].bbox.getCenter()[axis]
+        < this->drawentries[b].bbox.getCenter()[axis];
+    });
+
+  int child = static_cast<int>(this->cullnodes.size());
+  this->cullnodes[index].child = child;
+  this->cullnodes.resize(child + 2);
+  this->cullnodes[child].first = first;
+  this->cullnodes[child].count = count/2;
+  this->cullnodes[child+1].first = first + count/2;
+  this->cullnodes[child+1].count = count - count/2;
+  buildCullTree(child);
+  buildCullTree(child+1);
+}
+
+// Returns -1 if the box is completely outside of the plane, 1 if completely
+// inside, and 0 if intersecting
+static inline int
+testPlane(const SbPlane & plane, const SbBox3f & bbox)
+{
+  const SbVec3f & normal = plane.getNormal();
+  const SbVec3f & bmin = bbox.getMin();
+  const SbVec3f & bmax = bbox.getMax();
+  SbVec3f pmin, pmax;
+  for (int i=0; i<3; ++i) {
+    pmin[i] = normal[i] >= 0.f ? bmin[i] : bmax[i];
+    pmax[i] = normal[i] >= 0.f ? bmax[i] : bmin[i];
+  }
+  if (plane.getDistance(pmax) < 0.f)
+    return -1;
+  if (plane.getDistance(pmin) >= 0.f)
+    return 1;
+  return 0;
+}
+
+// Returns the projected diagonal of the box in pixels, or a negative value if
+// unknown.
+float
+SoFCRendererP::getProjectedSize(const SbBox3f & bbox) const
+{
+  float scale = this->cullvolume.getWorldToScreenScale(bbox.getCenter(), 1.f);
+  if (scale <= 0.f)
+    return -1.f;
+  float dx, dy, dz;
+  bbox.getSize(dx, dy, dz);
+  return std::sqrt(dx*dx + dy*dy + dz*dz) * this->cullpixels / scale;
+}
+
+bool
+SoFCRendererP::isSmall(const SbBox3f & bbox) const
+{
+  float size = getProjectedSize(bbox);
+  return size >= 0.f && size < this->cullsize;
+}
+
+int
+SoFCRendererP::getLevelOfDetail(const SbFCVector<DrawEntry> & draw_entries,
+                                const DrawEntry & draw_entry,
+                                int pass)
+{
+  if (!this->hasviewvolume
+      || this->lodsize <= 0.f
+      || &draw_entries != &this->drawentries
+      || pass != RenderPassNormal
+      || !isCullable(draw_entry)
+      || draw_entry.ventry->partidx >= 0)
+    return 0;
+
+  float size = getProjectedSize(draw_entry.bbox);
+  if (size <= 0.f)
+    return 0;
+  int lod = draw_entry.ventry->cache->getLevelOfDetail(size / this->lodsize);
+  if (lod)
+    ++this->lodcount;
+  return lod;
+}
+
+void
+SoFCRendererP::cullDrawEntries(SoGLRenderAction * action)
+{
+  this->culledfrustum = 0;
+  this->culledsmall = 0;
+  this->lodcount = 0;
+  this->cullstates.clear();
+  this->hasviewvolume = false;
+
+  // Do not cull when rendering shadow map, because the view volume is
+  // the light's, and shadow may be cast by objects outside of the view.
+  if (this->shadowmapping)
+    return;
+
+  SoState * state = action->getState();
+  // The draw entries are in the local space of the renderer's model matrix
+  this->cullvolume = SoViewVolumeElement::get(state);
+  if (!this->identity)
+    this->cullvolume.transform(this->matrix.inverse());
+  this->cullpixels = SoViewportRegionElement::get(state).getViewportSizePixels()[0];
+  this->hasviewvolume = true;
+  this->lodsize = static_cast<float>(ViewParams::getRenderCacheLodPixelSize());
+
+  if (this->cullnodes.empty() || !ViewParams::getRenderCacheCulling())
+    return;
+
+  this->cullvolume.getViewVolumePlanes(this->cullplanes);
+  this->cullsize = static_cast<float>(ViewParams::getRenderCacheCullingPixelSize());
+
+  this->cullstates.assign(this->drawentries.size(), CullNone);
+  cullNode(0, 0x3f);
+}
+
+void
+SoFCRendererP::cullNode(int index, int mask)
+{
+  const CullNode & node = this->cullnodes[index];
+
+  // Skip the planes the box is completely inside, as are the children
+  for (int i=0; i<6; ++i) {
+    if (!(mask & (1<<i)))
+      continue;
+    int res = testPlane(this->cullplanes[i], node.bbox);
+    if (res < 0) {
+      for (int j=node.first; j<node.first+node.count; ++j)
+        this->cullstates[this->cullindices[j]] = CullFrustum;
+      this->culledfrustum += node.count;
+      return;
+    }
+    if (res > 0)
+      mask &= ~(1<<i);
+  }
+
+  if (this->cullsize > 0.f && isSmall(node.bbox)) {
+    cullEntries(node, mask, true);
+    return;
+  }
+
+  if (node.child) {
+    cullNode(node.child, mask);
+    cullNode(node.child+1, mask);
+  }
+  else if (mask || this->cullsize > 0.f)
+    cullEntries(node, mask, false);
+}
+
+void
+SoFCRendererP::cullEntries(const CullNode & node, int mask, bool allsmall)
+{
+  for (int j=node.first; j<node.first+node.count; ++j) {
+    std::size_t idx = this->cullindices[j];
+    const auto & draw_entry = this->drawentries[idx];
+    bool outside = false;
+    for (int i=0; i<6 && !outside; ++i) {
+      if (mask & (1<<i))
+        outside = testPlane(this->cullplanes[i], draw_entry.bbox) < 0;
+    }
+    if (outside) {
+      this->cullstates[idx] = CullFrustum;
+      ++this->culledfrustum;
+    }
+    // Lines and points are drawn with at least one pixel, so only cull
+    // small triangles.
+    else if (draw_entry.material->type == Material::Triangle
+             && this->cullsize > 0.f
+             && (allsmall || isSmall(draw_entry.bbox))) {
+      this->cullstates[idx] = CullSmall;
+      ++this->culledsmall;
+    }
+  }
+}
+
 void
 SoFCRenderer::setHighlight(VertexCacheMap && caches, bool wholeontop)
 {
@@ -1305,7 +1631,8 @@ SoFCRendererP::renderTriangles(const DrawEntry &draw_entry,
                                   SoGLRenderAction *action,
                                   const int arrays,
                                   int part,
-                                  const SbPlane *plane)
+                                  const SbPlane *plane,
+                                  int lod)
 {
   auto cache = draw_entry.ventry->cache;
   if (cache->shouldGLRender()) {
@@ -1315,7 +1642,7 @@ SoFCRendererP::renderTriangles(const DrawEntry &draw_entry,
       return;
     pauseShadowRender(action->getState(), true);
   }
-  cache->renderTriangles(action, arrays, part, plane);
+  cache->renderTriangles(action, arrays, part, plane, lod);
 }
 
 void
@@ -1895,7 +2222,12 @@ SoFCRendererP::renderOpaque(SoGLRenderAction * action,
   bool pauseshadow = (&draw_entries == &this->slentries || &draw_entries == &this->hlentries);
 
   SoState * state = action->getState();
-  for (std::size_t idx : indices) {
+  std::size_t instances = 1;
+  for (std::size_t pos = 0; pos < indices.size(); pos += instances) {
+    instances = 1;
+    std::size_t idx = indices[pos];
+    if (isCulled(draw_entries, idx))
+      continue;
     auto & draw_entry = draw_entries[idx];
     if (draw_entry.skip > 0
         && !this->shadowmapping
@@ -1920,6 +2252,8 @@ SoFCRendererP::renderOpaque(SoGLRenderAction * action,
       continue;
     }
 
+    instances = countInstances(draw_entries, indices, pos, pass);
+
     int array = SoFCVertexCache::ALL;
     if (!this->material.pervertexcolor)
       array ^= SoFCVertexCache::COLOR;
@@ -1954,8 +2288,12 @@ SoFCRendererP::renderOpaque(SoGLRenderAction * action,
         pauseShadowRender(state, pauseshadow
             || !(draw_entry.material->shadowstyle & SoShadowStyleElement::SHADOWED));
 
-        if (!draw_entry.ventry->cache->hasTransparency()) {
-          renderTriangles(draw_entry, action, array, draw_entry.ventry->partidx);
+        if (instances > 1) {
+          renderInstances(action, draw_entries, indices, pos, instances, array);
+        }
+        else if (!draw_entry.ventry->cache->hasTransparency()) {
+          renderTriangles(draw_entry, action, array, draw_entry.ventry->partidx, nullptr,
+                          getLevelOfDetail(draw_entries, draw_entry, pass));
           ++this->drawcallcount;
         }
         else if (!this->material.pervertexcolor) {
@@ -1993,6 +2331,76 @@ SoFCRendererP::renderOpaque(SoGLRenderAction * action,
   }
 }
 
+// Returns the number of consecutive entries starting at \a pos that share the
+// vertex cache and material, and can thus be drawn as one batch of instances
+// with only the model matrix changed in between.
+std::size_t
+SoFCRendererP::countInstances(const SbFCVector<DrawEntry> & draw_entries,
+                              const SbFCVector<std::size_t> & indices,
+                              std::size_t pos,
+                              int pass) const
+{
+  if (&draw_entries != &this->drawentries
+      || pass != RenderPassNormal
+      || this->material.clippers.getNum()
+      || !ViewParams::getRenderCacheInstancing())
+    return 1;
+
+  const auto & draw_entry = draw_entries[indices[pos]];
+  const Material * material = draw_entry.material;
+  const SoFCVertexCache * cache = draw_entry.ventry->cache.get();
+  if (material->type != Material::Triangle
+      || material->outline
+      || material->autozoom.getNum()
+      || draw_entry.ventry->resetmatrix
+      || draw_entry.ventry->partidx >= 0
+      || cache->shouldGLRender()
+      || cache->hasTransparency())
+    return 1;
+
+  std::size_t count = 1;
+  for (std::size_t i = pos + 1; i < indices.size(); ++i, ++count) {
+    std::size_t idx = indices[i];
+    const auto & other = draw_entries[idx];
+    if (other.material != material
+        || other.ventry->cache.get() != cache
+        || other.ventry->resetmatrix
+        || other.ventry->partidx >= 0
+        || other.skip > 0
+        || isCulled(draw_entries, idx))
+      break;
+  }
+  return count;
+}
+
+void
+SoFCRendererP::renderInstances(SoGLRenderAction * action,
+                               const SbFCVector<DrawEntry> & draw_entries,
+                               const SbFCVector<std::size_t> & indices,
+                               std::size_t pos,
+                               std::size_t count,
+                               int array)
+{
+  // Same model matrix as setupMatrix() would produce for each entry
+  this->instancematrices.clear();
+  for (std::size_t i = pos; i < pos + count; ++i) {
+    const VertexCacheEntry * ventry = draw_entries[indices[i]].ventry;
+    if (ventry->identity)
+      this->instancematrices.push_back(this->identity ? SbMatrix::identity() : this->matrix);
+    else if (this->identity)
+      this->instancematrices.push_back(ventry->matrix);
+    else
+      this->instancematrices.push_back(ventry->matrix * this->matrix);
+  }
+
+  draw_entries[indices[pos]].ventry->cache->renderTriangleInstances(
+      action, array, &this->instancematrices[0], static_cast<int>(count));
+
+  this->drawcallcount += static_cast<int>(count);
+  ++this->batchcount;
+  this->instancecount += static_cast<int>(count);
+}
+
 void
 SoFCRendererP::renderTransparency(SoGLRenderAction * action,
                                   SbFCVector<DrawEntry> & draw_entries,
@@ -2045,6 +2453,8 @@ SoFCRendererP::renderTransparency(SoGLRenderAction * action,
   bool sel_highlight = &draw_entries == &this->slentries;
 
   for (auto & v : indices) {
+    if (isCulled(draw_entries, v.idx))
+      continue;
     auto & draw_entry = draw_entries[v.idx];
     if (draw_entry.skip > 0 && !this->shadowmapping)
       continue;
@@ -2210,6 +2620,9 @@ SoFCRenderer::render(SoGLRenderAction * action)
 
   if (!action->isRenderingDelayedPaths()) {
     PRIVATE(this)->drawcallcount = 0;
+    PRIVATE(this)->batchcount = 0;
+    PRIVATE(this)->instancecount = 0;
+    PRIVATE(this)->cullDrawEntries(action);
 
     PRIVATE(this)->renderOpaque(action,
                                 PRIVATE(this)->drawentries,
@@ -2458,7 +2871,16 @@ const char *
 SoFCRenderer::getStatistics() const
 {
   snprintf(PRIVATE(this)->stats, sizeof(PRIVATE(this)->stats)-1,
-      "draw calls: %d", PRIVATE(this)->drawcallcount);
+      "draw calls: %d, entries: %d, culled: %d (frustum: %d, small: %d), "
+      "instances: %d in %d batches, level of detail: %d",
+      PRIVATE(this)->drawcallcount,
+      static_cast<int>(PRIVATE(this)->drawentries.size()),
+      PRIVATE(this)->culledfrustum + PRIVATE(this)->culledsmall,
+      PRIVATE(this)->culledfrustum,
+      PRIVATE(this)->culledsmall,
+      PRIVATE(this)->instancecount,
+      PRIVATE(this)->batchcount,
+      PRIVATE(this)->lodcount);
   return PRIVATE(this)->stats;
 }
 
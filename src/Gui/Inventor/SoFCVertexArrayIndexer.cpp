@@ -169,6 +169,23 @@ SoFCVertexArrayIndexer::SoFCVertexArrayIndexer(const SoFCVertexArrayIndexer & ot
        exclude);
 }
 
+SoFCVertexArrayIndexer::SoFCVertexArrayIndexer(const SoFCVertexArrayIndexer & other,
+                                               const std::vector<int32_t> & indices,
+                                               const std::vector<int> & parts)
+  : target(other.target)
+  , indexarray(GL_ELEMENT_ARRAY_BUFFER, GL_STREAM_DRAW)
+  , indexarraylength(0)
+  , lastlineindex(0)
+  , use_shorts(TRUE)
+{
+  for (int32_t i : indices)
+    addIndex(i);
+  this->partarray.reserve(static_cast<int>(parts.size()));
+  for (int i : parts)
+    this->partarray.push_back(i);
+  this->partialindices = other.partialindices;
+}
+
 SoFCVertexArrayIndexer::~SoFCVertexArrayIndexer()
 {
 }
@@ -71,6 +71,13 @@ public:
                          int maxindex,
                          bool exclude = false);
 
+  // Construct with the given triangle indices, e.g. of a simplified version
+  // of \a other. \a parts are the part offsets into \a indices and must
+  // correspond to the parts of \a other.
+  SoFCVertexArrayIndexer(const SoFCVertexArrayIndexer & other,
+                         const std::vector<int32_t> & indices,
+                         const std::vector<int> & parts);
+
   ~SoFCVertexArrayIndexer();
 
   static void initClass();
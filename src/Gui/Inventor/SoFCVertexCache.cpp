@@ -33,6 +33,8 @@
 
 #include "PreCompiled.h"
 
+#include <atomic>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include <algorithm>
@@ -85,6 +87,8 @@
 
 #include <Inventor/nodes/SoCube.h>
 #include <Inventor/nodes/SoText2.h>
+#include <QRunnable>
+#include <QThreadPool>
 #include "SoFCBoundingBox.h"
 
 #include <Base/Console.h>
@@ -122,6 +126,116 @@ static SbName * ElementSelectableField;
 static SbName * OnTopPatternField;
 static SbName * ShapeInfoField;
 
+// Simplified versions of the triangles of a vertex cache. They are computed
+// by vertex clustering on copies of the vertices and indices in a worker
+// thread. The clustered triangles keep referring to the original vertex
+// array, and to the original parts, so that only the index buffer changes.
+struct VertexCacheLod {
+  struct Level {
+    int resolution;
+    std::vector<int32_t> indices;
+    std::vector<int> parts;
+  };
+
+  std::vector<SbVec3f> vertices;
+  std::vector<int32_t> indices;
+  std::vector<int> parts;
+  std::vector<Level> levels;
+  std::atomic<bool> done{false};
+
+  void build();
+};
+
+void
+VertexCacheLod::build()
+{
+  SbBox3f bbox;
+  for (const auto & v : this->vertices)
+    bbox.extendBy(v);
+  float dx, dy, dz;
+  bbox.getSize(dx, dy, dz);
+  float length = std::max(dx, std::max(dy, dz));
+  if (this->vertices.empty() || length <= 0.f)
+    return;
+  const SbVec3f origin = bbox.getMin();
+
+  std::size_t count = this->indices.size();
+  std::unordered_map<uint32_t, int32_t> cells;
+  std::vector<int32_t> vertexmap;
+
+  // Grid resolution along the longest side of the bounding box, from fine
+  // to coarse. Every vertex is replaced by the first vertex found in its
+  // grid cell, and the triangles that collapse are dropped.
+  for (int resolution : {256, 64, 16}) {
+    float scale = resolution / length;
+    cells.clear();
+    vertexmap.assign(this->vertices.size(), -1);
+
+    auto cluster = [&](int32_t v) {
+      int32_t & rep = vertexmap[v];
+      if (rep < 0) {
+        const SbVec3f & pt = this->vertices[v];
+        uint32_t cell = 0;
+        for (int i=2; i>=0; --i) {
+          int c = static_cast<int>((pt[i] - origin[i]) * scale);
+          c = std::max(0, std::min(resolution-1, c));
+          cell = cell * resolution + c;
+        }
+        rep = cells.emplace(cell, v).first->second;
+      }
+      return rep;
+    };
+
+    Level level;
+    level.resolution = resolution;
+    level.indices.reserve(count / 2);
+    level.parts.reserve(this->parts.size());
+    std::size_t part = 0;
+    for (std::size_t i=0; i+2<this->indices.size(); i+=3) {
+      for (; part<this->parts.size() && static_cast<std::size_t>(this->parts[part])<=i; ++part)
+        level.parts.push_back(static_cast<int>(level.indices.size()));
+      int32_t a = cluster(this->indices[i]);
+      int32_t b = cluster(this->indices[i+1]);
+      int32_t c = cluster(this->indices[i+2]);
+      if (a == b || b == c || a == c)
+        continue;
+      level.indices.push_back(a);
+      level.indices.push_back(b);
+      level.indices.push_back(c);
+    }
+    for (; part<this->parts.size(); ++part)
+      level.parts.push_back(static_cast<int>(level.indices.size()));
+
+    if (level.indices.empty())
+      break;
+    // Only keep the level if it saves enough compared to the previous one
+    if (level.indices.size() > count / 2)
+      continue;
+    count = level.indices.size();
+    this->levels.push_back(std::move(level));
+  }
+
+  std::vector<SbVec3f>().swap(this->vertices);
+  std::vector<int32_t>().swap(this->indices);
+  std::vector<int>().swap(this->parts);
+}
+
+class VertexCacheLodTask : public QRunnable {
+public:
+  explicit VertexCacheLodTask(const std::shared_ptr<VertexCacheLod> & lod)
+    : lod(lod)
+  {}
+
+  void run() override
+  {
+    lod->build();
+    lod->done = true;
+  }
+
+private:
+  std::shared_ptr<VertexCacheLod> lod;
+};
+
 class SoFCVertexCacheP {
 public:
   enum Arrays {
@@ -268,6 +382,8 @@ public:
     delete lineindexer;
     delete pointindexer;
     delete noseamindexer;
+    for (auto indexer : lodindexers)
+      delete indexer;
   }
 
   uint32_t getColor(const SoFCVertexArrayIndexer * indexer, int part) const;
@@ -389,7 +505,9 @@ public:
               const int arrays,
               const intptr_t * offsets = NULL,
               const int32_t * counts = NULL,
-              int32_t drawcount = 0);
+              int32_t drawcount = 0,
+              const SbMatrix * instances = NULL,
+              int32_t instancecount = 0);
 
   void renderImmediate(const cc_glglue * glue,
                        const GLint * indices,
@@ -503,6 +621,11 @@ public:
   SoFCVertexArrayIndexer * noseamindexer;
   SoFCVertexArrayIndexer * pointindexer;
 
+  std::shared_ptr<VertexCacheLod> lod;
+  SbFCVector<SoFCVertexArrayIndexer *> lodindexers;
+  SbFCVector<int> lodresolutions;
+  bool lodrequested = false;
+
   bool elementselectable;
   bool ontoppattern;
 
@@ -1096,12 +1219,26 @@ SoFCVertexCacheP::render(SoState * state,
                          const int arrays,
                          const intptr_t * offsets,
                          const int32_t * counts,
-                         int32_t drawcount)
+                         int32_t drawcount,
+                         const SbMatrix * instances,
+                         int32_t instancecount)
 {
   if (!indexer || !indexer->getNumIndices()) return;
   if (!this->vertexarray) return;
   int lastenabled = -1;
 
+  // Draw the same arrays with each of the given model matrices. The arrays
+  // are only set up once for all instances.
+  if (!instances)
+    instancecount = 1;
+  SbMatrix viewing;
+  if (instances)
+    viewing = SoViewingMatrixElement::get(state);
+  auto setInstance = [&](int instance) {
+    if (instances)
+      glLoadMatrixf((instances[instance] * viewing)[0]);
+  };
+
   const SbBool * enabled = NULL;
   const SbBool normal = (arrays & NORMAL) != 0;
   const SbBool texture = (arrays & TEXCOORD) != 0;
@@ -1118,44 +1255,57 @@ SoFCVertexCacheP::render(SoState * state,
   int vnum = this->vertexarray.getLength();
   if (SoFCVBO::shouldCreateVBO(state, contextid, vnum)) {
     this->enableVBOs(state, glue, contextid, color, normal, texture, enabled, lastenabled);
-    indexer->render(state, glue, true, contextid, offsets, counts, drawcount);
+    for (int instance=0; instance<instancecount; ++instance) {
+      setInstance(instance);
+      indexer->render(state, glue, true, contextid, offsets, counts, drawcount);
+    }
     this->disableVBOs(glue, color, normal, texture, enabled, lastenabled);
   } else if (SoFCVBO::shouldRenderAsVertexArrays(state, contextid, vnum)) {
     this->enableArrays(glue, color, normal, texture, enabled, lastenabled);
-    if (!drawcount)
-      indexer->render(state, glue, false, contextid);
-    else {
-      int typeshift = indexer->useShorts() ? 1 : 2;
-      for (int i=0; i<drawcount; ++i) {
-        int32_t count = counts[i];
-        intptr_t offset = offsets[i] >> typeshift;
-        offset = (intptr_t)(indexer->getIndices() + offset);
-        indexer->render(state, glue, false, contextid, &offset, &count, 1);
+    for (int instance=0; instance<instancecount; ++instance) {
+      setInstance(instance);
+      if (!drawcount)
+        indexer->render(state, glue, false, contextid);
+      else {
+        int typeshift = indexer->useShorts() ? 1 : 2;
+        for (int i=0; i<drawcount; ++i) {
+          int32_t count = counts[i];
+          intptr_t offset = offsets[i] >> typeshift;
+          offset = (intptr_t)(indexer->getIndices() + offset);
+          indexer->render(state, glue, false, contextid, &offset, &count, 1);
+        }
       }
     }
     this->disableArrays(glue, color, normal, texture, enabled, lastenabled);
   }
   else {
     // fall back to immediate mode rendering
-    glBegin(indexer->getTarget());
-    if (!drawcount) {
-      this->renderImmediate(glue,
-                            indexer->getIndices(),
-                            indexer->getNumIndices(),
-                            color, normal, texture, enabled, lastenabled);
-    }
-    else {
-      int typeshift = indexer->useShorts() ? 1 : 2;
-      for (int i=0; i<drawcount; ++i) {
-        int count = counts[i];
-        intptr_t offset = offsets[i] >> typeshift;
+    for (int instance=0; instance<instancecount; ++instance) {
+      setInstance(instance);
+      glBegin(indexer->getTarget());
+      if (!drawcount) {
         this->renderImmediate(glue,
-                              indexer->getIndices() + offset, count,
+                              indexer->getIndices(),
+                              indexer->getNumIndices(),
                               color, normal, texture, enabled, lastenabled);
       }
+      else {
+        int typeshift = indexer->useShorts() ? 1 : 2;
+        for (int i=0; i<drawcount; ++i) {
+          int count = counts[i];
+          intptr_t offset = offsets[i] >> typeshift;
+          this->renderImmediate(glue,
+                                indexer->getIndices() + offset, count,
+                                color, normal, texture, enabled, lastenabled);
+        }
+      }
+      glEnd();
     }
-    glEnd();
   }
+
+  // Restore the model view matrix as expected by the model matrix element
+  if (instances)
+    glLoadMatrixf((SoModelMatrixElement::get(state) * viewing)[0]);
 }
 
 SbBool
@@ -1172,8 +1322,55 @@ SoFCVertexCache::hasTransparency() const
   return PRIVATE(this)->hastransp;
 }
 
+int
+SoFCVertexCache::getLevelOfDetail(float resolution)
+{
+  auto & priv = *PRIVATE(this);
+  if (priv.glrender || !priv.triangleindexer || priv.hastransp || !priv.vertexarray)
+    return 0;
+
+  if (!priv.lodrequested) {
+    int numtriangles = priv.triangleindexer->getNumIndices() / 3;
+    if (numtriangles < ViewParams::getRenderCacheLodMinTriangles())
+      return 0;
+    priv.lodrequested = true;
+
+    auto lod = std::make_shared<VertexCacheLod>();
+    const SbVec3f * vertices = priv.vertexarray.getArrayPtr();
+    lod->vertices.assign(vertices, vertices + priv.vertexarray.getLength());
+    const GLint * indices = priv.triangleindexer->getIndices();
+    lod->indices.assign(indices, indices + priv.triangleindexer->getNumIndices());
+    if (priv.triangleindexer->getNumParts()) {
+      const int * parts = priv.triangleindexer->getPartOffsets();
+      lod->parts.assign(parts, parts + priv.triangleindexer->getNumParts());
+    }
+    priv.lod = lod;
+    QThreadPool::globalInstance()->start(new VertexCacheLodTask(lod));
+    return 0;
+  }
+
+  if (priv.lod) {
+    if (!priv.lod->done)
+      return 0;
+    for (const auto & level : priv.lod->levels) {
+      priv.lodindexers.push_back(
+          new SoFCVertexArrayIndexer(*priv.triangleindexer, level.indices, level.parts));
+      priv.lodresolutions.push_back(level.resolution);
+    }
+    priv.lod.reset();
+  }
+
+  int res = 0;
+  for (int i=0; i<(int)priv.lodresolutions.size(); ++i) {
+    if (priv.lodresolutions[i] < resolution)
+      break;
+    res = i + 1;
+  }
+  return res;
+}
+
 void
-SoFCVertexCache::renderTriangles(SoGLRenderAction * action, const int arrays, int part, const SbPlane *viewplane)
+SoFCVertexCache::renderTriangles(SoGLRenderAction * action, const int arrays, int part, const SbPlane *viewplane, int lod)
 {
   SoState *state = action->getState();
   if (PRIVATE(this)->glrender) {
@@ -1202,6 +1399,14 @@ SoFCVertexCache::renderTriangles(SoGLRenderAction * action, const int arrays, in
     return;
   }
 
+  if (lod > 0
+      && lod <= static_cast<int>(PRIVATE(this)->lodindexers.size())
+      && !(arrays & (SORTED_ARRAY | FULL_SORTED_ARRAY)))
+  {
+    PRIVATE(this)->render(state, PRIVATE(this)->lodindexers[lod-1], arrays);
+    return;
+  }
+
   int drawcount = 0;
   const intptr_t * offsets = NULL;
   const int32_t * counts = NULL;
@@ -1222,6 +1427,28 @@ SoFCVertexCache::renderTriangles(SoGLRenderAction * action, const int arrays, in
   PRIVATE(this)->render(state, PRIVATE(this)->triangleindexer, arrays, offsets, counts, drawcount);
 }
 
+void
+SoFCVertexCache::renderTriangleInstances(SoGLRenderAction * action,
+                                         const int arrays,
+                                         const SbMatrix * matrices,
+                                         int count)
+{
+  if (PRIVATE(this)->glrender || count <= 0)
+    return;
+
+  const intptr_t * offsets = NULL;
+  const int32_t * counts = NULL;
+  int drawcount = 0;
+  if (!(arrays & NON_SORTED_ARRAY) && PRIVATE(this)->opaquepartarray.size()) {
+    offsets = &PRIVATE(this)->opaquepartarray[0];
+    counts = &PRIVATE(this)->opaquepartcounts[0];
+    drawcount = (int)PRIVATE(this)->opaquepartarray.size();
+  }
+
+  PRIVATE(this)->render(action->getState(), PRIVATE(this)->triangleindexer,
+                        arrays, offsets, counts, drawcount, matrices, count);
+}
+
 void
 SoFCVertexCache::renderSolids(SoState * state)
 {
@@ -70,7 +70,10 @@ public:
   void open(SoState * state);
   void close(SoState * state);
 
-  void renderTriangles(SoGLRenderAction *action, const int arrays = ALL, int part = -1, const SbPlane *plane = nullptr);
+  void renderTriangles(SoGLRenderAction *action, const int arrays = ALL, int part = -1,
+                       const SbPlane *plane = nullptr, int lod = 0);
+  /// Render the opaque triangles once for each of the given model matrices
+  void renderTriangleInstances(SoGLRenderAction *action, const int arrays, const SbMatrix *matrices, int count);
   void renderLines(SoState * state, const int arrays = ALL, int part = -1, bool noseam = false);
   void renderPoints(SoGLRenderAction * action, const int array = ALL, int part = -1);
 
@@ -132,6 +135,12 @@ public:
   bool shouldRenderTriangles() const;
   bool shouldGLRender() const;
 
+  /// Returns the level of detail for rendering the triangles with a
+  /// simplification grid of at least \a resolution cells along the longest
+  /// side, or 0 for full detail. The levels are created in background on
+  /// first call.
+  int getLevelOfDetail(float resolution);
+
   uint32_t getFaceColor(int part) const;
   uint32_t getLineColor(int part) const;
   uint32_t getPointColor(int part) const;
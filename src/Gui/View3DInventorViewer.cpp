@@ -123,6 +123,7 @@
 #include "Application.h"
 #include "CornerCrossLetters.h"
 #include "Document.h"
+#include "ElementIdBuffer.h"
 #include "GLPainter.h"
 #include "MainWindow.h"
 #include "NaviCube.h"
@@ -5381,10 +5382,23 @@ bool View3DInventorViewer::Private::toggleDragger(int toggle)
     return false;
 }
 
+// Collects the elements drawn into the ID buffer of a box selection
+struct BoxSelectionIdBuffer {
+    ElementIdBuffer buffer;
+    App::DocumentObject *topObj = nullptr;
+    std::string prefix; // subname path from topObj to the current object
+    std::vector<App::SubObjectT> elements; // indexed by element ID - 1
+
+    BoxSelectionIdBuffer(const Base::Polygon2d &polygon, int size, bool depthTest)
+        : buffer(polygon, size, size, depthTest)
+    {}
+};
+
 static std::vector<std::string> getBoxSelection(const Base::Vector3d *dir,
         ViewProviderDocumentObject *vp, bool center, bool pickElement,
         const Base::ViewProjMethod &proj, const Base::Polygon2d &polygon,
-        const Base::Matrix4D &mat, bool transform=true, int depth=0)
+        const Base::Matrix4D &mat, bool transform=true, int depth=0,
+        BoxSelectionIdBuffer *idbuf=nullptr)
 {
     std::vector<std::string> ret;
     auto obj = vp->getObject();
@@ -5441,6 +5455,16 @@ static std::vector<std::string> getBoxSelection(const Base::Vector3d *dir,
                 std::unique_ptr<Data::Segment> segment(data->getSubElementByName(element.c_str()));
                 if(!segment)
                     continue;
+
+                // Skip elements outside of the selection before
+                // triangulating them
+                auto ebox3 = data->getBoundBoxFromSubElement(segment.get());
+                if(ebox3.IsValid()) {
+                    auto ebox = ebox3.ProjectBox(&proj);
+                    if(idbuf ? !idbuf->buffer.intersects(ebox) : !ebox.Intersect(polygon))
+                        continue;
+                }
+
                 std::vector<Base::Vector3d> points;
                 std::vector<Data::ComplexGeoData::Line> lines;
 
@@ -5450,6 +5474,41 @@ static std::vector<std::string> getBoxSelection(const Base::Vector3d *dir,
                 // Call getFacesFromSubElement to obtain the triangulation of
                 // the segment.
                 data->getFacesFromSubElement(segment.get(),points,pointNormals,faces);
+
+                if(idbuf) {
+                    // Draw the element into the ID buffer instead of
+                    // intersecting it with the polygon. The result is read
+                    // back by the caller once all objects are drawn.
+                    idbuf->elements.emplace_back(idbuf->topObj, (idbuf->prefix + element).c_str());
+                    auto id = (uint32_t)idbuf->elements.size();
+                    if(faces.size()) {
+                        for(auto &facet : faces) {
+                            if (dir) {
+                                Base::Vector3d normal = (points[facet.I2] - points[facet.I1])
+                                    % (points[facet.I3] - points[facet.I1]);
+                                normal.Normalize();
+                                if (normal.Dot(*dir) < 0.0f)
+                                    continue;
+                            }
+                            idbuf->buffer.addTriangle(proj(points[facet.I1]),
+                                                      proj(points[facet.I2]),
+                                                      proj(points[facet.I3]), id);
+                        }
+                        continue;
+                    }
+                    data->getLinesFromSubElement(segment.get(),points,lines);
+                    if(lines.empty()) {
+                        if(points.size())
+                            idbuf->buffer.addPoint(proj(points[0]), id);
+                        continue;
+                    }
+                    for(auto &line : lines) {
+                        for(auto i=line.I1;i<line.I2;++i)
+                            idbuf->buffer.addLine(proj(points[i]), proj(points[i+1]), id);
+                    }
+                    continue;
+                }
+
                 if(faces.empty()) {
                     data->getLinesFromSubElement(segment.get(),points,lines);
                     if(lines.empty()) {
@@ -5534,7 +5593,14 @@ static std::vector<std::string> getBoxSelection(const Base::Vector3d *dir,
         if(!svp)
             continue;
 
-        const auto &sels = getBoxSelection(dir,svp,center,pickElement,proj,polygon,smat,false,depth+1);
+        std::size_t prefixSize = 0;
+        if(idbuf) {
+            prefixSize = idbuf->prefix.size();
+            idbuf->prefix += sub;
+        }
+        const auto &sels = getBoxSelection(dir,svp,center,pickElement,proj,polygon,smat,false,depth+1,idbuf);
+        if(idbuf)
+            idbuf->prefix.resize(prefixSize);
         if(sels.size()==1 && sels[0] == "")
             ++count;
         for(auto &sel : sels)
@@ -5600,6 +5666,18 @@ View3DInventorViewer::getPickedList(const std::vector<SbVec2f> &pts,
     SbViewVolume vv = cam->getViewVolume();
     Gui::ViewVolumeProjection proj(vv);
 
+    // Select the elements touched by the polygon through an ID buffer. The
+    // polygon coordinates are normalized to the view volume, so use square
+    // pixels of the larger viewport dimension.
+    std::unique_ptr<BoxSelectionIdBuffer> idbuf;
+    if (pickElement && !center && ViewParams::getSelectElementIdBuffer()) {
+        const SbVec2s &size = this->getSoRenderManager()->getViewportRegion().getViewportSizePixels();
+        idbuf.reset(new BoxSelectionIdBuffer(polygon, std::max(size[0], size[1]),
+                                             ViewParams::getSelectElementVisibleOnly()));
+        if (idbuf->buffer.isEmpty())
+            return res;
+    }
+
     std::set<App::SubObjectT> sels;
     std::map<App::SubObjectT, std::vector<const App::SubObjectT*> > selObjs;
     if(currentSelection || unselect) {
@@ -5642,7 +5720,11 @@ View3DInventorViewer::getPickedList(const std::vector<SbVec2f> &pts,
                     Application::Instance->getViewProvider(sobj));
             if(!vp)
                 continue;
-            for(auto &sub : getBoxSelection(pdir,vp,center,pickElement,proj,polygon,mat,false))
+            if (idbuf) {
+                idbuf->topObj = obj;
+                idbuf->prefix = sel.getSubName();
+            }
+            for(auto &sub : getBoxSelection(pdir,vp,center,pickElement,proj,polygon,mat,false,0,idbuf.get()))
                 handler(App::SubObjectT(obj, (sel.getSubName()+sub).c_str()));
         }
 
@@ -5658,11 +5740,20 @@ View3DInventorViewer::getPickedList(const std::vector<SbVec2f> &pts,
                 continue;
 
             Base::Matrix4D mat;
-            for(auto &sub : getBoxSelection(pdir,vp,center,pickElement,proj,polygon,mat))
+            if (idbuf) {
+                idbuf->topObj = obj;
+                idbuf->prefix.clear();
+            }
+            for(auto &sub : getBoxSelection(pdir,vp,center,pickElement,proj,polygon,mat,true,0,idbuf.get()))
                 handler(App::SubObjectT(obj, sub.c_str()));
         }
     }
 
+    if (idbuf) {
+        for (auto id : idbuf->buffer.getIds())
+            handler(std::move(idbuf->elements[id-1]));
+    }
+
     return res;
 }
 
@@ -91,6 +91,8 @@ public:
     bool NoPreSelFaceHighlightWithOutline;
     bool AutoTransparentPick;
     bool SelectElementOnTop;
+    bool SelectElementIdBuffer;
+    bool SelectElementVisibleOnly;
     double TransparencyOnTop;
     long HiddenLineSync;
     bool HiddenLineSelectionOnTop;
@@ -214,6 +216,11 @@ public:
     long RenderCacheMergeDepthMin;
     double RenderHighlightPolygonOffsetFactor;
     double RenderHighlightPolygonOffsetUnits;
+    bool RenderCacheCulling;
+    double RenderCacheCullingPixelSize;
+    bool RenderCacheInstancing;
+    double RenderCacheLodPixelSize;
+    long RenderCacheLodMinTriangles;
     bool ForceSolidSingleSideLighting;
     long DefaultFontSize;
     bool EnableTaskPanelKeyTranslate;
@@ -298,6 +305,10 @@ public:
         funcs["AutoTransparentPick"] = &ViewParamsP::updateAutoTransparentPick;
         SelectElementOnTop = this->handle->GetBool("SelectElementOnTop", false);
         funcs["SelectElementOnTop"] = &ViewParamsP::updateSelectElementOnTop;
+        SelectElementIdBuffer = this->handle->GetBool("SelectElementIdBuffer", false);
+        funcs["SelectElementIdBuffer"] = &ViewParamsP::updateSelectElementIdBuffer;
+        SelectElementVisibleOnly = this->handle->GetBool("SelectElementVisibleOnly", false);
+        funcs["SelectElementVisibleOnly"] = &ViewParamsP::updateSelectElementVisibleOnly;
         TransparencyOnTop = this->handle->GetFloat("TransparencyOnTop", 0.5);
         funcs["TransparencyOnTop"] = &ViewParamsP::updateTransparencyOnTop;
         HiddenLineSync = this->handle->GetInt("HiddenLineSync", 1);
@@ -544,6 +555,16 @@ public:
         funcs["RenderHighlightPolygonOffsetFactor"] = &ViewParamsP::updateRenderHighlightPolygonOffsetFactor;
         RenderHighlightPolygonOffsetUnits = this->handle->GetFloat("RenderHighlightPolygonOffsetUnits", 1);
         funcs["RenderHighlightPolygonOffsetUnits"] = &ViewParamsP::updateRenderHighlightPolygonOffsetUnits;
+        RenderCacheCulling = this->handle->GetBool("RenderCacheCulling", true);
+        funcs["RenderCacheCulling"] = &ViewParamsP::updateRenderCacheCulling;
+        RenderCacheCullingPixelSize = this->handle->GetFloat("RenderCacheCullingPixelSize", 0.0);
+        funcs["RenderCacheCullingPixelSize"] = &ViewParamsP::updateRenderCacheCullingPixelSize;
+        RenderCacheInstancing = this->handle->GetBool("RenderCacheInstancing", true);
+        funcs["RenderCacheInstancing"] = &ViewParamsP::updateRenderCacheInstancing;
+        RenderCacheLodPixelSize = this->handle->GetFloat("RenderCacheLodPixelSize", 2.0);
+        funcs["RenderCacheLodPixelSize"] = &ViewParamsP::updateRenderCacheLodPixelSize;
+        RenderCacheLodMinTriangles = this->handle->GetInt("RenderCacheLodMinTriangles", 20000);
+        funcs["RenderCacheLodMinTriangles"] = &ViewParamsP::updateRenderCacheLodMinTriangles;
         ForceSolidSingleSideLighting = this->handle->GetBool("ForceSolidSingleSideLighting", true);
         funcs["ForceSolidSingleSideLighting"] = &ViewParamsP::updateForceSolidSingleSideLighting;
         DefaultFontSize = this->handle->GetInt("DefaultFontSize", 0);
@@ -729,6 +750,14 @@ public:
         self->SelectElementOnTop = self->handle->GetBool("SelectElementOnTop", false);
     }
     // Auto generated code (Tools/params_utils.py:310)
+    static void updateSelectElementIdBuffer(ViewParamsP *self) {
+        self->SelectElementIdBuffer = self->handle->GetBool("SelectElementIdBuffer", false);
+    }
+    // Auto generated code (Tools/params_utils.py:310)
+    static void updateSelectElementVisibleOnly(ViewParamsP *self) {
+        self->SelectElementVisibleOnly = self->handle->GetBool("SelectElementVisibleOnly", false);
+    }
+    // Auto generated code (Tools/params_utils.py:310)
     static void updateTransparencyOnTop(ViewParamsP *self) {
         self->TransparencyOnTop = self->handle->GetFloat("TransparencyOnTop", 0.5);
     }
@@ -1232,6 +1261,26 @@ public:
     static void updateRenderHighlightPolygonOffsetUnits(ViewParamsP *self) {
         self->RenderHighlightPolygonOffsetUnits = self->handle->GetFloat("RenderHighlightPolygonOffsetUnits", 1);
     }
+    // Auto generated code (Tools/params_utils.py:310)
+    static void updateRenderCacheCulling(ViewParamsP *self) {
+        self->RenderCacheCulling = self->handle->GetBool("RenderCacheCulling", true);
+    }
+    // Auto generated code (Tools/params_utils.py:310)
+    static void updateRenderCacheCullingPixelSize(ViewParamsP *self) {
+        self->RenderCacheCullingPixelSize = self->handle->GetFloat("RenderCacheCullingPixelSize", 0.0);
+    }
+    // Auto generated code (Tools/params_utils.py:310)
+    static void updateRenderCacheInstancing(ViewParamsP *self) {
+        self->RenderCacheInstancing = self->handle->GetBool("RenderCacheInstancing", true);
+    }
+    // Auto generated code (Tools/params_utils.py:310)
+    static void updateRenderCacheLodPixelSize(ViewParamsP *self) {
+        self->RenderCacheLodPixelSize = self->handle->GetFloat("RenderCacheLodPixelSize", 2.0);
+    }
+    // Auto generated code (Tools/params_utils.py:310)
+    static void updateRenderCacheLodMinTriangles(ViewParamsP *self) {
+        self->RenderCacheLodMinTriangles = self->handle->GetInt("RenderCacheLodMinTriangles", 20000);
+    }
     // Auto generated code (Tools/params_utils.py:318)
     static void updateForceSolidSingleSideLighting(ViewParamsP *self) {
         auto v = self->handle->GetBool("ForceSolidSingleSideLighting", true);
@@ -2209,6 +2258,66 @@ void ViewParams::removeSelectElementOnTop() {
     instance()->handle->RemoveBool("SelectElementOnTop");
 }
 
+// Auto generated code (Tools/params_utils.py:372)
+const char *ViewParams::docSelectElementIdBuffer() {
+    return QT_TRANSLATE_NOOP("ViewParams",
+"Do box/lasso element selection by rasterizing the elements into an ID buffer of the\n"
+"selected screen region instead of intersecting each element with the selection polygon.\n"
+"Only used when selecting the elements touched by the polygon, e.g. when dragging the\n"
+"box from right to left.");
+}
+
+// Auto generated code (Tools/params_utils.py:380)
+const bool & ViewParams::getSelectElementIdBuffer() {
+    return instance()->SelectElementIdBuffer;
+}
+
+// Auto generated code (Tools/params_utils.py:388)
+const bool & ViewParams::defaultSelectElementIdBuffer() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:397)
+void ViewParams::setSelectElementIdBuffer(const bool &v) {
+    instance()->handle->SetBool("SelectElementIdBuffer",v);
+    instance()->SelectElementIdBuffer = v;
+}
+
+// Auto generated code (Tools/params_utils.py:406)
+void ViewParams::removeSelectElementIdBuffer() {
+    instance()->handle->RemoveBool("SelectElementIdBuffer");
+}
+
+// Auto generated code (Tools/params_utils.py:372)
+const char *ViewParams::docSelectElementVisibleOnly() {
+    return QT_TRANSLATE_NOOP("ViewParams",
+"Only select elements by box/lasso that are not hidden behind other geometry.\n"
+"Requires 'SelectElementIdBuffer'.");
+}
+
+// Auto generated code (Tools/params_utils.py:380)
+const bool & ViewParams::getSelectElementVisibleOnly() {
+    return instance()->SelectElementVisibleOnly;
+}
+
+// Auto generated code (Tools/params_utils.py:388)
+const bool & ViewParams::defaultSelectElementVisibleOnly() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:397)
+void ViewParams::setSelectElementVisibleOnly(const bool &v) {
+    instance()->handle->SetBool("SelectElementVisibleOnly",v);
+    instance()->SelectElementVisibleOnly = v;
+}
+
+// Auto generated code (Tools/params_utils.py:406)
+void ViewParams::removeSelectElementVisibleOnly() {
+    instance()->handle->RemoveBool("SelectElementVisibleOnly");
+}
+
 // Auto generated code (Tools/params_utils.py:372)
 const char *ViewParams::docTransparencyOnTop() {
     return QT_TRANSLATE_NOOP("ViewParams",
@@ -5649,6 +5758,151 @@ void ViewParams::removeRenderHighlightPolygonOffsetUnits() {
     instance()->handle->RemoveFloat("RenderHighlightPolygonOffsetUnits");
 }
 
+// Auto generated code (Tools/params_utils.py:372)
+const char *ViewParams::docRenderCacheCulling() {
+    return QT_TRANSLATE_NOOP("ViewParams",
+"Skip drawing objects outside of the view frustum. Only effective when\n"
+"using experimental render cache.");
+}
+
+// Auto generated code (Tools/params_utils.py:380)
+const bool & ViewParams::getRenderCacheCulling() {
+    return instance()->RenderCacheCulling;
+}
+
+// Auto generated code (Tools/params_utils.py:388)
+const bool & ViewParams::defaultRenderCacheCulling() {
+    const static bool def = true;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:397)
+void ViewParams::setRenderCacheCulling(const bool &v) {
+    instance()->handle->SetBool("RenderCacheCulling",v);
+    instance()->RenderCacheCulling = v;
+}
+
+// Auto generated code (Tools/params_utils.py:406)
+void ViewParams::removeRenderCacheCulling() {
+    instance()->handle->RemoveBool("RenderCacheCulling");
+}
+
+// Auto generated code (Tools/params_utils.py:372)
+const char *ViewParams::docRenderCacheCullingPixelSize() {
+    return QT_TRANSLATE_NOOP("ViewParams",
+"Skip drawing objects whose projected size on screen is smaller than\n"
+"this number of pixels. Set zero to disable.");
+}
+
+// Auto generated code (Tools/params_utils.py:380)
+const double & ViewParams::getRenderCacheCullingPixelSize() {
+    return instance()->RenderCacheCullingPixelSize;
+}
+
+// Auto generated code (Tools/params_utils.py:388)
+const double & ViewParams::defaultRenderCacheCullingPixelSize() {
+    const static double def = 0.0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:397)
+void ViewParams::setRenderCacheCullingPixelSize(const double &v) {
+    instance()->handle->SetFloat("RenderCacheCullingPixelSize",v);
+    instance()->RenderCacheCullingPixelSize = v;
+}
+
+// Auto generated code (Tools/params_utils.py:406)
+void ViewParams::removeRenderCacheCullingPixelSize() {
+    instance()->handle->RemoveFloat("RenderCacheCullingPixelSize");
+}
+
+// Auto generated code (Tools/params_utils.py:372)
+const char *ViewParams::docRenderCacheInstancing() {
+    return QT_TRANSLATE_NOOP("ViewParams",
+"Draw objects sharing the same geometry and material, e.g. link array\n"
+"elements, as one batch that only changes the transformation in between.");
+}
+
+// Auto generated code (Tools/params_utils.py:380)
+const bool & ViewParams::getRenderCacheInstancing() {
+    return instance()->RenderCacheInstancing;
+}
+
+// Auto generated code (Tools/params_utils.py:388)
+const bool & ViewParams::defaultRenderCacheInstancing() {
+    const static bool def = true;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:397)
+void ViewParams::setRenderCacheInstancing(const bool &v) {
+    instance()->handle->SetBool("RenderCacheInstancing",v);
+    instance()->RenderCacheInstancing = v;
+}
+
+// Auto generated code (Tools/params_utils.py:406)
+void ViewParams::removeRenderCacheInstancing() {
+    instance()->handle->RemoveBool("RenderCacheInstancing");
+}
+
+// Auto generated code (Tools/params_utils.py:372)
+const char *ViewParams::docRenderCacheLodPixelSize() {
+    return QT_TRANSLATE_NOOP("ViewParams",
+"Draw large meshes with a simplified level of detail if the grid cell used for\n"
+"simplification covers no more than this number of pixels on screen. Set zero\n"
+"to disable.");
+}
+
+// Auto generated code (Tools/params_utils.py:380)
+const double & ViewParams::getRenderCacheLodPixelSize() {
+    return instance()->RenderCacheLodPixelSize;
+}
+
+// Auto generated code (Tools/params_utils.py:388)
+const double & ViewParams::defaultRenderCacheLodPixelSize() {
+    const static double def = 2.0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:397)
+void ViewParams::setRenderCacheLodPixelSize(const double &v) {
+    instance()->handle->SetFloat("RenderCacheLodPixelSize",v);
+    instance()->RenderCacheLodPixelSize = v;
+}
+
+// Auto generated code (Tools/params_utils.py:406)
+void ViewParams::removeRenderCacheLodPixelSize() {
+    instance()->handle->RemoveFloat("RenderCacheLodPixelSize");
+}
+
+// Auto generated code (Tools/params_utils.py:372)
+const char *ViewParams::docRenderCacheLodMinTriangles() {
+    return QT_TRANSLATE_NOOP("ViewParams",
+"Minimum number of triangles of a mesh to create levels of detail for.");
+}
+
+// Auto generated code (Tools/params_utils.py:380)
+const long & ViewParams::getRenderCacheLodMinTriangles() {
+    return instance()->RenderCacheLodMinTriangles;
+}
+
+// Auto generated code (Tools/params_utils.py:388)
+const long & ViewParams::defaultRenderCacheLodMinTriangles() {
+    const static long def = 20000;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:397)
+void ViewParams::setRenderCacheLodMinTriangles(const long &v) {
+    instance()->handle->SetInt("RenderCacheLodMinTriangles",v);
+    instance()->RenderCacheLodMinTriangles = v;
+}
+
+// Auto generated code (Tools/params_utils.py:406)
+void ViewParams::removeRenderCacheLodMinTriangles() {
+    instance()->handle->RemoveInt("RenderCacheLodMinTriangles");
+}
+
 // Auto generated code (Tools/params_utils.py:372)
 const char *ViewParams::docForceSolidSingleSideLighting() {
     return QT_TRANSLATE_NOOP("ViewParams",
@@ -5981,7 +6235,7 @@ void ViewParams::removeToolTipDisable() {
     instance()->handle->RemoveBool("ToolTipDisable");
 }
 
-// Auto generated code (Gui/ViewParams.py:483)
+// Auto generated code (Gui/ViewParams.py:506)
 const std::vector<QString> ViewParams::AnimationCurveTypes = {
     QStringLiteral("Linear"),
     QStringLiteral("InQuad"),
@@ -6026,7 +6280,7 @@ const std::vector<QString> ViewParams::AnimationCurveTypes = {
     QStringLiteral("OutInBounce"),
 };
 
-// Auto generated code (Gui/ViewParams.py:491)
+// Auto generated code (Gui/ViewParams.py:514)
 static const char *DrawStyleNames[] = {
     QT_TRANSLATE_NOOP("DrawStyle", "As Is"),
     QT_TRANSLATE_NOOP("DrawStyle", "Points"),
@@ -6040,7 +6294,7 @@ static const char *DrawStyleNames[] = {
     nullptr,
 };
 
-// Auto generated code (Gui/ViewParams.py:501)
+// Auto generated code (Gui/ViewParams.py:524)
 static const char *DrawStyleDocs[] = {
     QT_TRANSLATE_NOOP("DrawStyle", "Draw style, normal display mode"),
     QT_TRANSLATE_NOOP("DrawStyle", "Draw style, show points only"),
@@ -6054,13 +6308,13 @@ static const char *DrawStyleDocs[] = {
 };
 
 namespace Gui {
-// Auto generated code (Gui/ViewParams.py:511)
+// Auto generated code (Gui/ViewParams.py:534)
 const char **drawStyleNames()
 {
     return DrawStyleNames;
 }
 
-// Auto generated code (Gui/ViewParams.py:518)
+// Auto generated code (Gui/ViewParams.py:541)
 const char *drawStyleNameFromIndex(int i)
 {
     if (i < 0 || i>= 9)
@@ -6068,7 +6322,7 @@ const char *drawStyleNameFromIndex(int i)
     return DrawStyleNames[i];
 }
 
-// Auto generated code (Gui/ViewParams.py:527)
+// Auto generated code (Gui/ViewParams.py:550)
 int drawStyleIndexFromName(const char *name)
 {
     if (!name)
@@ -6080,7 +6334,7 @@ int drawStyleIndexFromName(const char *name)
     return -1;
 }
 
-// Auto generated code (Gui/ViewParams.py:540)
+// Auto generated code (Gui/ViewParams.py:563)
 const char *drawStyleDocumentation(int i)
 {
     if (i < 0 || i>= 9)
@@ -34,7 +34,7 @@ import ViewParams
 ViewParams.declare_begin()
 ]]]*/
 
-// Auto generated code (Gui/ViewParams.py:451)
+// Auto generated code (Gui/ViewParams.py:474)
 #include <QString>
 
 // Auto generated code (Tools/params_utils.py:82)
@@ -431,6 +431,34 @@ public:
     static const char *docSelectElementOnTop();
     //@}
 
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter SelectElementIdBuffer
+    ///
+    /// Do box/lasso element selection by rasterizing the elements into an ID buffer of the
+    /// selected screen region instead of intersecting each element with the selection polygon.
+    /// Only used when selecting the elements touched by the polygon, e.g. when dragging the
+    /// box from right to left.
+    static const bool & getSelectElementIdBuffer();
+    static const bool & defaultSelectElementIdBuffer();
+    static void removeSelectElementIdBuffer();
+    static void setSelectElementIdBuffer(const bool &v);
+    static const char *docSelectElementIdBuffer();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter SelectElementVisibleOnly
+    ///
+    /// Only select elements by box/lasso that are not hidden behind other geometry.
+    /// Requires 'SelectElementIdBuffer'.
+    static const bool & getSelectElementVisibleOnly();
+    static const bool & defaultSelectElementVisibleOnly();
+    static void removeSelectElementVisibleOnly();
+    static void setSelectElementVisibleOnly(const bool &v);
+    static const char *docSelectElementVisibleOnly();
+    //@}
+
     // Auto generated code (Tools/params_utils.py:139)
     //@{
     /// Accessor for parameter TransparencyOnTop
@@ -1871,6 +1899,71 @@ public:
     static const char *docRenderHighlightPolygonOffsetUnits();
     //@}
 
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter RenderCacheCulling
+    ///
+    /// Skip drawing objects outside of the view frustum. Only effective when
+    /// using experimental render cache.
+    static const bool & getRenderCacheCulling();
+    static const bool & defaultRenderCacheCulling();
+    static void removeRenderCacheCulling();
+    static void setRenderCacheCulling(const bool &v);
+    static const char *docRenderCacheCulling();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter RenderCacheCullingPixelSize
+    ///
+    /// Skip drawing objects whose projected size on screen is smaller than
+    /// this number of pixels. Set zero to disable.
+    static const double & getRenderCacheCullingPixelSize();
+    static const double & defaultRenderCacheCullingPixelSize();
+    static void removeRenderCacheCullingPixelSize();
+    static void setRenderCacheCullingPixelSize(const double &v);
+    static const char *docRenderCacheCullingPixelSize();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter RenderCacheInstancing
+    ///
+    /// Draw objects sharing the same geometry and material, e.g. link array
+    /// elements, as one batch that only changes the transformation in between.
+    static const bool & getRenderCacheInstancing();
+    static const bool & defaultRenderCacheInstancing();
+    static void removeRenderCacheInstancing();
+    static void setRenderCacheInstancing(const bool &v);
+    static const char *docRenderCacheInstancing();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter RenderCacheLodPixelSize
+    ///
+    /// Draw large meshes with a simplified level of detail if the grid cell used for
+    /// simplification covers no more than this number of pixels on screen. Set zero
+    /// to disable.
+    static const double & getRenderCacheLodPixelSize();
+    static const double & defaultRenderCacheLodPixelSize();
+    static void removeRenderCacheLodPixelSize();
+    static void setRenderCacheLodPixelSize(const double &v);
+    static const char *docRenderCacheLodPixelSize();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter RenderCacheLodMinTriangles
+    ///
+    /// Minimum number of triangles of a mesh to create levels of detail for.
+    static const long & getRenderCacheLodMinTriangles();
+    static const long & defaultRenderCacheLodMinTriangles();
+    static void removeRenderCacheLodMinTriangles();
+    static void setRenderCacheLodMinTriangles(const long &v);
+    static const char *docRenderCacheLodMinTriangles();
+    //@}
+
     // Auto generated code (Tools/params_utils.py:139)
     //@{
     /// Accessor for parameter ForceSolidSingleSideLighting
@@ -2007,7 +2100,7 @@ public:
     static const char *docToolTipDisable();
     //@}
 
-    // Auto generated code (Gui/ViewParams.py:457)
+    // Auto generated code (Gui/ViewParams.py:480)
     static const std::vector<QString> AnimationCurveTypes;
 
     static void onViewParamChanged(const char *sReason);
@@ -2035,7 +2128,7 @@ ViewParams.declare_end()
 }; // class ViewParams
 } // namespace Gui
 
-// Auto generated code (Gui/ViewParams.py:467)
+// Auto generated code (Gui/ViewParams.py:490)
 namespace Gui {
 /// Obtain all draw style names, terminated by nullptr entry.
 GuiExport const char **drawStyleNames();
@@ -179,6 +179,14 @@ Params = [
     ParamBool('AutoTransparentPick', False, "Make pre-selected object transparent for picking hidden lines"),
     ParamBool('SelectElementOnTop', False,
        "Do box/lasso element selection on already selected object(sg if SelectionOnTop is enabled."),
+    ParamBool('SelectElementIdBuffer', False,
+       "Do box/lasso element selection by rasterizing the elements into an ID buffer of the\n"
+       "selected screen region instead of intersecting each element with the selection polygon.\n"
+       "Only used when selecting the elements touched by the polygon, e.g. when dragging the\n"
+       "box from right to left."),
+    ParamBool('SelectElementVisibleOnly', False,
+       "Only select elements by box/lasso that are not hidden behind other geometry.\n"
+       "Requires 'SelectElementIdBuffer'."),
     ParamFloat('TransparencyOnTop', 0.5,
        title='Transparency',
        doc="Transparency for the selected object when being shown on top."),
@@ -423,6 +431,21 @@ Params = [
         "Minimum hierarchy depth that the cache merge can happen."),
     ParamFloat('RenderHighlightPolygonOffsetFactor', 1),
     ParamFloat('RenderHighlightPolygonOffsetUnits', 1),
+    ParamBool('RenderCacheCulling',  True,
+        "Skip drawing objects outside of the view frustum. Only effective when\n"
+        "using experimental render cache."),
+    ParamFloat('RenderCacheCullingPixelSize',  0.0,
+        "Skip drawing objects whose projected size on screen is smaller than\n"
+        "this number of pixels. Set zero to disable."),
+    ParamBool('RenderCacheInstancing',  True,
+        "Draw objects sharing the same geometry and material, e.g. link array\n"
+        "elements, as one batch that only changes the transformation in between."),
+    ParamFloat('RenderCacheLodPixelSize',  2.0,
+        "Draw large meshes with a simplified level of detail if the grid cell used for\n"
+        "simplification covers no more than this number of pixels on screen. Set zero\n"
+        "to disable."),
+    ParamInt('RenderCacheLodMinTriangles',  20000,
+        "Minimum number of triangles of a mesh to create levels of detail for."),
     ParamBool('ForceSolidSingleSideLighting',  True, on_change=True, title='Force single side lighting on solid',
         doc="Force single side lighting on solid. This can help visualizing invalid\n"
         "solid shapes with flipped normals."),
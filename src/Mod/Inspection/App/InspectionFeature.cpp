@@ -48,9 +48,9 @@
 #include <Mod/Mesh/App/Core/Algorithm.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Mesh/App/Core/KDTree.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Points/App/PointsFeature.h>
-#include <Mod/Points/App/PointsGrid.h>
 #include <Mod/Part/App/PartFeature.h>
 
 #include "InspectionFeature.h"
@@ -196,7 +196,8 @@ namespace Inspection {
             assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
         }
 
-        void AddFacet (const MeshCore::MeshGeomFacet &rclFacet, unsigned long ulFacetIndex)
+        void AddFacet (const MeshCore::MeshGeomFacet &rclFacet, unsigned long ulFacetIndex,
+                       MeshCore::GridCells::Entries &entries) const
         {
             unsigned long ulX, ulY, ulZ;
             unsigned long ulX1, ulY1, ulZ1, ulX2, ulY2, ulZ2;
@@ -215,19 +216,17 @@ namespace Inspection {
                     for (ulY = ulY1; ulY <= ulY2; ulY++) {
                         for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                             if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ)))
-                                _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                                entries.push_back({GetCellIndex(ulX, ulY, ulZ), ulFacetIndex});
                         }
                     }
                 }
             }
             else
-                _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+                entries.push_back({GetCellIndex(ulX1, ulY1, ulZ1), ulFacetIndex});
         }
 
         void InitGrid (void) override
         {
-            unsigned long i, j;
-
             Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(_transform);
 
             float fLengthX = clBBMesh.LengthX(); 
@@ -244,12 +243,7 @@ namespace Inspection {
             _fMinZ = clBBMesh.MinZ - 0.5f;
 
             _aulGrid.clear();
-            _aulGrid.resize(_ulCtGridsX);
-            for (i = 0; i < _ulCtGridsX; i++) {
-                _aulGrid[i].resize(_ulCtGridsY);
-                for (j = 0; j < _ulCtGridsY; j++)
-                    _aulGrid[i][j].resize(_ulCtGridsZ);
-            }
+            _aulGrid.resize(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ);
         }
 
         void RebuildGrid (void) override
@@ -258,11 +252,13 @@ namespace Inspection {
             InitGrid();
  
             unsigned long i = 0;
+            std::vector<MeshCore::GridCells::Entries> entries(1);
             MeshCore::MeshFacetIterator clFIter(*_pclMesh);
             clFIter.Transform(_transform);
             for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-                AddFacet(*clFIter, i++);
+                AddFacet(*clFIter, i++, entries.front());
             }
+            _aulGrid.assign(_aulGrid.size(), entries);
         }
 
     private:
@@ -270,6 +266,15 @@ namespace Inspection {
     };
 }
 
+void InspectNominalGeometry::getDistances(const std::vector<Base::Vector3f>& points, std::vector<float>& distances) const
+{
+    distances.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); i++)
+        distances[i] = getDistance(points[i]);
+}
+
+// ----------------------------------------------------------------
+
 InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset) : _mesh(rMesh.getKernel())
 {
     Base::Matrix4D tmp;
@@ -416,37 +421,37 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalPoints::InspectNominalPoints(const Points::PointKernel& Kernel, float /*offset*/)
-  : _rKernel(Kernel)
+InspectNominalPoints::InspectNominalPoints(const Points::PointKernel& Kernel, float offset)
+  : _radius(offset)
 {
-    int uGridPerAxis = 50; // totally 125.000 grid elements 
-    this->_pGrid = new Points::PointsGrid (Kernel, uGridPerAxis);
+    std::vector<Base::Vector3f> points;
+    points.reserve(Kernel.size());
+    for (Points::PointKernel::const_point_iterator it = Kernel.begin(); it != Kernel.end(); ++it) {
+        const Base::Vector3d& p = *it;
+        points.emplace_back(float(p.x), float(p.y), float(p.z));
+    }
+    this->_pTree = new MeshCore::MeshKDTree(points);
+    this->_pTree->Optimize();
 }
 
 InspectNominalPoints::~InspectNominalPoints()
 {
-    delete this->_pGrid;
+    delete this->_pTree;
 }
 
 float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 {
-    //TODO: Make faster
-    std::set<unsigned long> indices;
-    unsigned long x,y,z;
-    Base::Vector3d pointd(point.x,point.y,point.z);
-    _pGrid->Position(pointd, x, y, z);
-    _pGrid->GetElements(x,y,z,indices);
-
-    double fMinDist=DBL_MAX;
-    for (std::set<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
-        Base::Vector3d pt = _rKernel.getPoint(*it);
-        double fDist = Base::Distance(pointd, pt);
-        if (fDist < fMinDist) {
-            fMinDist = fDist;
-        }
-    }
+    Base::Vector3f nearest;
+    float fMinDist;
+    if (_pTree->FindNearest(point, _radius, nearest, fMinDist) == MeshCore::POINT_INDEX_MAX)
+        return FLT_MAX;
+    return fMinDist;
+}
 
-    return (float)fMinDist;
+void InspectNominalPoints::getDistances(const std::vector<Base::Vector3f>& points, std::vector<float>& distances) const
+{
+    std::vector<MeshCore::PointIndex> indices;
+    _pTree->FindNearest(points, _radius, indices, distances);
 }
 
 // ----------------------------------------------------------------
@@ -728,44 +733,61 @@ App::DocumentObjectExecReturn* Feature::execute(void)
 #else
     unsigned long count = actual->countPoints();
     std::vector<float> vals(count);
-    std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index)
+    float radius = this->SearchRadius.getValue();
+
+    // The points are inspected in blocks, so that each nominal geometry can handle the
+    // queries of a block at once and the per-call overhead is paid once per block
+    const unsigned long blockSize = 4096;
+    unsigned long countBlocks = (count + blockSize - 1) / blockSize;
+    std::function<DistanceInspectionRMS(unsigned long)> fMap = [&](unsigned long block)
     {
         DistanceInspectionRMS res;
-        Base::Vector3f pnt = actual->getPoint(index);
-
-        float fMinDist = FLT_MAX;
+        unsigned long first = block * blockSize;
+        unsigned long last = std::min(first + blockSize, count);
+        std::vector<Base::Vector3f> points;
+        points.reserve(last - first);
+        for (unsigned long index = first; index < last; index++)
+            points.push_back(actual->getPoint(index));
+
+        std::vector<float> minDist(points.size(), FLT_MAX);
+        std::vector<float> dist;
         for (std::vector<InspectNominalGeometry*>::iterator it = inspectNominal.begin(); it != inspectNominal.end(); ++it) {
-            float fDist = (*it)->getDistance(pnt);
-            if (fabs(fDist) < fabs(fMinDist))
-                fMinDist = fDist;
+            (*it)->getDistances(points, dist);
+            for (std::size_t i = 0; i < points.size(); i++) {
+                if (fabs(dist[i]) < fabs(minDist[i]))
+                    minDist[i] = dist[i];
+            }
         }
 
-        if (fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = FLT_MAX;
-        }
-        else if (-fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = -FLT_MAX;
-        }
-        else {
-            res.m_sumsq += fMinDist * fMinDist;
-            res.m_numv++;
-        }
+        for (std::size_t i = 0; i < points.size(); i++) {
+            float fMinDist = minDist[i];
+            if (fMinDist > radius) {
+                fMinDist = FLT_MAX;
+            }
+            else if (-fMinDist > radius) {
+                fMinDist = -FLT_MAX;
+            }
+            else {
+                res.m_sumsq += fMinDist * fMinDist;
+                res.m_numv++;
+            }
 
-        vals[index] = fMinDist;
+            vals[first + i] = fMinDist;
+        }
         return res;
     };
 
     DistanceInspectionRMS res;
 
     if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
+        // Build vector of increasing block indices
+        std::vector<unsigned long> index(countBlocks);
         std::iota(index.begin(), index.end(), 0);
         // Perform map-reduce operation : compute distances and update sum of squares for RMS computation
         QFuture<DistanceInspectionRMS> future = QtConcurrent::mappedReduced(
             index, fMap, &DistanceInspectionRMS::operator+=);
         // Setup progress bar
-        Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
+        Base::FutureWatcherProgress progress("Inspecting...", countBlocks);
         QFutureWatcher<DistanceInspectionRMS> watcher;
         QObject::connect(&watcher, &QFutureWatcher<DistanceInspectionRMS>::progressValueChanged,
                          &progress, &Base::FutureWatcherProgress::progressValueChanged);
@@ -781,10 +803,12 @@ App::DocumentObjectExecReturn* Feature::execute(void)
         // Single-threaded operation
         std::stringstream str;
         str << "Inspecting " << this->Label.getValue() << "...";
-        Base::SequencerLauncher seq(str.str().c_str(), count);
+        Base::SequencerLauncher seq(str.str().c_str(), countBlocks);
 
-        for (unsigned int i = 0; i < count; i++)
+        for (unsigned long i = 0; i < countBlocks; i++) {
             res += fMap(i);
+            seq.next();
+        }
     }
 
     Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
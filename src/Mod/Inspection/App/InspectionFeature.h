@@ -37,10 +37,10 @@ class gp_Pnt;
 namespace MeshCore {
 class MeshKernel;
 class MeshGrid;
+class MeshKDTree;
 }
 
 namespace Mesh   { class MeshObject; }
-namespace Points { class PointsGrid; }
 namespace Part   { class TopoShape;  }
 
 namespace Inspection
@@ -104,6 +104,8 @@ public:
     InspectNominalGeometry() {}
     virtual ~InspectNominalGeometry() {}
     virtual float getDistance(const Base::Vector3f&) const = 0;
+    /// Calculates the distances of a batch of points, by default getDistance() is called for each of them
+    virtual void getDistances(const std::vector<Base::Vector3f>&, std::vector<float>&) const;
 };
 
 class InspectionExport InspectNominalMesh : public InspectNominalGeometry
@@ -143,10 +145,11 @@ public:
     InspectNominalPoints(const Points::PointKernel&, float offset);
     ~InspectNominalPoints() override;
     float getDistance(const Base::Vector3f&) const override;
+    void getDistances(const std::vector<Base::Vector3f>&, std::vector<float>&) const override;
 
 private:
-    const Points::PointKernel& _rKernel;
-    Points::PointsGrid* _pGrid;
+    MeshCore::MeshKDTree* _pTree;
+    float _radius;
 };
 
 class InspectionExport InspectNominalShape : public InspectNominalGeometry
@@ -27,6 +27,7 @@
 #endif
 
 #include <Base/Console.h>
+#include <Base/Functional.h>
 #include <Base/Sequencer.h>
 
 #include "Algorithm.h"
@@ -631,8 +632,8 @@ bool MeshAlgorithm::FillupHole(const std::vector<PointIndex>& boundary,
     PointIndex refPoint0 = *(boundary.begin());
     PointIndex refPoint1 = *(boundary.begin()+1);
     if (pP2FStructure) {
-        const std::set<FacetIndex>& ring1 = (*pP2FStructure)[refPoint0];
-        const std::set<FacetIndex>& ring2 = (*pP2FStructure)[refPoint1];
+        MeshRefIndices::Range ring1 = (*pP2FStructure)[refPoint0];
+        MeshRefIndices::Range ring2 = (*pP2FStructure)[refPoint1];
         std::vector<FacetIndex> f_int;
         std::set_intersection(ring1.begin(), ring1.end(), ring2.begin(), ring2.end(),
             std::back_insert_iterator<std::vector<FacetIndex> >(f_int));
@@ -1686,28 +1687,146 @@ float MeshAlgorithm::CalculateMinimumGridLength(float fLength, const Base::Bound
 
 // ----------------------------------------------------
 
+namespace {
+/* Converts the counts of each list, stored at the position of the following list, into
+ * the start offsets of the lists. Returns the total number of indices.
+ */
+ElementIndex AccumulateOffsets(std::vector<ElementIndex>& offsets)
+{
+    for (std::size_t i = 1; i < offsets.size(); i++)
+        offsets[i] += offsets[i - 1];
+    return offsets.back();
+}
+
+/* Restores the start offsets after they have been used as insert positions, where each
+ * of them was moved to the start of the next list.
+ */
+void RestoreOffsets(std::vector<ElementIndex>& offsets)
+{
+    std::copy_backward(offsets.begin(), offsets.end() - 1, offsets.end());
+    offsets[0] = 0;
+}
+
+/* Sorts each list and removes duplicates in parallel. Afterwards the lists are moved
+ * together.
+ */
+void SortUniqueLists(std::vector<ElementIndex>& offsets, std::vector<ElementIndex>& indices)
+{
+    ElementIndex ctLists = offsets.size() - 1;
+    std::vector<ElementIndex> sizes(offsets.size(), 0);
+    Base::forEachChunk(ctLists, [&](std::size_t, ElementIndex begin, ElementIndex end) {
+        for (ElementIndex i = begin; i < end; i++) {
+            auto first = indices.begin() + offsets[i];
+            auto last = indices.begin() + offsets[i + 1];
+            std::sort(first, last);
+            sizes[i + 1] = static_cast<ElementIndex>(std::unique(first, last) - first);
+        }
+    });
+
+    ElementIndex ctIndices = AccumulateOffsets(sizes);
+    std::vector<ElementIndex> unique(ctIndices);
+    Base::forEachChunk(ctLists, [&](std::size_t, ElementIndex begin, ElementIndex end) {
+        for (ElementIndex i = begin; i < end; i++) {
+            auto first = indices.begin() + offsets[i];
+            std::copy(first, first + (sizes[i + 1] - sizes[i]), unique.begin() + sizes[i]);
+        }
+    });
+
+    offsets.swap(sizes);
+    indices.swap(unique);
+}
+}
+
+void MeshRefIndices::Clear()
+{
+    std::vector<ElementIndex>().swap(_offsets);
+    std::vector<ElementIndex>().swap(_indices);
+    _modified.clear();
+}
+
+void MeshRefIndices::Assign(std::vector<ElementIndex>&& offsets, std::vector<ElementIndex>&& indices)
+{
+    _offsets = std::move(offsets);
+    _indices = std::move(indices);
+    _modified.clear();
+}
+
+std::size_t MeshRefIndices::GetMemoryUsage() const
+{
+    std::size_t size = (_offsets.capacity() + _indices.capacity()) * sizeof(ElementIndex);
+    for (const auto& it : _modified)
+        size += sizeof(it) + it.second.capacity() * sizeof(ElementIndex);
+    return size;
+}
+
+std::vector<ElementIndex>& MeshRefIndices::GetModifiable(ElementIndex pos)
+{
+    std::unordered_map<ElementIndex, std::vector<ElementIndex> >::iterator it = _modified.find(pos);
+    if (it == _modified.end()) {
+        Range list = (*this)[pos];
+        it = _modified.emplace(pos, std::vector<ElementIndex>(list.begin(), list.end())).first;
+    }
+    return it->second;
+}
+
+void MeshRefIndices::Insert(ElementIndex pos, ElementIndex index)
+{
+    if ((*this)[pos].count(index) > 0)
+        return;
+    std::vector<ElementIndex>& list = GetModifiable(pos);
+    list.insert(std::lower_bound(list.begin(), list.end(), index), index);
+}
+
+void MeshRefIndices::Erase(ElementIndex pos, ElementIndex index)
+{
+    if ((*this)[pos].count(index) == 0)
+        return;
+    std::vector<ElementIndex>& list = GetModifiable(pos);
+    list.erase(std::lower_bound(list.begin(), list.end(), index));
+}
+
+// ----------------------------------------------------
+
 void MeshRefPointToFacets::Rebuild ()
 {
-    _map.clear();
+    _map.Clear();
 
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rPoints.size());
 
-    MeshFacetArray::_TConstIterator pFBegin = rFacets.begin();
+    // count the facets of each point, a degenerated facet counts only once
+    std::vector<ElementIndex> offsets(rPoints.size() + 1, 0);
     for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        _map[pFIter->_aulPoints[0]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[1]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[2]].insert(pFIter - pFBegin);
+        const PointIndex* p = pFIter->_aulPoints;
+        ++offsets[p[0] + 1];
+        if (p[1] != p[0])
+            ++offsets[p[1] + 1];
+        if (p[2] != p[0] && p[2] != p[1])
+            ++offsets[p[2] + 1];
     }
+
+    // inserting the facets in ascending order keeps each list sorted
+    std::vector<ElementIndex> indices(AccumulateOffsets(offsets));
+    FacetIndex index = 0;
+    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter, ++index) {
+        const PointIndex* p = pFIter->_aulPoints;
+        indices[offsets[p[0]]++] = index;
+        if (p[1] != p[0])
+            indices[offsets[p[1]]++] = index;
+        if (p[2] != p[0] && p[2] != p[1])
+            indices[offsets[p[2]]++] = index;
+    }
+    RestoreOffsets(offsets);
+
+    _map.Assign(std::move(offsets), std::move(indices));
 }
 
 Base::Vector3f MeshRefPointToFacets::GetNormal(PointIndex pos) const
 {
-    const std::set<FacetIndex>& n = _map[pos];
+    MeshRefIndices::Range n = _map[pos];
     Base::Vector3f normal;
     MeshGeomFacet f;
-    for (std::set<FacetIndex>::const_iterator it = n.begin(); it != n.end(); ++it) {
+    for (MeshRefIndices::Range::const_iterator it = n.begin(); it != n.end(); ++it) {
         f = _rclMesh.GetFacet(*it);
         normal += f.Area() * f.GetNormal();
     }
@@ -1725,8 +1844,8 @@ std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(const std::vector<Poi
     for (int i=0; i < level; i++) {
         std::set<PointIndex> cur;
         for (std::set<PointIndex>::iterator it = lp.begin(); it != lp.end(); ++it) {
-            const std::set<FacetIndex>& ft = (*this)[*it];
-            for (std::set<FacetIndex>::const_iterator jt = ft.begin(); jt != ft.end(); ++jt) {
+            MeshRefIndices::Range ft = (*this)[*it];
+            for (MeshRefIndices::Range::const_iterator jt = ft.begin(); jt != ft.end(); ++jt) {
                 for (int j = 0; j < 3; j++) {
                     PointIndex index = f_it[*jt]._aulPoints[j];
                     if (cp.find(index) == cp.end() && nb.find(index) == nb.end()) {
@@ -1747,8 +1866,8 @@ std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(const std::vector<Poi
 std::set<PointIndex> MeshRefPointToFacets::NeighbourPoints(PointIndex pos) const
 {
     std::set<PointIndex> p;
-    const std::set<FacetIndex>& vf = _map[pos];
-    for (std::set<FacetIndex>::const_iterator it = vf.begin(); it != vf.end(); ++it) {
+    MeshRefIndices::Range vf = _map[pos];
+    for (MeshRefIndices::Range::const_iterator it = vf.begin(); it != vf.end(); ++it) {
         PointIndex p1, p2, p3;
         _rclMesh.GetFacetPoints(*it, p1, p2, p3);
         if (p1 != pos)
@@ -1784,9 +1903,9 @@ void MeshRefPointToFacets::SearchNeighbours(const MeshFacetArray& rFacets, Facet
     visited.insert(index);
     collect.Append(_rclMesh, index);
     for (int i = 0; i < 3; i++) {
-        const std::set<FacetIndex> &f = (*this)[face._aulPoints[i]];
+        MeshRefIndices::Range f = (*this)[face._aulPoints[i]];
 
-        for (std::set<FacetIndex>::const_iterator j = f.begin(); j != f.end(); ++j) {
+        for (MeshRefIndices::Range::const_iterator j = f.begin(); j != f.end(); ++j) {
             SearchNeighbours(rFacets, *j, rclCenter, fMaxDist2, visited, collect);
         }
     }
@@ -1798,7 +1917,7 @@ MeshRefPointToFacets::GetFacet (FacetIndex index) const
     return _rclMesh.GetFacets().begin() + index;
 }
 
-const std::set<FacetIndex>&
+MeshRefIndices::Range
 MeshRefPointToFacets::operator[] (PointIndex pos) const
 {
     return _map[pos];
@@ -1809,8 +1928,8 @@ MeshRefPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2) const
 {
     std::vector<FacetIndex> intersection;
     std::back_insert_iterator<std::vector<FacetIndex> > result(intersection);
-    const std::set<FacetIndex>& set1 = _map[pos1];
-    const std::set<FacetIndex>& set2 = _map[pos2];
+    MeshRefIndices::Range set1 = _map[pos1];
+    MeshRefIndices::Range set2 = _map[pos2];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
@@ -1821,19 +1940,19 @@ MeshRefPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2, PointIndex po
     std::vector<FacetIndex> intersection;
     std::back_insert_iterator<std::vector<FacetIndex> > result(intersection);
     std::vector<FacetIndex> set1 = GetIndices(pos1, pos2);
-    const std::set<FacetIndex>& set2 = _map[pos3];
+    MeshRefIndices::Range set2 = _map[pos3];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
 
 void MeshRefPointToFacets::AddNeighbour(PointIndex pos, FacetIndex facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToFacets::RemoveNeighbour(PointIndex pos, FacetIndex facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 void MeshRefPointToFacets::RemoveFacet(FacetIndex facetIndex)
@@ -1841,32 +1960,53 @@ void MeshRefPointToFacets::RemoveFacet(FacetIndex facetIndex)
     PointIndex p0, p1, p2;
     _rclMesh.GetFacetPoints(facetIndex, p0, p1, p2);
 
-    _map[p0].erase(facetIndex);
-    _map[p1].erase(facetIndex);
-    _map[p2].erase(facetIndex);
+    _map.Erase(p0, facetIndex);
+    _map.Erase(p1, facetIndex);
+    _map.Erase(p2, facetIndex);
 }
 
 //----------------------------------------------------------------------------
 
 void MeshRefFacetToFacets::Rebuild ()
 {
-    _map.clear();
+    _map.Clear();
 
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rFacets.size());
-
     MeshRefPointToFacets  vertexFace(_rclMesh);
-    MeshFacetArray::_TConstIterator pFBegin = rFacets.begin();
-    for (MeshFacetArray::_TConstIterator pFIter = pFBegin; pFIter != rFacets.end(); ++pFIter) {
-        for (int i = 0; i < 3; i++) {
-            const std::set<FacetIndex>& faces = vertexFace[pFIter->_aulPoints[i]];
-            for (std::set<FacetIndex>::const_iterator it = faces.begin(); it != faces.end(); ++it)
-                _map[pFIter - pFBegin].insert(*it);
+
+    // merges the facets of the three points of a facet, this is done twice to count the
+    // neighbours first and then to write them directly to their final position
+    auto mergeFacets = [&rFacets, &vertexFace](FacetIndex index, std::vector<ElementIndex>& faces, auto result) {
+        const PointIndex* p = rFacets[index]._aulPoints;
+        MeshRefIndices::Range f0 = vertexFace[p[0]];
+        MeshRefIndices::Range f1 = vertexFace[p[1]];
+        MeshRefIndices::Range f2 = vertexFace[p[2]];
+        faces.clear();
+        std::set_union(f0.begin(), f0.end(), f1.begin(), f1.end(), std::back_inserter(faces));
+        return std::set_union(faces.begin(), faces.end(), f2.begin(), f2.end(), result);
+    };
+
+    std::vector<ElementIndex> offsets(rFacets.size() + 1, 0);
+    Base::forEachChunk(rFacets.size(), [&](std::size_t, FacetIndex begin, FacetIndex end) {
+        std::vector<ElementIndex> faces, merged;
+        for (FacetIndex index = begin; index < end; index++) {
+            merged.clear();
+            mergeFacets(index, faces, std::back_inserter(merged));
+            offsets[index + 1] = merged.size();
         }
-    }
+    });
+
+    std::vector<ElementIndex> indices(AccumulateOffsets(offsets));
+    Base::forEachChunk(rFacets.size(), [&](std::size_t, FacetIndex begin, FacetIndex end) {
+        std::vector<ElementIndex> faces;
+        for (FacetIndex index = begin; index < end; index++)
+            mergeFacets(index, faces, indices.begin() + offsets[index]);
+    });
+
+    _map.Assign(std::move(offsets), std::move(indices));
 }
 
-const std::set<FacetIndex>&
+MeshRefIndices::Range
 MeshRefFacetToFacets::operator[] (FacetIndex pos) const
 {
     return _map[pos];
@@ -1877,8 +2017,8 @@ MeshRefFacetToFacets::GetIndices(FacetIndex pos1, FacetIndex pos2) const
 {
     std::vector<FacetIndex> intersection;
     std::back_insert_iterator<std::vector<FacetIndex> > result(intersection);
-    const std::set<FacetIndex>& set1 = _map[pos1];
-    const std::set<FacetIndex>& set2 = _map[pos2];
+    MeshRefIndices::Range set1 = _map[pos1];
+    MeshRefIndices::Range set2 = _map[pos2];
     std::set_intersection(set1.begin(), set1.end(), set2.begin(), set2.end(), result);
     return intersection;
 }
@@ -1887,24 +2027,36 @@ MeshRefFacetToFacets::GetIndices(FacetIndex pos1, FacetIndex pos2) const
 
 void MeshRefPointToPoints::Rebuild ()
 {
-    _map.clear();
+    _map.Clear();
 
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    _map.resize(rPoints.size());
-
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+
+    // each facet adds two neighbours to each of its points, an edge shared by two
+    // facets adds them twice which is cleaned up afterwards
+    std::vector<ElementIndex> offsets(rPoints.size() + 1, 0);
+    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
+        for (int i = 0; i < 3; i++)
+            offsets[pFIter->_aulPoints[i] + 1] += 2;
+    }
+
+    std::vector<ElementIndex> indices(AccumulateOffsets(offsets));
     for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
         PointIndex ulP0 = pFIter->_aulPoints[0];
         PointIndex ulP1 = pFIter->_aulPoints[1];
         PointIndex ulP2 = pFIter->_aulPoints[2];
 
-        _map[ulP0].insert(ulP1);
-        _map[ulP0].insert(ulP2);
-        _map[ulP1].insert(ulP0);
-        _map[ulP1].insert(ulP2);
-        _map[ulP2].insert(ulP0);
-        _map[ulP2].insert(ulP1);
+        indices[offsets[ulP0]++] = ulP1;
+        indices[offsets[ulP0]++] = ulP2;
+        indices[offsets[ulP1]++] = ulP0;
+        indices[offsets[ulP1]++] = ulP2;
+        indices[offsets[ulP2]++] = ulP0;
+        indices[offsets[ulP2]++] = ulP1;
     }
+    RestoreOffsets(offsets);
+    SortUniqueLists(offsets, indices);
+
+    _map.Assign(std::move(offsets), std::move(indices));
 }
 
 Base::Vector3f MeshRefPointToPoints::GetNormal(PointIndex pos) const
@@ -1913,8 +2065,8 @@ Base::Vector3f MeshRefPointToPoints::GetNormal(PointIndex pos) const
     MeshCore::PlaneFit pf;
     pf.AddPoint(rPoints[pos]);
     MeshCore::MeshPoint center = rPoints[pos];
-    const std::set<PointIndex>& cv = _map[pos];
-    for (std::set<PointIndex>::const_iterator cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
+    MeshRefIndices::Range cv = _map[pos];
+    for (MeshRefIndices::Range::const_iterator cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
         pf.AddPoint(rPoints[*cv_it]);
         center += rPoints[*cv_it];
     }
@@ -1930,15 +2082,15 @@ float MeshRefPointToPoints::GetAverageEdgeLength(PointIndex index) const
 {
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     float len=0.0f;
-    const std::set<PointIndex>& n = (*this)[index];
+    MeshRefIndices::Range n = (*this)[index];
     const Base::Vector3f& p = rPoints[index];
-    for (std::set<PointIndex>::const_iterator it = n.begin(); it != n.end(); ++it) {
+    for (MeshRefIndices::Range::const_iterator it = n.begin(); it != n.end(); ++it) {
         len += Base::Distance(p, rPoints[*it]);
     }
     return (len/n.size());
 }
 
-const std::set<PointIndex>&
+MeshRefIndices::Range
 MeshRefPointToPoints::operator[] (PointIndex pos) const
 {
     return _map[pos];
@@ -1946,12 +2098,12 @@ MeshRefPointToPoints::operator[] (PointIndex pos) const
 
 void MeshRefPointToPoints::AddNeighbour(PointIndex pos, PointIndex facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToPoints::RemoveNeighbour(PointIndex pos, PointIndex facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 //----------------------------------------------------------------------------
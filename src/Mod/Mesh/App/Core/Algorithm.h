@@ -23,8 +23,10 @@
 #ifndef MESHALGORITHM_H
 #define MESHALGORITHM_H
 
+#include <algorithm>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "Elements.h"
@@ -381,6 +383,82 @@ private:
     std::vector<FacetIndex>& indices;
 };
 
+/**
+ * The MeshRefIndices class stores for each point or facet of a mesh a sorted list of
+ * indices of neighbour elements. All lists are kept in one array ordered by element and
+ * an offset array holds the start of each list (compressed sparse row layout), which needs
+ * much less memory than a std::set per element.
+ * Lists changed with Insert() or Erase() are copied into a separate map, so that a few
+ * incremental updates don't require to rebuild the whole structure.
+ */
+class MeshExport MeshRefIndices
+{
+public:
+    /// The sorted indices of a single element
+    class Range
+    {
+    public:
+        using value_type = ElementIndex;
+        using const_iterator = const ElementIndex*;
+
+        Range(const ElementIndex* first, const ElementIndex* last)
+          : first(first), last(last)
+        { }
+        const_iterator begin() const
+        { return first; }
+        const_iterator end() const
+        { return last; }
+        std::size_t size() const
+        { return static_cast<std::size_t>(last - first); }
+        bool empty() const
+        { return first == last; }
+        /// Returns the position of \a index or end() if it's not in the list
+        const_iterator find(ElementIndex index) const
+        {
+            const_iterator it = std::lower_bound(first, last, index);
+            return (it != last && *it == index) ? it : last;
+        }
+        std::size_t count(ElementIndex index) const
+        { return find(index) != last ? 1 : 0; }
+
+    private:
+        const ElementIndex* first;
+        const ElementIndex* last;
+    };
+
+    /// Removes all lists and releases the memory
+    void Clear();
+    /// Takes over the lists given by \a offsets and \a indices, see class description.
+    void Assign(std::vector<ElementIndex>&& offsets, std::vector<ElementIndex>&& indices);
+    /// Returns the number of lists
+    std::size_t Size() const
+    { return _offsets.empty() ? 0 : _offsets.size() - 1; }
+    /// Returns the number of bytes allocated for the lists
+    std::size_t GetMemoryUsage() const;
+    Range operator[] (ElementIndex pos) const
+    {
+        if (!_modified.empty()) {
+            std::unordered_map<ElementIndex, std::vector<ElementIndex> >::const_iterator it = _modified.find(pos);
+            if (it != _modified.end())
+                return Range(it->second.data(), it->second.data() + it->second.size());
+        }
+        const ElementIndex* data = _indices.data();
+        return Range(data + _offsets[pos], data + _offsets[pos + 1]);
+    }
+    /// Adds \a index to the list of \a pos if it's not already there
+    void Insert(ElementIndex pos, ElementIndex index);
+    /// Removes \a index from the list of \a pos
+    void Erase(ElementIndex pos, ElementIndex index);
+
+private:
+    std::vector<ElementIndex>& GetModifiable(ElementIndex pos);
+
+private:
+    std::vector<ElementIndex> _offsets;
+    std::vector<ElementIndex> _indices;
+    std::unordered_map<ElementIndex, std::vector<ElementIndex> > _modified;
+};
+
 /**
  * The MeshRefPointToFacets builds up a structure to have access to all facets indexing
  * a point.
@@ -399,7 +477,7 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild ();
-    const std::set<FacetIndex>& operator[] (PointIndex) const;
+    MeshRefIndices::Range operator[] (PointIndex) const;
     std::vector<FacetIndex> GetIndices(PointIndex, PointIndex) const;
     std::vector<FacetIndex> GetIndices(PointIndex, PointIndex, PointIndex) const;
     MeshFacetArray::_TConstIterator GetFacet (FacetIndex) const;
@@ -417,7 +495,7 @@ protected:
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<FacetIndex> > _map;
+    MeshRefIndices _map;
 };
 
 /**
@@ -440,13 +518,13 @@ public:
 
     /// Returns a set of facets sharing one or more points with the facet with
     /// index \a ulFacetIndex.
-    const std::set<FacetIndex>& operator[] (FacetIndex) const;
+    MeshRefIndices::Range operator[] (FacetIndex) const;
     /// Returns an array of common facets of the passed facet indexes.
     std::vector<FacetIndex> GetIndices(FacetIndex, FacetIndex) const;
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<FacetIndex> > _map;
+    MeshRefIndices _map;
 };
 
 /**
@@ -467,7 +545,7 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild ();
-    const std::set<PointIndex>& operator[] (PointIndex) const;
+    MeshRefIndices::Range operator[] (PointIndex) const;
     Base::Vector3f GetNormal(PointIndex) const;
     float GetAverageEdgeLength(PointIndex) const;
     void AddNeighbour(PointIndex, PointIndex);
@@ -475,7 +553,7 @@ public:
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<PointIndex> > _map;
+    MeshRefIndices _map;
 };
 
 /**
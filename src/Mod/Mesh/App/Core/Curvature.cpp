@@ -30,6 +30,7 @@
 #include <QFutureWatcher>
 #include <QtConcurrentMap>
 
+#include <Base/Functional.h>
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 
@@ -162,8 +163,8 @@ void MeshCurvature::ComputePerVertex()
 
         int iV0 = i;
         int iV1;
-        const std::set<unsigned long>& nb = pt2p[i];
-        for (std::set<unsigned long>::const_iterator it = nb.begin(); it != nb.end(); ++it) {
+        MeshCore::MeshRefIndices::Range nb = pt2p[i];
+        for (MeshCore::MeshRefIndices::Range::const_iterator it = nb.begin(); it != nb.end(); ++it) {
             iV1 = *it;
 
             // Compute edge from V0 to V1, project to tangent plane of vertex,
@@ -288,52 +289,219 @@ void MeshCurvature::ComputePerVertex()
         myCurvature.push_back(ci);
     }
 }
+
+void MeshCurvature::ComputePerVertex(const MeshRefPointToFacets&)
+{
+    ComputePerVertex();
+}
+
+void MeshCurvature::UpdatePerVertex(const MeshRefPointToFacets&, const std::vector<PointIndex>&)
+{
+    ComputePerVertex();
+}
 #else
-void MeshCurvature::ComputePerVertex()
+namespace {
+
+/*
+ * Computes the same values as Wm4::MeshCurvature but gathers the contributions of
+ * the adjacent facets per vertex instead of scattering them per facet. Because the
+ * adjacent facets of a point are sorted the sums are built in the same order, so that
+ * the results are identical and the vertices can be handled independently.
+ */
+class VertexCurvature
 {
-    myCurvature.clear();
+public:
+    using Vector3 = Wm4::Vector3<double>;
+    using Matrix3 = Wm4::Matrix3<double>;
 
-    // get all points
-    std::vector< Wm4::Vector3<double> > aPnts;
-    aPnts.reserve(myKernel.CountPoints());
-    MeshPointIterator cPIt(myKernel);
-    for (cPIt.Init(); cPIt.More(); cPIt.Next()) {
-        Wm4::Vector3<double> cP(cPIt->x, cPIt->y, cPIt->z);
-        aPnts.push_back(cP);
+    VertexCurvature(const MeshKernel& kernel, const MeshRefPointToFacets& search)
+        : points(kernel.GetPoints()), facets(kernel.GetFacets()), search(search)
+    {
     }
+    Vector3 Point(PointIndex index) const
+    {
+        const MeshPoint& p = points[index];
+        return Vector3(p.x, p.y, p.z);
+    }
+    Vector3 Normal(PointIndex index) const
+    {
+        Vector3 normal(0.0, 0.0, 0.0);
+        for (FacetIndex it : search[index]) {
+            const PointIndex* aiV = facets[it]._aulPoints;
+            Vector3 kV0 = Point(aiV[0]);
+            Vector3 kEdge1 = Point(aiV[1]) - kV0;
+            Vector3 kEdge2 = Point(aiV[2]) - kV0;
+            normal += kEdge1.Cross(kEdge2);
+            // a degenerated facet is listed once but its zero normal doesn't count anyway
+        }
+        normal.Normalize();
+        return normal;
+    }
+    template <typename NormalOf>
+    CurvatureInfo Compute(PointIndex iV0, NormalOf normalOf) const
+    {
+        // compute the matrix of normal derivatives
+        Matrix3 kWWTrn(true), kDWTrn(true);
+        Vector3 kV0 = Point(iV0);
+        Vector3 kN0 = normalOf(iV0);
+        for (FacetIndex it : search[iV0]) {
+            const PointIndex* aiV = facets[it]._aulPoints;
+            for (int j = 0; j < 3; j++) {
+                if (aiV[j] != iV0)
+                    continue;
+                // Compute the edges from V0 to V1 and V2, project to tangent plane of vertex,
+                // and compute difference of adjacent normals.
+                for (int k = 1; k < 3; k++) {
+                    PointIndex iV1 = aiV[(j+k)%3];
+                    Vector3 kE = Point(iV1) - kV0;
+                    Vector3 kW = kE - (kE.Dot(kN0))*kN0;
+                    Vector3 kD = normalOf(iV1) - kN0;
+                    for (int iRow = 0; iRow < 3; iRow++) {
+                        for (int iCol = 0; iCol < 3; iCol++) {
+                            kWWTrn[iRow][iCol] += kW[iRow]*kW[iCol];
+                            kDWTrn[iRow][iCol] += kD[iRow]*kW[iCol];
+                        }
+                    }
+                }
+            }
+        }
 
-    // get all point connections
-    std::vector<int> aIdx;
-    aIdx.reserve(3*myKernel.CountFacets());
-    const MeshFacetArray& raFts = myKernel.GetFacets();
-    for (MeshFacetArray::const_iterator jt = raFts.begin(); jt != raFts.end(); ++jt) {
-        for (int i=0; i<3; i++) {
-            aIdx.push_back((int)jt->_aulPoints[i]);
+        // Add in N*N^T to W*W^T for numerical stability.
+        for (int iRow = 0; iRow < 3; iRow++) {
+            for (int iCol = 0; iCol < 3; iCol++) {
+                kWWTrn[iRow][iCol] = 0.5*kWWTrn[iRow][iCol] + kN0[iRow]*kN0[iCol];
+                kDWTrn[iRow][iCol] *= 0.5;
+            }
+        }
+        Matrix3 kDNormal = kDWTrn*kWWTrn.Inverse();
+
+        // The principal curvatures are the eigenvalues of the shape matrix
+        // S = J^T * dN/dX * J with J = [U | V], see Wm4::MeshCurvature
+        Vector3 kU, kV;
+        Vector3::GenerateComplementBasis(kU,kV,kN0);
+        double fS01 = kU.Dot(kDNormal*kV);
+        double fS10 = kV.Dot(kDNormal*kU);
+        double fSAvr = 0.5*(fS01+fS10);
+        Wm4::Matrix2<double> kS
+        (
+            kU.Dot(kDNormal*kU), fSAvr,
+            fSAvr, kV.Dot(kDNormal*kV)
+        );
+
+        double fTrace = kS[0][0] + kS[1][1];
+        double fDet = kS[0][0]*kS[1][1] - kS[0][1]*kS[1][0];
+        double fDiscr = fTrace*fTrace - 4.0*fDet;
+        double fRootDiscr = Wm4::Math<double>::Sqrt(Wm4::Math<double>::FAbs(fDiscr));
+        double fMinCurvature = 0.5*(fTrace - fRootDiscr);
+        double fMaxCurvature = 0.5*(fTrace + fRootDiscr);
+
+        CurvatureInfo ci;
+        Vector3 kMinDir = Direction(kS, fMinCurvature, kU, kV);
+        Vector3 kMaxDir = Direction(kS, fMaxCurvature, kU, kV);
+        ci.cMaxCurvDir = Base::Vector3f((float)kMaxDir.X(), (float)kMaxDir.Y(), (float)kMaxDir.Z());
+        ci.cMinCurvDir = Base::Vector3f((float)kMinDir.X(), (float)kMinDir.Y(), (float)kMinDir.Z());
+        ci.fMaxCurvature = (float)fMaxCurvature;
+        ci.fMinCurvature = (float)fMinCurvature;
+        return ci;
+    }
+
+private:
+    // the eigenvector of S for the eigenvalue fCurvature
+    static Vector3 Direction(const Wm4::Matrix2<double>& kS, double fCurvature,
+                             const Vector3& kU, const Vector3& kV)
+    {
+        Wm4::Vector2<double> kW0(kS[0][1],fCurvature-kS[0][0]);
+        Wm4::Vector2<double> kW1(fCurvature-kS[1][1],kS[1][0]);
+        if (kW0.SquaredLength() >= kW1.SquaredLength()) {
+            kW0.Normalize();
+            return kW0.X()*kU + kW0.Y()*kV;
+        }
+        else {
+            kW1.Normalize();
+            return kW1.X()*kU + kW1.Y()*kV;
         }
     }
 
+private:
+    const MeshPointArray& points;
+    const MeshFacetArray& facets;
+    const MeshRefPointToFacets& search;
+};
+
+}
+
+void MeshCurvature::ComputePerVertex()
+{
+    MeshRefPointToFacets search(myKernel);
+    ComputePerVertex(search);
+}
+
+void MeshCurvature::ComputePerVertex(const MeshRefPointToFacets& search)
+{
+    myCurvature.clear();
+
     // in case of an empty mesh no curvature can be calculated
     if (myKernel.CountPoints() == 0 || myKernel.CountFacets() == 0)
         return;
 
-    // compute vertex based curvatures
-    Wm4::MeshCurvature<double> meshCurv(myKernel.CountPoints(), &(aPnts[0]), myKernel.CountFacets(), &(aIdx[0]));
-
-    // get curvature information now
-    const Wm4::Vector3<double>* aMaxCurvDir = meshCurv.GetMaxDirections();
-    const Wm4::Vector3<double>* aMinCurvDir = meshCurv.GetMinDirections();
-    const double* aMaxCurv = meshCurv.GetMaxCurvatures();
-    const double* aMinCurv = meshCurv.GetMinCurvatures();
+    std::size_t numPoints = myKernel.CountPoints();
+    VertexCurvature vertex(myKernel, search);
+    std::vector<VertexCurvature::Vector3> normals(numPoints);
+    Base::forEachChunk(numPoints, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            normals[i] = vertex.Normal(i);
+    });
+
+    myCurvature.resize(numPoints);
+    Base::forEachChunk(numPoints, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            myCurvature[i] = vertex.Compute(i, [&normals](PointIndex index) {
+                return normals[index];
+            });
+        }
+    });
+}
 
-    myCurvature.reserve(myKernel.CountPoints());
-    for (unsigned long i=0; i<myKernel.CountPoints(); i++) {
-        CurvatureInfo ci;
-        ci.cMaxCurvDir = Base::Vector3f((float)aMaxCurvDir[i].X(), (float)aMaxCurvDir[i].Y(), (float)aMaxCurvDir[i].Z());
-        ci.cMinCurvDir = Base::Vector3f((float)aMinCurvDir[i].X(), (float)aMinCurvDir[i].Y(), (float)aMinCurvDir[i].Z());
-        ci.fMaxCurvature = (float)aMaxCurv[i];
-        ci.fMinCurvature = (float)aMinCurv[i];
-        myCurvature.push_back(ci);
+void MeshCurvature::UpdatePerVertex(const MeshRefPointToFacets& search, const std::vector<PointIndex>& moved)
+{
+    if (myCurvature.size() != myKernel.CountPoints()) {
+        ComputePerVertex(search);
+        return;
     }
+
+    // A moved point changes the normals of its neighbours and thus the curvature of
+    // the neighbours of its neighbours.
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    auto addNeighbours = [&](const std::vector<PointIndex>& points) {
+        std::vector<PointIndex> ring(points);
+        for (PointIndex it : points) {
+            for (FacetIndex jt : search[it]) {
+                const PointIndex* p = facets[jt]._aulPoints;
+                ring.insert(ring.end(), p, p + 3);
+            }
+        }
+        std::sort(ring.begin(), ring.end());
+        ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+        return ring;
+    };
+    std::vector<PointIndex> affected = addNeighbours(addNeighbours(moved));
+    std::vector<PointIndex> withNormal = addNeighbours(affected);
+
+    VertexCurvature vertex(myKernel, search);
+    std::vector<VertexCurvature::Vector3> normals(withNormal.size());
+    Base::forEachChunk(withNormal.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            normals[i] = vertex.Normal(withNormal[i]);
+    });
+
+    Base::forEachChunk(affected.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            myCurvature[affected[i]] = vertex.Compute(affected[i], [&](PointIndex index) {
+                auto it = std::lower_bound(withNormal.begin(), withNormal.end(), index);
+                return normals[it - withNormal.begin()];
+            });
+        }
+    });
 }
 #endif // OPTIMIZE_CURVATURE
 
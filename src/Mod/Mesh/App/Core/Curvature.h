@@ -61,6 +61,13 @@ public:
     void SetRadius(float r) { myRadius = r; }
     void ComputePerFace(bool parallel);
     void ComputePerVertex();
+    /// Computes the curvature of all points with the given point to facets structure of the mesh
+    void ComputePerVertex(const MeshRefPointToFacets& search);
+    /** Updates the curvature after the points \a moved have been moved. Only the values of the
+     * points whose neighbourhood contains a moved point are recomputed.
+     * \note If the topology of the mesh has changed ComputePerVertex() must be used instead.
+     */
+    void UpdatePerVertex(const MeshRefPointToFacets& search, const std::vector<PointIndex>& moved);
     const std::vector<CurvatureInfo>& GetCurvature() const { return myCurvature; }
 
 private:
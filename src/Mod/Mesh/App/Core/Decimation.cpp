@@ -22,6 +22,16 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+# include <algorithm>
+# include <array>
+# include <cmath>
+# include <functional>
+#endif
+
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include "Decimation.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
@@ -29,6 +39,430 @@
 
 using namespace MeshCore;
 
+namespace {
+
+using Face = std::array<PointIndex, 3>;
+
+// the vector products of Base::Vector3f are not inlined, these are used in the inner loops
+inline float Dot(const Base::Vector3f& a, const Base::Vector3f& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline Base::Vector3f Cross(const Base::Vector3f& a, const Base::Vector3f& b)
+{
+    return Base::Vector3f(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+/**
+ * Edge-collapse decimation with a priority queue of the edges ordered by their error.
+ * The error of an edge is computed from the planes of the facets around its end points
+ * in the current mesh (memoryless quadrics), so that no quadric has to be accumulated
+ * over the collapses. After a collapse the planes and quadrics around the remaining point
+ * are updated. The queue entries of the edges depending on them are recognized as outdated
+ * by the modification stamps of the points and get re-evaluated when they are taken from
+ * the queue. As the error mostly grows with a collapse this rarely changes the order.
+ */
+class QuadricCollapse
+{
+public:
+    QuadricCollapse(std::vector<Base::Vector3f>& points, std::vector<float>& errors,
+                    std::vector<unsigned char>& locked, std::vector<Face>& faces)
+      : points(points), errors(errors), locked(locked), faces(faces)
+    {
+    }
+
+    /// Builds the point to facet lists and locks the points of boundary and non-manifold edges
+    void Init()
+    {
+        pointFaces.resize(points.size());
+        stamps.assign(points.size(), 0);
+        facePlanes.resize(faces.size());
+        quadrics.resize(points.size());
+        numFaces = 0;
+        for (FacetIndex i = 0; i < faces.size(); i++) {
+            if (IsValid(faces[i])) {
+                for (PointIndex p : faces[i])
+                    pointFaces[p].push_back(i);
+                UpdatePlane(i);
+                numFaces++;
+            }
+        }
+        for (PointIndex p = 0; p < points.size(); p++)
+            UpdateQuadric(p);
+
+        // each neighbour appears once per facet of the edge
+        for (PointIndex p = 0; p < points.size(); p++) {
+            ring.clear();
+            for (FacetIndex f : pointFaces[p]) {
+                for (PointIndex q : faces[f]) {
+                    if (q != p)
+                        ring.push_back(q);
+                }
+            }
+            std::sort(ring.begin(), ring.end());
+            for (auto it = ring.begin(); it != ring.end();) {
+                auto next = std::upper_bound(it, ring.end(), *it);
+                if (next - it != 2) {
+                    locked[p] = 1;
+                    break;
+                }
+                it = next;
+            }
+        }
+    }
+
+    /// Collapses edges until \a targetSize facets are left or each error exceeds \a maxError
+    void Run(std::size_t targetSize, float maxError)
+    {
+        Collapse c;
+        for (PointIndex p = 0; p < points.size(); p++) {
+            Neighbours(p, ring);
+            for (PointIndex q : ring) {
+                if (q > p && Evaluate(p, q, c))
+                    queue.push_back(c);
+            }
+        }
+        std::make_heap(queue.begin(), queue.end(), std::greater<Collapse>());
+
+        while (numFaces > targetSize && !queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end(), std::greater<Collapse>());
+            c = queue.back();
+            queue.pop_back();
+            if (!IsCurrent(c)) {
+                if (HasEdge(c.from, c.to) && Evaluate(c.from, c.to, c))
+                    Push(c);
+                continue;
+            }
+            if (c.error > maxError)
+                break;
+            Base::Vector3f pos = Evaluate(c);
+            if (!CanCollapse(c, pos))
+                continue;
+            Apply(c, pos);
+            Update(c);
+        }
+        std::vector<Collapse>().swap(queue);
+    }
+
+    static bool IsValid(const Face& face)
+    {
+        return face[0] != POINT_INDEX_MAX;
+    }
+
+private:
+    struct Collapse
+    {
+        float error;
+        unsigned int stampFrom, stampTo;
+        PointIndex from, to;
+        bool operator > (const Collapse& c) const
+        {
+            return error > c.error;
+        }
+    };
+    struct Plane
+    {
+        Base::Vector3f normal;
+        float distance;
+    };
+
+    void UpdatePlane(FacetIndex f)
+    {
+        const Face& face = faces[f];
+        const Base::Vector3f& p0 = points[face[0]];
+        Base::Vector3f n = Cross(points[face[1]] - p0, points[face[2]] - p0);
+        float len = std::sqrt(Dot(n, n));
+        if (len > 0.0f)
+            n /= len;
+        facePlanes[f] = {n, -Dot(n, p0)};
+    }
+
+    void UpdateQuadric(PointIndex p)
+    {
+        SymmetricMatrix q;
+        for (FacetIndex f : pointFaces[p]) {
+            const Plane& plane = facePlanes[f];
+            q += SymmetricMatrix(plane.normal.x, plane.normal.y, plane.normal.z, plane.distance);
+        }
+        quadrics[p] = q;
+    }
+
+    bool IsCurrent(const Collapse& c) const
+    {
+        return stamps[c.from] == c.stampFrom && stamps[c.to] == c.stampTo;
+    }
+
+    bool HasEdge(PointIndex p, PointIndex q) const
+    {
+        for (FacetIndex f : pointFaces[p]) {
+            const Face& face = faces[f];
+            if (face[0] == q || face[1] == q || face[2] == q)
+                return true;
+        }
+        return false;
+    }
+
+    void Push(const Collapse& c)
+    {
+        queue.push_back(c);
+        std::push_heap(queue.begin(), queue.end(), std::greater<Collapse>());
+    }
+
+    /// The sorted points connected with \a p by an edge
+    void Neighbours(PointIndex p, std::vector<PointIndex>& ring) const
+    {
+        ring.clear();
+        for (FacetIndex f : pointFaces[p]) {
+            for (PointIndex q : faces[f]) {
+                if (q != p)
+                    ring.push_back(q);
+            }
+        }
+        std::sort(ring.begin(), ring.end());
+        ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+    }
+
+    /// Computes the error of collapsing the edge \a u, \a v. A locked point is kept.
+    bool Evaluate(PointIndex u, PointIndex v, Collapse& c)
+    {
+        if (locked[u] && locked[v])
+            return false;
+        if (locked[u])
+            std::swap(u, v);
+        c.from = u;
+        c.to = v;
+        c.stampFrom = stamps[u];
+        c.stampTo = stamps[v];
+        Evaluate(c);
+        return true;
+    }
+
+    /// Computes the error and the new position of the remaining point of \a c
+    Base::Vector3f Evaluate(Collapse& c)
+    {
+        // the facets of the edge are counted twice
+        SymmetricMatrix q = quadrics[c.from] + quadrics[c.to];
+        const Base::Vector3f& p1 = points[c.from];
+        const Base::Vector3f& p2 = points[c.to];
+        Base::Vector3f pos = p2;
+        if (!locked[c.to]) {
+            // the minimum of the quadric if it is well-conditioned and close to the edge,
+            // otherwise the best of the end points and the middle
+            double det = q.det(0, 1, 2, 1, 4, 5, 2, 5, 7);
+            double trace = (q[0] + q[4] + q[7]) / 3.0;
+            bool solved = false;
+            if (det > 1e-3 * trace * trace * trace) {
+                Base::Vector3f opt(float(-1.0 / det * q.det(1, 2, 3, 4, 5, 6, 5, 7, 8)),
+                                   float( 1.0 / det * q.det(0, 2, 3, 1, 5, 6, 2, 7, 8)),
+                                   float(-1.0 / det * q.det(0, 1, 3, 1, 4, 6, 2, 5, 8)));
+                Base::Vector3f mid = (p1 + p2) * 0.5f;
+                if (Base::DistanceP2(opt, mid) <= Base::DistanceP2(p1, p2)) {
+                    pos = opt;
+                    solved = true;
+                }
+            }
+            if (!solved) {
+                Base::Vector3f mid = (p1 + p2) * 0.5f;
+                double e1 = QuadricError(q, p1);
+                double e2 = QuadricError(q, p2);
+                double e3 = QuadricError(q, mid);
+                pos = e1 < e2 ? (e1 < e3 ? p1 : mid) : (e2 < e3 ? p2 : mid);
+            }
+        }
+
+        float dist = 0.0f;
+        for (PointIndex p : {c.from, c.to}) {
+            for (FacetIndex f : pointFaces[p]) {
+                const Plane& plane = facePlanes[f];
+                dist = std::max(dist, std::fabs(Dot(plane.normal, pos) + plane.distance));
+            }
+        }
+        c.error = std::max(errors[c.from], errors[c.to]) + dist;
+        return pos;
+    }
+
+    static double QuadricError(const SymmetricMatrix& q, const Base::Vector3f& v)
+    {
+        double x = v.x, y = v.y, z = v.z;
+        return q[0]*x*x + 2*q[1]*x*y + 2*q[2]*x*z + 2*q[3]*x + q[4]*y*y
+             + 2*q[5]*y*z + 2*q[6]*y + q[7]*z*z + 2*q[8]*z + q[9];
+    }
+
+    /// Checks that the collapse keeps the mesh manifold and doesn't fold or degenerate facets
+    bool CanCollapse(const Collapse& c, const Base::Vector3f& pos)
+    {
+        // the opposite points of the two facets of the edge must be the only common neighbours
+        Neighbours(c.from, ringFrom);
+        Neighbours(c.to, ringTo);
+        std::size_t common = 0;
+        auto it = ringFrom.begin();
+        for (PointIndex p : ringTo) {
+            it = std::lower_bound(it, ringFrom.end(), p);
+            if (it == ringFrom.end())
+                break;
+            if (*it == p)
+                common++;
+        }
+        if (common != 2)
+            return false;
+
+        return !IsFolded(c.from, c.to, pos) && !IsFolded(c.to, c.from, pos);
+    }
+
+    /// Checks if a facet of \a p without \a other flips or degenerates when \a p is moved
+    bool IsFolded(PointIndex p, PointIndex other, const Base::Vector3f& pos) const
+    {
+        if (points[p] == pos)
+            return false;
+        for (FacetIndex f : pointFaces[p]) {
+            const Face& face = faces[f];
+            if (face[0] == other || face[1] == other || face[2] == other)
+                continue;
+            Base::Vector3f v[3];
+            for (int j = 0; j < 3; j++)
+                v[j] = face[j] == p ? pos : points[face[j]];
+            const Base::Vector3f& p0 = points[face[0]];
+            Base::Vector3f n1 = Cross(points[face[1]] - p0, points[face[2]] - p0);
+            Base::Vector3f e1 = v[1] - v[0];
+            Base::Vector3f e2 = v[2] - v[0];
+            Base::Vector3f n2 = Cross(e1, e2);
+            float len2 = Dot(n2, n2);
+            if (len2 <= 1e-8f * Dot(e1, e1) * Dot(e2, e2))
+                return true;
+            if (Dot(n1, n2) < 0.2f * std::sqrt(Dot(n1, n1) * len2))
+                return true;
+        }
+        return false;
+    }
+
+    /// Moves \a c.to to \a pos and replaces \a c.from with it
+    void Apply(const Collapse& c, const Base::Vector3f& pos)
+    {
+        std::vector<FacetIndex>& target = pointFaces[c.to];
+        for (FacetIndex f : pointFaces[c.from]) {
+            Face& face = faces[f];
+            if (face[0] == c.to || face[1] == c.to || face[2] == c.to) {
+                for (PointIndex p : face) {
+                    if (p != c.from) {
+                        std::vector<FacetIndex>& list = pointFaces[p];
+                        list.erase(std::find(list.begin(), list.end(), f));
+                    }
+                }
+                face[0] = POINT_INDEX_MAX;
+                numFaces--;
+            }
+            else {
+                std::replace(face.begin(), face.end(), c.from, c.to);
+                target.push_back(f);
+            }
+        }
+
+        std::vector<FacetIndex>().swap(pointFaces[c.from]);
+        points[c.to] = pos;
+        errors[c.to] = c.error;
+        stamps[c.from]++;
+        stamps[c.to]++;
+    }
+
+    /** Updates the planes and quadrics around the remaining point of \a c, this invalidates
+     * the queue entries of the edges of its neighbours.
+     */
+    void Update(const Collapse& c)
+    {
+        for (FacetIndex f : pointFaces[c.to])
+            UpdatePlane(f);
+        UpdateQuadric(c.to);
+        Neighbours(c.to, ring);
+        for (PointIndex q : ring) {
+            UpdateQuadric(q);
+            stamps[q]++;
+        }
+
+        // the edges of the removed point are new edges of the remaining point, ringFrom and
+        // ringTo still hold the neighbours before the collapse
+        Collapse e;
+        for (PointIndex q : ringFrom) {
+            if (q != c.to && !std::binary_search(ringTo.begin(), ringTo.end(), q)
+                    && Evaluate(c.to, q, e))
+                Push(e);
+        }
+    }
+
+private:
+    std::vector<Base::Vector3f>& points;
+    std::vector<float>& errors;
+    std::vector<unsigned char>& locked;
+    std::vector<Face>& faces;
+    std::vector<std::vector<FacetIndex>> pointFaces;
+    std::vector<Plane> facePlanes;
+    std::vector<SymmetricMatrix> quadrics;
+    std::vector<unsigned int> stamps;
+    std::vector<Collapse> queue;
+    std::size_t numFaces = 0;
+
+    // buffers
+    std::vector<PointIndex> ring, ringFrom, ringTo;
+};
+
+/// Removes the points not referenced by a facet
+void RemoveUnusedPoints(std::vector<Base::Vector3f>& points, std::vector<float>& errors,
+                        std::vector<unsigned char>& locked, std::vector<Face>& faces)
+{
+    std::vector<PointIndex> index(points.size(), POINT_INDEX_MAX);
+    for (const Face& face : faces) {
+        for (PointIndex p : face)
+            index[p] = 0;
+    }
+    PointIndex count = 0;
+    for (PointIndex i = 0; i < points.size(); i++) {
+        if (index[i] == 0) {
+            points[count] = points[i];
+            errors[count] = errors[i];
+            locked[count] = locked[i];
+            index[i] = count++;
+        }
+    }
+    points.resize(count);
+    errors.resize(count);
+    locked.resize(count);
+    for (Face& face : faces) {
+        for (PointIndex& p : face)
+            p = index[p];
+    }
+}
+
+/// Sorts the facets of [begin, end) into \a numBlocks spatial blocks of the same size
+void SplitBlocks(const std::vector<Base::Vector3f>& centers, std::vector<FacetIndex>& order,
+                 std::size_t begin, std::size_t end, std::size_t numBlocks,
+                 std::vector<std::pair<std::size_t, std::size_t>>& blocks)
+{
+    if (numBlocks <= 1) {
+        blocks.emplace_back(begin, end);
+        return;
+    }
+
+    Base::BoundBox3f box;
+    for (std::size_t i = begin; i < end; i++)
+        box.Add(centers[order[i]]);
+    int axis = 0;
+    if (box.LengthY() > box.LengthX())
+        axis = 1;
+    if (box.LengthZ() > std::max(box.LengthX(), box.LengthY()))
+        axis = 2;
+
+    std::size_t half = numBlocks / 2;
+    std::size_t mid = begin + (end - begin) * half / numBlocks;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                     [&centers, axis](FacetIndex a, FacetIndex b) {
+        return centers[a][axis] < centers[b][axis];
+    });
+    SplitBlocks(centers, order, begin, mid, half, blocks);
+    SplitBlocks(centers, order, mid, end, numBlocks - half, blocks);
+}
+
+}
+
 MeshSimplify::MeshSimplify(MeshKernel& mesh)
   : myKernel(mesh)
 {
@@ -151,3 +585,145 @@ void MeshSimplify::simplify(int targetSize)
 
     myKernel.Adopt(new_points, new_facets, true);
 }
+
+void MeshSimplify::simplify(const Parameters& params)
+{
+    const MeshPointArray& meshPoints = myKernel.GetPoints();
+    const MeshFacetArray& meshFacets = myKernel.GetFacets();
+    std::vector<Base::Vector3f> points(meshPoints.begin(), meshPoints.end());
+    std::vector<float> errors(points.size(), 0.0f);
+    std::vector<unsigned char> locked(points.size(), 0);
+
+    // lock the points of feature edges, those of boundary edges are locked by QuadricCollapse
+    if (params.featureAngle >= 0.0f) {
+        std::vector<Base::Vector3f> normals;
+        normals.reserve(meshFacets.size());
+        for (const auto& facet : meshFacets) {
+            const Base::Vector3f& p0 = points[facet._aulPoints[0]];
+            Base::Vector3f n = (points[facet._aulPoints[1]] - p0) % (points[facet._aulPoints[2]] - p0);
+            normals.push_back(n.Normalize());
+        }
+        float cosAngle = std::cos(params.featureAngle);
+        for (FacetIndex i = 0; i < meshFacets.size(); i++) {
+            const MeshFacet& facet = meshFacets[i];
+            for (int j = 0; j < 3; j++) {
+                FacetIndex n = facet._aulNeighbours[j];
+                if (n != FACET_INDEX_MAX && i < n && normals[i] * normals[n] < cosAngle) {
+                    locked[facet._aulPoints[j]] = 1;
+                    locked[facet._aulPoints[(j + 1) % 3]] = 1;
+                }
+            }
+        }
+    }
+
+    std::vector<Face> faces;
+    std::size_t numFacets = meshFacets.size();
+    std::size_t numBlocks = params.blockSize > 0 ? numFacets / params.blockSize : 0;
+    if (numBlocks > 1) {
+        std::vector<Base::Vector3f> centers;
+        centers.reserve(numFacets);
+        std::vector<FacetIndex> order(numFacets);
+        for (FacetIndex i = 0; i < numFacets; i++) {
+            const PointIndex* p = meshFacets[i]._aulPoints;
+            centers.push_back((points[p[0]] + points[p[1]] + points[p[2]]) / 3.0f);
+            order[i] = i;
+        }
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        SplitBlocks(centers, order, 0, numFacets, numBlocks, ranges);
+
+        // decimate the blocks with their common points locked, each block writes only
+        // its own points
+        std::vector<std::vector<Face>> blocks(ranges.size());
+        std::vector<std::size_t> indices(ranges.size());
+        for (std::size_t i = 0; i < indices.size(); i++)
+            indices[i] = i;
+        QtConcurrent::blockingMap(indices, [&](std::size_t index) {
+            std::size_t begin = ranges[index].first;
+            std::size_t end = ranges[index].second;
+            std::vector<PointIndex> globals;
+            globals.reserve((end - begin) * 3);
+            for (std::size_t i = begin; i < end; i++) {
+                const PointIndex* p = meshFacets[order[i]]._aulPoints;
+                globals.insert(globals.end(), p, p + 3);
+            }
+            std::sort(globals.begin(), globals.end());
+            globals.erase(std::unique(globals.begin(), globals.end()), globals.end());
+
+            std::vector<Face> localFaces;
+            localFaces.reserve(end - begin);
+            for (std::size_t i = begin; i < end; i++) {
+                const PointIndex* p = meshFacets[order[i]]._aulPoints;
+                Face face;
+                for (int j = 0; j < 3; j++)
+                    face[j] = std::lower_bound(globals.begin(), globals.end(), p[j]) - globals.begin();
+                localFaces.push_back(face);
+            }
+            std::vector<Base::Vector3f> localPoints;
+            std::vector<float> localErrors;
+            std::vector<unsigned char> localLocked;
+            localPoints.reserve(globals.size());
+            localErrors.reserve(globals.size());
+            localLocked.reserve(globals.size());
+            for (PointIndex p : globals) {
+                localPoints.push_back(points[p]);
+                localErrors.push_back(errors[p]);
+                localLocked.push_back(locked[p]);
+            }
+
+            QuadricCollapse alg(localPoints, localErrors, localLocked, localFaces);
+            alg.Init();
+            // leave a part of the facets to the final pass, otherwise the seams would keep
+            // their resolution
+            std::size_t target = params.targetSize * (end - begin) / numFacets;
+            alg.Run(target + target / 4, params.maxError);
+
+            for (std::size_t i = 0; i < globals.size(); i++) {
+                if (!localLocked[i]) {
+                    points[globals[i]] = localPoints[i];
+                    errors[globals[i]] = localErrors[i];
+                }
+            }
+            std::vector<Face>& result = blocks[index];
+            for (const Face& face : localFaces) {
+                if (QuadricCollapse::IsValid(face))
+                    result.push_back({globals[face[0]], globals[face[1]], globals[face[2]]});
+            }
+        });
+
+        std::size_t numFaces = 0;
+        for (const auto& block : blocks)
+            numFaces += block.size();
+        faces.reserve(numFaces);
+        for (auto& block : blocks) {
+            faces.insert(faces.end(), block.begin(), block.end());
+            std::vector<Face>().swap(block);
+        }
+        RemoveUnusedPoints(points, errors, locked, faces);
+    }
+    else {
+        faces.reserve(numFacets);
+        for (const auto& facet : meshFacets)
+            faces.push_back({facet._aulPoints[0], facet._aulPoints[1], facet._aulPoints[2]});
+    }
+
+    // the final pass over the whole mesh also collapses the edges at the seams of the blocks
+    QuadricCollapse alg(points, errors, locked, faces);
+    alg.Init();
+    alg.Run(params.targetSize, params.maxError);
+
+    faces.erase(std::remove_if(faces.begin(), faces.end(), [](const Face& face) {
+        return !QuadricCollapse::IsValid(face);
+    }), faces.end());
+    RemoveUnusedPoints(points, errors, locked, faces);
+
+    MeshPointArray newPoints;
+    newPoints.reserve(points.size());
+    for (const auto& point : points)
+        newPoints.push_back(point);
+    MeshFacetArray newFacets;
+    newFacets.reserve(faces.size());
+    for (const Face& face : faces)
+        newFacets.push_back(MeshFacet(face[0], face[1], face[2]));
+
+    myKernel.Adopt(newPoints, newFacets, true);
+}
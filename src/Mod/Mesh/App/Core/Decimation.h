@@ -24,6 +24,8 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <cfloat>
+#include <cstddef>
 #include <Mod/Mesh/MeshGlobal.h>
 
 namespace MeshCore
@@ -33,10 +35,37 @@ class MeshKernel;
 class MeshExport MeshSimplify
 {
 public:
+    /// The parameters of the edge-collapse decimation
+    struct Parameters
+    {
+        /// The number of facets to keep, 0 to only stop at \a maxError
+        std::size_t targetSize = 0;
+        /// The maximum distance of a moved point to the original surface
+        float maxError = FLT_MAX;
+        /** The points of edges with a dihedral angle above this angle (in radians) are kept.
+         * A negative value disables the feature detection.
+         */
+        float featureAngle = 1.0471976f;
+        /** The mesh is split into spatial blocks of about this number of facets that are
+         * decimated in parallel. 0 disables the blocks.
+         */
+        std::size_t blockSize = 100000;
+    };
+
     MeshSimplify(MeshKernel&);//explicit bombs
     ~MeshSimplify();
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /** Decimates the mesh by collapsing the edge with the lowest error until the mesh has
+     * \a targetSize facets or the error of each remaining edge exceeds \a maxError.
+     * The error of an edge is the distance of the new point to the planes of the facets
+     * around the edge in the current mesh (memoryless quadrics), added to the error of
+     * the previous collapses at its end points. The points of boundary, non-manifold and
+     * feature edges are never moved.
+     * The blocks are decimated in parallel with their common points kept, a final pass
+     * over the whole mesh then collapses the edges at the seams.
+     */
+    void simplify(const Parameters&);
 
 private:
     MeshKernel& myKernel;
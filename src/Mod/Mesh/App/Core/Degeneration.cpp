@@ -565,7 +565,8 @@ bool MeshRemoveNeedles::Fixup()
         if (neighbour != FACET_INDEX_MAX)
             ce._removeFacets.push_back(neighbour);
 
-        std::set<FacetIndex> vf = vf_it[ce._fromPoint];
+        MeshRefIndices::Range adjacent = vf_it[ce._fromPoint];
+        std::set<FacetIndex> vf(adjacent.begin(), adjacent.end());
         vf.erase(faceedge.first);
         if (neighbour != FACET_INDEX_MAX)
             vf.erase(neighbour);
@@ -786,9 +787,9 @@ bool MeshFixMergeFacets::Fixup()
         if (vv_it[i].size() == 3 && vf_it[i].size() == 3) {
             VertexCollapse vc;
             vc._point = i;
-            const std::set<PointIndex>& adjPts = vv_it[i];
+            MeshCore::MeshRefIndices::Range adjPts = vv_it[i];
             vc._circumPoints.insert(vc._circumPoints.begin(), adjPts.begin(), adjPts.end());
-            const std::set<FacetIndex>& adjFts = vf_it[i];
+            MeshCore::MeshRefIndices::Range adjFts = vf_it[i];
             vc._circumFacets.insert(vc._circumFacets.begin(), adjFts.begin(), adjFts.end());
             topAlg.CollapseVertex(vc);
         }
@@ -816,11 +817,11 @@ bool MeshEvalDentsOnSurface::Evaluate()
 
         // get the local neighbourhood of the point
         std::set<PointIndex> nb = clPt2Facets.NeighbourPoints(point,1);
-        const std::set<FacetIndex>& faces = clPt2Facets[index];
+        MeshRefIndices::Range faces = clPt2Facets[index];
 
         for (std::set<PointIndex>::iterator pt = nb.begin(); pt != nb.end(); ++pt) {
             const MeshPoint& mp = rPntAry[*pt];
-            for (std::set<FacetIndex>::const_iterator
+            for (MeshRefIndices::Range::const_iterator
                 ft = faces.begin(); ft != faces.end(); ++ft) {
                     // the point must not be part of the facet we test
                     if (f_beg[*ft]._aulPoints[0] == *pt)
@@ -832,7 +833,7 @@ bool MeshEvalDentsOnSurface::Evaluate()
                     // is the point projectable onto the facet?
                     rTriangle = _rclMesh.GetFacet(f_beg[*ft]);
                     if (rTriangle.IntersectWithLine(mp,rTriangle.GetNormal(),tmp)) {
-                        const std::set<FacetIndex>& f = clPt2Facets[*pt];
+                        MeshRefIndices::Range f = clPt2Facets[*pt];
                         this->indices.insert(this->indices.end(), f.begin(), f.end());
                         break;
                     }
@@ -1070,6 +1070,43 @@ bool MeshGeomFacet::IntersectWithFacet(const MeshGeomFacet &rclFacet) const
  * http://www.acm.org/jgt/papers/Moller97/tritri.html
  * http://www.cs.lth.se/home/Tomas_Akenine_Moller/code/
  */
+namespace {
+int IntersectWithCoplanarFacet(const MeshGeomFacet& rclFacet1,
+                               const MeshGeomFacet& rclFacet2,
+                               Base::Vector3f& rclPt0,
+                               Base::Vector3f& rclPt1)
+{
+    // Since tri_tri_intersect_with_isection may return garbage values try to get
+    // sensible values with edge/edge intersections
+    std::vector<Base::Vector3f> intersections;
+    for (short i=0; i<3; i++) {
+        MeshGeomEdge edge1 = rclFacet1.GetEdge(i);
+        for (short j=0; j<3; j++) {
+            MeshGeomEdge edge2 = rclFacet2.GetEdge(j);
+            Base::Vector3f point;
+            if (edge1.IntersectWithEdge(edge2, point)) {
+                intersections.push_back(point);
+            }
+        }
+    }
+
+    // If triangles overlap there can be more than two intersection points
+    // In that case use any two of them.
+    if (intersections.size() >= 2) {
+        rclPt0 = intersections[0];
+        rclPt1 = intersections[1];
+        return 2;
+    }
+    else if (intersections.size() == 1) {
+        rclPt0 = intersections[0];
+        rclPt1 = intersections[0];
+        return 1;
+    }
+
+    return 0;
+}
+}
+
 int MeshGeomFacet::IntersectWithFacet (const MeshGeomFacet& rclFacet,
                                        Base::Vector3f& rclPt0,
                                        Base::Vector3f& rclPt1) const
@@ -1077,34 +1114,7 @@ int MeshGeomFacet::IntersectWithFacet (const MeshGeomFacet& rclFacet,
     // Note: tri_tri_intersect_with_isection() does not return line of
     // intersection when triangles are coplanar. See tritritest.h:18 and 658.
     if (IsCoplanar(rclFacet)) {
-        // Since tri_tri_intersect_with_isection may return garbage values try to get
-        // sensible values with edge/edge intersections
-        std::vector<Base::Vector3f> intersections;
-        for (short i=0; i<3; i++) {
-            MeshGeomEdge edge1 = GetEdge(i);
-            for (short j=0; j<3; j++) {
-                MeshGeomEdge edge2 = rclFacet.GetEdge(j);
-                Base::Vector3f point;
-                if (edge1.IntersectWithEdge(edge2, point)) {
-                    intersections.push_back(point);
-                }
-            }
-        }
-
-        // If triangles overlap there can be more than two intersection points
-        // In that case use any two of them.
-        if (intersections.size() >= 2) {
-            rclPt0 = intersections[0];
-            rclPt1 = intersections[1];
-            return 2;
-        }
-        else if (intersections.size() == 1) {
-            rclPt0 = intersections[0];
-            rclPt1 = intersections[0];
-            return 1;
-        }
-
-        return 0;
+        return IntersectWithCoplanarFacet(*this, rclFacet, rclPt0, rclPt1);
     }
 
     float V[3][3], U[3][3];
@@ -1125,6 +1135,11 @@ int MeshGeomFacet::IntersectWithFacet (const MeshGeomFacet& rclFacet,
                                          &coplanar, isectpt1, isectpt2) == 0)
         return 0; // no intersections
 
+    // The facets are nearly coplanar but not within the tolerance of IsCoplanar(),
+    // the intersection points are not set in this case
+    if (coplanar)
+        return IntersectWithCoplanarFacet(*this, rclFacet, rclPt0, rclPt1);
+
     rclPt0.x = isectpt1[0]; rclPt0.y = isectpt1[1]; rclPt0.z = isectpt1[2];
     rclPt1.x = isectpt2[0]; rclPt1.y = isectpt2[1]; rclPt1.z = isectpt2[2];
 
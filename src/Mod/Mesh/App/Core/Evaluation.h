@@ -295,7 +295,7 @@ public:
     /// collect all intersection lines
     void GetIntersections(const std::vector<std::pair<FacetIndex, FacetIndex> >&,
         std::vector<std::pair<Base::Vector3f, Base::Vector3f> >&) const;
-    /// collect the index of all facets with self intersections
+    /// collect the index of all facets with self intersections, each pair once and sorted
     void GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex> >&) const;
 };
 
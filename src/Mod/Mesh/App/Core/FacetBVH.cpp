@@ -0,0 +1,427 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+# include <cmath>
+#endif
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <Base/Sequencer.h>
+
+#include "FacetBVH.h"
+#include "Elements.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace {
+// the maximum number of facets of a leaf
+const ElementIndex MaxLeafSize = 4;
+// the epsilon of the triangle/triangle test in tritritest.h
+const float TriTriEpsilon = 0.000001f;
+}
+
+MeshFacetBVH::MeshFacetBVH (const MeshKernel &rclM)
+  : _rclMesh(rclM)
+{
+    Rebuild();
+}
+
+void MeshFacetBVH::Rebuild ()
+{
+    _nodes.clear();
+    _facets.clear();
+    _boxes.clear();
+    _triangles.clear();
+
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    ElementIndex ctFacets = rFacets.size();
+    if (ctFacets == 0)
+        return;
+
+    // the facets are sorted with their boxes and centers to keep them close in memory
+    struct Entry
+    {
+        Base::BoundBox3f box;
+        Base::Vector3f center;
+        FacetIndex index;
+    };
+    std::vector<Entry> entries(ctFacets);
+    for (ElementIndex i = 0; i < ctFacets; i++) {
+        const MeshFacet& face = rFacets[i];
+        Entry& entry = entries[i];
+        for (int j = 0; j < 3; j++)
+            entry.box.Add(rPoints[face._aulPoints[j]]);
+        entry.center = entry.box.GetCenter();
+        entry.index = i;
+    }
+
+    // split the facets of a node at the middle of the longest axis of the box of their centers
+    _nodes.reserve(2 * (ctFacets / MaxLeafSize + 1));
+    _nodes.push_back(Node{Base::BoundBox3f(), 0, ctFacets});
+
+    std::vector<ElementIndex> todo;
+    todo.push_back(0);
+    while (!todo.empty()) {
+        ElementIndex index = todo.back();
+        todo.pop_back();
+
+        ElementIndex first = _nodes[index].first;
+        ElementIndex count = _nodes[index].count;
+        std::vector<Entry>::iterator begin = entries.begin() + first;
+        std::vector<Entry>::iterator end = begin + count;
+        Base::BoundBox3f box, centerBox;
+        for (std::vector<Entry>::iterator it = begin; it != end; ++it) {
+            box.Add(it->box);
+            centerBox.Add(it->center);
+        }
+        _nodes[index].box = box;
+        if (count <= MaxLeafSize)
+            continue;
+
+        int axis = 0;
+        if (centerBox.LengthY() > centerBox.LengthX())
+            axis = 1;
+        if (centerBox.LengthZ() > std::max(centerBox.LengthX(), centerBox.LengthY()))
+            axis = 2;
+        float middle = centerBox.GetCenter()[axis];
+        std::vector<Entry>::iterator mid = std::partition(begin, end, [axis, middle](const Entry& entry) {
+            return entry.center[axis] < middle;
+        });
+        ElementIndex half = mid - begin;
+        if (half == 0 || half == count) {
+            // all centers are equal
+            half = count / 2;
+        }
+
+        ElementIndex left = _nodes.size();
+        _nodes.push_back(Node{Base::BoundBox3f(), first, half});
+        _nodes.push_back(Node{Base::BoundBox3f(), first + half, count - half});
+        _nodes[index].first = left;
+        _nodes[index].count = 0;
+        todo.push_back(left);
+        todo.push_back(left + 1);
+    }
+
+    _facets.resize(ctFacets);
+    _boxes.resize(ctFacets);
+    _triangles.resize(ctFacets);
+    for (ElementIndex i = 0; i < ctFacets; i++) {
+        _facets[i] = entries[i].index;
+        _boxes[i] = entries[i].box;
+        const MeshFacet& face = rFacets[_facets[i]];
+        Triangle& tria = _triangles[i];
+        for (int j = 0; j < 3; j++)
+            tria.points[j] = rPoints[face._aulPoints[j]];
+        // same computation as in tri_tri_intersect_with_isectline
+        tria.normal = (tria.points[1] - tria.points[0]) % (tria.points[2] - tria.points[0]);
+        tria.distance = -(tria.normal * tria.points[0]);
+    }
+}
+
+bool MeshFacetBVH::IsSeparated (const Triangle& t1, const Triangle& t2)
+{
+    // This is the first test of tri_tri_intersect_with_isectline: if all points of t2 are
+    // on the same side of the plane of t1 there is no intersection.
+    // MeshGeomFacet::IntersectWithFacet handles nearly coplanar facets differently, so these
+    // are never rejected here.
+    float dist[3];
+    for (int i = 0; i < 3; i++) {
+        dist[i] = t1.normal * t2.points[i] + t1.distance;
+        if (std::fabs(dist[i]) < TriTriEpsilon)
+            return false;
+    }
+    if ((dist[0] > 0.0f) != (dist[1] > 0.0f) || (dist[0] > 0.0f) != (dist[2] > 0.0f))
+        return false;
+
+    float length = t1.normal.Length();
+    return std::fabs(dist[0]) > TriTriEpsilon * length;
+}
+
+/* Calls func(result, leaf1, leaf2, same) for all pairs of leaves of this tree and the tree of
+ * rclTree whose boxes overlap. If self is set both trees are the same, each pair of different
+ * leaves is passed once and each leaf is passed with itself with same set to true.
+ * Pairs of overlapping sub-trees are collected first and then handled in parallel, each of
+ * them with its own result object. func returns false to stop the traversal.
+ * The progress is shown with \a text, if \a canAbort is set the user can abort the traversal.
+ */
+template <typename Result, typename LeafFunc>
+std::vector<Result> MeshFacetBVH::Traverse (const MeshFacetBVH& rclTree, bool self, const char* text,
+                                            bool canAbort, LeafFunc func) const
+{
+    using NodePair = std::pair<ElementIndex, ElementIndex>;
+    const std::vector<Node>& nodes1 = _nodes;
+    const std::vector<Node>& nodes2 = rclTree._nodes;
+    if (nodes1.empty() || nodes2.empty())
+        return std::vector<Result>();
+
+    auto isSame = [self](const NodePair& pair) {
+        return self && pair.first == pair.second;
+    };
+    auto isLeafPair = [&nodes1, &nodes2](const NodePair& pair) {
+        return nodes1[pair.first].count > 0 && nodes2[pair.second].count > 0;
+    };
+    auto isOverlapping = [&](const NodePair& pair) {
+        return isSame(pair) || (nodes1[pair.first].box && nodes2[pair.second].box);
+    };
+    // adds the pairs of the children, the larger node is split
+    auto split = [&](const NodePair& pair, std::vector<NodePair>& todo) {
+        const Node& node1 = nodes1[pair.first];
+        const Node& node2 = nodes2[pair.second];
+        if (isSame(pair)) {
+            todo.emplace_back(node1.first, node1.first);
+            todo.emplace_back(node1.first + 1, node1.first + 1);
+            todo.emplace_back(node1.first, node1.first + 1);
+        }
+        else if (node2.count > 0 || (node1.count == 0 &&
+                 node1.box.CalcDiagonalLength() >= node2.box.CalcDiagonalLength())) {
+            todo.emplace_back(node1.first, pair.second);
+            todo.emplace_back(node1.first + 1, pair.second);
+        }
+        else {
+            todo.emplace_back(pair.first, node2.first);
+            todo.emplace_back(pair.first, node2.first + 1);
+        }
+    };
+
+    // collect enough independent pairs of sub-trees to keep all threads busy
+    std::size_t ctThreads = static_cast<std::size_t>(std::max(1, QThread::idealThreadCount()));
+    std::size_t ctTasks = ctThreads * 16;
+    std::vector<NodePair> tasks;
+    tasks.emplace_back(0, 0);
+    bool divided = true;
+    while (tasks.size() < ctTasks && divided) {
+        divided = false;
+        std::vector<NodePair> next;
+        for (const NodePair& pair : tasks) {
+            if (!isOverlapping(pair))
+                continue;
+            if (isLeafPair(pair)) {
+                next.push_back(pair);
+            }
+            else {
+                split(pair, next);
+                divided = true;
+            }
+        }
+        tasks.swap(next);
+    }
+
+    struct Task
+    {
+        NodePair root;
+        Result result;
+    };
+    std::vector<Task> work(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); i++)
+        work[i].root = tasks[i];
+
+    std::atomic<bool> stop(false);
+    auto traverse = [&](Task& task) {
+        std::vector<NodePair> todo;
+        todo.push_back(task.root);
+        while (!todo.empty() && !stop) {
+            NodePair pair = todo.back();
+            todo.pop_back();
+            if (!isOverlapping(pair))
+                continue;
+            if (isLeafPair(pair)) {
+                if (!func(task.result, nodes1[pair.first], nodes2[pair.second], isSame(pair)))
+                    stop = true;
+            }
+            else {
+                split(pair, todo);
+            }
+        }
+    };
+
+    // The tasks are handled in rounds, after each of them the progress is shown and a
+    // requested abort is thrown from the calling thread
+    Base::SequencerLauncher seq(text, work.size());
+    std::size_t ctRound = ctThreads * 4;
+    for (std::size_t first = 0; first < work.size() && !stop; first += ctRound) {
+        std::size_t last = std::min(first + ctRound, work.size());
+        if (last - first > 1)
+            QtConcurrent::blockingMap(work.begin() + first, work.begin() + last, traverse);
+        else
+            traverse(work[first]);
+        for (std::size_t i = first; i < last; i++)
+            seq.next(canAbort);
+    }
+
+    std::vector<Result> results;
+    results.reserve(work.size());
+    for (Task& task : work)
+        results.push_back(std::move(task.result));
+    return results;
+}
+
+bool MeshFacetBVH::IntersectFacets (ElementIndex pos1, ElementIndex pos2, FacetPair& pair) const
+{
+    if (!(_boxes[pos1] && _boxes[pos2]))
+        return false;
+
+    // Facets sharing a point usually don't intersect each other but the test below would
+    // detect false-positives, so they are skipped
+    if (_facets[pos1] > _facets[pos2])
+        std::swap(pos1, pos2);
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    const MeshFacet& face1 = rFacets[_facets[pos1]];
+    const MeshFacet& face2 = rFacets[_facets[pos2]];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            if (face1._aulPoints[i] == face2._aulPoints[j])
+                return false;
+        }
+    }
+
+    const Triangle& tria1 = _triangles[pos1];
+    const Triangle& tria2 = _triangles[pos2];
+    if (IsSeparated(tria1, tria2))
+        return false;
+
+    Base::Vector3f pt1, pt2;
+    MeshGeomFacet facet1(tria1.points[0], tria1.points[1], tria1.points[2]);
+    MeshGeomFacet facet2(tria2.points[0], tria2.points[1], tria2.points[2]);
+    if (facet1.IntersectWithFacet(facet2, pt1, pt2) != 2)
+        return false;
+
+    pair.first = _facets[pos1];
+    pair.second = _facets[pos2];
+    return true;
+}
+
+bool MeshFacetBVH::IntersectFacets (const MeshFacetBVH& rclTree, ElementIndex pos1, ElementIndex pos2,
+                                    Intersection& section) const
+{
+    if (!(_boxes[pos1] && rclTree._boxes[pos2]))
+        return false;
+
+    const Triangle& tria1 = _triangles[pos1];
+    const Triangle& tria2 = rclTree._triangles[pos2];
+    if (IsSeparated(tria1, tria2))
+        return false;
+
+    MeshGeomFacet facet1(tria1.points[0], tria1.points[1], tria1.points[2]);
+    MeshGeomFacet facet2(tria2.points[0], tria2.points[1], tria2.points[2]);
+    if (facet1.IntersectWithFacet(facet2, section.p1, section.p2) != 2)
+        return false;
+
+    section.f1 = _facets[pos1];
+    section.f2 = rclTree._facets[pos2];
+    return true;
+}
+
+bool MeshFacetBVH::HasSelfIntersections () const
+{
+    std::vector<bool> found = Traverse<bool>(*this, true, "Checking for self-intersections...",
+                                             false, [this](bool& result,
+        const Node& leaf1, const Node& leaf2, bool same) {
+        FacetPair pair;
+        for (ElementIndex i = leaf1.first; i < leaf1.first + leaf1.count; i++) {
+            for (ElementIndex j = same ? i + 1 : leaf2.first; j < leaf2.first + leaf2.count; j++) {
+                if (IntersectFacets(i, j, pair)) {
+                    result = true;
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+
+    return std::find(found.begin(), found.end(), true) != found.end();
+}
+
+void MeshFacetBVH::GetSelfIntersections (std::vector<FacetPair>& intersection) const
+{
+    using Pairs = std::vector<FacetPair>;
+    std::vector<Pairs> results = Traverse<Pairs>(*this, true, "Checking for self-intersections...",
+                                                 true, [this](Pairs& result,
+        const Node& leaf1, const Node& leaf2, bool same) {
+        FacetPair pair;
+        for (ElementIndex i = leaf1.first; i < leaf1.first + leaf1.count; i++) {
+            for (ElementIndex j = same ? i + 1 : leaf2.first; j < leaf2.first + leaf2.count; j++) {
+                if (IntersectFacets(i, j, pair))
+                    result.push_back(pair);
+            }
+        }
+        return true;
+    });
+
+    std::size_t offset = intersection.size();
+    for (const Pairs& pairs : results)
+        intersection.insert(intersection.end(), pairs.begin(), pairs.end());
+    std::sort(intersection.begin() + offset, intersection.end());
+}
+
+bool MeshFacetBVH::HasIntersections (const MeshFacetBVH& rclTree) const
+{
+    std::vector<bool> found = Traverse<bool>(rclTree, false, "Checking for intersections...",
+                                             false, [this, &rclTree](bool& result,
+        const Node& leaf1, const Node& leaf2, bool) {
+        Intersection section;
+        for (ElementIndex i = leaf1.first; i < leaf1.first + leaf1.count; i++) {
+            for (ElementIndex j = leaf2.first; j < leaf2.first + leaf2.count; j++) {
+                if (IntersectFacets(rclTree, i, j, section)) {
+                    result = true;
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+
+    return std::find(found.begin(), found.end(), true) != found.end();
+}
+
+void MeshFacetBVH::GetIntersections (const MeshFacetBVH& rclTree, std::vector<Intersection>& intersection) const
+{
+    using Sections = std::vector<Intersection>;
+    std::vector<Sections> results = Traverse<Sections>(rclTree, false, "Checking for intersections...",
+                                                       false, [this, &rclTree](Sections& result,
+        const Node& leaf1, const Node& leaf2, bool) {
+        Intersection section;
+        for (ElementIndex i = leaf1.first; i < leaf1.first + leaf1.count; i++) {
+            for (ElementIndex j = leaf2.first; j < leaf2.first + leaf2.count; j++) {
+                if (IntersectFacets(rclTree, i, j, section))
+                    result.push_back(section);
+            }
+        }
+        return true;
+    });
+
+    std::size_t offset = intersection.size();
+    for (const Sections& sections : results)
+        intersection.insert(intersection.end(), sections.begin(), sections.end());
+    std::sort(intersection.begin() + offset, intersection.end(), [](const Intersection& a, const Intersection& b) {
+        return a.f2 < b.f2 || (a.f2 == b.f2 && a.f1 < b.f1);
+    });
+}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef MESH_FACETBVH_H
+#define MESH_FACETBVH_H
+
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh. It is
+ * used to find the pairs of intersecting facets of a mesh or of two meshes.
+ * The tree is a binary tree of axis-aligned boxes split at the middle of the facet centers.
+ * Its coordinates and the planes of the facets are stored in the order of the leaves, so
+ * that close facets are close in memory. The pairs of overlapping sub-trees are handled in
+ * parallel.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    using FacetPair = std::pair<FacetIndex, FacetIndex>;
+
+    /// The intersection line of two facets
+    struct Intersection
+    {
+        FacetIndex f1, f2;
+        Base::Vector3f p1, p2;
+    };
+
+    /// Construction
+    explicit MeshFacetBVH (const MeshKernel &rclM);
+    /// Destruction
+    ~MeshFacetBVH ()
+    { }
+
+    /// Rebuilds up data structure
+    void Rebuild ();
+    /// Returns the number of nodes of the tree
+    std::size_t CountNodes () const
+    { return _nodes.size(); }
+
+    /** Checks if two facets of the mesh intersect each other. Facets sharing a point are
+     * not tested.
+     */
+    bool HasSelfIntersections () const;
+    /** Returns all pairs of intersecting facets of the mesh, except of facets sharing a point.
+     * Each pair is listed once with the lower index first and the pairs are sorted.
+     * The user can abort the search, in this case a Base::AbortException is thrown.
+     */
+    void GetSelfIntersections (std::vector<FacetPair>&) const;
+    /// Checks if a facet of this mesh intersects a facet of the mesh of \a rclTree.
+    bool HasIntersections (const MeshFacetBVH& rclTree) const;
+    /** Returns the intersection lines of the facets of this mesh (f1) with the facets of the
+     * mesh of \a rclTree (f2), sorted by f2 and then by f1.
+     */
+    void GetIntersections (const MeshFacetBVH& rclTree, std::vector<Intersection>&) const;
+
+private:
+    /// A leaf if count > 0, otherwise first is the index of the left child, the right follows it
+    struct Node
+    {
+        Base::BoundBox3f box;
+        ElementIndex first;
+        ElementIndex count;
+    };
+    /// The corner points of a facet and its plane as used by the triangle/triangle test
+    struct Triangle
+    {
+        Base::Vector3f points[3];
+        Base::Vector3f normal;
+        float distance;
+    };
+
+    template <typename Result, typename LeafFunc>
+    std::vector<Result> Traverse (const MeshFacetBVH& rclTree, bool self, const char* text,
+                                  bool canAbort, LeafFunc func) const;
+    bool IntersectFacets (ElementIndex pos1, ElementIndex pos2, FacetPair& pair) const;
+    bool IntersectFacets (const MeshFacetBVH& rclTree, ElementIndex pos1, ElementIndex pos2,
+                          Intersection& section) const;
+    static bool IsSeparated (const Triangle& t1, const Triangle& t2);
+
+private:
+    const MeshKernel &_rclMesh; /**< The mesh kernel. */
+    std::vector<Node> _nodes;
+    std::vector<FacetIndex> _facets; /**< The facet indices in the order of the leaves. */
+    std::vector<Base::BoundBox3f> _boxes; /**< The facet boxes in the order of the leaves. */
+    std::vector<Triangle> _triangles; /**< The facets in the order of the leaves. */
+};
+
+} // namespace MeshCore
+
+#endif // MESH_FACETBVH_H
@@ -91,8 +91,6 @@ void MeshGrid::InitGrid ()
 {
   assert(_pclMesh);
 
-  unsigned long i, j;
-
   // Calculate grid length if not initialised
   //
   if ((_ulCtGridsX == 0) || (_ulCtGridsY == 0) || (_ulCtGridsZ == 0))
@@ -127,13 +125,7 @@ void MeshGrid::InitGrid ()
 
   // Create data structure
   _aulGrid.clear();
-  _aulGrid.resize(_ulCtGridsX);
-  for (i = 0; i < _ulCtGridsX; i++)
-  {
-    _aulGrid[i].resize(_ulCtGridsY);
-    for (j = 0; j < _ulCtGridsY; j++)
-      _aulGrid[i][j].resize(_ulCtGridsZ);
-  }
+  _aulGrid.resize(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ);
 }
 
 unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::vector<ElementIndex> &raulElements,
@@ -153,7 +145,7 @@ unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::vector<Eleme
     {
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
-        raulElements.insert(raulElements.end(), _aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+        raulElements.insert(raulElements.end(), GetCell(i, j, k).begin(), GetCell(i, j, k).end());
       }
     }
   }
@@ -188,7 +180,7 @@ unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::vector<Eleme
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
         if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2)
-          raulElements.insert(raulElements.end(), _aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+          raulElements.insert(raulElements.end(), GetCell(i, j, k).begin(), GetCell(i, j, k).end());
       }
     }
   }
@@ -219,7 +211,7 @@ unsigned long MeshGrid::Inside (const Base::BoundBox3f &rclBB, std::set<ElementI
     {
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
-        raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+        raulElements.insert(GetCell(i, j, k).begin(), GetCell(i, j, k).end());
       }
     }
   }
@@ -477,7 +469,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsY; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+              raclInd.insert(GetCell(nX, i, j).begin(), GetCell(nX, i, j).end());
           }
           nX++;
         }
@@ -491,7 +483,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsY; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+              raclInd.insert(GetCell(nX, i, j).begin(), GetCell(nX, i, j).end());
           }
           nX++;
         }
@@ -505,7 +497,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+              raclInd.insert(GetCell(i, nY, j).begin(), GetCell(i, nY, j).end());
           }
           nY++;
         }
@@ -519,7 +511,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+              raclInd.insert(GetCell(i, nY, j).begin(), GetCell(i, nY, j).end());
           }
           nY--;
         }
@@ -533,7 +525,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsY; j++)
-              raclInd.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+              raclInd.insert(GetCell(i, j, nZ).begin(), GetCell(i, j, nZ).end());
           }
           nZ++;
         }
@@ -547,7 +539,7 @@ void MeshGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt, std::set<Ele
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsY; j++)
-              raclInd.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+              raclInd.insert(GetCell(i, j, nZ).begin(), GetCell(i, j, nZ).end());
           }
           nZ--;
         }
@@ -643,7 +635,7 @@ void MeshGrid::GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ,
 unsigned long MeshGrid::GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,
                                      std::set<ElementIndex> &raclInd) const
 {
-  const std::set<ElementIndex> &rclSet = _aulGrid[ulX][ulY][ulZ];
+  GridCells::Cell rclSet = GetCell(ulX, ulY, ulZ);
   if (!rclSet.empty())
   {
     raclInd.insert(rclSet.begin(), rclSet.end());
@@ -659,9 +651,10 @@ unsigned long MeshGrid::GetElements(const Base::Vector3f &rclPoint, std::vector<
   if (!CheckPosition(rclPoint, ulX, ulY, ulZ))
     return 0;
 
-  aulFacets.resize(_aulGrid[ulX][ulY][ulZ].size());
+  GridCells::Cell rclSet = GetCell(ulX, ulY, ulZ);
+  aulFacets.resize(rclSet.size());
 
-  std::copy(_aulGrid[ulX][ulY][ulZ].begin(), _aulGrid[ulX][ulY][ulZ].end(), aulFacets.begin());
+  std::copy(rclSet.begin(), rclSet.end(), aulFacets.begin());
   return aulFacets.size();
 }
 
@@ -766,15 +759,9 @@ void MeshFacetGrid::RebuildGrid ()
   InitGrid();
 
   // Fill data structure
-  MeshFacetIterator clFIter(*_pclMesh);
-
-  unsigned long i = 0;
-  for (clFIter.Init(); clFIter.More(); clFIter.Next())
-  {
-//    AddFacet(*clFIter, i++, 2.0f);
-    AddFacet(*clFIter, i++);
-  }
-
+  _aulGrid.fill(_aulGrid.size(), _ulCtElements, [this](ElementIndex i, GridCells::Entries &entries) {
+    AddFacet(_pclMesh->GetFacet(i), i, entries);
+  });
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt) const
@@ -1005,8 +992,8 @@ void MeshFacetGrid::SearchNearestFacetInGrid(unsigned long ulX, unsigned long ul
                                              const Base::Vector3f &rclPt, float &rfMinDist,
                                              ElementIndex &rulFacetInd) const
 {
-  const std::set<ElementIndex> &rclSet = _aulGrid[ulX][ulY][ulZ];
-  for (std::set<ElementIndex>::const_iterator pI = rclSet.begin(); pI != rclSet.end(); ++pI)
+  GridCells::Cell rclSet = GetCell(ulX, ulY, ulZ);
+  for (GridCells::Cell::const_iterator pI = rclSet.begin(); pI != rclSet.end(); ++pI)
   {
     float fDist = _pclMesh->GetFacet(*pI).DistanceToPoint(rclPt);
     if (fDist < rfMinDist)
@@ -1051,13 +1038,14 @@ MeshPointGrid::MeshPointGrid (const MeshKernel &rclM, float fGridLen)
           std::max<unsigned long>(static_cast<unsigned long>(clBBMesh.LengthZ() / fGridLen), 1));
 }
 
-void MeshPointGrid::AddPoint (const MeshPoint &rclPt, ElementIndex ulPtIndex, float fEpsilon)
+void MeshPointGrid::AddPoint (const MeshPoint &rclPt, ElementIndex ulPtIndex, GridCells::Entries &raclEntries,
+                              float fEpsilon) const
 {
   (void)fEpsilon;
   unsigned long ulX, ulY, ulZ;
   Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
   if ( (ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ) )
-    _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
+    raclEntries.push_back({GetCellIndex(ulX, ulY, ulZ), ulPtIndex});
 }
 
 void MeshPointGrid::Validate (const MeshKernel &rclMesh)
@@ -1108,14 +1096,10 @@ void MeshPointGrid::RebuildGrid ()
   InitGrid();
 
   // Fill data structure
-
-  MeshPointIterator cPIter(*_pclMesh);
-
-  unsigned long i = 0;
-  for (cPIter.Init(); cPIter.More(); cPIter.Next())
-  {
-    AddPoint(*cPIter, i++);
-  }
+  const MeshPointArray& rPoints = _pclMesh->GetPoints();
+  _aulGrid.fill(_aulGrid.size(), _ulCtElements, [this, &rPoints](ElementIndex i, GridCells::Entries &entries) {
+    AddPoint(rPoints[i], i, entries);
+  });
 }
 
 void MeshPointGrid::Pos (const Base::Vector3f &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const
@@ -1177,7 +1161,7 @@ bool MeshGridIterator::InitOnRay (const Base::Vector3f &rclPt, const Base::Vecto
   if (_rclGrid.GetBoundBox().IsInBox(rclPt))
   {  // Determine the voxel by the starting point
     _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    raulElements.insert(raulElements.end(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).begin(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).end());
     _bValidRay = true;
   }
   else
@@ -1190,7 +1174,7 @@ bool MeshGridIterator::InitOnRay (const Base::Vector3f &rclPt, const Base::Vecto
       else
         _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
 
-      raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+      raulElements.insert(raulElements.end(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).begin(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).end());
       _bValidRay = true;
     }
   }
@@ -1241,7 +1225,7 @@ bool MeshGridIterator::NextOnRay (std::vector<ElementIndex> &raulElements)
   if (_bValidRay && _rclGrid.CheckPos(_ulX, _ulY, _ulZ))
   {
     GridElement pos(_ulX, _ulY, _ulZ); _cSearchPositions.insert(pos);
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    raulElements.insert(raulElements.end(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).begin(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).end());
   }
   else
     _bValidRay = false;  // Beam leaked
@@ -26,6 +26,7 @@
 #include <set>
 
 #include <Base/BoundBox.h>
+#include <Base/GridCells.h>
 
 #include "MeshKernel.h"
 
@@ -41,6 +42,9 @@ class MeshKernel;
 class MeshGeomFacet;
 class MeshGrid;
 
+/** The elements of all grids stored in one array, see Base::GridCells. */
+using GridCells = Base::GridCells<ElementIndex>;
+
 #define MESHGRID_BBOX_EXTENSION 10.0f
 
 /**
@@ -124,7 +128,10 @@ public:
   bool GetPositionToIndex(unsigned long id, unsigned long& ulX, unsigned long& ulY, unsigned long& ulZ) const;
   /** Returns the number of elements in a given grid. */
   unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
-  { return static_cast<unsigned long>(_aulGrid[ulX][ulY][ulZ].size()); }
+  { return static_cast<unsigned long>(GetCell(ulX, ulY, ulZ).size()); }
+  /** Returns the number of bytes allocated for the grid elements. */
+  unsigned long GetMemoryUsage() const
+  { return static_cast<unsigned long>(_aulGrid.memoryUsage()); }
   /** Validates the grid structure and rebuilds it if needed. Must be implemented in sub-classes. */
   virtual void Validate (const MeshKernel &rclM) = 0;
   /** Verifies the grid structure and returns false if inconsistencies are found. */
@@ -154,9 +161,13 @@ protected:
   virtual void RebuildGrid () = 0;
   /** Returns the number of stored elements. Must be implemented in sub-classes. */
   virtual unsigned long HasElements () const = 0;
+  /** Returns the elements of the given grid. */
+  inline GridCells::Cell GetCell (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const;
+  /** Returns the number of the given grid in the data structure. */
+  inline ElementIndex GetCellIndex (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const;
 
 protected:
-  std::vector<std::vector<std::vector<std::set<ElementIndex> > > >  _aulGrid;   /**< Grid data structure. */
+  GridCells         _aulGrid;     /**< Grid data structure. */
   const MeshKernel* _pclMesh;     /**< The mesh kernel. */
   unsigned long     _ulCtElements;/**< Number of grid elements for validation issues. */
   unsigned long     _ulCtGridsX;  /**< Number of grid elements in z. */
@@ -224,9 +235,10 @@ protected:
   /** Returns the grid numbers to the given point \a rclPoint. */
   inline void PosWithCheck (const Base::Vector3f &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const;
   /** Adds a new facet element to the grid structure. \a rclFacet is the geometric facet and \a ulFacetIndex
-   * the corresponding index in the mesh kernel. The facet is added to each grid element that intersects
-   * the facet. */
-  inline void AddFacet (const MeshGeomFacet &rclFacet, ElementIndex ulFacetIndex, float fEpsilon = 0.0f);
+   * the corresponding index in the mesh kernel. The facet is added to \a raclEntries for each grid element
+   * that intersects the facet. */
+  inline void AddFacet (const MeshGeomFacet &rclFacet, ElementIndex ulFacetIndex, GridCells::Entries &raclEntries,
+                        float fEpsilon = 0.0f) const;
   /** Returns the number of stored elements. */
   unsigned long HasElements () const override
   { return _pclMesh->CountFacets(); }
@@ -268,8 +280,9 @@ public:
 
 protected:
   /** Adds a new point element to the grid structure. \a rclPt is the geometric point and \a ulPtIndex
-   * the corresponding index in the mesh kernel. */
-  void AddPoint (const MeshPoint &rclPt, ElementIndex ulPtIndex, float fEpsilon = 0.0f);
+   * the corresponding index in the mesh kernel. The point is added to \a raclEntries. */
+  void AddPoint (const MeshPoint &rclPt, ElementIndex ulPtIndex, GridCells::Entries &raclEntries,
+                 float fEpsilon = 0.0f) const;
   /** Returns the grid numbers to the given point \a rclPoint. */
   void Pos(const Base::Vector3f &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const;
   /** Returns the number of stored elements. */
@@ -294,7 +307,8 @@ public:
   /** Returns indices of the elements in the current grid. */
   void GetElements (std::vector<ElementIndex> &raulElements) const
   {
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    GridCells::Cell cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+    raulElements.insert(raulElements.end(), cell.begin(), cell.end());
   }
   /** Returns the number of elements in the current grid. */
   unsigned long GetCtElements() const
@@ -390,6 +404,17 @@ inline bool MeshGrid::CheckPos (unsigned long ulX, unsigned long ulY, unsigned l
   return ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ));
 }
 
+inline ElementIndex MeshGrid::GetCellIndex (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+{
+  // same order as the former nested arrays, so that iterating over z is contiguous
+  return (ulX * _ulCtGridsY + ulY) * _ulCtGridsZ + ulZ;
+}
+
+inline GridCells::Cell MeshGrid::GetCell (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+{
+  return _aulGrid[GetCellIndex(ulX, ulY, ulZ)];
+}
+
 // --------------------------------------------------------------
 
 inline void MeshFacetGrid::Pos (const Base::Vector3f &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const
@@ -433,7 +458,8 @@ inline void MeshFacetGrid::PosWithCheck (const Base::Vector3f &rclPoint, unsigne
   assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
 }
 
-inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, ElementIndex ulFacetIndex, float /*fEpsilon*/)
+inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, ElementIndex ulFacetIndex,
+                                     GridCells::Entries &raclEntries, float /*fEpsilon*/) const
 {
   unsigned long ulX, ulY, ulZ;
 
@@ -472,13 +498,13 @@ inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, ElementIndex
         for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++)
         {
           if ( rclFacet.IntersectBoundingBox( GetBoundBox(ulX, ulY, ulZ) ) )
-            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+            raclEntries.push_back({GetCellIndex(ulX, ulY, ulZ), ulFacetIndex});
         }
       }
     }
   }
   else
-    _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+    raclEntries.push_back({GetCellIndex(ulX1, ulY1, ulZ1), ulFacetIndex});
 }
 
 } // namespace MeshCore
@@ -0,0 +1,366 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
+# include <cstring>
+# include <limits>
+# include <sstream>
+#endif
+
+#include <QFile>
+#include <QThread>
+
+#include <Base/Functional.h>
+
+#include "Core/Functional.h"
+#include "Core/MeshIO.h"
+#include "Core/MeshKernel.h"
+
+#include "ReaderMapped.h"
+
+
+using namespace MeshCore;
+
+namespace {
+
+/// A corner point of an STL facet with the index of the corner
+struct Vertex
+{
+    float x, y, z;
+    uint32_t i;
+
+    bool operator!=(const Vertex& rhs) const
+    {
+        return x != rhs.x || y != rhs.y || z != rhs.z;
+    }
+    bool operator<(const Vertex& rhs) const
+    {
+        if (x != rhs.x)
+            return x < rhs.x;
+        else if (y != rhs.y)
+            return y < rhs.y;
+        else if (z != rhs.z)
+            return z < rhs.z;
+        else
+            return false;
+    }
+};
+
+template <typename T>
+T Read(const char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+bool IsLittleEndian()
+{
+    uint16_t value = 1;
+    return Read<unsigned char>(reinterpret_cast<const char*>(&value)) == 1;
+}
+
+/// Read-only memory mapping of a file
+class MappedFile
+{
+public:
+    explicit MappedFile(const char* filename)
+      : file(QString::fromUtf8(filename))
+    {
+        if (file.open(QIODevice::ReadOnly) && file.size() > 0) {
+            uchar* map = file.map(0, file.size());
+            if (map) {
+                data = reinterpret_cast<const char*>(map);
+                size = static_cast<std::size_t>(file.size());
+            }
+        }
+    }
+    ~MappedFile()
+    {
+        if (data)
+            file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(data)));
+    }
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+
+private:
+    QFile file;
+};
+
+}
+
+ReaderMapped::ReaderMapped(MeshKernel& kernel, Material* material)
+  : _kernel(kernel)
+  , _material(material)
+{
+}
+
+bool ReaderMapped::LoadBinarySTL(const char* filename)
+{
+    const std::size_t headerSize = 84;
+    const std::size_t recordSize = 50;
+    MappedFile file(filename);
+    if (!file.data || file.size < headerSize)
+        return false;
+
+    // the same check for the keywords of an ASCII file as in MeshInput::LoadSTL
+    uint32_t numFacets = Read<uint32_t>(file.data + 80);
+    std::string text(file.data + headerSize,
+                     std::min<std::size_t>(numFacets > 1 ? 100 : 50, file.size - headerSize));
+    std::transform(text.begin(), text.end(), text.begin(), ::toupper);
+    for (const char* keyword : {"SOLID", "FACET", "NORMAL", "VERTEX", "ENDFACET", "ENDLOOP"}) {
+        if (text.find(keyword) != std::string::npos)
+            return false;
+    }
+    if (numFacets == 0 || numFacets > (file.size - headerSize) / recordSize)
+        return false;
+    if (numFacets > std::numeric_limits<uint32_t>::max() / 3)
+        return false;
+
+    // a record is the normal, the three points and two attribute bytes
+    std::size_t numCorners = 3 * static_cast<std::size_t>(numFacets);
+    std::vector<Vertex> verts(numCorners);
+    Base::forEachChunk(numFacets, [&](std::size_t, std::size_t begin, std::size_t end) {
+        const char* record = file.data + headerSize + begin * recordSize;
+        for (std::size_t i = begin; i < end; i++, record += recordSize) {
+            for (std::size_t j = 0; j < 3; j++) {
+                Vertex& v = verts[3 * i + j];
+                v.x = Read<float>(record + 12 * (j + 1));
+                v.y = Read<float>(record + 12 * (j + 1) + 4);
+                v.z = Read<float>(record + 12 * (j + 1) + 8);
+                v.i = static_cast<uint32_t>(3 * i + j);
+            }
+        }
+    });
+
+    MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<Vertex>(), QThread::idealThreadCount());
+
+    // count the different points of each chunk of the sorted corners
+    std::vector<std::size_t> offsets(Base::countChunks(numCorners) + 1, 0);
+    std::size_t numChunks = Base::forEachChunk(numCorners, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; i++) {
+            if (i == 0 || verts[i] != verts[i - 1])
+                count++;
+        }
+        offsets[chunk + 1] = count;
+    });
+    for (std::size_t i = 1; i <= numChunks; i++)
+        offsets[i] += offsets[i - 1];
+
+    // the points are numbered in sorted order
+    MeshPointArray points(offsets[numChunks]);
+    std::vector<uint32_t> indices(numCorners);
+    Base::forEachChunk(numCorners, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        std::size_t index = offsets[chunk];
+        for (std::size_t i = begin; i < end; i++) {
+            const Vertex& v = verts[i];
+            if (i == 0 || v != verts[i - 1]) {
+                points[index].Set(v.x, v.y, v.z);
+                index++;
+            }
+            indices[v.i] = static_cast<uint32_t>(index - 1);
+        }
+    });
+    std::vector<Vertex>().swap(verts);
+
+    MeshFacetArray facets(numFacets);
+    Base::forEachChunk(numFacets, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            for (std::size_t j = 0; j < 3; j++)
+                facets[i]._aulPoints[j] = indices[3 * i + j];
+        }
+    });
+    std::vector<uint32_t>().swap(indices);
+
+    _kernel.Adopt(points, facets, true);
+    return true;
+}
+
+bool ReaderMapped::LoadPLY(const char* filename)
+{
+    if (!IsLittleEndian())
+        return false;
+    MappedFile file(filename);
+    if (!file.data)
+        return false;
+
+    const char* marker = "end_header";
+    const char* last = file.data + file.size;
+    const char* pos = std::search(file.data, last, marker, marker + std::strlen(marker));
+    pos = std::find(pos, last, '\n');
+    if (pos == last)
+        return false;
+    std::size_t headerSize = static_cast<std::size_t>(pos + 1 - file.data);
+
+    // only the vertex and face elements are supported, the vertices with float or double
+    // coordinates and the faces with the list of point indices only
+    std::istringstream header(std::string(file.data, headerSize));
+    std::string line, element;
+    std::vector<std::string> elements;
+    std::size_t numPoints = 0, numFaces = 0;
+    std::size_t vertexSize = 0, coordOffset[3] = {0, 0, 0}, coordSize[3] = {0, 0, 0};
+    std::size_t numFaceProps = 0;
+    bool hasColor = false;
+    std::getline(header, line);
+    if (line.compare(0, 3, "ply") != 0)
+        return false;
+    while (std::getline(header, line)) {
+        std::istringstream str(line);
+        std::string kw;
+        str >> kw;
+        if (kw == "format") {
+            std::string format, version;
+            str >> format >> version;
+            if (format != "binary_little_endian" || version != "1.0")
+                return false;
+        }
+        else if (kw == "element") {
+            std::size_t count = 0;
+            str >> element >> count;
+            if (element == "vertex")
+                numPoints = count;
+            else if (element == "face")
+                numFaces = count;
+            else
+                return false;
+            elements.push_back(element);
+        }
+        else if (kw == "property") {
+            std::string type, name;
+            str >> type;
+            if (element == "vertex") {
+                str >> name;
+                std::size_t size = 0;
+                if (type == "char" || type == "int8" || type == "uchar" || type == "uint8")
+                    size = 1;
+                else if (type == "short" || type == "int16" || type == "ushort" || type == "uint16")
+                    size = 2;
+                else if (type == "int" || type == "int32" || type == "uint" || type == "uint32" ||
+                         type == "float" || type == "float32")
+                    size = 4;
+                else if (type == "double" || type == "float64")
+                    size = 8;
+                else
+                    return false;
+
+                int coord = name == "x" ? 0 : name == "y" ? 1 : name == "z" ? 2 : -1;
+                if (coord >= 0) {
+                    bool real = type == "float" || type == "float32" || type == "double" || type == "float64";
+                    if (!real || coordSize[coord] != 0)
+                        return false;
+                    coordOffset[coord] = vertexSize;
+                    coordSize[coord] = size;
+                }
+                if (name == "red" || name == "green" || name == "blue" ||
+                    name == "diffuse_red" || name == "diffuse_green" || name == "diffuse_blue")
+                    hasColor = true;
+                vertexSize += size;
+            }
+            else if (element == "face") {
+                std::string countType, indexType;
+                str >> countType >> indexType >> name;
+                if (type != "list" || (name != "vertex_indices" && name != "vertex_index"))
+                    return false;
+                if (countType != "uchar" && countType != "uint8" && countType != "char" && countType != "int8")
+                    return false;
+                if (indexType != "int" && indexType != "int32" && indexType != "uint" && indexType != "uint32")
+                    return false;
+                numFaceProps++;
+            }
+        }
+        else if (kw == "end_header") {
+            break;
+        }
+    }
+
+    if (elements != std::vector<std::string>{"vertex", "face"} || numFaceProps != 1)
+        return false;
+    if (coordSize[0] == 0 || coordSize[1] == 0 || coordSize[2] == 0)
+        return false;
+    if (hasColor && _material)
+        return false;
+
+    // all faces must be triangles to have records of the same size
+    const std::size_t faceSize = 1 + 3 * sizeof(uint32_t);
+    if ((file.size - headerSize) / vertexSize < numPoints)
+        return false;
+    std::size_t faceStart = headerSize + numPoints * vertexSize;
+    if ((file.size - faceStart) / faceSize < numFaces)
+        return false;
+
+    MeshPointArray points(numPoints);
+    Base::forEachChunk(numPoints, [&](std::size_t, std::size_t begin, std::size_t end) {
+        const char* record = file.data + headerSize + begin * vertexSize;
+        for (std::size_t i = begin; i < end; i++, record += vertexSize) {
+            float coords[3];
+            for (int j = 0; j < 3; j++) {
+                const char* value = record + coordOffset[j];
+                coords[j] = coordSize[j] == 4 ? Read<float>(value)
+                                              : static_cast<float>(Read<double>(value));
+            }
+            points[i].Set(coords[0], coords[1], coords[2]);
+        }
+    });
+
+    // faces with an invalid point index are skipped like in MeshInput::LoadPLY
+    std::atomic<bool> triangles(true);
+    std::vector<std::vector<MeshFacet>> chunkFacets(Base::countChunks(numFaces));
+    std::size_t numChunks = Base::forEachChunk(numFaces, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        std::vector<MeshFacet>& list = chunkFacets[chunk];
+        list.reserve(end - begin);
+        const char* record = file.data + faceStart + begin * faceSize;
+        for (std::size_t i = begin; i < end; i++, record += faceSize) {
+            if (Read<unsigned char>(record) != 3) {
+                triangles = false;
+                return;
+            }
+            uint32_t p0 = Read<uint32_t>(record + 1);
+            uint32_t p1 = Read<uint32_t>(record + 5);
+            uint32_t p2 = Read<uint32_t>(record + 9);
+            if (p0 < numPoints && p1 < numPoints && p2 < numPoints)
+                list.emplace_back(p0, p1, p2);
+        }
+    });
+    if (!triangles)
+        return false;
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < numChunks; i++)
+        count += chunkFacets[i].size();
+    MeshFacetArray facets;
+    facets.reserve(count);
+    for (std::size_t i = 0; i < numChunks; i++) {
+        facets.insert(facets.end(), chunkFacets[i].begin(), chunkFacets[i].end());
+        std::vector<MeshFacet>().swap(chunkFacets[i]);
+    }
+
+    MeshCleanup meshCleanup(points, facets);
+    meshCleanup.RemoveInvalids();
+    _kernel.Adopt(points, facets, true);
+    return true;
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef MESH_IO_READER_MAPPED_H
+#define MESH_IO_READER_MAPPED_H
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace MeshCore
+{
+
+class MeshKernel;
+struct Material;
+
+/** Loads binary STL and PLY files from a memory mapping of the file.
+ * The records are decoded in parallel chunks. The corner points of the STL facets are
+ * merged by a parallel sort, which gives the same mesh as MeshFastBuilder.
+ * Files that can't be mapped or that use features not handled here are rejected without
+ * touching the mesh, so that the caller can fall back to the stream based reader.
+ */
+class MeshExport ReaderMapped
+{
+public:
+    /*!
+     * \brief ReaderMapped
+     */
+    ReaderMapped(MeshKernel& kernel, Material*);
+    /*!
+     * \brief Load the mesh from a binary STL file
+     * \return true on success and false otherwise
+     */
+    bool LoadBinarySTL(const char* filename);
+    /*!
+     * \brief Load the mesh from a binary little-endian PLY file with triangles only.
+     * Files with colors are rejected if a material is set.
+     * \return true on success and false otherwise
+     */
+    bool LoadPLY(const char* filename);
+
+private:
+    MeshKernel& _kernel;
+    Material* _material;
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_IO_READER_MAPPED_H
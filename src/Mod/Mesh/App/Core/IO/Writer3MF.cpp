@@ -31,6 +31,7 @@
 #include "Core/MeshKernel.h"
 
 #include "Writer3MF.h"
+#include "WriterBlocks.h"
 
 
 using namespace MeshCore;
@@ -116,24 +117,36 @@ bool Writer3MF::SaveObject(std::ostream &str, int id, const MeshKernel& mesh) co
     str << Base::blanks(3) << "<mesh>\n";
 
     // vertices
+    WriterBlocks writer(str);
     str << Base::blanks(4) << "<vertices>\n";
-    std::size_t index = 0;
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it, ++index) {
-        str << Base::blanks(5) << "<vertex x=\"" << it->x
-                                    << "\" y=\"" << it->y
-                                    << "\" z=\"" << it->z
-                                    << "\" />\n";
-    }
+    bool ok = writer.Write(rPoints.size(), 3 * WriterBlocks::MaxFloatSize + 40,
+                           [&rPoints](std::size_t index, char* out) {
+        const MeshPoint& p = rPoints[index];
+        out = WriterBlocks::FormatString(out, "     <vertex x=\"");
+        out = WriterBlocks::FormatGeneral(out, p.x);
+        out = WriterBlocks::FormatString(out, "\" y=\"");
+        out = WriterBlocks::FormatGeneral(out, p.y);
+        out = WriterBlocks::FormatString(out, "\" z=\"");
+        out = WriterBlocks::FormatGeneral(out, p.z);
+        return WriterBlocks::FormatString(out, "\" />\n");
+    });
     str << Base::blanks(4) << "</vertices>\n";
 
     // facet indices
     str << Base::blanks(4) << "<triangles>\n";
-    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
-        str << Base::blanks(5) << "<triangle v1=\"" << it->_aulPoints[0]
-                                      << "\" v2=\"" << it->_aulPoints[1]
-                                      << "\" v3=\"" << it->_aulPoints[2]
-                                      << "\" />\n";
-    }
+    ok = ok && writer.Write(rFacets.size(), 3 * WriterBlocks::MaxUIntSize + 48,
+                            [&rFacets](std::size_t index, char* out) {
+        const MeshFacet& f = rFacets[index];
+        out = WriterBlocks::FormatString(out, "     <triangle v1=\"");
+        out = WriterBlocks::FormatUInt(out, f._aulPoints[0]);
+        out = WriterBlocks::FormatString(out, "\" v2=\"");
+        out = WriterBlocks::FormatUInt(out, f._aulPoints[1]);
+        out = WriterBlocks::FormatString(out, "\" v3=\"");
+        out = WriterBlocks::FormatUInt(out, f._aulPoints[2]);
+        return WriterBlocks::FormatString(out, "\" />\n");
+    });
+    if (!ok)
+        return false;
     str << Base::blanks(4) << "</triangles>\n";
 
     str << Base::blanks(3) << "</mesh>\n";
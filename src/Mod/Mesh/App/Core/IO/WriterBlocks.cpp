@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <cstdint>
+# include <cstdio>
+# include <ostream>
+# include <vector>
+#endif
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <Base/Sequencer.h>
+
+#include "WriterBlocks.h"
+
+
+using namespace MeshCore;
+
+WriterBlocks::WriterBlocks(std::ostream& out, std::size_t blockSize)
+  : _out(out)
+  , _blockSize(blockSize)
+{
+}
+
+bool WriterBlocks::Write(std::size_t count, std::size_t maxRecordSize, const Record& record)
+{
+    if (!_out || _out.bad())
+        return false;
+    if (count == 0)
+        return true;
+
+    std::size_t perBlock = std::max<std::size_t>(_blockSize / maxRecordSize, 1);
+    std::size_t numBlocks = (count + perBlock - 1) / perBlock;
+    std::size_t numBuffers = std::min<std::size_t>(numBlocks, std::max(1, QThread::idealThreadCount()) * 2);
+
+    // a formatted number may be followed by a terminating zero
+    struct Buffer
+    {
+        std::size_t block = 0;
+        std::vector<char> data;
+        std::size_t size = 0;
+    };
+    std::vector<Buffer> buffers(numBuffers);
+    for (auto& it : buffers)
+        it.data.resize(perBlock * maxRecordSize + 1);
+
+    auto format = [&](Buffer& buffer) {
+        std::size_t begin = buffer.block * perBlock;
+        std::size_t end = std::min(begin + perBlock, count);
+        char* str = buffer.data.data();
+        for (std::size_t i = begin; i < end; i++)
+            str = record(i, str);
+        buffer.size = static_cast<std::size_t>(str - buffer.data.data());
+    };
+
+    Base::SequencerLauncher seq("saving...", numBlocks);
+    for (std::size_t first = 0; first < numBlocks; first += numBuffers) {
+        std::size_t last = std::min(first + numBuffers, numBlocks);
+        for (std::size_t i = first; i < last; i++)
+            buffers[i - first].block = i;
+        if (last - first > 1)
+            QtConcurrent::blockingMap(buffers.begin(), buffers.begin() + (last - first), format);
+        else
+            format(buffers.front());
+
+        for (std::size_t i = first; i < last; i++) {
+            const Buffer& buffer = buffers[i - first];
+            _out.write(buffer.data.data(), static_cast<std::streamsize>(buffer.size));
+            if (!_out)
+                return false;
+            seq.next(true); // allow to cancel
+        }
+    }
+
+    return true;
+}
+
+char* WriterBlocks::FormatFloat(char* str, float value)
+{
+    // the product of a float and 10^6 is exact as double, so rounding it to an integer
+    // gives the same digits as printf
+    double scaled = static_cast<double>(value) * 1e6;
+    if (!std::isfinite(scaled) || std::fabs(scaled) >= 1e18)
+        return str + std::sprintf(str, "%f", static_cast<double>(value));
+
+    if (std::signbit(value))
+        *str++ = '-';
+    auto digits = static_cast<uint64_t>(std::nearbyint(std::fabs(scaled)));
+    str = FormatUInt(str, digits / 1000000);
+    *str++ = '.';
+    auto fraction = static_cast<unsigned>(digits % 1000000);
+    for (int i = 5; i >= 0; i--) {
+        str[i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+    return str + 6;
+}
+
+char* WriterBlocks::FormatGeneral(char* str, float value)
+{
+    return str + std::sprintf(str, "%g", static_cast<double>(value));
+}
+
+char* WriterBlocks::FormatUInt(char* str, std::uint64_t value)
+{
+    char digits[MaxUIntSize];
+    int len = 0;
+    do {
+        digits[len++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    while (value != 0);
+    while (len > 0)
+        *str++ = digits[--len];
+    return str;
+}
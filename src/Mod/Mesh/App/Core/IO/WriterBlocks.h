@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef MESH_IO_WRITER_BLOCKS_H
+#define MESH_IO_WRITER_BLOCKS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iosfwd>
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace MeshCore
+{
+
+/** Writes the records of a mesh file in blocks.
+ * The records of a block are formatted into a preallocated buffer. Several blocks are
+ * formatted in parallel and then written in order, with one write() call per block.
+ * For text formats the Format functions replace the iostream number formatting.
+ */
+class MeshExport WriterBlocks
+{
+public:
+    /// Formats the record with the given index at the position and returns the end of it
+    using Record = std::function<char*(std::size_t, char*)>;
+
+    /// Upper limit of the characters written by FormatFloat or FormatGeneral
+    static constexpr std::size_t MaxFloatSize = 48;
+    /// Upper limit of the characters written by FormatUInt
+    static constexpr std::size_t MaxUIntSize = 20;
+
+    /*!
+     * \brief WriterBlocks
+     * \param blockSize the size of a block in bytes
+     */
+    explicit WriterBlocks(std::ostream& out, std::size_t blockSize = 1 << 22);
+    /*!
+     * \brief Write \a count records, each one with at most \a maxRecordSize bytes.
+     * \return true if the data could be written successfully, false otherwise.
+     */
+    bool Write(std::size_t count, std::size_t maxRecordSize, const Record& record);
+
+    /*!
+     * \brief Writes the number with six decimals, like an ostream with std::fixed and
+     * precision(6) does.
+     */
+    static char* FormatFloat(char* str, float value);
+    /*!
+     * \brief Writes the number with six significant digits, like an ostream with the
+     * default format does.
+     */
+    static char* FormatGeneral(char* str, float value);
+    static char* FormatUInt(char* str, std::uint64_t value);
+    static char* FormatString(char* str, const char* text)
+    {
+        std::size_t len = std::strlen(text);
+        std::memcpy(str, text, len);
+        return str + len;
+    }
+
+private:
+    std::ostream& _out;
+    std::size_t _blockSize;
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_IO_WRITER_BLOCKS_H
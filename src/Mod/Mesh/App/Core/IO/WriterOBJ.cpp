@@ -25,8 +25,9 @@
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
-#include "Core/Iterator.h"
+#include "Core/MeshKernel.h"
 
+#include "WriterBlocks.h"
 #include "WriterOBJ.h"
 
 
@@ -47,6 +48,19 @@ struct WriterOBJ::Color_Less
     }
 };
 
+namespace {
+
+char* FormatPoint(char* str, const Base::Vector3f& pt)
+{
+    str = WriterBlocks::FormatFloat(str, pt.x);
+    *str++ = ' ';
+    str = WriterBlocks::FormatFloat(str, pt.y);
+    *str++ = ' ';
+    return WriterBlocks::FormatFloat(str, pt.z);
+}
+
+}
+
 WriterOBJ::WriterOBJ(const MeshKernel& kernel, const Material* material)
   : _kernel(kernel)
   , _material(material)
@@ -74,7 +88,6 @@ bool WriterOBJ::Save(std::ostream& out)
     if (!out || out.bad())
         return false;
 
-    Base::SequencerLauncher seq("saving...", _kernel.CountPoints() + _kernel.CountFacets());
     bool exportColorPerVertex = false;
     bool exportColorPerFace = false;
 
@@ -111,20 +124,14 @@ bool WriterOBJ::Save(std::ostream& out)
         out << "mtllib " << _material->library << '\n';
     }
 
-    out.precision(6);
-    out.setf(std::ios::fixed | std::ios::showpoint);
-
     // vertices
-    Base::Vector3f pt;
-    std::size_t index = 0;
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it, ++index) {
-        if (this->apply_transform) {
-            pt = this->_transform * *it;
-        }
-        else {
-            pt.Set(it->x, it->y, it->z);
-        }
-
+    WriterBlocks writer(out);
+    bool ok = writer.Write(rPoints.size(), 3 * WriterBlocks::MaxFloatSize + 24,
+                           [&](std::size_t index, char* str) {
+        const MeshPoint& p = rPoints[index];
+        Base::Vector3f pt = this->apply_transform ? this->_transform * p : Base::Vector3f(p);
+        str = WriterBlocks::FormatString(str, "v ");
+        str = FormatPoint(str, pt);
         if (exportColorPerVertex) {
             App::Color c;
             if (_material->binding == MeshIO::PER_VERTEX) {
@@ -134,36 +141,49 @@ bool WriterOBJ::Save(std::ostream& out)
                 c = _material->diffuseColor.front();
             }
 
-            int r = static_cast<int>(c.r * 255.0f);
-            int g = static_cast<int>(c.g * 255.0f);
-            int b = static_cast<int>(c.b * 255.0f);
-
-            out << "v " << pt.x << " " << pt.y << " " << pt.z << " " << r << " " << g << " " << b << '\n';
-        }
-        else {
-            out << "v " << pt.x << " " << pt.y << " " << pt.z << '\n';
+            for (float value : {c.r, c.g, c.b}) {
+                *str++ = ' ';
+                str = WriterBlocks::FormatUInt(str, static_cast<int>(value * 255.0f));
+            }
         }
-        seq.next(true); // allow to cancel
-    }
+        *str++ = '\n';
+        return str;
+    });
+
     // Export normals
-    MeshFacetIterator clIter(_kernel), clEnd(_kernel);
-    const MeshGeomFacet* pclFacet;
-
-    clIter.Begin();
-    clEnd.End();
-
-    while (clIter < clEnd) {
-        pclFacet = &(*clIter);
-        out << "vn " << pclFacet->GetNormal().x << " "
-            << pclFacet->GetNormal().y << " "
-            << pclFacet->GetNormal().z << '\n';
-        ++clIter;
-        seq.next(true); // allow to cancel
-    }
+    ok = ok && writer.Write(rFacets.size(), 3 * WriterBlocks::MaxFloatSize + 8,
+                            [&](std::size_t index, char* str) {
+        const MeshFacet& f = rFacets[index];
+        const MeshPoint& p0 = rPoints[f._aulPoints[0]];
+        Base::Vector3f normal = (rPoints[f._aulPoints[1]] - p0) % (rPoints[f._aulPoints[2]] - p0);
+        normal.Normalize();
+        str = WriterBlocks::FormatString(str, "vn ");
+        str = FormatPoint(str, normal);
+        *str++ = '\n';
+        return str;
+    });
+    if (!ok)
+        return false;
+
+    // facet indices (no texture and normal indices) of the facet with the given index
+    auto formatFacet = [&rFacets](char* str, FacetIndex index) {
+        const MeshFacet& f = rFacets[index];
+        *str++ = 'f';
+        for (int i = 0; i < 3; i++) {
+            *str++ = ' ';
+            str = WriterBlocks::FormatUInt(str, f._aulPoints[i] + 1);
+            str = WriterBlocks::FormatString(str, "//");
+            str = WriterBlocks::FormatUInt(str, index + 1);
+        }
+        *str++ = '\n';
+        return str;
+    };
+    const std::size_t facetSize = 6 * WriterBlocks::MaxUIntSize + 16;
 
     if (_groups.empty()) {
         if (exportColorPerFace) {
             // facet indices (no texture and normal indices)
+            Base::SequencerLauncher seq("saving...", rFacets.size());
 
             // make sure to use the 'usemtl' statement as less often as possible
             std::vector<App::Color> colors = _material->diffuseColor;
@@ -190,19 +210,15 @@ bool WriterOBJ::Save(std::ostream& out)
             }
         }
         else {
-            // facet indices (no texture and normal indices)
-            std::size_t faceIdx = 1;
-            for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
-                out << "f " << it->_aulPoints[0]+1 << "//" << faceIdx << " "
-                            << it->_aulPoints[1]+1 << "//" << faceIdx << " "
-                            << it->_aulPoints[2]+1 << "//" << faceIdx << '\n';
-                seq.next(true); // allow to cancel
-                faceIdx++;
-            }
+            return writer.Write(rFacets.size(), facetSize, [&](std::size_t index, char* str) {
+                return formatFacet(str, index);
+            });
         }
     }
     else {
         if (exportColorPerFace) {
+            Base::SequencerLauncher seq("saving...", rFacets.size());
+
             // make sure to use the 'usemtl' statement as less often as possible
             std::vector<App::Color> colors = _material->diffuseColor;
             std::sort(colors.begin(), colors.end(), Color_Less());
@@ -235,13 +251,11 @@ bool WriterOBJ::Save(std::ostream& out)
         else {
             for (std::vector<Group>::const_iterator gt = _groups.begin(); gt != _groups.end(); ++gt) {
                 out << "g " << Base::Tools::escapedUnicodeFromUtf8(gt->name.c_str()) << '\n';
-                for (std::vector<FacetIndex>::const_iterator it = gt->indices.begin(); it != gt->indices.end(); ++it) {
-                    const MeshFacet& f = rFacets[*it];
-                    out << "f " << f._aulPoints[0]+1 << "//" << *it + 1 << " "
-                                << f._aulPoints[1]+1 << "//" << *it + 1 << " "
-                                << f._aulPoints[2]+1 << "//" << *it + 1 << '\n';
-                    seq.next(true); // allow to cancel
-                }
+                const std::vector<FacetIndex>& indices = gt->indices;
+                if (!writer.Write(indices.size(), facetSize, [&](std::size_t index, char* str) {
+                    return formatFacet(str, indices[index]);
+                }))
+                    return false;
             }
         }
     }
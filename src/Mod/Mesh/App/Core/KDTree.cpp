@@ -24,6 +24,13 @@
 #ifdef _MSC_VER
 # pragma warning(disable : 4396)
 #endif
+#ifndef _PreComp_
+# include <algorithm>
+# include <cfloat>
+# include <cstdint>
+#endif
+
+#include <Base/Functional.h>
 
 #include <kdtree++/kdtree.hpp>
 #include "KDTree.h"
@@ -31,6 +38,52 @@
 
 using namespace MeshCore;
 
+namespace {
+
+// inserts two zero bits in front of each of the lower 21 bits
+std::uint64_t SpreadBits(std::uint64_t v)
+{
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffff;
+    v = (v | v << 16) & 0x1f0000ff0000ff;
+    v = (v | v << 8)  & 0x100f00f00f00f00f;
+    v = (v | v << 4)  & 0x10c30c30c30c30c3;
+    v = (v | v << 2)  & 0x1249249249249249;
+    return v;
+}
+
+template <typename Points>
+std::vector<std::size_t> MortonOrder(const Points& points)
+{
+    Base::BoundBox3f box;
+    for (const auto& it : points)
+        box.Add(it);
+
+    const float cells = float(1 << 21) - 1.0f;
+    float dx = box.LengthX() > 0.0f ? cells / box.LengthX() : 0.0f;
+    float dy = box.LengthY() > 0.0f ? cells / box.LengthY() : 0.0f;
+    float dz = box.LengthZ() > 0.0f ? cells / box.LengthZ() : 0.0f;
+
+    std::vector<std::pair<std::uint64_t, std::size_t> > codes(points.size());
+    Base::forEachChunk(points.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Base::Vector3f& p = points[i];
+            std::uint64_t x = static_cast<std::uint64_t>((p.x - box.MinX) * dx);
+            std::uint64_t y = static_cast<std::uint64_t>((p.y - box.MinY) * dy);
+            std::uint64_t z = static_cast<std::uint64_t>((p.z - box.MinZ) * dz);
+            codes[i] = std::make_pair(SpreadBits(x) | SpreadBits(y) << 1 | SpreadBits(z) << 2, i);
+        }
+    });
+    std::sort(codes.begin(), codes.end());
+
+    std::vector<std::size_t> order(codes.size());
+    for (std::size_t i = 0; i < codes.size(); i++)
+        order[i] = codes[i].second;
+    return order;
+}
+
+}
+
 struct Point3d
 {
    using value_type = float;
@@ -177,6 +230,41 @@ PointIndex MeshKDTree::FindNearest(const Base::Vector3f& p, float max_dist,
     return index;
 }
 
+void MeshKDTree::FindNearest(const std::vector<Base::Vector3f>& points, float max_dist,
+                             std::vector<PointIndex>& indices, std::vector<float>& dist) const
+{
+    FindNearestBatch(points, max_dist, indices, dist);
+}
+
+void MeshKDTree::FindNearest(const MeshPointArray& points, float max_dist,
+                             std::vector<PointIndex>& indices, std::vector<float>& dist) const
+{
+    FindNearestBatch(points, max_dist, indices, dist);
+}
+
+template <typename Points>
+void MeshKDTree::FindNearestBatch(const Points& points, float max_dist,
+                                  std::vector<PointIndex>& indices, std::vector<float>& dist) const
+{
+    indices.assign(points.size(), POINT_INDEX_MAX);
+    dist.assign(points.size(), FLT_MAX);
+    if (points.empty() || IsEmpty())
+        return;
+
+    std::vector<std::size_t> order = MortonOrder(points);
+    Base::forEachChunk(order.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t index = order[i];
+            std::pair<MyKDTree::const_iterator, MyKDTree::distance_type> it =
+                d->kd_tree.find_nearest(Point3d(points[index],0), max_dist);
+            if (it.first != d->kd_tree.end()) {
+                indices[index] = it.first->i;
+                dist[index] = it.second;
+            }
+        }
+    });
+}
+
 PointIndex MeshKDTree::FindExact(const Base::Vector3f& p) const
 {
     MyKDTree::const_iterator it =
@@ -48,9 +48,24 @@ public:
     PointIndex FindNearest(const Base::Vector3f& p, Base::Vector3f& n, float&) const;
     PointIndex FindNearest(const Base::Vector3f& p, float max_dist,
                               Base::Vector3f& n, float&) const;
+    /** Searches for the nearest point of each of \a points within the distance \a max_dist.
+     * For a point without such a neighbour its index is POINT_INDEX_MAX and its distance is
+     * FLT_MAX. The queries are handled in the order of a Morton curve through their bounding
+     * box, so that consecutive queries mostly visit the same nodes, and big batches are
+     * handled in parallel.
+     */
+    void FindNearest(const std::vector<Base::Vector3f>& points, float max_dist,
+                     std::vector<PointIndex>& indices, std::vector<float>& dist) const;
+    void FindNearest(const MeshPointArray& points, float max_dist,
+                     std::vector<PointIndex>& indices, std::vector<float>& dist) const;
     PointIndex FindExact(const Base::Vector3f& p) const;
     void FindInRange(const Base::Vector3f&, float, std::vector<PointIndex>&) const;
 
+private:
+    template <typename Points>
+    void FindNearestBatch(const Points& points, float max_dist,
+                          std::vector<PointIndex>& indices, std::vector<float>& dist) const;
+
 private:
     class Private;
     Private* d;
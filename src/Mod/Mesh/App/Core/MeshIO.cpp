@@ -46,11 +46,14 @@
 #include <Base/Reader.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 #include <Base/Tools.h>
 #include <Base/Writer.h>
 #include "IO/Reader3MF.h"
+#include "IO/ReaderMapped.h"
 #include "IO/ReaderOBJ.h"
 #include "IO/Writer3MF.h"
+#include "IO/WriterBlocks.h"
 #include "IO/WriterInventor.h"
 #include "IO/WriterOBJ.h"
 #include <zipios++/gzipoutputstream.h>
@@ -192,7 +195,8 @@ bool MeshInput::LoadAny(const char* FileName)
         // read file
         bool ok = false;
         if (fi.hasExtension("stl") || fi.hasExtension("ast")) {
-            ok = LoadSTL(str);
+            ReaderMapped reader(_rclMesh, _material);
+            ok = reader.LoadBinarySTL(FileName) || LoadSTL(str);
         }
         else if (fi.hasExtension("iv")) {
             ok = LoadInventor( str );
@@ -215,7 +219,8 @@ bool MeshInput::LoadAny(const char* FileName)
             ok = LoadOFF( str );
         }
         else if (fi.hasExtension("ply")) {
-            ok = LoadPLY( str );
+            ReaderMapped reader(_rclMesh, _material);
+            ok = reader.LoadPLY(FileName) || LoadPLY( str );
         }
         else {
             throw Base::FileException("File extension not supported", FileName);
@@ -1619,6 +1624,35 @@ bool MeshInput::LoadCadmouldFE (std::ifstream &rstrIn)
 
 // --------------------------------------------------------------
 
+namespace MeshCore {
+
+/// Writes the coordinates of a point separated by blanks
+char* formatPoint(char* str, const Base::Vector3f& pt)
+{
+    str = WriterBlocks::FormatFloat(str, pt.x);
+    *str++ = ' ';
+    str = WriterBlocks::FormatFloat(str, pt.y);
+    *str++ = ' ';
+    return WriterBlocks::FormatFloat(str, pt.z);
+}
+
+/// Writes the color components in the range [0, 255] separated by blanks
+char* formatColor(char* str, const App::Color& c, bool alpha)
+{
+    str = WriterBlocks::FormatUInt(str, static_cast<int>(c.r * 255.0f));
+    *str++ = ' ';
+    str = WriterBlocks::FormatUInt(str, static_cast<int>(c.g * 255.0f));
+    *str++ = ' ';
+    str = WriterBlocks::FormatUInt(str, static_cast<int>(c.b * 255.0f));
+    if (alpha) {
+        *str++ = ' ';
+        str = WriterBlocks::FormatUInt(str, static_cast<int>(c.a * 255.0f));
+    }
+    return str;
+}
+
+}
+
 std::string MeshOutput::stl_header = "MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH-"
                                      "MESH-MESH-MESH-MESH-MESH-MESH-MESH-MESH\n";
 
@@ -1953,46 +1987,42 @@ bool MeshOutput::SaveFormat(std::ostream &str, MeshIO::Format fmt) const
 /** Saves the mesh object into an ASCII file. */
 bool MeshOutput::SaveAsciiSTL (std::ostream &rstrOut) const
 {
-    MeshFacetIterator clIter(_rclMesh), clEnd(_rclMesh);
-    clIter.Transform(this->_transform);
-    const MeshGeomFacet *pclFacet;
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
 
     if (!rstrOut || rstrOut.bad() || _rclMesh.CountFacets() == 0)
         return false;
 
-    rstrOut.precision(6);
-    rstrOut.setf(std::ios::fixed | std::ios::showpoint);
-    Base::SequencerLauncher seq("saving...", _rclMesh.CountFacets() + 1);
-
     if (this->objectName.empty())
         rstrOut << "solid Mesh\n";
     else
         rstrOut << "solid " << this->objectName << '\n';
 
-    clIter.Begin();
-    clEnd.End();
-    while (clIter < clEnd) {
-        pclFacet = &(*clIter);
-
-        // normal
-        rstrOut << "  facet normal " << pclFacet->GetNormal().x << " "
-                                     << pclFacet->GetNormal().y << " "
-                                     << pclFacet->GetNormal().z << '\n';
-        rstrOut << "    outer loop\n";
-
-        // vertices
+    // twelve numbers and the keywords
+    WriterBlocks writer(rstrOut);
+    bool ok = writer.Write(rFacets.size(), 12 * WriterBlocks::MaxFloatSize + 128,
+                           [&](std::size_t index, char* str) {
+        const MeshFacet& facet = rFacets[index];
+        Base::Vector3f points[3];
         for (int i = 0; i < 3; i++) {
-            rstrOut << "      vertex "  << pclFacet->_aclPoints[i].x << " "
-                                        << pclFacet->_aclPoints[i].y << " "
-                                        << pclFacet->_aclPoints[i].z << '\n';
+            const MeshPoint& p = rPoints[facet._aulPoints[i]];
+            points[i] = this->apply_transform ? this->_transform * p : Base::Vector3f(p);
         }
+        Base::Vector3f normal = (points[1] - points[0]) % (points[2] - points[0]);
+        normal.Normalize();
 
-        rstrOut << "    endloop\n";
-        rstrOut << "  endfacet\n";
-
-        ++clIter;
-        seq.next(true);// allow to cancel
-    }
+        str = WriterBlocks::FormatString(str, "  facet normal ");
+        str = formatPoint(str, normal);
+        str = WriterBlocks::FormatString(str, "\n    outer loop\n");
+        for (int i = 0; i < 3; i++) {
+            str = WriterBlocks::FormatString(str, "      vertex ");
+            str = formatPoint(str, points[i]);
+            *str++ = '\n';
+        }
+        return WriterBlocks::FormatString(str, "    endloop\n  endfacet\n");
+    });
+    if (!ok)
+        return false;
 
     rstrOut << "endsolid Mesh\n";
 
@@ -2002,18 +2032,13 @@ bool MeshOutput::SaveAsciiSTL (std::ostream &rstrOut) const
 /** Saves the mesh object into a binary file. */
 bool MeshOutput::SaveBinarySTL (std::ostream &rstrOut) const
 {
-    MeshFacetIterator clIter(_rclMesh), clEnd(_rclMesh);
-    clIter.Transform(this->_transform);
-    const MeshGeomFacet *pclFacet;
-    uint32_t i;
-    uint16_t usAtt;
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
     char szInfo[81];
 
     if (!rstrOut || rstrOut.bad() /*|| _rclMesh.CountFacets() == 0*/)
         return false;
 
-    Base::SequencerLauncher seq("saving...", _rclMesh.CountFacets() + 1);
-
     // stl_header has a length of 80
     strcpy(szInfo, stl_header.c_str());
     rstrOut.write(szInfo, std::strlen(szInfo));
@@ -2021,32 +2046,29 @@ bool MeshOutput::SaveBinarySTL (std::ostream &rstrOut) const
     uint32_t uCtFts = (uint32_t)_rclMesh.CountFacets();
     rstrOut.write((const char*)&uCtFts, sizeof(uCtFts));
 
-    usAtt = 0;
-    clIter.Begin();
-    clEnd.End();
-    while (clIter < clEnd) {
-        pclFacet = &(*clIter);
-        // normal
-        Base::Vector3f normal = pclFacet->GetNormal();
-        rstrOut.write((const char*)&(normal.x), sizeof(float));
-        rstrOut.write((const char*)&(normal.y), sizeof(float));
-        rstrOut.write((const char*)&(normal.z), sizeof(float));
-
-        // vertices
-        for (i = 0; i < 3; i++) {
-            rstrOut.write((const char*)&(pclFacet->_aclPoints[i].x), sizeof(float));
-            rstrOut.write((const char*)&(pclFacet->_aclPoints[i].y), sizeof(float));
-            rstrOut.write((const char*)&(pclFacet->_aclPoints[i].z), sizeof(float));
+    // the normal, the vertices and the attribute
+    WriterBlocks writer(rstrOut);
+    return writer.Write(rFacets.size(), 50, [&](std::size_t index, char* str) {
+        const MeshFacet& facet = rFacets[index];
+        Base::Vector3f points[3];
+        for (int i = 0; i < 3; i++) {
+            const MeshPoint& p = rPoints[facet._aulPoints[i]];
+            points[i] = this->apply_transform ? this->_transform * p : Base::Vector3f(p);
         }
+        Base::Vector3f normal = (points[1] - points[0]) % (points[2] - points[0]);
+        normal.Normalize();
 
-        // attribute
-        rstrOut.write((const char*)&usAtt, sizeof(usAtt));
-
-        ++clIter;
-        seq.next(true); // allow to cancel
-    }
-
-    return true;
+        float record[12] = {normal.x, normal.y, normal.z};
+        for (int i = 0; i < 3; i++) {
+            record[3 * i + 3] = points[i].x;
+            record[3 * i + 4] = points[i].y;
+            record[3 * i + 5] = points[i].z;
+        }
+        std::memcpy(str, record, sizeof(record));
+        str[48] = 0;
+        str[49] = 0;
+        return str + 50;
+    });
 }
 
 /** Saves an OBJ file. */
@@ -2089,8 +2111,6 @@ bool MeshOutput::SaveSMF (std::ostream &out) const
     if (!out || out.bad())
         return false;
 
-    Base::SequencerLauncher seq("saving...", _rclMesh.CountPoints() + _rclMesh.CountFacets());
-
     // Header
     out << "#$SMF 1.0\n";
     out << "#$vertices " << rPoints.size() << '\n';
@@ -2098,33 +2118,29 @@ bool MeshOutput::SaveSMF (std::ostream &out) const
     out << "#\n";
     out << "# Created by FreeCAD <http://www.freecad.org>\n";
 
-    out.precision(6);
-    out.setf(std::ios::fixed | std::ios::showpoint);
-
     // vertices
-    Base::Vector3f pt;
-    std::size_t index = 0;
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it, ++index) {
-        if (this->apply_transform) {
-            pt = this->_transform * *it;
-        }
-        else {
-            pt.Set(it->x, it->y, it->z);
-        }
-
-        out << "v " << pt.x << " " << pt.y << " " << pt.z << '\n';
-        seq.next(true); // allow to cancel
-    }
+    WriterBlocks writer(out);
+    bool ok = writer.Write(rPoints.size(), 3 * WriterBlocks::MaxFloatSize + 8,
+                           [&](std::size_t index, char* str) {
+        const MeshPoint& p = rPoints[index];
+        str = WriterBlocks::FormatString(str, "v ");
+        str = formatPoint(str, this->apply_transform ? this->_transform * p : Base::Vector3f(p));
+        *str++ = '\n';
+        return str;
+    });
 
     // facet indices
-    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
-        out << "f " << it->_aulPoints[0]+1 << " "
-                    << it->_aulPoints[1]+1 << " "
-                    << it->_aulPoints[2]+1 << '\n';
-        seq.next(true); // allow to cancel
-    }
-
-    return true;
+    return ok && writer.Write(rFacets.size(), 3 * WriterBlocks::MaxUIntSize + 8,
+                              [&](std::size_t index, char* str) {
+        const MeshFacet& f = rFacets[index];
+        *str++ = 'f';
+        for (int i = 0; i < 3; i++) {
+            *str++ = ' ';
+            str = WriterBlocks::FormatUInt(str, f._aulPoints[i] + 1);
+        }
+        *str++ = '\n';
+        return str;
+    });
 }
 
 /** Saves an Asymptote file. */
@@ -2241,8 +2257,6 @@ bool MeshOutput::SaveOFF (std::ostream &out) const
     if (!out || out.bad())
         return false;
 
-    Base::SequencerLauncher seq("saving...", _rclMesh.CountPoints() + _rclMesh.CountFacets());
-
     bool exportColor = false;
     if (_material) {
         if (_material->binding == MeshIO::PER_FACE) {
@@ -2273,47 +2287,38 @@ bool MeshOutput::SaveOFF (std::ostream &out) const
     out << rPoints.size() << " " << rFacets.size() << " 0\n";
 
     // vertices
-    Base::Vector3f pt;
-    std::size_t index = 0;
-    for (MeshPointArray::_TConstIterator it = rPoints.begin(); it != rPoints.end(); ++it, ++index) {
-        if (this->apply_transform) {
-            pt = this->_transform * *it;
-        }
-        else {
-            pt.Set(it->x, it->y, it->z);
-        }
-
+    WriterBlocks writer(out);
+    bool ok = writer.Write(rPoints.size(), 3 * WriterBlocks::MaxFloatSize + 24,
+                           [&](std::size_t index, char* str) {
+        const MeshPoint& p = rPoints[index];
+        Base::Vector3f pt = this->apply_transform ? this->_transform * p : Base::Vector3f(p);
+        str = WriterBlocks::FormatGeneral(str, pt.x);
+        *str++ = ' ';
+        str = WriterBlocks::FormatGeneral(str, pt.y);
+        *str++ = ' ';
+        str = WriterBlocks::FormatGeneral(str, pt.z);
         if (exportColor) {
-            App::Color c;
-            if (_material->binding == MeshIO::PER_VERTEX) {
-                c = _material->diffuseColor[index];
-            }
-            else {
-                c = _material->diffuseColor.front();
-            }
-
-            int r = static_cast<int>(c.r * 255.0f);
-            int g = static_cast<int>(c.g * 255.0f);
-            int b = static_cast<int>(c.b * 255.0f);
-            int a = static_cast<int>(c.a * 255.0f);
-
-            out << pt.x << " " << pt.y << " " << pt.z << " " << r << " " << g << " " << b << " " << a << '\n';
-        }
-        else {
-            out << pt.x << " " << pt.y << " " << pt.z << '\n';
+            const App::Color& c = _material->binding == MeshIO::PER_VERTEX
+                ? _material->diffuseColor[index] : _material->diffuseColor.front();
+            *str++ = ' ';
+            str = formatColor(str, c, true);
         }
-        seq.next(true); // allow to cancel
-    }
+        *str++ = '\n';
+        return str;
+    });
 
     // facet indices (no texture and normal indices)
-    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
-        out << "3 " << it->_aulPoints[0]
-            << " " << it->_aulPoints[1]
-            << " " << it->_aulPoints[2] << '\n';
-        seq.next(true); // allow to cancel
-    }
-
-    return true;
+    return ok && writer.Write(rFacets.size(), 3 * WriterBlocks::MaxUIntSize + 8,
+                              [&](std::size_t index, char* str) {
+        const MeshFacet& f = rFacets[index];
+        *str++ = '3';
+        for (int i = 0; i < 3; i++) {
+            *str++ = ' ';
+            str = WriterBlocks::FormatUInt(str, f._aulPoints[i]);
+        }
+        *str++ = '\n';
+        return str;
+    });
 }
 
 bool MeshOutput::SaveBinaryPLY (std::ostream &out) const
@@ -2342,38 +2347,39 @@ bool MeshOutput::SaveBinaryPLY (std::ostream &out) const
         << "property list uchar int vertex_index\n"
         << "end_header\n";
 
-    Base::OutputStream os(out);
-    os.setByteOrder(Base::Stream::LittleEndian);
-
-    for (std::size_t i = 0; i < v_count; i++) {
-        const MeshPoint& p = rPoints[i];
-        if (this->apply_transform) {
-            Base::Vector3f pt = this->_transform * p;
-            os << pt.x << pt.y << pt.z;
-        }
-        else {
-            os << p.x << p.y << p.z;
-        }
+    bool swap = Base::SwapOrder() == HIGH_ENDIAN;
+    std::size_t vertexSize = 3 * sizeof(float) + (saveVertexColor ? 3 : 0);
+    WriterBlocks writer(out);
+    bool ok = writer.Write(v_count, vertexSize, [&](std::size_t index, char* str) {
+        const MeshPoint& p = rPoints[index];
+        Base::Vector3f pt = this->apply_transform ? this->_transform * p : Base::Vector3f(p);
+        float coords[3] = {pt.x, pt.y, pt.z};
+        if (swap) {
+            for (float& c : coords)
+                Base::SwapEndian(c);
+        }
+        std::memcpy(str, coords, sizeof(coords));
+        str += sizeof(coords);
         if (saveVertexColor) {
-            const App::Color& c = _material->diffuseColor[i];
-            uint8_t r = uint8_t(255.0f * c.r);
-            uint8_t g = uint8_t(255.0f * c.g);
-            uint8_t b = uint8_t(255.0f * c.b);
-            os << r << g << b;
+            const App::Color& c = _material->diffuseColor[index];
+            *str++ = static_cast<char>(uint8_t(255.0f * c.r));
+            *str++ = static_cast<char>(uint8_t(255.0f * c.g));
+            *str++ = static_cast<char>(uint8_t(255.0f * c.b));
         }
-    }
-    unsigned char n = 3;
-    int f1, f2, f3;
-    for (std::size_t i = 0; i < f_count; i++) {
-        const MeshFacet& f = rFacets[i];
-        f1 = (int)f._aulPoints[0];
-        f2 = (int)f._aulPoints[1];
-        f3 = (int)f._aulPoints[2];
-        os << n;
-        os << f1 << f2 << f3;
-    }
+        return str;
+    });
 
-    return true;
+    return ok && writer.Write(f_count, 1 + 3 * sizeof(int32_t), [&](std::size_t index, char* str) {
+        const MeshFacet& f = rFacets[index];
+        int32_t indices[3] = {(int32_t)f._aulPoints[0], (int32_t)f._aulPoints[1], (int32_t)f._aulPoints[2]};
+        if (swap) {
+            for (int32_t& i : indices)
+                Base::SwapEndian(i);
+        }
+        *str++ = 3;
+        std::memcpy(str, indices, sizeof(indices));
+        return str + sizeof(indices);
+    });
 }
 
 bool MeshOutput::SaveAsciiPLY (std::ostream &out) const
@@ -2403,50 +2409,28 @@ bool MeshOutput::SaveAsciiPLY (std::ostream &out) const
         << "property list uchar int vertex_index\n"
         << "end_header\n";
 
-    out.precision(6);
-    out.setf(std::ios::fixed | std::ios::showpoint);
-    if (saveVertexColor) {
-        for (std::size_t i = 0; i < v_count; i++) {
-            const MeshPoint& p = rPoints[i];
-            if (this->apply_transform) {
-                Base::Vector3f pt = this->_transform * p;
-                out << pt.x << " " << pt.y << " " << pt.z;
-            }
-            else {
-                out << p.x << " " << p.y << " " << p.z;
-            }
-
-            const App::Color& c = _material->diffuseColor[i];
-            int r = (int)(255.0f * c.r);
-            int g = (int)(255.0f * c.g);
-            int b = (int)(255.0f * c.b);
-            out << " " << r << " " << g << " " << b << '\n';
-        }
-    }
-    else {
-        for (std::size_t i = 0; i < v_count; i++) {
-            const MeshPoint& p = rPoints[i];
-            if (this->apply_transform) {
-                Base::Vector3f pt = this->_transform * p;
-                out << pt.x << " " << pt.y << " " << pt.z << '\n';
-            }
-            else {
-                out << p.x << " " << p.y << " " << p.z << '\n';
-            }
+    WriterBlocks writer(out);
+    bool ok = writer.Write(v_count, 3 * WriterBlocks::MaxFloatSize + 16, [&](std::size_t index, char* str) {
+        const MeshPoint& p = rPoints[index];
+        str = formatPoint(str, this->apply_transform ? this->_transform * p : Base::Vector3f(p));
+        if (saveVertexColor) {
+            *str++ = ' ';
+            str = formatColor(str, _material->diffuseColor[index], false);
         }
-    }
-
-    unsigned int n = 3;
-    int f1, f2, f3;
-    for (std::size_t i = 0; i < f_count; i++) {
-        const MeshFacet& f = rFacets[i];
-        f1 = (int)f._aulPoints[0];
-        f2 = (int)f._aulPoints[1];
-        f3 = (int)f._aulPoints[2];
-        out << n << " " << f1 << " " << f2 << " " << f3 << '\n';
-    }
+        *str++ = '\n';
+        return str;
+    });
 
-    return true;
+    return ok && writer.Write(f_count, 3 * WriterBlocks::MaxUIntSize + 8, [&](std::size_t index, char* str) {
+        const MeshFacet& f = rFacets[index];
+        *str++ = '3';
+        for (int i = 0; i < 3; i++) {
+            *str++ = ' ';
+            str = WriterBlocks::FormatUInt(str, f._aulPoints[i]);
+        }
+        *str++ = '\n';
+        return str;
+    });
 }
 
 bool MeshOutput::SaveMeshNode (std::ostream &rstrOut)
@@ -25,6 +25,8 @@
 #include <algorithm>
 #endif
 
+#include <Base/Functional.h>
+
 #include "Segmentation.h"
 #include "Algorithm.h"
 #include "Approximation.h"
@@ -538,6 +540,14 @@ bool MeshSurfaceVisitor::Visit (const MeshFacet & face, const MeshFacet &,
 
 void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm)
 {
+    bool stateless = std::all_of(segm.begin(), segm.end(), [](const MeshSurfaceSegmentPtr& it) {
+        return it->IsStateless();
+    });
+    if (stateless) {
+        FindStatelessSegments(segm);
+        return;
+    }
+
     // reset VISIT flags
     FacetIndex startFacet;
     MeshCore::MeshAlgorithm cAlgo(myKernel);
@@ -592,3 +602,61 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         }
     }
 }
+
+void MeshSegmentAlgorithm::FindStatelessSegments(std::vector<MeshSurfaceSegmentPtr>& segm)
+{
+    // Does the same as FindSegments() but tests all facets in parallel before growing
+    // the regions and uses its own flags instead of the VISIT flags of the facets.
+    const MeshCore::MeshFacetArray& rFAry = myKernel.GetFacets();
+    std::size_t numFacets = rFAry.size();
+    std::vector<unsigned char> visited(numFacets, 0);
+    std::vector<unsigned char> accepted(numFacets);
+    std::vector<FacetIndex> resetVisited;
+    std::vector<FacetIndex> currentLevel, nextLevel;
+
+    for (std::vector<MeshSurfaceSegmentPtr>::iterator it = segm.begin(); it != segm.end(); ++it) {
+        for (FacetIndex index : resetVisited)
+            visited[index] = 0;
+        resetVisited.clear();
+
+        const MeshSurfaceSegment& surface = **it;
+        Base::forEachChunk(numFacets, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++)
+                accepted[i] = surface.TestFacet(rFAry[i]) ? 1 : 0;
+        });
+
+        for (FacetIndex startFacet = 0; startFacet < numFacets; startFacet++) {
+            if (visited[startFacet])
+                continue;
+
+            // collect all facets of the same geometry in the order of MeshKernel::VisitNeighbourFacets
+            std::vector<FacetIndex> indices;
+            indices.push_back(startFacet);
+            visited[startFacet] = 1;
+            currentLevel.assign(1, startFacet);
+            while (!currentLevel.empty()) {
+                for (FacetIndex index : currentLevel) {
+                    for (FacetIndex neighbour : rFAry[index]._aulNeighbours) {
+                        if (neighbour >= numFacets)
+                            continue;
+                        if (!accepted[neighbour] || visited[neighbour])
+                            continue;
+                        visited[neighbour] = 1;
+                        nextLevel.push_back(neighbour);
+                        indices.push_back(neighbour);
+                    }
+                }
+                currentLevel.swap(nextLevel);
+                nextLevel.clear();
+            }
+
+            // add or discard the segment
+            if (indices.size() <= 1) {
+                resetVisited.push_back(startFacet);
+            }
+            else {
+                (*it)->AddSegment(indices);
+            }
+        }
+    }
+}
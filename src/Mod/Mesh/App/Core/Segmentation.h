@@ -50,6 +50,10 @@ public:
     virtual void Initialize(FacetIndex);
     virtual bool TestInitialFacet(FacetIndex) const;
     virtual void AddFacet(const MeshFacet& rclFacet);
+    /** Returns true if TestFacet() only depends on the facet itself but not on the facets
+     * added so far. Then all facets can be tested in advance.
+     */
+    virtual bool IsStateless() const { return false; }
     void AddSegment(const std::vector<FacetIndex>&);
     const std::vector<MeshSegment>& GetSegments() const { return segments; }
     MeshSegment FindSegment(FacetIndex) const;
@@ -192,6 +196,7 @@ class MeshExport MeshCurvatureSurfaceSegment : public MeshSurfaceSegment
 public:
     MeshCurvatureSurfaceSegment(const std::vector<CurvatureInfo>& ci, unsigned long minFacets)
         : MeshSurfaceSegment(minFacets), info(ci) {}
+    bool IsStateless() const override { return true; }
 
 protected:
     const std::vector<CurvatureInfo>& info;
@@ -274,6 +279,9 @@ public:
     explicit MeshSegmentAlgorithm(const MeshKernel& kernel) : myKernel(kernel) {}
     void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
 
+private:
+    void FindStatelessSegments(std::vector<MeshSurfaceSegmentPtr>&);
+
 private:
     const MeshKernel& myKernel;
 };
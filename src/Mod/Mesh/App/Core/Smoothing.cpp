@@ -21,7 +21,11 @@
  ***************************************************************************/
 
 #include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+#endif
 
+#include <Base/Functional.h>
 #include <Base/Tools.h>
 
 #include "Smoothing.h"
@@ -63,107 +67,64 @@ PlaneFitSmoothing::~PlaneFitSmoothing()
 
 void PlaneFitSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
-
-    for (unsigned int i=0; i<iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3)
-                continue;
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
-
-            float scale = 1.0f/(static_cast<float>(cv.size())+1.0f);
-            center.Scale(scale,scale,scale);
-
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
-
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N*L < 0.0f)
-                N.Scale(-1.0, -1.0, -1.0);
-
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(fabs(this->maximum),fabs(N*L));
-            N.Scale(d,d,d);
-
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
-
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
-    }
+    std::vector<PointIndex> point_indices(kernel.CountPoints());
+    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<PointIndex>(0));
+    SmoothPoints(iterations, point_indices);
 }
 
 void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
+    // each point is moved once per iteration, the chunks must not share points
+    std::vector<PointIndex> indices(point_indices);
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
 
-    MeshCore::MeshPointIterator v_it(kernel);
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    MeshCore::MeshPointArray PointArray = points;
     MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
     for (unsigned int i=0; i<iterations; i++) {
-        Base::Vector3f N, L;
-        for (std::vector<PointIndex>::const_iterator it = point_indices.begin(); it != point_indices.end(); ++it) {
-            v_it.Set(*it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3)
-                continue;
-
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
+        Base::forEachChunk(indices.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+            Base::Vector3f N, L;
+            for (std::size_t j = begin; j < end; j++) {
+                PointIndex pos = indices[j];
+                const MeshPoint& pnt = points[pos];
+                MeshCore::MeshRefIndices::Range cv = vv_it[pos];
+                if (cv.size() < 3)
+                    continue;
+
+                MeshCore::PlaneFit pf;
+                pf.AddPoint(pnt);
+                Base::Vector3f center = pnt;
+                for (PointIndex index : cv) {
+                    pf.AddPoint(points[index]);
+                    center += points[index];
+                }
 
-            float scale = 1.0f/(static_cast<float>(cv.size())+1.0f);
-            center.Scale(scale,scale,scale);
+                float scale = 1.0f/(static_cast<float>(cv.size())+1.0f);
+                center.Scale(scale,scale,scale);
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+                // get the mean plane of the current vertex with the surrounding vertices
+                pf.Fit();
+                N = pf.GetNormal();
+                N.Normalize();
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N*L < 0.0f)
-                N.Scale(-1.0, -1.0, -1.0);
+                // look in which direction we should move the vertex
+                L.Set(pnt.x - center.x, pnt.y - center.y, pnt.z - center.z);
+                if (N*L < 0.0f)
+                    N.Scale(-1.0, -1.0, -1.0);
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(fabs(this->maximum),fabs(N*L));
-            N.Scale(d,d,d);
+                // maximum value to move is distance to mean plane
+                float d = std::min<float>(fabs(this->maximum),fabs(N*L));
+                N.Scale(d,d,d);
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+                PointArray[pos].Set(pnt.x - N.x, pnt.y - N.y, pnt.z - N.z);
+            }
+        });
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
+        // assign values without affecting the fit of the other points
+        for (PointIndex pos : indices) {
+            kernel.SetPoint(pos, PointArray[pos]);
         }
     }
 }
@@ -180,81 +141,87 @@ LaplaceSmoothing::~LaplaceSmoothing()
 void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
                                 const MeshRefPointToFacets& vf_it, double stepsize)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it,
-    v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it,++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-v_it->x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-v_it->y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-v_it->z);
-        }
-
-        float x = static_cast<float>(static_cast<double>(v_it->x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z)+stepsize*delz);
-        kernel.SetPoint(pos,x,y,z);
-    }
+    std::vector<Base::Vector3f> buffer;
+    Umbrella(vv_it, stepsize, InnerPoints(vv_it, vf_it), buffer);
 }
 
 void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
                                 const MeshRefPointToFacets& vf_it, double stepsize,
                                 const std::vector<PointIndex>& point_indices)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (std::vector<PointIndex>::const_iterator pos = point_indices.begin(); pos != point_indices.end(); ++pos) {
-        const std::set<PointIndex>& cv = vv_it[*pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[*pos].size()) {
-            // do nothing for border points
-            continue;
-        }
+    std::vector<Base::Vector3f> buffer;
+    Umbrella(vv_it, stepsize, InnerPoints(vv_it, vf_it, point_indices), buffer);
+}
 
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
+std::vector<PointIndex> LaplaceSmoothing::InnerPoints(const MeshRefPointToPoints& vv_it,
+                                                      const MeshRefPointToFacets& vf_it) const
+{
+    std::vector<PointIndex> point_indices(kernel.CountPoints());
+    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<PointIndex>(0));
+    return InnerPoints(vv_it, vf_it, point_indices);
+}
 
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-(v_beg[*pos]).x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-(v_beg[*pos]).y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-(v_beg[*pos]).z);
+std::vector<PointIndex> LaplaceSmoothing::InnerPoints(const MeshRefPointToPoints& vv_it,
+                                                      const MeshRefPointToFacets& vf_it,
+                                                      const std::vector<PointIndex>& point_indices) const
+{
+    // the chunks of Umbrella() must not share points
+    std::vector<PointIndex> indices(point_indices);
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    std::vector<PointIndex> inner;
+    std::copy_if(indices.begin(), indices.end(), std::back_inserter(inner),
+                 [&](PointIndex pos) {
+        std::size_t n_count = vv_it[pos].size();
+        // do nothing for border points
+        return n_count >= 3 && n_count == vf_it[pos].size();
+    });
+    return inner;
+}
+
+void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it, double stepsize,
+                                const std::vector<PointIndex>& inner_points,
+                                std::vector<Base::Vector3f>& buffer)
+{
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    buffer.resize(inner_points.size());
+
+    Base::forEachChunk(inner_points.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshPoint& pnt = points[inner_points[i]];
+            MeshCore::MeshRefIndices::Range cv = vv_it[inner_points[i]];
+
+            double delx=0.0,dely=0.0,delz=0.0;
+            for (PointIndex index : cv) {
+                const MeshPoint& neighbour = points[index];
+                delx += static_cast<double>(neighbour.x-pnt.x);
+                dely += static_cast<double>(neighbour.y-pnt.y);
+                delz += static_cast<double>(neighbour.z-pnt.z);
+            }
+
+            double w = stepsize/double(cv.size());
+            buffer[i].x = static_cast<float>(static_cast<double>(pnt.x)+w*delx);
+            buffer[i].y = static_cast<float>(static_cast<double>(pnt.y)+w*dely);
+            buffer[i].z = static_cast<float>(static_cast<double>(pnt.z)+w*delz);
         }
+    });
 
-        float x = static_cast<float>(static_cast<double>((v_beg[*pos]).x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[*pos]).y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[*pos]).z)+stepsize*delz);
-        kernel.SetPoint(*pos,x,y,z);
-    }
+    Base::forEachChunk(inner_points.size(), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+            kernel.SetPoint(inner_points[i], buffer[i]);
+    });
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
     MeshCore::MeshRefPointToPoints vv_it(kernel);
     MeshCore::MeshRefPointToFacets vf_it(kernel);
+    std::vector<PointIndex> inner = InnerPoints(vv_it, vf_it);
+    std::vector<Base::Vector3f> buffer;
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
+        Umbrella(vv_it, lambda, inner, buffer);
     }
 }
 
@@ -262,9 +229,11 @@ void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<P
 {
     MeshCore::MeshRefPointToPoints vv_it(kernel);
     MeshCore::MeshRefPointToFacets vf_it(kernel);
+    std::vector<PointIndex> inner = InnerPoints(vv_it, vf_it, point_indices);
+    std::vector<Base::Vector3f> buffer;
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
+        Umbrella(vv_it, lambda, inner, buffer);
     }
 }
 
@@ -281,12 +250,14 @@ void TaubinSmoothing::Smooth(unsigned int iterations)
 {
     MeshCore::MeshRefPointToPoints vv_it(kernel);
     MeshCore::MeshRefPointToFacets vf_it(kernel);
+    std::vector<PointIndex> inner = InnerPoints(vv_it, vf_it);
+    std::vector<Base::Vector3f> buffer;
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-        Umbrella(vv_it, vf_it, -(lambda+micro));
+        Umbrella(vv_it, lambda, inner, buffer);
+        Umbrella(vv_it, -(lambda+micro), inner, buffer);
     }
 }
 
@@ -294,12 +265,14 @@ void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<Po
 {
     MeshCore::MeshRefPointToPoints vv_it(kernel);
     MeshCore::MeshRefPointToFacets vf_it(kernel);
+    std::vector<PointIndex> inner = InnerPoints(vv_it, vf_it, point_indices);
+    std::vector<Base::Vector3f> buffer;
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-        Umbrella(vv_it, vf_it, -(lambda+micro), point_indices);
+        Umbrella(vv_it, lambda, inner, buffer);
+        Umbrella(vv_it, -(lambda+micro), inner, buffer);
     }
 }
 
@@ -376,7 +349,7 @@ void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
     for (FacetIndex pos = 0; pos < facets.size(); pos++) {
         iter.Set(pos);
         Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
+        MeshCore::MeshRefIndices::Range cv = ff_it[pos];
         const MeshCore::MeshFacet& facet = facets[pos];
 
         std::vector<AngleNormal> anglesWithFaces;
@@ -405,7 +378,7 @@ void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
     // Step 2: move vertices
     for (auto pos : point_indices) {
         Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
+        MeshCore::MeshRefIndices::Range cv = vf_it[pos];
 
         double totalArea = 0.0;
         Base::Vector3d totalvT;
@@ -25,6 +25,8 @@
 
 #include <vector>
 
+#include <Base/Vector3D.h>
+
 #include "Definitions.h"
 
 
@@ -96,6 +98,25 @@ protected:
     void Umbrella(const MeshRefPointToPoints&,
                   const MeshRefPointToFacets&, double,
                   const std::vector<PointIndex>&);
+    /** Returns the points that are moved by the umbrella operator, i.e. all points except
+     * of border points and points with less than three neighbours.
+     */
+    std::vector<PointIndex> InnerPoints(const MeshRefPointToPoints&,
+                                        const MeshRefPointToFacets&) const;
+    /** Returns the points of \a point_indices that are moved by the umbrella operator.
+     * The points are sorted and each of them is listed once.
+     */
+    std::vector<PointIndex> InnerPoints(const MeshRefPointToPoints&,
+                                        const MeshRefPointToFacets&,
+                                        const std::vector<PointIndex>& point_indices) const;
+    /** Applies the umbrella operator to the given inner points.
+     * The new positions are computed from the positions before this step (Jacobi
+     * iteration) into \a buffer and written back afterwards, so that the points are
+     * handled in parallel.
+     */
+    void Umbrella(const MeshRefPointToPoints&, double,
+                  const std::vector<PointIndex>& inner_points,
+                  std::vector<Base::Vector3f>& buffer);
 
 protected:
     double lambda;
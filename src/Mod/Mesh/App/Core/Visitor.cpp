@@ -99,8 +99,8 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners (MeshFacetVisitor &rcl
         for (std::vector<FacetIndex>::iterator pCurrFacet = aclCurrentLevel.begin(); pCurrFacet < aclCurrentLevel.end(); ++pCurrFacet) {
             for (int i = 0; i < 3; i++) {
                 const MeshFacet &rclFacet = raclFAry[*pCurrFacet];
-                const std::set<FacetIndex>& raclNB = clRPF[rclFacet._aulPoints[i]];
-                for (std::set<FacetIndex>::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
+                MeshRefIndices::Range raclNB = clRPF[rclFacet._aulPoints[i]];
+                for (MeshRefIndices::Range::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
                     if (!pFBegin[*pINb].IsFlag(MeshFacet::VISIT)) {
                         // only visit if VISIT Flag not set
                         ulVisited++;
@@ -135,8 +135,8 @@ unsigned long MeshKernel::VisitNeighbourPoints (MeshPointVisitor &rclPVisitor, P
     while (!aclCurrentLevel.empty()) {
         // visit all neighbours of the current level
         for (clCurrIter = aclCurrentLevel.begin(); clCurrIter < aclCurrentLevel.end(); ++clCurrIter) {
-            const std::set<PointIndex>& raclNB = clNPs[*clCurrIter];
-            for (std::set<PointIndex>::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
+            MeshRefIndices::Range raclNB = clNPs[*clCurrIter];
+            for (MeshRefIndices::Range::const_iterator pINb = raclNB.begin(); pINb != raclNB.end(); ++pINb) {
                 if (!pPBegin[*pINb].IsFlag(MeshPoint::VISIT)) {
                     // only visit if VISIT Flag not set
                     ulVisited++;
@@ -56,10 +56,7 @@ App::DocumentObjectExecReturn *Curvature::execute()
     }
 
     // get all points
-    const MeshCore::MeshKernel& rMesh = pcFeat->Mesh.getValue().getKernel();
-    MeshCore::MeshCurvature meshCurv(rMesh);
-    meshCurv.ComputePerVertex();
-    const std::vector<MeshCore::CurvatureInfo>& curv = meshCurv.GetCurvature();
+    const std::vector<MeshCore::CurvatureInfo>& curv = pcFeat->Mesh.getValue().getCurvaturePerVertex();
 
     std::vector<CurvatureInfo> values;
     values.reserve(curv.size());
@@ -42,6 +42,7 @@
 #include <Base/ViewProj.h>
 #include <Base/Writer.h>
 
+#include "Core/Algorithm.h"
 #include "Core/Builder.h"
 #include "Core/Decimation.h"
 #include "Core/Degeneration.h"
@@ -65,6 +66,19 @@ const float MeshObject::Epsilon = 1.0e-5F;
 TYPESYSTEM_SOURCE(Mesh::MeshObject, Data::ComplexGeoData)
 TYPESYSTEM_SOURCE(Mesh::MeshSegment, Data::Segment)
 
+struct MeshObject::CurvatureCache
+{
+    explicit CurvatureCache(const MeshCore::MeshKernel& kernel)
+      : search(kernel), curvature(kernel)
+    {
+        curvature.ComputePerVertex(search);
+    }
+
+    MeshCore::MeshRefPointToFacets search;
+    MeshCore::MeshCurvature curvature;
+    std::vector<PointIndex> moved;
+};
+
 MeshObject::MeshObject()
 {
 }
@@ -116,6 +130,8 @@ const MeshCore::MeshKernel& MeshObject::getKernel() const
 
 MeshCore::MeshKernel& MeshObject::getKernel()
 {
+    // the caller may change anything of the kernel
+    _curvature.reset();
     if (!_kernel)
         _kernel = std::make_shared<MeshCore::MeshKernel>();
     else if (_kernel.use_count() > 1)
@@ -123,6 +139,32 @@ MeshCore::MeshKernel& MeshObject::getKernel()
     return *_kernel;
 }
 
+MeshCore::MeshKernel& MeshObject::getKernelToMovePoints(const std::vector<PointIndex>& points)
+{
+    // The cached data refer to the kernel, so they can only be kept if it won't be copied
+    std::unique_ptr<CurvatureCache> curvature;
+    if (_kernel.use_count() == 1)
+        curvature.swap(_curvature);
+    MeshCore::MeshKernel& kernel = getKernel();
+    if (curvature) {
+        curvature->moved.insert(curvature->moved.end(), points.begin(), points.end());
+        _curvature.swap(curvature);
+    }
+    return kernel;
+}
+
+const std::vector<MeshCore::CurvatureInfo>& MeshObject::getCurvaturePerVertex() const
+{
+    if (!_curvature) {
+        _curvature.reset(new CurvatureCache(getKernel()));
+    }
+    else if (!_curvature->moved.empty()) {
+        _curvature->curvature.UpdatePerVertex(_curvature->search, _curvature->moved);
+        _curvature->moved.clear();
+    }
+    return _curvature->curvature.GetCurvature();
+}
+
 const std::vector<const char*>& MeshObject::getElementTypes(void) const
 {
     static std::vector<const char*> temp = {
@@ -213,6 +255,22 @@ void MeshObject::getFacesFromSubElement(const Data::Segment* element,
     }
 }
 
+Base::BoundBox3d MeshObject::getBoundBoxFromSubElement(const Data::Segment* element) const
+{
+    Base::BoundBox3d bbox;
+    if (element && element->getTypeId() == MeshSegment::getClassTypeId()) {
+        const MeshSegment* segm = static_cast<const MeshSegment*>(element);
+        if (!segm->segment)
+            return segm->mesh->getBoundBox();
+        const MeshCore::MeshFacetArray& facets = segm->mesh->getKernel().GetFacets();
+        for (FacetIndex index : segm->segment->getIndices()) {
+            for (PointIndex pnt : facets[index]._aulPoints)
+                bbox.Add(segm->mesh->getPoint(pnt));
+        }
+    }
+    return bbox;
+}
+
 void MeshObject::transformGeometry(const Base::Matrix4D &rclMat)
 {
     MeshCore::MeshKernel kernel;
@@ -321,6 +379,7 @@ void MeshObject::operator = (const MeshObject& mesh)
         // copy the mesh structure
         setTransform(mesh._Mtrx);
         this->_kernel = mesh._kernel;
+        this->_curvature.reset();
         copySegments(mesh);
     }
 }
@@ -342,6 +401,7 @@ void MeshObject::swap(MeshCore::MeshKernel& Kernel)
 void MeshObject::swap(MeshObject& mesh)
 {
     this->_kernel.swap(mesh._kernel);
+    this->_curvature.swap(mesh._curvature);
     swapSegments(mesh);
     Base::Matrix4D tmp=this->_Mtrx;
     this->_Mtrx = mesh._Mtrx;
@@ -1103,6 +1163,7 @@ void MeshObject::offsetSpecial(float fSize, float zmax, float zmin)
 void MeshObject::clear()
 {
     _kernel.reset();
+    _curvature.reset();
     this->_segments.clear();
     setTransform(Base::Matrix4D());
 }
@@ -1131,12 +1192,24 @@ void MeshObject::movePoint(PointIndex index, const Base::Vector3d& v)
     vec.x += _Mtrx[0][3];
     vec.y += _Mtrx[1][3];
     vec.z += _Mtrx[2][3];
-    getKernel().MovePoint(index, transformPointToInside(vec));
+    getKernelToMovePoints({index}).MovePoint(index, transformPointToInside(vec));
 }
 
 void MeshObject::setPoint(PointIndex index, const Base::Vector3d& p)
 {
-    getKernel().SetPoint(index, transformPointToInside(p));
+    getKernelToMovePoints({index}).SetPoint(index, transformPointToInside(p));
+}
+
+void MeshObject::setPoints(const std::vector<std::pair<PointIndex, Base::Vector3f> >& points)
+{
+    std::vector<PointIndex> indices;
+    indices.reserve(points.size());
+    for (const auto& it : points)
+        indices.push_back(it.first);
+
+    MeshCore::MeshKernel& kernel = getKernelToMovePoints(indices);
+    for (const auto& it : points)
+        kernel.SetPoint(it.first, it.second);
 }
 
 void MeshObject::smooth(int iterations, float d_max)
@@ -36,6 +36,7 @@
 #include <Base/Matrix.h>
 #include <Base/Tools3D.h>
 
+#include "Core/Curvature.h"
 #include "Core/Iterator.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
@@ -123,6 +124,8 @@ public:
         std::vector<Base::Vector3d> &Points,
         std::vector<Base::Vector3d> &PointNormals,
         std::vector<Facet> &faces) const override;
+    /** Get the bound box of a segment */
+    Base::BoundBox3d getBoundBoxFromSubElement(const Data::Segment*) const override;
     //@}
 
     bool isSame(const Data::ComplexGeoData &other) const override;
@@ -243,11 +246,19 @@ public:
     Base::Matrix4D getEigenSystem(Base::Vector3d& v) const;
     void movePoint(PointIndex, const Base::Vector3d& v);
     void setPoint(PointIndex, const Base::Vector3d& v);
+    /// Sets the points in the local coordinate system of the mesh
+    void setPoints(const std::vector<std::pair<PointIndex, Base::Vector3f> >&);
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
     void decimate(int targetSize);
     Base::Vector3d getPointNormal(PointIndex) const;
     std::vector<Base::Vector3d> getPointNormals() const;
+    /** Returns the principal curvatures of all points in the local coordinate system.
+     * The values are computed on demand and kept until the mesh gets modified. If only
+     * points are moved with movePoint(), setPoint() or setPoints() just the values in the
+     * neighbourhood of these points are recomputed.
+     */
+    const std::vector<MeshCore::CurvatureInfo>& getCurvaturePerVertex() const;
     void crossSections(const std::vector<TPlane>&, std::vector<TPolylines> &sections,
                        float fMinEps = 1.0e-2f, bool bConnectPolygons = false) const;
     void cut(const Base::Polygon2d& polygon, const Base::ViewProjMethod& proj, CutType);
@@ -427,11 +438,15 @@ private:
     void swapKernel(MeshCore::MeshKernel& m, const std::vector<std::string>& g);
     void copySegments(const MeshObject&);
     void swapSegments(MeshObject&);
+    MeshCore::MeshKernel& getKernelToMovePoints(const std::vector<PointIndex>&);
 
 private:
+    struct CurvatureCache;
+
     Base::Matrix4D _Mtrx;
     std::shared_ptr<MeshCore::MeshKernel> _kernel;
     std::vector<Segment> _segments;
+    mutable std::unique_ptr<CurvatureCache> _curvature;
     static const float Epsilon;
 };
 
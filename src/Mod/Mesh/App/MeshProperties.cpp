@@ -689,9 +689,7 @@ void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<PointIndex, Base::Vector3f> >& inds)
 {
     aboutToSetValue();
-    MeshCore::MeshKernel& kernel = _meshObject->getKernel();
-    for (std::vector<std::pair<PointIndex, Base::Vector3f> >::const_iterator it = inds.begin(); it != inds.end(); ++it)
-        kernel.SetPoint(it->first, it->second);
+    _meshObject->setPoints(inds);
     hasSetValue();
 }
 
@@ -791,6 +789,24 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
     hasSetValue();
 }
 
+bool PropertyMeshKernel::canRestoreDocFileInThread() const
+{
+    return true;
+}
+
+std::function<void()> PropertyMeshKernel::restoreDocFileInThread(Base::Reader &reader)
+{
+    auto kernel = std::make_shared<MeshCore::MeshKernel>();
+    MeshObject mesh;
+    mesh.load(reader);
+    mesh.swap(*kernel);
+    return [this, kernel]() {
+        aboutToSetValue();
+        _meshObject->swap(*kernel);
+        hasSetValue();
+    };
+}
+
 App::Property *PropertyMeshKernel::Copy() const
 {
     // Note: Copy the content, do NOT reference the same mesh object
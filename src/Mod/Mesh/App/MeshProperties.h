@@ -244,6 +244,8 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const override;
     void RestoreDocFile(Base::Reader &reader) override;
+    bool canRestoreDocFileInThread() const override;
+    std::function<void()> restoreDocFileInThread(Base::Reader &reader) override;
 
     App::Property *Copy() const override;
     void Paste(const App::Property &from) override;
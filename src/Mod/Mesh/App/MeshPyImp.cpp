@@ -31,6 +31,7 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include "Core/Decimation.h"
 #include "Core/Degeneration.h"
 #include "Core/Segmentation.h"
 #include "Core/Smoothing.h"
@@ -1910,8 +1911,28 @@ PyObject* MeshPy::smooth(PyObject *args, PyObject *kwds)
     Py_Return;
 }
 
-PyObject*  MeshPy::decimate(PyObject *args)
+PyObject*  MeshPy::decimate(PyObject *args, PyObject *kwds)
 {
+    if (kwds && PyDict_Size(kwds) > 0) {
+        MeshCore::MeshSimplify::Parameters params;
+        int targetSize = 0;
+        int blockSize = static_cast<int>(params.blockSize);
+        static char* keywords_decimate[] = {"TargetSize", "MaxError", "FeatureAngle", "BlockSize", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "|iffi", keywords_decimate,
+                                         &targetSize, &params.maxError, &params.featureAngle, &blockSize))
+            return nullptr;
+
+        params.targetSize = static_cast<std::size_t>(std::max(targetSize, 0));
+        params.blockSize = static_cast<std::size_t>(std::max(blockSize, 0));
+        PY_TRY {
+            MeshPropertyLock lock(this->parentProperty);
+            MeshCore::MeshSimplify dm(getMeshObjectPtr()->getKernel());
+            dm.simplify(params);
+        } PY_CATCH;
+
+        Py_Return;
+    }
+
     float fTol, fRed;
     if (PyArg_ParseTuple(args, "ff", &fTol,&fRed)) {
         PY_TRY {
@@ -1931,7 +1952,8 @@ PyObject*  MeshPy::decimate(PyObject *args)
         Py_Return;
     }
 
-    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)");
+    PyErr_SetString(PyExc_ValueError, "decimate(tolerance=float, reduction=float), decimate(targetSize=int) or "
+                                      "decimate(TargetSize=int, MaxError=float, FeatureAngle=float, BlockSize=int)");
     return nullptr;
 }
 
@@ -2036,10 +2058,10 @@ PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
     if (!PyArg_ParseTuple(args, "O",&l))
         return nullptr;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
-    MeshCore::MeshSegmentAlgorithm finder(kernel);
-    MeshCore::MeshCurvature meshCurv(kernel);
-    meshCurv.ComputePerVertex();
+    // the non-const kernel would drop the cached curvature
+    const MeshObject* mesh = getMeshObjectPtr();
+    MeshCore::MeshSegmentAlgorithm finder(mesh->getKernel());
+    const std::vector<MeshCore::CurvatureInfo>& curv = mesh->getCurvaturePerVertex();
 
     Py::Sequence func(l);
     std::vector<MeshCore::MeshSurfaceSegmentPtr> segm;
@@ -2050,7 +2072,7 @@ PyObject*  MeshPy::getSegmentsByCurvature(PyObject *args)
         float tol1 = (float)Py::Float(t[2]);
         float tol2 = (float)Py::Float(t[3]);
         int num = (int)Py::Long(t[4]);
-        segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureFreeformSegment>(meshCurv.GetCurvature(), num, tol1, tol2, c1, c2));
+        segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureFreeformSegment>(curv, num, tol1, tol2, c1, c2));
     }
 
     finder.FindSegments(segm);
@@ -2075,11 +2097,7 @@ PyObject* MeshPy::getCurvaturePerVertex(PyObject* args)
     if (!PyArg_ParseTuple(args, ""))
         return nullptr;
 
-    const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
-    MeshCore::MeshCurvature meshCurv(kernel);
-    meshCurv.ComputePerVertex();
-
-    const std::vector<MeshCore::CurvatureInfo>& curv = meshCurv.GetCurvature();
+    const std::vector<MeshCore::CurvatureInfo>& curv = getMeshObjectPtr()->getCurvaturePerVertex();
     Base::Placement plm = getMeshObjectPtr()->getPlacement();
     plm.setPosition(Base::Vector3d());
 
@@ -10,7 +10,7 @@ import io
 import FreeCAD, unittest, Mesh
 import MeshEnums
 from FreeCAD import Base
-import time, tempfile, math
+import time, tempfile, math, struct
 # http://python-kurs.eu/threads.php
 try:
     import _thread as thread
@@ -463,6 +463,78 @@ endsolid Simple"""
         mesh.read(Stream=data, Format="AST")
         self.assertTrue(mesh.hasSelfIntersections())
 
+        # only the last facet intersects the second one, facets sharing a point are ignored
+        self.assertEqual([(i[0], i[1]) for i in mesh.getSelfIntersections()], [(1, 4)])
+
+    def testSelfIntersectionOfLargeMesh(self):
+        # a 40x40 grid in the xy plane and a vertical sheet at x = 10.5 crossing it
+        # along y = 0.25..40, each of the 80 vertical facets around z = 0 overlaps
+        # two horizontal facets, except of the last one
+        mesh = createGrid(40, 40)
+        count = mesh.CountFacets
+        sheet = createGrid(40, 4, lambda i, j: (10.5, i + 0.25, j - 2.5))
+        mesh.addMesh(sheet)
+        self.assertTrue(mesh.hasSelfIntersections())
+
+        pairs = [(i[0], i[1]) for i in mesh.getSelfIntersections()]
+        self.assertEqual(len(pairs), 159)
+        self.assertEqual(pairs, sorted(set(pairs)))
+        for f1, f2 in pairs:
+            self.assertLess(f1, count)
+            self.assertGreaterEqual(f2, count)
+            self.assertEqual(f1 // 80, 10)
+            self.assertEqual((f2 - count) // 2 % 4, 2)
+
+        # the same pairs are found with the exact test of all facets
+        mesh = createGrid(6, 6)
+        mesh.addMesh(createGrid(6, 3, lambda i, j: (2.5, i + 0.25, j - 1.5)))
+        facets = mesh.Facets
+        expected = []
+        for i in range(len(facets)):
+            for j in range(i + 1, len(facets)):
+                if set(facets[i].PointIndices) & set(facets[j].PointIndices):
+                    continue
+                if len(facets[i].intersect(facets[j])) == 2:
+                    expected.append((i, j))
+        self.assertEqual([(i[0], i[1]) for i in mesh.getSelfIntersections()], expected)
+
+    def testSectionOfMeshes(self):
+        grid = createGrid(40, 40)
+        sheet = createGrid(40, 4, lambda i, j: (10.5, i + 0.25, j - 2.5))
+        lines = grid.section(sheet, ConnectLines=False)
+        self.assertEqual(len(lines), 159)
+        length = 0.0
+        for p1, p2 in lines:
+            for p in (p1, p2):
+                self.assertAlmostEqual(p.x, 10.5, places=4)
+                self.assertAlmostEqual(p.z, 0.0, places=4)
+            length += (p2 - p1).Length
+        self.assertAlmostEqual(length, 39.75, places=3)
+
+    def testIntersectionNearlyCoplanar(self):
+        # The small facet lies in the plane of the large one within the epsilon of the
+        # triangle test but the normals differ by 5 degree. This used to return the
+        # uninitialised intersection points of the triangle test.
+        self.planarMesh.append( [-0.5,-0.5,-0.045045] )
+        self.planarMesh.append( [0.5,-0.5,-0.045045] )
+        self.planarMesh.append( [0.0,0.5,0.044955] )
+        self.planarMesh.append( [0.0,0.0,0.0] )
+        self.planarMesh.append( [0.001,0.0,0.0] )
+        self.planarMesh.append( [0.0,0.001,0.0] )
+        planarMeshObject = Mesh.Mesh(self.planarMesh)
+        f1 = planarMeshObject.Facets[0]
+        f2 = planarMeshObject.Facets[1]
+        res = f1.intersect(f2)
+        for i in range(10):
+            self.assertEqual(res, f1.intersect(f2))
+        for p in res:
+            for f in (f1, f2):
+                box = FreeCAD.BoundBox()
+                for q in f.Points:
+                    box.add(FreeCAD.Vector(*q))
+                box.enlarge(0.0001)
+                self.assertTrue(box.isInside(FreeCAD.Vector(*p)))
+
 
 class PivyTestCases(unittest.TestCase):
     def setUp(self):
@@ -533,6 +605,429 @@ def createMesh(r,s):
     mesh=Mesh.createSphere(r,s)
     #FreeCAD.Console.PrintMessage("... destroy sphere\n")
 
+def createGrid(nx, ny, point=None):
+    """Returns a mesh of nx*ny squares split into two triangles along the diagonal
+    from (i, j) to (i+1, j+1). The optional point(i, j) function returns the
+    coordinates of the grid points, the default is (i, j, 0)."""
+    if point is None:
+        point = lambda i, j: (float(i), float(j), 0.0)
+    triangles = []
+    for i in range(nx):
+        for j in range(ny):
+            triangles += [point(i, j), point(i + 1, j), point(i + 1, j + 1)]
+            triangles += [point(i, j), point(i + 1, j + 1), point(i, j + 1)]
+    return Mesh.Mesh(triangles)
+
+def createLargeMesh(numFacets):
+    """Returns a mesh of at least numFacets facets made of copies of a 250x250 grid
+    placed next to each other"""
+    grid = createGrid(250, 250)
+    mesh = grid.copy()
+    while mesh.CountFacets < numFacets:
+        grid.translate(0.0, 251.0, 0.0)
+        mesh.addMesh(grid)
+    return mesh
+
+def singlePrecision(value):
+    return struct.unpack("f", struct.pack("f", value))[0]
+
+def edgeLengths(mesh):
+    points, facets = mesh.Topology
+    lengths = []
+    for facet in facets:
+        for k in range(3):
+            lengths.append((points[facet[k]] - points[facet[(k + 1) % 3]]).Length)
+    return lengths
+
+class MeshAdjacencyCases(unittest.TestCase):
+    """Checks the point and facet neighbourhoods through the algorithms using them"""
+    def testLaplaceNeighbours(self):
+        # on the grid each inner point has six neighbours, with z = i*i their mean
+        # height is 2/3 above the point
+        mesh = createGrid(6, 5, lambda i, j: (float(i), float(j), float(i * i)))
+        before = mesh.Topology[0]
+        mesh.smooth(Method="Laplace", Iteration=1, Lambda=0.5)
+        after = mesh.Topology[0]
+        self.assertEqual(len(before), len(after))
+        for p, q in zip(before, after):
+            inner = 0 < p.x < 6 and 0 < p.y < 5
+            self.assertAlmostEqual(q.x, p.x, places=5)
+            self.assertAlmostEqual(q.y, p.y, places=5)
+            self.assertAlmostEqual(q.z, p.z + 1.0 / 3.0 if inner else p.z, places=4)
+
+    def testCurvatureOfSphere(self):
+        mesh = Mesh.createSphere(10.0, 50)
+        curvature = mesh.getCurvaturePerVertex()
+        self.assertEqual(len(curvature), mesh.CountPoints)
+        # the estimates near the poles are less accurate, so check the mean
+        mean = sum(abs(c[0]) + abs(c[1]) for c in curvature) / (2 * len(curvature))
+        self.assertAlmostEqual(mean, 0.1, delta=0.005)
+
+    def testMedianFilterOfPlane(self):
+        mesh = createGrid(8, 8)
+        before = mesh.Topology[0]
+        mesh.smooth(Method="MedianFilter", Iteration=2)
+        for p, q in zip(before, mesh.Topology[0]):
+            self.assertAlmostEqual((p - q).Length, 0.0, places=5)
+
+    def testRemoveNeedles(self):
+        # the third column of squares is only 0.001 wide
+        columns = [0.0, 1.0, 2.0, 2.001, 3.001, 4.001]
+        mesh = createGrid(5, 4, lambda i, j: (columns[i], float(j), 0.0))
+        count = mesh.CountFacets
+        needles = sum(1 for length in edgeLengths(mesh) if length < 0.01)
+        mesh.removeNeedles(0.01)
+        self.assertLess(mesh.CountFacets, count)
+        self.assertLess(sum(1 for length in edgeLengths(mesh) if length < 0.01), needles)
+        self.assertFalse(mesh.hasInvalidPoints())
+        self.assertFalse(mesh.hasNonManifolds())
+        self.assertAlmostEqual(mesh.Area, 4.001 * 4.0, places=2)
+
+@unittest.skipUnless(os.environ.get("FREECAD_MESH_BENCHMARK"),
+                     "set FREECAD_MESH_BENCHMARK to run the mesh benchmarks")
+class MeshAdjacencyBenchmark(unittest.TestCase):
+    """Times the algorithms building the neighbourhoods of meshes with 1 to 20 million facets"""
+    def testBuildNeighbourhoods(self):
+        for million in (1, 4, 10, 20):
+            mesh = createLargeMesh(million * 1000000)
+            times = []
+            for method in ("Laplace", "MedianFilter"):
+                start = time.perf_counter()
+                mesh.smooth(Method=method, Iteration=1)
+                times.append(time.perf_counter() - start)
+            start = time.perf_counter()
+            mesh.getCurvaturePerVertex()
+            times.append(time.perf_counter() - start)
+            FreeCAD.Console.PrintMessage(
+                "{} facets: Laplace {:.3f} s, MedianFilter {:.3f} s, curvature {:.3f} s\n"
+                .format(mesh.CountFacets, *times))
+
+def curvatureSegments(mesh, curvature, types):
+    """Finds the segments of getSegmentsByCurvature() facet by facet, in the order the
+    neighbours are visited by MeshKernel::VisitNeighbourFacets()"""
+    facets = mesh.Topology[1]
+    neighbours = [f.NeighbourIndices for f in mesh.Facets]
+    count = len(facets)
+    f32 = singlePrecision
+    visited = [False] * count
+    segments = []
+    reset = []
+    for c1, c2, tol1, tol2, num in types:
+        for index in reset:
+            visited[index] = False
+        reset = []
+        c1, c2, tol1, tol2 = f32(c1), f32(c2), f32(tol1), f32(tol2)
+        accepted = [all(f32(abs(curvature[k][1] - c2)) <= tol2 and
+                        f32(abs(curvature[k][0] - c1)) <= tol1 for k in facet)
+                    for facet in facets]
+        for start in range(count):
+            if visited[start]:
+                continue
+            indices = [start]
+            visited[start] = True
+            level = [start]
+            while level:
+                nextLevel = []
+                for index in level:
+                    for n in neighbours[index]:
+                        if n < count and accepted[n] and not visited[n]:
+                            visited[n] = True
+                            nextLevel.append(n)
+                            indices.append(n)
+                level = nextLevel
+            if len(indices) <= 1:
+                reset.append(start)
+            elif len(indices) >= num:
+                segments.append(indices)
+    return segments
+
+class MeshCurvatureCases(unittest.TestCase):
+    """Checks the curvature kept by the mesh against a full computation"""
+    def setUp(self):
+        # a wavy surface with a flat part for i < 8
+        self.mesh = createGrid(20, 16, lambda i, j: (float(i), float(j),
+                                                     math.sin(max(i - 8, 0) * 0.4) * math.cos(j * 0.3) * 2.0))
+
+    def pointAt(self, i, j):
+        """Returns the index of the grid point (i, j)"""
+        for index, p in enumerate(self.mesh.Topology[0]):
+            if p.x == i and p.y == j:
+                return index
+        raise ValueError("no grid point ({}, {})".format(i, j))
+
+    def assertCurvature(self, curvature, expected):
+        self.assertEqual(len(curvature), len(expected))
+        for c, e in zip(curvature, expected):
+            self.assertAlmostEqual(c[0], e[0], places=5)
+            self.assertAlmostEqual(c[1], e[1], places=5)
+            self.assertAlmostEqual((c[2] - e[2]).Length, 0.0, places=5)
+            self.assertAlmostEqual((c[3] - e[3]).Length, 0.0, places=5)
+
+    def testMovedPoints(self):
+        mesh = self.mesh
+        # inner points of the wavy part
+        moved = self.pointAt(12, 8)
+        before = mesh.getCurvaturePerVertex()
+        mesh.movePoint(moved, FreeCAD.Vector(0.0, 0.0, 0.5))
+        mesh.movePoint(self.pointAt(15, 3), 0.2, -0.1, -0.4)
+        mesh.setPoint(self.pointAt(12, 9), FreeCAD.Vector(12.0, 9.0, 1.5))
+        curvature = mesh.getCurvaturePerVertex()
+        self.assertNotAlmostEqual(curvature[moved][0], before[moved][0], places=3)
+        # the copy has no curvature yet and computes all points
+        self.assertCurvature(curvature, mesh.copy().getCurvaturePerVertex())
+
+    def testMovedPointsWithPlacement(self):
+        mesh = self.mesh
+        mesh.Placement = FreeCAD.Placement(FreeCAD.Vector(1.0, 2.0, 3.0), FreeCAD.Rotation(30.0, 0.0, 0.0))
+        moved = self.pointAt(10, 5)
+        mesh.getCurvaturePerVertex()
+        point = mesh.Points[moved].Vector
+        mesh.setPoint(moved, point + FreeCAD.Vector(0.0, 0.0, 0.7))
+        self.assertCurvature(mesh.getCurvaturePerVertex(), mesh.copy().getCurvaturePerVertex())
+
+    def testTopologyChange(self):
+        mesh = self.mesh
+        mesh.getCurvaturePerVertex()
+        mesh.removeFacets(list(range(200, 260)))
+        curvature = mesh.getCurvaturePerVertex()
+        self.assertEqual(len(curvature), mesh.CountPoints)
+        self.assertCurvature(curvature, mesh.copy().getCurvaturePerVertex())
+
+        mesh.addFacet(30.0, 0.0, 0.0, 31.0, 0.0, 0.0, 30.0, 1.0, 1.0)
+        curvature = mesh.getCurvaturePerVertex()
+        self.assertEqual(len(curvature), mesh.CountPoints)
+        self.assertCurvature(curvature, mesh.copy().getCurvaturePerVertex())
+
+    def testSegmentsByCurvature(self):
+        mesh = self.mesh
+        types = [(0.0, 0.0, 0.01, 0.01, 10), (0.5, 0.0, 0.3, 0.2, 3), (0.0, -0.5, 0.2, 0.3, 3)]
+        segments = mesh.getSegmentsByCurvature(types)
+        expected = curvatureSegments(mesh, mesh.getCurvaturePerVertex(), types)
+        # the flat part is one segment at least
+        self.assertGreater(len(segments), 0)
+        self.assertEqual(segments, expected)
+
+        # the cached curvature must follow moved points
+        mesh.movePoint(self.pointAt(12, 8), FreeCAD.Vector(0.0, 0.0, 0.5))
+        segments = mesh.getSegmentsByCurvature(types)
+        expected = curvatureSegments(mesh, mesh.copy().getCurvaturePerVertex(), types)
+        self.assertEqual(segments, expected)
+
+def pointNeighbours(mesh):
+    """Returns the points of the mesh as tuples, the neighbour points of each point
+    and the number of facets of each point"""
+    points, facets = mesh.Topology
+    points = [(p.x, p.y, p.z) for p in points]
+    neighbours = [set() for p in points]
+    counts = [0] * len(points)
+    for facet in facets:
+        for k in range(3):
+            neighbours[facet[k]].update((facet[(k + 1) % 3], facet[(k + 2) % 3]))
+            counts[facet[k]] += 1
+    return points, [sorted(n) for n in neighbours], counts
+
+def umbrellaStep(points, neighbours, inner, stepsize):
+    """The umbrella operator computed point by point from the positions before the step"""
+    result = list(points)
+    for k in inner:
+        p = points[k]
+        w = stepsize / len(neighbours[k])
+        result[k] = tuple(p[c] + w * sum(points[n][c] - p[c] for n in neighbours[k])
+                          for c in range(3))
+    return result
+
+class MeshSmoothingCases(unittest.TestCase):
+    """Compares the smoothing, which handles the points in parallel chunks, with a serial
+    computation of the same steps"""
+    def setUp(self):
+        # a noisy grid with enough inner points for several chunks
+        self.mesh = createGrid(110, 110, lambda i, j: (i * 0.1, j * 0.1,
+                                                       0.02 * math.sin(i * 12.9898 + j * 78.233)))
+        self.points, self.neighbours, counts = pointNeighbours(self.mesh)
+        self.inner = [k for k, n in enumerate(self.neighbours)
+                      if len(n) >= 3 and len(n) == counts[k]]
+
+    def assertPoints(self, points):
+        result = self.mesh.Topology[0]
+        self.assertEqual(len(result), len(points))
+        for p, q in zip(result, points):
+            self.assertAlmostEqual(p.x, q[0], places=4)
+            self.assertAlmostEqual(p.y, q[1], places=4)
+            self.assertAlmostEqual(p.z, q[2], places=4)
+
+    def testLaplace(self):
+        points = self.points
+        for i in range(3):
+            points = umbrellaStep(points, self.neighbours, self.inner, 0.5)
+        self.mesh.smooth(Method="Laplace", Iteration=3, Lambda=0.5)
+        self.assertPoints(points)
+
+    def testTaubin(self):
+        points = self.points
+        for i in range(2):
+            points = umbrellaStep(points, self.neighbours, self.inner, 0.5)
+            points = umbrellaStep(points, self.neighbours, self.inner, -0.55)
+        self.mesh.smooth(Method="Taubin", Iteration=4, Lambda=0.5, Micro=0.05)
+        self.assertPoints(points)
+
+    def testPlaneFit(self):
+        try:
+            import numpy
+        except ImportError:
+            self.skipTest("numpy is needed for the plane fit")
+        points = self.points
+        for i in range(2):
+            result = list(points)
+            for k, neighbours in enumerate(self.neighbours):
+                if len(neighbours) < 3:
+                    continue
+                fit = numpy.array([points[k]] + [points[n] for n in neighbours])
+                center = fit.mean(axis=0)
+                # the normal of the mean plane belongs to the smallest eigenvalue
+                normal = numpy.linalg.eigh(numpy.cov(fit.T))[1][:, 0]
+                dist = numpy.dot(normal, numpy.array(points[k]) - center)
+                result[k] = tuple(numpy.array(points[k]) - normal * dist)
+            points = result
+        self.mesh.smooth(Method="PlaneFit", Iteration=2)
+        self.assertPoints(points)
+
+@unittest.skipUnless(os.environ.get("FREECAD_MESH_BENCHMARK"),
+                     "set FREECAD_MESH_BENCHMARK to run the mesh benchmarks")
+class MeshSmoothingBenchmark(unittest.TestCase):
+    """Times ten smoothing steps of meshes with 1 and 4 million facets"""
+    def testSmooth(self):
+        for million in (1, 4):
+            mesh = createLargeMesh(million * 1000000)
+            times = []
+            for method in ("Laplace", "Taubin", "PlaneFit"):
+                start = time.perf_counter()
+                mesh.smooth(Method=method, Iteration=10)
+                times.append(time.perf_counter() - start)
+            FreeCAD.Console.PrintMessage(
+                "{} facets: Laplace {:.3f} s, Taubin {:.3f} s, PlaneFit {:.3f} s\n"
+                .format(mesh.CountFacets, *times))
+
+def createTorus(n, m, radius=10.0, tube=3.0):
+    """Returns a closed torus of n*m squares split into two triangles"""
+    def point(i, j):
+        u = 2.0 * math.pi * (i % n) / n
+        v = 2.0 * math.pi * (j % m) / m
+        r = radius + tube * math.cos(v)
+        return (r * math.cos(u), r * math.sin(u), tube * math.sin(v))
+    return createGrid(n, m, point)
+
+def boundaryEdges(mesh):
+    """Returns the edges with only one facet as pairs of point coordinates"""
+    points, facets = mesh.Topology
+    count = {}
+    for facet in facets:
+        for k in range(3):
+            edge = frozenset((facet[k], facet[(k + 1) % 3]))
+            count[edge] = count.get(edge, 0) + 1
+    key = lambda i: (points[i].x, points[i].y, points[i].z)
+    return {frozenset(map(key, edge)) for edge, c in count.items() if c == 1}
+
+def heightDeviation(mesh, height, samples):
+    """Estimates the Hausdorff distance of the height field mesh to the surface z = height(x, y)
+    from the vertical distances of its points and of the surface at the sample positions"""
+    points = mesh.Topology[0]
+    dist = max(abs(p.z - height(p.x, p.y)) for p in points)
+    bottom = min(p.z for p in points) - 1.0
+    for x, y in samples:
+        for hit in mesh.nearestFacetOnRay((x, y, bottom), (0.0, 0.0, 1.0)).values():
+            dist = max(dist, abs(hit[2] - height(x, y)))
+    return dist
+
+class MeshDecimationCases(unittest.TestCase):
+    """Checks the edge-collapse decimation of decimate(TargetSize, MaxError, FeatureAngle, BlockSize)"""
+    def wave(self, i, j):
+        return (float(i), float(j), self.height(i, j))
+
+    def height(self, x, y):
+        return math.sin(x * 0.3) * math.cos(y * 0.25) * 3.0
+
+    def testTargetSize(self):
+        mesh = createGrid(40, 40, self.wave)
+        mesh.decimate(TargetSize=800)
+        # an inner edge collapse removes two facets
+        self.assertIn(mesh.CountFacets, (799, 800))
+        self.assertFalse(mesh.hasNonManifolds())
+        self.assertFalse(mesh.hasInvalidPoints())
+
+    def testMaxError(self):
+        mesh = createGrid(40, 40, self.wave)
+        count = mesh.CountFacets
+        smallest = mesh.copy()
+        smallest.decimate(TargetSize=1)
+        mesh.decimate(MaxError=0.1)
+        self.assertLess(mesh.CountFacets, count)
+        self.assertGreater(mesh.CountFacets, 2 * smallest.CountFacets)
+        for p in mesh.Points:
+            self.assertLessEqual(abs(p.z - self.height(p.x, p.y)), 0.1)
+
+    def testBoundaryAndFeatures(self):
+        # a folded sheet with a right angle along x = 10
+        mesh = createGrid(20, 12, lambda i, j: (float(i), float(j), float(abs(i - 10))))
+        count = mesh.CountFacets
+        key = lambda p: (p.x, p.y, p.z)
+        kept = {key(p) for p in mesh.Points if p.x in (0.0, 10.0, 20.0) or p.y in (0.0, 12.0)}
+        crease = {p for p in kept if p[0] == 10.0}
+        boundary = boundaryEdges(mesh)
+        unfeatured = mesh.copy()
+
+        mesh.decimate(TargetSize=60)
+        self.assertLess(mesh.CountFacets, count)
+        self.assertTrue(kept.issubset({key(p) for p in mesh.Points}))
+        self.assertEqual(boundaryEdges(mesh), boundary)
+
+        # without feature detection points of the crease are collapsed
+        unfeatured.decimate(TargetSize=60, FeatureAngle=-1.0)
+        self.assertFalse(crease.issubset({key(p) for p in unfeatured.Points}))
+
+    def testBlocks(self):
+        mesh = createGrid(100, 100, lambda i, j: (i * 0.5, j * 0.5, math.sin(i * 0.1) * math.cos(j * 0.13) * 4.0))
+        boundary = boundaryEdges(mesh)
+        serial = mesh.copy()
+        serial.decimate(TargetSize=4000, BlockSize=0)
+        mesh.decimate(TargetSize=4000, BlockSize=2000)
+        self.assertIn(mesh.CountFacets, (3999, 4000))
+        self.assertFalse(mesh.hasNonManifolds())
+        self.assertEqual(boundaryEdges(serial), boundary)
+        self.assertEqual(boundaryEdges(mesh), boundary)
+
+    def testBlocksOfClosedMesh(self):
+        mesh = createTorus(120, 80)
+        self.assertTrue(mesh.isSolid())
+        mesh.decimate(TargetSize=2000, BlockSize=1000)
+        self.assertIn(mesh.CountFacets, (1999, 2000))
+        self.assertTrue(mesh.isSolid())
+        self.assertFalse(mesh.hasNonManifolds())
+        self.assertEqual(len(boundaryEdges(mesh)), 0)
+
+@unittest.skipUnless(os.environ.get("FREECAD_MESH_BENCHMARK"),
+                     "set FREECAD_MESH_BENCHMARK to run the mesh benchmarks")
+class MeshDecimationBenchmark(unittest.TestCase):
+    """Compares the throughput and the error of the edge-collapse decimation with the
+    decimation of Simplify.h on height fields with 200,000 and 1 million facets"""
+    def testDecimate(self):
+        height = lambda x, y: math.sin(x) * math.cos(y * 0.7) * 0.8
+        samples = [(0.1 + 9.8 * (k % 40) / 40.0, 0.1 + 9.8 * (k // 40) / 40.0) for k in range(1600)]
+        for n in (316, 707):
+            grid = createGrid(n, n, lambda i, j: (i * 10.0 / n, j * 10.0 / n, height(i * 10.0 / n, j * 10.0 / n)))
+            target = grid.CountFacets // 10
+            methods = [("Simplify.h", lambda mesh: mesh.decimate(target)),
+                       ("serial", lambda mesh: mesh.decimate(TargetSize=target, BlockSize=0)),
+                       ("blocks", lambda mesh: mesh.decimate(TargetSize=target))]
+            for name, method in methods:
+                mesh = grid.copy()
+                start = time.perf_counter()
+                method(mesh)
+                seconds = time.perf_counter() - start
+                FreeCAD.Console.PrintMessage(
+                    "{} facets, {}: {} facets, {:.3f} s, {:.2f} M tri/s, Hausdorff {:.5f}\n"
+                    .format(grid.CountFacets, name, mesh.CountFacets, seconds,
+                            grid.CountFacets / seconds / 1.0e6, heightDeviation(mesh, height, samples)))
+
 class LoadMeshInThreadsCases(unittest.TestCase):
 
     def setUp(self):
@@ -643,6 +1138,93 @@ class NastranReader(unittest.TestCase):
     def tearDown(self):
         pass
 
+class MeshWriterCases(unittest.TestCase):
+    """Compares the written files with the output of printf, which the writers
+    formatted with an ostream before"""
+    def setUp(self):
+        # enough facets for several blocks of the writer, with coordinates of
+        # different sign and magnitude
+        self.mesh = createGrid(150, 150, lambda i, j: ((i - 75) * 12.3457,
+                                                       j * 0.75 - 0.0000013 * i,
+                                                       math.sin(i * 0.7 + j * 0.3) * 1.0e5 / (1 + i)))
+        self.points, self.facets = self.mesh.Topology
+
+    def write(self, mesh, fmt):
+        data = io.BytesIO()
+        mesh.write(Stream=data, Format=fmt)
+        return data.getvalue().decode()
+
+    def vertices(self, form, prefix=""):
+        return "".join("{}{} {} {}\n".format(prefix, form % p.x, form % p.y, form % p.z)
+                       for p in self.points)
+
+    def testAsciiSTL(self):
+        lines = ["solid Mesh\n"]
+        for index, facet in enumerate(self.facets):
+            n = self.mesh.Facets[index].Normal
+            lines.append("  facet normal %.6f %.6f %.6f\n    outer loop\n" % (n.x, n.y, n.z))
+            for k in facet:
+                p = self.points[k]
+                lines.append("      vertex %.6f %.6f %.6f\n" % (p.x, p.y, p.z))
+            lines.append("    endloop\n  endfacet\n")
+        lines.append("endsolid Mesh\n")
+        self.assertEqual(self.write(self.mesh, "AST"), "".join(lines))
+
+    def testOBJ(self):
+        text = "# Created by FreeCAD <http://www.freecad.org>\n"
+        text += self.vertices("%.6f", "v ")
+        text += "".join("vn %.6f %.6f %.6f\n" % (f.Normal.x, f.Normal.y, f.Normal.z)
+                        for f in self.mesh.Facets)
+        text += "".join("f {0}//{3} {1}//{3} {2}//{3}\n".format(f[0] + 1, f[1] + 1, f[2] + 1, i + 1)
+                        for i, f in enumerate(self.facets))
+        self.assertEqual(self.write(self.mesh, "OBJ"), text)
+
+    def testSMF(self):
+        text = "#$SMF 1.0\n#$vertices {}\n#$faces {}\n#\n".format(len(self.points), len(self.facets))
+        text += "# Created by FreeCAD <http://www.freecad.org>\n"
+        text += self.vertices("%.6f", "v ")
+        text += "".join("f {} {} {}\n".format(f[0] + 1, f[1] + 1, f[2] + 1) for f in self.facets)
+        self.assertEqual(self.write(self.mesh, "SMF"), text)
+
+    def testOFF(self):
+        text = "OFF\n{} {} 0\n".format(len(self.points), len(self.facets))
+        text += self.vertices("%g")
+        text += "".join("3 {} {} {}\n".format(*f) for f in self.facets)
+        self.assertEqual(self.write(self.mesh, "OFF"), text)
+
+    def testAsciiPLY(self):
+        text = ("ply\nformat ascii 1.0\n"
+                "comment Created by FreeCAD <http://www.freecad.org>\n"
+                "element vertex {}\n"
+                "property float32 x\nproperty float32 y\nproperty float32 z\n"
+                "element face {}\n"
+                "property list uchar int vertex_index\nend_header\n").format(len(self.points), len(self.facets))
+        text += self.vertices("%.6f")
+        text += "".join("3 {} {} {}\n".format(*f) for f in self.facets)
+        self.assertEqual(self.write(self.mesh, "APLY"), text)
+
+    def testTransformed(self):
+        # the writer rounds the translated points to single precision
+        mesh = self.mesh.copy()
+        mesh.Placement = FreeCAD.Placement(FreeCAD.Vector(0.5, -2.0, 4.0), FreeCAD.Rotation())
+        self.points = [FreeCAD.Vector(singlePrecision(p.x + 0.5),
+                                      singlePrecision(p.y - 2.0),
+                                      singlePrecision(p.z + 4.0)) for p in self.points]
+        text = self.write(mesh, "SMF")
+        self.assertIn(self.vertices("%.6f", "v "), text)
+
+    def testBinaryRoundTrip(self):
+        # the files are read back through the memory mapped reader
+        for ext in ("stl", "ply"):
+            name = os.path.join(tempfile.gettempdir(), "MeshWriterCases." + ext)
+            self.mesh.write(name)
+            mesh = Mesh.Mesh(name)
+            os.remove(name)
+            points, facets = mesh.Topology
+            self.assertEqual(len(facets), len(self.facets))
+            key = lambda p: (p.x, p.y, p.z)
+            self.assertEqual(sorted(map(key, points)), sorted(map(key, self.points)))
+
 class MeshSubElement(unittest.TestCase):
     def setUp(self):
         self.mesh = Mesh.createBox(1.0, 1.0, 1.0)
@@ -79,11 +79,12 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
         std::vector<App::Color> diffuseColor;
         const MeshCore::MeshPointArray& points = mesh.getKernel().GetPoints();
         const MeshCore::MeshFacetArray& facets = mesh.getKernel().GetFacets();
+        std::vector<PointIndex> indices = findIndices(points, max_dist);
 
         if (binding == MeshCore::MeshIO::PER_VERTEX) {
             diffuseColor.reserve(points.size());
             for (size_t index=0; index<points.size(); index++) {
-                PointIndex pos = findIndex(points[index], max_dist);
+                PointIndex pos = indices[index];
                 if (pos < countPointsRefMesh) {
                     diffuseColor.push_back(textureColor[pos]);
                 }
@@ -102,7 +103,7 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
             std::vector<PointIndex> pointMap;
             pointMap.reserve(points.size());
             for (size_t index=0; index<points.size(); index++) {
-                PointIndex pos = findIndex(points[index], max_dist);
+                PointIndex pos = indices[index];
                 if (pos < countPointsRefMesh) {
                     pointMap.push_back(pos);
                 }
@@ -139,3 +140,18 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
         }
     }
 }
+
+std::vector<PointIndex> MeshTexture::findIndices(const MeshCore::MeshPointArray& points, float max_dist) const
+{
+    std::vector<PointIndex> indices;
+    if (max_dist < 0.0f) {
+        indices.reserve(points.size());
+        for (const auto& it : points)
+            indices.push_back(kdTree->FindExact(it));
+    }
+    else {
+        std::vector<float> dist;
+        kdTree->FindNearest(points, max_dist, indices, dist);
+    }
+    return indices;
+}
@@ -69,36 +69,39 @@ Segmentation::~Segmentation()
 void Segmentation::accept()
 {
     const Mesh::MeshObject* mesh = myMesh->Mesh.getValuePtr();
-    // make a copy because we might smooth the mesh before
-    MeshCore::MeshKernel kernel = mesh->getKernel();
-
+    // Smooth a copy of the mesh if requested, otherwise the curvature cached
+    // by the mesh is used and only the segments must be searched for again
+    Mesh::MeshObject smoothed;
+    const Mesh::MeshObject* curvMesh = mesh;
     if (ui->checkBoxSmooth->isChecked()) {
+        MeshCore::MeshKernel kernel = mesh->getKernel();
         MeshCore::LaplaceSmoothing smoother(kernel);
         smoother.Smooth(ui->smoothSteps->value());
+        smoothed.swap(kernel);
+        curvMesh = &smoothed;
     }
 
-    MeshCore::MeshSegmentAlgorithm finder(kernel);
-    MeshCore::MeshCurvature meshCurv(kernel);
-    meshCurv.ComputePerVertex();
+    MeshCore::MeshSegmentAlgorithm finder(curvMesh->getKernel());
+    const std::vector<MeshCore::CurvatureInfo>& curvature = curvMesh->getCurvaturePerVertex();
 
     std::vector<MeshCore::MeshSurfaceSegmentPtr> segm;
     if (ui->groupBoxFree->isChecked()) {
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureFreeformSegment>
-            (meshCurv.GetCurvature(), ui->numFree->value(),
+            (curvature, ui->numFree->value(),
              ui->tol1Free->value(), ui->tol2Free->value(),
              ui->crv1Free->value(), ui->crv2Free->value()));
     }
     if (ui->groupBoxCyl->isChecked()) {
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureCylindricalSegment>
-            (meshCurv.GetCurvature(), ui->numCyl->value(), ui->tol1Cyl->value(), ui->tol2Cyl->value(), ui->crvCyl->value()));
+            (curvature, ui->numCyl->value(), ui->tol1Cyl->value(), ui->tol2Cyl->value(), ui->crvCyl->value()));
     }
     if (ui->groupBoxSph->isChecked()) {
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvatureSphericalSegment>
-            (meshCurv.GetCurvature(), ui->numSph->value(), ui->tolSph->value(), ui->crvSph->value()));
+            (curvature, ui->numSph->value(), ui->tolSph->value(), ui->crvSph->value()));
     }
     if (ui->groupBoxPln->isChecked()) {
         segm.emplace_back(std::make_shared<MeshCore::MeshCurvaturePlanarSegment>
-            (meshCurv.GetCurvature(), ui->numPln->value(), ui->tolPln->value()));
+            (curvature, ui->numPln->value(), ui->tolPln->value()));
     }
     finder.FindSegments(segm);
 
@@ -79,6 +79,7 @@ typedef boost::iterator_range<const char*> CharRange;
 #include "PartFeaturePy.h"
 #include "PartParams.h"
 #include "PartPyCXX.h"
+#include "ShapeCache.h"
 #include "TopoShapePy.h"
 #include "TopoShapeOpCode.h"
 
@@ -126,10 +127,31 @@ short Feature::mustExecute() const
     return GeoFeature::mustExecute();
 }
 
+bool Feature::canCacheShape() const
+{
+    return false;
+}
+
+std::string Feature::getShapeCacheData() const
+{
+    return std::string();
+}
+
 App::DocumentObjectExecReturn *Feature::recompute()
 {
     try {
-        return App::GeoFeature::recompute();
+        std::string key;
+        if (ShapeCache::isEnabled() && canCacheShape()) {
+            key = ShapeCache::instance().getKey(this);
+            if (!key.empty() && ShapeCache::instance().restore(key, this)) {
+                FC_LOG("Restored shape of " << getFullName() << " from cache");
+                return App::DocumentObject::StdReturn;
+            }
+        }
+        auto ret = App::GeoFeature::recompute();
+        if (!key.empty() && ret == App::DocumentObject::StdReturn)
+            ShapeCache::instance().save(this);
+        return ret;
     }
     catch (Standard_Failure& e) {
 
@@ -188,6 +188,20 @@ public:
 
     void fixShape(TopoShape &s) const;
 
+    /** Check whether the shapes of this feature can be restored from ShapeCache
+     *
+     * The feature output must be fully determined by its persistent
+     * properties and linked objects. The default implementation returns false.
+     */
+    virtual bool canCacheShape() const;
+
+    /** Return additional data to be included in the ShapeCache key
+     *
+     * Override this function if the feature output depends on some state not
+     * stored in its own properties, e.g. a setting of its container.
+     */
+    virtual std::string getShapeCacheData() const;
+
 protected:
     /// recompute only this object
     App::DocumentObjectExecReturn *recompute() override;
@@ -63,6 +63,9 @@ public:
     double MeshDeviation;
     double MeshAngularDeflection;
     double MinimumAngularDeflection;
+    bool EnableShapeCache;
+    long ShapeCacheMemoryCount;
+    long ShapeCacheDiskLimit;
 
     // Auto generated code (Tools/params_utils.py:252)
     PartParamsP() {
@@ -115,6 +118,12 @@ public:
         funcs["MeshAngularDeflection"] = &PartParamsP::updateMeshAngularDeflection;
         MinimumAngularDeflection = this->handle->GetFloat("MinimumAngularDeflection", 5.0);
         funcs["MinimumAngularDeflection"] = &PartParamsP::updateMinimumAngularDeflection;
+        EnableShapeCache = this->handle->GetBool("EnableShapeCache", false);
+        funcs["EnableShapeCache"] = &PartParamsP::updateEnableShapeCache;
+        ShapeCacheMemoryCount = this->handle->GetInt("ShapeCacheMemoryCount", 500);
+        funcs["ShapeCacheMemoryCount"] = &PartParamsP::updateShapeCacheMemoryCount;
+        ShapeCacheDiskLimit = this->handle->GetInt("ShapeCacheDiskLimit", 1024);
+        funcs["ShapeCacheDiskLimit"] = &PartParamsP::updateShapeCacheDiskLimit;
     }
 
     // Auto generated code (Tools/params_utils.py:282)
@@ -225,6 +234,18 @@ public:
     static void updateMinimumAngularDeflection(PartParamsP *self) {
         self->MinimumAngularDeflection = self->handle->GetFloat("MinimumAngularDeflection", 5.0);
     }
+    // Auto generated code (Tools/params_utils.py:307)
+    static void updateEnableShapeCache(PartParamsP *self) {
+        self->EnableShapeCache = self->handle->GetBool("EnableShapeCache", false);
+    }
+    // Auto generated code (Tools/params_utils.py:307)
+    static void updateShapeCacheMemoryCount(PartParamsP *self) {
+        self->ShapeCacheMemoryCount = self->handle->GetInt("ShapeCacheMemoryCount", 500);
+    }
+    // Auto generated code (Tools/params_utils.py:307)
+    static void updateShapeCacheDiskLimit(PartParamsP *self) {
+        self->ShapeCacheDiskLimit = self->handle->GetInt("ShapeCacheDiskLimit", 1024);
+    }
 };
 
 // Auto generated code (Tools/params_utils.py:329)
@@ -860,4 +881,91 @@ void PartParams::setMinimumAngularDeflection(const double &v) {
 void PartParams::removeMinimumAngularDeflection() {
     instance()->handle->RemoveFloat("MinimumAngularDeflection");
 }
+
+// Auto generated code (Tools/params_utils.py:369)
+const char *PartParams::docEnableShapeCache() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Enable caching of computed feature shapes keyed by the hash of the feature\n"
+"type, its property values and its input shapes. A cache hit skips the\n"
+"feature execution on recompute.");
+}
+
+// Auto generated code (Tools/params_utils.py:377)
+const bool & PartParams::getEnableShapeCache() {
+    return instance()->EnableShapeCache;
+}
+
+// Auto generated code (Tools/params_utils.py:385)
+const bool & PartParams::defaultEnableShapeCache() {
+    const static bool def = false;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:394)
+void PartParams::setEnableShapeCache(const bool &v) {
+    instance()->handle->SetBool("EnableShapeCache",v);
+    instance()->EnableShapeCache = v;
+}
+
+// Auto generated code (Tools/params_utils.py:403)
+void PartParams::removeEnableShapeCache() {
+    instance()->handle->RemoveBool("EnableShapeCache");
+}
+
+// Auto generated code (Tools/params_utils.py:369)
+const char *PartParams::docShapeCacheMemoryCount() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Maximum number of shapes kept in the in-memory shape cache.");
+}
+
+// Auto generated code (Tools/params_utils.py:377)
+const long & PartParams::getShapeCacheMemoryCount() {
+    return instance()->ShapeCacheMemoryCount;
+}
+
+// Auto generated code (Tools/params_utils.py:385)
+const long & PartParams::defaultShapeCacheMemoryCount() {
+    const static long def = 500;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:394)
+void PartParams::setShapeCacheMemoryCount(const long &v) {
+    instance()->handle->SetInt("ShapeCacheMemoryCount",v);
+    instance()->ShapeCacheMemoryCount = v;
+}
+
+// Auto generated code (Tools/params_utils.py:403)
+void PartParams::removeShapeCacheMemoryCount() {
+    instance()->handle->RemoveInt("ShapeCacheMemoryCount");
+}
+
+// Auto generated code (Tools/params_utils.py:369)
+const char *PartParams::docShapeCacheDiskLimit() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Size limit in MB of the on-disk shape cache, which is written when the document\n"
+"is saved or closed. Zero disables the on-disk cache.");
+}
+
+// Auto generated code (Tools/params_utils.py:377)
+const long & PartParams::getShapeCacheDiskLimit() {
+    return instance()->ShapeCacheDiskLimit;
+}
+
+// Auto generated code (Tools/params_utils.py:385)
+const long & PartParams::defaultShapeCacheDiskLimit() {
+    const static long def = 1024;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:394)
+void PartParams::setShapeCacheDiskLimit(const long &v) {
+    instance()->handle->SetInt("ShapeCacheDiskLimit",v);
+    instance()->ShapeCacheDiskLimit = v;
+}
+
+// Auto generated code (Tools/params_utils.py:403)
+void PartParams::removeShapeCacheDiskLimit() {
+    instance()->handle->RemoveInt("ShapeCacheDiskLimit");
+}
 //[[[end]]]
@@ -300,6 +300,45 @@ public:
     static const char *docMinimumAngularDeflection();
     //@}
 
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter EnableShapeCache
+    ///
+    /// Enable caching of computed feature shapes keyed by the hash of the feature
+    /// type, its property values and its input shapes. A cache hit skips the
+    /// feature execution on recompute.
+    static const bool & getEnableShapeCache();
+    static const bool & defaultEnableShapeCache();
+    static void removeEnableShapeCache();
+    static void setEnableShapeCache(const bool &v);
+    static const char *docEnableShapeCache();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter ShapeCacheMemoryCount
+    ///
+    /// Maximum number of shapes kept in the in-memory shape cache.
+    static const long & getShapeCacheMemoryCount();
+    static const long & defaultShapeCacheMemoryCount();
+    static void removeShapeCacheMemoryCount();
+    static void setShapeCacheMemoryCount(const long &v);
+    static const char *docShapeCacheMemoryCount();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:139)
+    //@{
+    /// Accessor for parameter ShapeCacheDiskLimit
+    ///
+    /// Size limit in MB of the on-disk shape cache, which is written when the document
+    /// is saved or closed. Zero disables the on-disk cache.
+    static const long & getShapeCacheDiskLimit();
+    static const long & defaultShapeCacheDiskLimit();
+    static void removeShapeCacheDiskLimit();
+    static void setShapeCacheDiskLimit(const long &v);
+    static const char *docShapeCacheDiskLimit();
+    //@}
+
 // Auto generated code (Tools/params_utils.py:179)
 }; // class PartParams
 } // namespace Part
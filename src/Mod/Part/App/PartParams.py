@@ -79,6 +79,15 @@ Params = [
     _MeshDeviation,
     _MeshAngularDeflection,
     _MinimumAngularDeflection,
+    ParamBool("EnableShapeCache", False,
+        doc="Enable caching of computed feature shapes keyed by the hash of the feature\n"
+            "type, its property values and its input shapes. A cache hit skips the\n"
+            "feature execution on recompute."),
+    ParamInt("ShapeCacheMemoryCount", 500,
+        doc="Maximum number of shapes kept in the in-memory shape cache."),
+    ParamInt("ShapeCacheDiskLimit", 1024,
+        doc="Size limit in MB of the on-disk shape cache, which is written when the document\n"
+            "is saved or closed. Zero disables the on-disk cache."),
 ]
 
 def declare():
@@ -91,6 +91,21 @@ App::DocumentObjectExecReturn* Primitive::execute() {
     return Part::Feature::execute();
 }
 
+bool Primitive::canCacheShape() const
+{
+    return true;
+}
+
+bool Primitive::canRecomputeInThread() const
+{
+    // Attachment reads the placement and shape of other objects, and shape
+    // contents are merged from the linked objects, so only the plain
+    // primitive builds its shape purely from its own properties.
+    return AttachmentSupport.getValues().empty()
+        && Support.getValues().empty()
+        && !getPropertyByName("ShapeContents");
+}
+
 // suppress warning about tp_print for Py3.8
 #if defined(__clang__)
 # pragma clang diagnostic push
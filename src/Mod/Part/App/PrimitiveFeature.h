@@ -46,6 +46,9 @@ public:
     PyObject* getPyObject() override;
     //@}
 
+    bool canCacheShape() const override;
+    bool canRecomputeInThread() const override;
+
 protected:
     void onChanged (const App::Property* prop) override;
     void handleChangedPropertyName(Base::XMLReader &reader, const char * TypeName, const char *PropName) override;
@@ -623,10 +623,6 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 
 void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 {
-    // save the element map
-    auto elementMap = _Shape.resetElementMap();
-    auto hasher = _Shape.Hasher;
-
     Base::FileInfo brep(reader.getFileName());
     TopoShape shape;
     if (brep.hasExtension("bin")) {
@@ -635,9 +631,38 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
     else {
         shape.importBrep(reader);
     }
+    restoreShape(shape);
+}
+
+bool PropertyPartShape::canRestoreDocFileInThread() const
+{
+    return true;
+}
+
+std::function<void()> PropertyPartShape::restoreDocFileInThread(Base::Reader &reader)
+{
+    auto shape = std::make_shared<TopoShape>();
+    Base::FileInfo brep(reader.getFileName());
+    if (brep.hasExtension("bin")) {
+        shape->importBinary(reader);
+    }
+    else {
+        // no progress indicator outside of the main thread
+        shape->importBrep(reader, 0);
+    }
+    return [this, shape]() {
+        restoreShape(*shape);
+    };
+}
+
+void PropertyPartShape::restoreShape(TopoShape &shape)
+{
+    // The element map may have been restored before the shape, so
+    // transfer it to the new shape
+    auto elementMap = _Shape.resetElementMap();
+    auto hasher = _Shape.Hasher;
 
     std::string ver = _Ver;
-    // restore the element map
     shape.Hasher = hasher;
     shape.resetElementMap(elementMap);
     setValue(shape);
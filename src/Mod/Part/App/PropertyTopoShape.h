@@ -95,6 +95,8 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const override;
     void RestoreDocFile(Base::Reader &reader) override;
+    bool canRestoreDocFileInThread() const override;
+    std::function<void()> restoreDocFileInThread(Base::Reader &reader) override;
 
     App::Property *Copy(void) const override;
     void Paste(const App::Property &from) override;
@@ -116,6 +118,7 @@ protected:
 
 private:
     void saveToFile(Base::Writer &writer) const;
+    void restoreShape(TopoShape &shape);
     TopoDS_Shape loadFromFile(Base::Reader &reader);
     TopoDS_Shape loadFromStream(Base::Reader &reader);
 
@@ -0,0 +1,666 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cstring>
+# include <list>
+# include <map>
+# include <mutex>
+# include <sstream>
+# include <unordered_map>
+# include <QCryptographicHash>
+#endif
+
+#include <zipios++/zipios-config.h>
+#include <zipios++/zipinputstream.h>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/DocumentObject.h>
+#include <App/PropertyFile.h>
+#include <App/PropertyLinks.h>
+#include <App/StringHasher.h>
+#include <Base/Console.h>
+#include <Base/FileInfo.h>
+#include <Base/Persistence.h>
+#include <Base/Reader.h>
+#include <Base/Writer.h>
+
+#include "ShapeCache.h"
+#include "PartFeature.h"
+#include "PartParams.h"
+
+FC_LOG_LEVEL_INIT("Part",true,true)
+
+using namespace Part;
+
+// Bump this version whenever the key calculation or the file format changes
+static const int ShapeCacheVersion = 1;
+
+namespace {
+
+struct CacheEntry
+{
+    std::vector<std::pair<std::string, TopoShape>> shapes;
+    App::StringHasherRef hasher;
+    /// document of the entry if it is yet to be written to disk
+    const App::Document *pendingDoc = nullptr;
+};
+
+/* Persistence helper of a cache entry
+ *
+ * The XML part lists the shapes and their files. The string table of the
+ * hasher is saved first, so that it can be verified against the current
+ * document hasher before restoring any element map.
+ */
+class CacheFile: public Base::Persistence
+{
+public:
+    CacheFile(CacheEntry &entry)
+        :entry(entry)
+    {}
+
+    unsigned int getMemSize() const override
+    {
+        return 0;
+    }
+
+    void Save(Base::Writer &writer) const override
+    {
+        files.clear();
+        writer.Stream() << writer.ind() << "<ShapeCache version=\"" << ShapeCacheVersion
+                        << "\" count=\"" << entry.shapes.size() << "\"";
+        if (entry.hasher)
+            writer.Stream() << " table=\"" << addFile(writer, "Table.txt", -1, false) << "\"";
+        writer.Stream() << ">\n";
+        writer.incInd();
+        int i = 0;
+        for (auto &v : entry.shapes) {
+            writer.Stream() << writer.ind() << "<Shape name=\"" << v.first
+                            << "\" file=\"" << addFile(writer, "Shape.bin", i, false) << "\"";
+            if (v.second.getElementMapSize())
+                writer.Stream() << " map=\"" << addFile(writer, "Shape.Map.txt", i, true) << "\"";
+            writer.Stream() << "/>\n";
+            ++i;
+        }
+        writer.decInd();
+        writer.Stream() << writer.ind() << "</ShapeCache>\n";
+    }
+
+    void Restore(Base::XMLReader &reader) override
+    {
+        files.clear();
+        entry.shapes.clear();
+        reader.readElement("ShapeCache");
+        if (reader.getAttributeAsInteger("version") != ShapeCacheVersion)
+            return;
+        if (reader.hasAttribute("table"))
+            addFile(reader, reader.getAttribute("table"), -1, false);
+        else
+            tableValid = true;
+        long count = reader.getAttributeAsInteger("count");
+        for (long i=0; i<count; ++i) {
+            reader.readElement("Shape");
+            entry.shapes.emplace_back(reader.getAttribute("name"), TopoShape());
+            addFile(reader, reader.getAttribute("file"), i, false);
+            if (reader.hasAttribute("map"))
+                addFile(reader, reader.getAttribute("map"), i, true);
+        }
+        reader.readEndElement("ShapeCache");
+    }
+
+    void SaveDocFile(Base::Writer &writer) const override
+    {
+        auto it = files.find(writer.getCurrentFileName());
+        if (it == files.end())
+            return;
+        if (it->second.first < 0)
+            entry.hasher->SaveDocFile(writer);
+        else if (it->second.second)
+            entry.shapes[it->second.first].second.SaveDocFile(writer);
+        else
+            entry.shapes[it->second.first].second.exportBinary(writer.Stream());
+    }
+
+    void RestoreDocFile(Base::Reader &reader) override
+    {
+        auto it = files.find(reader.getFileName());
+        if (it == files.end())
+            return;
+        if (it->second.first < 0) {
+            App::StringHasherRef table(new App::StringHasher);
+            table->RestoreDocFile(reader);
+            tableValid = checkTable(table);
+        }
+        else {
+            auto &shape = entry.shapes[it->second.first].second;
+            if (!it->second.second)
+                shape.importBinary(reader);
+            else if (!tableValid)
+                return;
+            else {
+                shape.Hasher = entry.hasher;
+                shape.RestoreDocFile(reader);
+            }
+        }
+        ++restored;
+    }
+
+    bool isValid() const
+    {
+        return !files.empty() && restored == files.size();
+    }
+
+private:
+    const std::string &addFile(Base::Writer &writer, const char *name, int index, bool map) const
+    {
+        const auto &filename = writer.addFile(name, this);
+        files.emplace(filename, std::make_pair(index, map));
+        return filename;
+    }
+
+    void addFile(Base::XMLReader &reader, const char *name, int index, bool map)
+    {
+        reader.addFile(name, this);
+        files.emplace(name, std::make_pair(index, map));
+    }
+
+    // Check that all string IDs used by the cached element maps exist with the
+    // same content in the hasher of the current document
+    bool checkTable(const App::StringHasherRef &table) const
+    {
+        if (!entry.hasher)
+            return false;
+        for (auto &v : table->getIDMap()) {
+            auto sid = entry.hasher->getID(v.first);
+            if (!sid || sid.dataToText() != v.second.dataToText())
+                return false;
+        }
+        return true;
+    }
+
+private:
+    CacheEntry &entry;
+    // file name -> (shape index or -1 for string table, is element map)
+    mutable std::map<std::string, std::pair<int, bool>> files;
+    std::size_t restored = 0;
+    bool tableValid = false;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+
+class ShapeCache::Private
+{
+public:
+    typedef std::unordered_map<const App::DocumentObject*, std::string> KeyMap;
+
+    Private()
+    {
+        auto &app = App::GetApplication();
+        connBeforeRecompute = app.signalBeforeRecomputeDocument.connect(
+            [this](const App::Document &doc) {
+                std::lock_guard<std::mutex> lock(mutex);
+                docKeys[&doc].clear();
+            });
+        connRecomputed = app.signalRecomputed.connect(
+            [this](const App::Document &doc) {
+                std::lock_guard<std::mutex> lock(mutex);
+                docKeys.erase(&doc);
+            });
+        connDeleteDocument = app.signalDeleteDocument.connect(
+            [this](const App::Document &doc) {
+                std::lock_guard<std::mutex> lock(mutex);
+                docKeys.erase(&doc);
+                flushFiles(&doc);
+            });
+        connFinishSaveDocument = app.signalFinishSaveDocument.connect(
+            [this](const App::Document &doc, const std::string &) {
+                std::lock_guard<std::mutex> lock(mutex);
+                flushFiles(&doc);
+            });
+    }
+
+    static bool skipProperty(const App::Property *prop)
+    {
+        if (prop->testStatus(App::Property::Transient)
+                || prop->testStatus(App::Property::Output)
+                || (prop->getType() & (App::Prop_Transient | App::Prop_Output)))
+            return true;
+        // Shape properties hold the result of the execution
+        if (prop->isDerivedFrom(PropertyPartShape::getClassTypeId()))
+            return true;
+        static const char *excludes[] = {
+            "Label", "Label2", "Visibility", "ExpressionEngine", "ColoredElements",
+        };
+        const char *name = prop->getName();
+        for (auto exclude : excludes) {
+            if (strcmp(name, exclude) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    static void hashShape(QCryptographicHash &hash, const Feature *feature)
+    {
+        const auto &shape = feature->Shape.getShape();
+        std::ostringstream ss;
+        shape.exportBinary(ss);
+        std::string data = ss.str();
+        hash.addData(data.c_str(), static_cast<int>(data.size()));
+        for (auto &v : shape.getElementMap()) {
+            data = v.index.toString();
+            hash.addData(data.c_str(), static_cast<int>(data.size()));
+            data = v.name.toString();
+            hash.addData(data.c_str(), static_cast<int>(data.size()));
+        }
+    }
+
+    std::string getObjectKey(const App::DocumentObject *obj, KeyMap &keys, bool input)
+    {
+        auto res = keys.emplace(obj, std::string());
+        // Note that the entry stays empty while being calculated, which
+        // breaks any cyclic dependency.
+        if (!res.second)
+            return res.first->second;
+
+        if (!obj || !obj->getNameInDocument())
+            return std::string();
+
+        // Input objects must be up to date, or else we can't trust their
+        // properties or shape content.
+        if (input && (obj->isError() || obj->isTouched() || obj->mustExecute() > 0))
+            return std::string();
+
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        std::ostringstream ss;
+        ss << ShapeCacheVersion << ' ' << obj->getTypeId().getName() << ' ' << obj->getID();
+        std::string data = ss.str();
+        hash.addData(data.c_str(), static_cast<int>(data.size()));
+
+        auto feature = Base::freecad_dynamic_cast<Feature>(obj);
+        if (feature && (!feature->canCacheShape() || obj->getPropertyByName("Proxy"))) {
+            // Shape of features that do not support caching (e.g. sketches,
+            // imported shapes, Python features) are hashed by content.
+            hashShape(hash, feature);
+        }
+        else {
+            if (feature) {
+                data = feature->getElementMapVersion(&feature->Shape);
+                hash.addData(data.c_str(), static_cast<int>(data.size()));
+                data = feature->getShapeCacheData();
+                hash.addData(data.c_str(), static_cast<int>(data.size()));
+            }
+
+            std::vector<App::Property*> props;
+            obj->getPropertyList(props);
+            std::vector<App::DocumentObject*> links;
+            for (auto prop : props) {
+                if (skipProperty(prop))
+                    continue;
+                // External file content is not tracked
+                if (prop->isDerivedFrom(App::PropertyFileIncluded::getClassTypeId()))
+                    return std::string();
+
+                Base::StringWriter writer;
+                prop->Save(writer);
+                hash.addData(prop->getName());
+                data = writer.getString();
+                hash.addData(data.c_str(), static_cast<int>(data.size()));
+
+                if (auto propLink = Base::freecad_dynamic_cast<App::PropertyLinkBase>(prop)) {
+                    links.clear();
+                    propLink->getLinks(links, true);
+                    for (auto link : links) {
+                        if (link == obj)
+                            continue;
+                        // Only shape features are allowed to have dependencies
+                        if (!feature)
+                            return std::string();
+                        data = getObjectKey(link, keys, true);
+                        if (data.empty())
+                            return std::string();
+                        hash.addData(data.c_str(), static_cast<int>(data.size()));
+                    }
+                }
+            }
+        }
+
+        res.first->second = hash.result().toHex().constData();
+        return res.first->second;
+    }
+
+    std::string getKey(const Feature *feature, bool refresh)
+    {
+        auto doc = feature->getDocument();
+        auto it = docKeys.find(doc);
+        if (it == docKeys.end()) {
+            KeyMap keys;
+            return getObjectKey(feature, keys, false);
+        }
+        if (refresh)
+            it->second.erase(feature);
+        return getObjectKey(feature, it->second, false);
+    }
+
+    bool apply(const CacheEntry &entry, Feature *feature) const
+    {
+        auto hasher = feature->getDocument()->getStringHasher();
+        if (entry.hasher && entry.hasher != hasher)
+            return false;
+
+        std::vector<std::pair<PropertyPartShape*, const TopoShape*>> props;
+        for (auto &v : entry.shapes) {
+            auto prop = Base::freecad_dynamic_cast<PropertyPartShape>(
+                    feature->getPropertyByName(v.first.c_str()));
+            if (!prop)
+                return false;
+            props.emplace_back(prop, &v.second);
+        }
+        for (auto &v : props) {
+            TopoShape shape(*v.second);
+            shape.Tag = feature->getID();
+            v.first->setValue(shape);
+        }
+        return true;
+    }
+
+    void addEntry(const std::string &key, CacheEntry &&entry)
+    {
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            it->second.first = std::move(entry);
+            lru.splice(lru.end(), lru, it->second.second);
+            return;
+        }
+        lru.push_back(key);
+        entries.emplace(key, std::make_pair(std::move(entry), std::prev(lru.end())));
+
+        std::size_t limit = static_cast<std::size_t>(
+                std::max(0l, PartParams::getShapeCacheMemoryCount()));
+        while (lru.size() > limit) {
+            entries.erase(lru.front());
+            lru.pop_front();
+        }
+    }
+
+    static std::string getCachePath()
+    {
+        std::string path = App::Application::getUserCachePath();
+        if (!path.empty() && path.back() != '/' && path.back() != '\\')
+            path += '/';
+        return path + "ShapeCache/";
+    }
+
+    static std::string getFilePath(const std::string &key)
+    {
+        return getCachePath() + key + ".zip";
+    }
+
+    bool loadFile(const std::string &key, CacheEntry &entry)
+    {
+        if (PartParams::getShapeCacheDiskLimit() <= 0)
+            return false;
+        Base::FileInfo fi(getFilePath(key));
+        if (!fi.exists())
+            return false;
+        bool res = false;
+        try {
+            zipios::ZipInputStream zipstream(fi.filePath());
+            Base::ZipReader reader(zipstream, fi.filePath());
+            Base::XMLReader xmlReader(reader);
+            if (xmlReader.isValid()) {
+                CacheFile file(entry);
+                Data::ComplexGeoData::resetElementMapIds();
+                file.Restore(xmlReader);
+                xmlReader.readFiles();
+                res = file.isValid();
+            }
+        }
+        catch (Base::Exception &e) {
+            FC_WARN("Failed to read shape cache " << fi.filePath() << ": " << e.what());
+        }
+        catch (std::exception &e) {
+            FC_WARN("Failed to read shape cache " << fi.filePath() << ": " << e.what());
+        }
+        Data::ComplexGeoData::resetElementMapIds();
+        return res;
+    }
+
+    // Write the pending entries. Note that entries evicted from memory before
+    // that are simply dropped, so that the pending ones are bounded as well.
+    void flushFiles(const App::Document *doc)
+    {
+        long limit = PartParams::getShapeCacheDiskLimit();
+        bool written = false;
+        for (auto &v : entries) {
+            auto &entry = v.second.first;
+            if (!entry.pendingDoc || (doc && entry.pendingDoc != doc))
+                continue;
+            entry.pendingDoc = nullptr;
+            if (limit > 0) {
+                saveFile(v.first, entry);
+                written = true;
+            }
+        }
+        if (written)
+            pruneFiles(limit * 1024 * 1024);
+    }
+
+    void saveFile(const std::string &key, CacheEntry &entry)
+    {
+        // The file is named by the key, so an existing one has the same content
+        Base::FileInfo fi(getFilePath(key));
+        if (fi.exists())
+            return;
+
+        Base::FileInfo dir(getCachePath());
+        if (!dir.exists() && !dir.createDirectories()) {
+            FC_WARN("Failed to create shape cache directory " << dir.filePath());
+            return;
+        }
+
+        std::string tmpPath = fi.filePath() + ".tmp";
+        Base::FileInfo tmp(tmpPath);
+        Data::ComplexGeoData::resetElementMapIds();
+        try {
+            if (entry.hasher)
+                entry.hasher->clearMarks();
+            for (auto &v : entry.shapes)
+                v.second.beforeSave();
+            {
+                Base::ZipWriter writer(tmpPath.c_str());
+                writer.putNextEntry("ShapeCache.xml");
+                writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>\n";
+                CacheFile file(entry);
+                file.Save(writer);
+                writer.writeFiles();
+            }
+            if (!tmp.renameFile(fi.filePath().c_str()))
+                tmp.deleteFile();
+            else if (diskSize >= 0)
+                diskSize += Base::FileInfo(fi.filePath()).size();
+        }
+        catch (Base::Exception &e) {
+            FC_WARN("Failed to write shape cache " << fi.filePath() << ": " << e.what());
+            tmp.deleteFile();
+        }
+        catch (std::exception &e) {
+            FC_WARN("Failed to write shape cache " << fi.filePath() << ": " << e.what());
+            tmp.deleteFile();
+        }
+        Data::ComplexGeoData::resetElementMapIds();
+    }
+
+    void pruneFiles(int64_t limit)
+    {
+        if (diskSize >= 0 && diskSize <= limit)
+            return;
+
+        Base::FileInfo dir(getCachePath());
+        std::vector<std::pair<int64_t, Base::FileInfo>> files;
+        diskSize = 0;
+        for (auto &fi : dir.getDirectoryContent()) {
+            if (!fi.isFile() || !fi.hasExtension("zip"))
+                continue;
+            diskSize += fi.size();
+            files.emplace_back(fi.lastModified().getSeconds(), fi);
+        }
+        if (diskSize <= limit)
+            return;
+
+        std::sort(files.begin(), files.end(),
+            [](const std::pair<int64_t, Base::FileInfo> &a,
+               const std::pair<int64_t, Base::FileInfo> &b) {
+                return a.first < b.first;
+            });
+        for (auto &v : files) {
+            if (diskSize <= limit)
+                break;
+            auto size = v.second.size();
+            if (v.second.deleteFile())
+                diskSize -= size;
+        }
+    }
+
+public:
+    std::mutex mutex;
+    std::unordered_map<const App::Document*, KeyMap> docKeys;
+    std::list<std::string> lru;
+    std::unordered_map<std::string,
+        std::pair<CacheEntry, std::list<std::string>::iterator>> entries;
+    int64_t diskSize = -1;
+
+    boost::signals2::scoped_connection connBeforeRecompute;
+    boost::signals2::scoped_connection connRecomputed;
+    boost::signals2::scoped_connection connDeleteDocument;
+    boost::signals2::scoped_connection connFinishSaveDocument;
+};
+
+// ----------------------------------------------------------------------------
+
+ShapeCache::ShapeCache()
+    :pimpl(new Private)
+{
+}
+
+ShapeCache::~ShapeCache()
+{
+}
+
+ShapeCache &ShapeCache::instance()
+{
+    static ShapeCache *inst;
+    if (!inst)
+        inst = new ShapeCache;
+    return *inst;
+}
+
+bool ShapeCache::isEnabled()
+{
+    return PartParams::getEnableShapeCache();
+}
+
+std::string ShapeCache::getKey(const Feature *feature)
+{
+    if (!feature || !feature->getDocument() || !feature->canCacheShape())
+        return std::string();
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    return pimpl->getKey(feature, false);
+}
+
+bool ShapeCache::restore(const std::string &key, Feature *feature)
+{
+    if (key.empty() || !feature || !feature->getDocument())
+        return false;
+
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    auto it = pimpl->entries.find(key);
+    if (it != pimpl->entries.end()) {
+        pimpl->lru.splice(pimpl->lru.end(), pimpl->lru, it->second.second);
+        if (pimpl->apply(it->second.first, feature))
+            return true;
+    }
+
+    CacheEntry entry;
+    entry.hasher = feature->getDocument()->getStringHasher();
+    if (!pimpl->loadFile(key, entry) || !pimpl->apply(entry, feature))
+        return false;
+    pimpl->addEntry(key, std::move(entry));
+    return true;
+}
+
+void ShapeCache::save(const Feature *feature)
+{
+    if (!feature || !feature->getDocument() || !feature->canCacheShape())
+        return;
+
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+
+    // Properties may be modified during execution, e.g. Placement by
+    // attachment, so recalculate the key here.
+    std::string key = pimpl->getKey(feature, true);
+    if (key.empty())
+        return;
+
+    CacheEntry entry;
+    entry.hasher = feature->getDocument()->getStringHasher();
+    std::vector<App::Property*> props;
+    feature->getPropertyList(props);
+    for (auto prop : props) {
+        auto propShape = Base::freecad_dynamic_cast<PropertyPartShape>(prop);
+        if (!propShape)
+            continue;
+        auto shape = propShape->getShape();
+        if (shape.Hasher && shape.Hasher != entry.hasher)
+            return;
+        entry.shapes.emplace_back(prop->getName(), shape);
+    }
+    // Writing the file is expensive, defer it to document save or close
+    if (PartParams::getShapeCacheDiskLimit() > 0)
+        entry.pendingDoc = feature->getDocument();
+    pimpl->addEntry(key, std::move(entry));
+}
+
+void ShapeCache::flush(const App::Document *doc)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    pimpl->flushFiles(doc);
+}
+
+void ShapeCache::clear(bool disk)
+{
+    std::lock_guard<std::mutex> lock(pimpl->mutex);
+    pimpl->entries.clear();
+    pimpl->lru.clear();
+    if (disk) {
+        Base::FileInfo dir(Private::getCachePath());
+        if (dir.exists())
+            dir.deleteDirectoryRecursive();
+        pimpl->diskSize = -1;
+    }
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PART_SHAPE_CACHE_H
+#define PART_SHAPE_CACHE_H
+
+#include <memory>
+#include <string>
+#include <Mod/Part/PartGlobal.h>
+
+namespace App {
+class Document;
+}
+
+namespace Part {
+
+class Feature;
+
+/** Cache of shape feature recompute results
+ *
+ * The cache maps a key computed from the input of a feature to the shapes
+ * produced by its last successful execution. The key is a SHA1 hash of the
+ * feature type, its persistent properties, and recursively the keys (or the
+ * shape content) of all linked objects. A recompute with an unchanged key can
+ * thus restore the shapes without executing the feature.
+ *
+ * Entries are kept in a bounded in-memory LRU list, and are optionally
+ * written to the user cache directory so that they survive a restart of the
+ * application. Writing is deferred until the document is saved or closed to
+ * keep the file IO out of recompute. Only features returning true from
+ * Feature::canCacheShape() are cached.
+ */
+class PartExport ShapeCache
+{
+public:
+    /// Return the singleton instance
+    static ShapeCache &instance();
+
+    /// Check whether shape caching is enabled in user preference
+    static bool isEnabled();
+
+    /** Compute the cache key of a feature
+     * @param feature: the feature to be recomputed
+     * @return Returns the key, or an empty string if the feature cannot be
+     * cached, e.g. because some dependency is in error or not yet
+     * recomputed.
+     */
+    std::string getKey(const Feature *feature);
+
+    /** Restore the shapes of a feature from cache
+     * @param key: the key obtained from getKey()
+     * @param feature: the feature to restore
+     * @return Returns true if the shapes are restored from cache.
+     */
+    bool restore(const std::string &key, Feature *feature);
+
+    /** Store the shapes of a feature after successful execution
+     *
+     * The shapes are stored in memory immediately, and queued to be written
+     * to disk on the next call of flush().
+     */
+    void save(const Feature *feature);
+
+    /** Write the queued entries to the on-disk cache
+     * @param doc: if not null, then only write entries of this document
+     *
+     * It is called automatically after saving or before closing a document.
+     */
+    void flush(const App::Document *doc=nullptr);
+
+    /** Clear the cache
+     * @param disk: if true, then also remove the on-disk cache files
+     */
+    void clear(bool disk=false);
+
+private:
+    ShapeCache();
+    ~ShapeCache();
+
+    ShapeCache(const ShapeCache&) = delete;
+    ShapeCache& operator=(const ShapeCache&) = delete;
+
+private:
+    class Private;
+    std::unique_ptr<Private> pimpl;
+};
+
+} // namespace Part
+
+#endif // PART_SHAPE_CACHE_H
@@ -3634,6 +3634,13 @@ void TopoShape::getFacesFromSubElement(const Data::Segment* element,
     }
 }
 
+Base::BoundBox3d TopoShape::getBoundBoxFromSubElement(const Data::Segment* element) const
+{
+    if (element->getTypeId() == ShapeSegment::getClassTypeId())
+        return static_cast<const ShapeSegment*>(element)->Shape.getBoundBox();
+    return Base::BoundBox3d();
+}
+
 TopoDS_Shape TopoShape::defeaturing(const std::vector<TopoDS_Shape>& s) const
 {
     if (this->_Shape.IsNull())
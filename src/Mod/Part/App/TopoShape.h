@@ -207,6 +207,8 @@ public:
         std::vector<Base::Vector3d> &Points,
         std::vector<Base::Vector3d> &PointNormals,
         std::vector<Facet> &faces) const override;
+    /** Get the bound box of a segment */
+    Base::BoundBox3d getBoundBoxFromSubElement(const Data::Segment*) const override;
     //@}
     /// get the Topo"sub"Shape with the given name
     TopoDS_Shape getSubShape(const char* Type, bool silent=false) const;
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+#endif
+
+#include "BoundBoxBVH.h"
+
+using namespace PartGui;
+
+static const int BVHLeafSize = 8;
+
+void BoundBoxBVH::init(const std::vector<SbBox3f> &bboxes)
+{
+    clear();
+    boxCount = bboxes.size();
+
+    std::vector<Item> items;
+    items.reserve(boxCount);
+    for (int i=0, count=(int)boxCount; i<count; ++i) {
+        if (!bboxes[i].isEmpty())
+            items.push_back({bboxes[i].getCenter(), i});
+    }
+    if (items.empty())
+        return;
+
+    nodes.reserve(2 * (items.size() / BVHLeafSize + 1));
+    nodes.emplace_back();
+    build(bboxes, items, 0, 0, (int)items.size());
+
+    indices.reserve(items.size());
+    boxes.reserve(items.size());
+    for (const auto &item : items) {
+        indices.push_back(item.index);
+        boxes.push_back(bboxes[item.index]);
+    }
+}
+
+void BoundBoxBVH::build(const std::vector<SbBox3f> &bboxes, std::vector<Item> &items,
+                        int index, int first, int count)
+{
+    if (count <= BVHLeafSize) {
+        SbBox3f bbox;
+        for (int i=first, end=first+count; i<end; ++i)
+            bbox.extendBy(bboxes[items[i].index]);
+        nodes[index].bbox = bbox;
+        nodes[index].first = first;
+        nodes[index].count = count;
+        return;
+    }
+
+    SbBox3f cbox;
+    for (int i=first, end=first+count; i<end; ++i)
+        cbox.extendBy(items[i].center);
+    float dx, dy, dz;
+    cbox.getSize(dx, dy, dz);
+    if (dx + dy + dz <= 0.0f) {
+        // All centers coincide, no way to split
+        SbBox3f bbox;
+        for (int i=first, end=first+count; i<end; ++i)
+            bbox.extendBy(bboxes[items[i].index]);
+        nodes[index].bbox = bbox;
+        nodes[index].first = first;
+        nodes[index].count = count;
+        return;
+    }
+    int axis = dx >= dy ? (dx >= dz ? 0 : 2) : (dy >= dz ? 1 : 2);
+
+    int half = count / 2;
+    auto begin = items.begin() + first;
+    std::nth_element(begin, begin + half, begin + count,
+        [axis](const Item &a, const Item &b) {
+            return a.center[axis] < b.center[axis];
+        });
+
+    // Do not keep a reference to the node across here, as adding the
+    // children may reallocate
+    int child = (int)nodes.size();
+    nodes.emplace_back();
+    nodes.emplace_back();
+    nodes[index].child = child;
+    build(bboxes, items, child, first, half);
+    build(bboxes, items, child + 1, first + half, count - half);
+
+    SbBox3f bbox = nodes[child].bbox;
+    bbox.extendBy(nodes[child + 1].bbox);
+    nodes[index].bbox = bbox;
+}
+
+void BoundBoxBVH::clear()
+{
+    nodes.clear();
+    indices.clear();
+    boxes.clear();
+    boxCount = 0;
+}
+
+bool BoundBoxBVH::empty() const
+{
+    return nodes.empty();
+}
+
+std::size_t BoundBoxBVH::size() const
+{
+    return boxCount;
+}
+
+void BoundBoxBVH::rayPick(SoRayPickAction *action, std::vector<int> &results) const
+{
+    if (nodes.empty())
+        return;
+
+    static thread_local std::vector<int> stack;
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node &node = nodes[stack.back()];
+        stack.pop_back();
+        if (!action->intersect(node.bbox, TRUE))
+            continue;
+        if (node.count) {
+            for (int i=node.first, end=node.first+node.count; i<end; ++i) {
+                if (node.count == 1 || action->intersect(boxes[i], TRUE))
+                    results.push_back(indices[i]);
+            }
+        } else {
+            stack.push_back(node.child + 1);
+            stack.push_back(node.child);
+        }
+    }
+}
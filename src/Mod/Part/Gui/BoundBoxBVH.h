@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef PARTGUI_BBOX_BVH_H
+#define PARTGUI_BBOX_BVH_H
+
+#include <vector>
+#include <Inventor/SbBox3f.h>
+#include <Inventor/actions/SoRayPickAction.h>
+#include <Mod/Part/PartGlobal.h>
+
+namespace PartGui {
+
+/** Bounding volume hierarchy for ray picking a large number of small bounding boxes
+ *
+ * Unlike BoundBoxRayPick, which inserts the boxes one by one into an rtree,
+ * the tree is built top down in one pass by splitting the box centers at the
+ * median of the longest axis, so that it is cheap to build for millions of
+ * primitives, e.g. all triangles or line segments of a shape. The boxes are
+ * copied in the order of the leaves, so that close boxes are close in memory.
+ */
+class PartGuiExport BoundBoxBVH {
+public:
+    /** Build the tree
+     * @param bboxes: the boxes to index. Empty boxes are skipped, but still
+     *                count for the index reported by rayPick().
+     */
+    void init(const std::vector<SbBox3f> &bboxes);
+    void clear();
+    bool empty() const;
+    /// Return the number of boxes given to init()
+    std::size_t size() const;
+    /// Append the indices of all boxes intersecting with the pick ray or volume
+    void rayPick(SoRayPickAction *action, std::vector<int> &results) const;
+
+private:
+    struct Node {
+        SbBox3f bbox;
+        int first = 0;
+        int count = 0; // leaf if count > 0
+        int child = 0; // index of the left child, the right one follows it
+    };
+    struct Item {
+        SbVec3f center;
+        int index;
+    };
+    void build(const std::vector<SbBox3f> &bboxes, std::vector<Item> &items,
+               int index, int first, int count);
+
+private:
+    std::vector<Node> nodes;
+    std::vector<int> indices; // box indices in the order of the leaves
+    std::vector<SbBox3f> boxes; // boxes in the order of the leaves
+    std::size_t boxCount = 0;
+};
+
+} // namespace PartGui
+
+#endif
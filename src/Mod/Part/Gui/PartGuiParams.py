@@ -63,6 +63,15 @@ Params = [
     ParamInt("SelectionPickThreshold", 1000),
     ParamInt("SelectionPickThreshold2", 500),
     ParamBool("SelectionPickRTree", False),
+    ParamBool("SelectionPickBVH", True,
+        doc="Use a bounding volume hierarchy over all triangles and line segments of a shape with\n"
+            "at least 'SelectionPickThreshold' indices to speed up picking. The hierarchy is built\n"
+            "on the first pick of the shape."),
+    ParamBool("ParallelTessellation", True,
+        doc="Tessellate the shapes for display using multiple threads."),
+    ParamInt("AsyncTessellationThreshold", 0,
+        doc="Tessellate shapes with at least this number of faces in a worker thread, showing\n"
+            "their bounding box until done. Zero to disable."),
 ]
 
 def declare():
@@ -93,6 +93,9 @@ public:
     long SelectionPickThreshold;
     long SelectionPickThreshold2;
     bool SelectionPickRTree;
+    bool SelectionPickBVH;
+    bool ParallelTessellation;
+    long AsyncTessellationThreshold;
 
     // Auto generated code (Tools/params_utils.py:203)
     PartParamsP() {
@@ -151,6 +154,12 @@ public:
         funcs["SelectionPickThreshold2"] = &PartParamsP::updateSelectionPickThreshold2;
         SelectionPickRTree = handle->GetBool("SelectionPickRTree", false);
         funcs["SelectionPickRTree"] = &PartParamsP::updateSelectionPickRTree;
+        SelectionPickBVH = handle->GetBool("SelectionPickBVH", true);
+        funcs["SelectionPickBVH"] = &PartParamsP::updateSelectionPickBVH;
+        ParallelTessellation = handle->GetBool("ParallelTessellation", true);
+        funcs["ParallelTessellation"] = &PartParamsP::updateParallelTessellation;
+        AsyncTessellationThreshold = handle->GetInt("AsyncTessellationThreshold", 0);
+        funcs["AsyncTessellationThreshold"] = &PartParamsP::updateAsyncTessellationThreshold;
     }
 
     // Auto generated code (Tools/params_utils.py:217)
@@ -297,6 +306,18 @@ public:
     static void updateSelectionPickRTree(PartParamsP *self) {
         self->SelectionPickRTree = self->handle->GetBool("SelectionPickRTree", false);
     }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateSelectionPickBVH(PartParamsP *self) {
+        self->SelectionPickBVH = self->handle->GetBool("SelectionPickBVH", true);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateParallelTessellation(PartParamsP *self) {
+        self->ParallelTessellation = self->handle->GetBool("ParallelTessellation", true);
+    }
+    // Auto generated code (Tools/params_utils.py:238)
+    static void updateAsyncTessellationThreshold(PartParamsP *self) {
+        self->AsyncTessellationThreshold = self->handle->GetInt("AsyncTessellationThreshold", 0);
+    }
 };
 
 // Auto generated code (Tools/params_utils.py:256)
@@ -1013,6 +1034,93 @@ void PartParams::setSelectionPickRTree(const bool &v) {
 void PartParams::removeSelectionPickRTree() {
     instance()->handle->RemoveBool("SelectionPickRTree");
 }
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docSelectionPickBVH() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Use a bounding volume hierarchy over all triangles and line segments of a shape with\n"
+"at least 'SelectionPickThreshold' indices to speed up picking. The hierarchy is built\n"
+"on the first pick of the shape.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & PartParams::getSelectionPickBVH() {
+    return instance()->SelectionPickBVH;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & PartParams::defaultSelectionPickBVH() {
+    const static bool def = true;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setSelectionPickBVH(const bool &v) {
+    instance()->handle->SetBool("SelectionPickBVH",v);
+    instance()->SelectionPickBVH = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeSelectionPickBVH() {
+    instance()->handle->RemoveBool("SelectionPickBVH");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docParallelTessellation() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Tessellate the shapes for display using multiple threads.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const bool & PartParams::getParallelTessellation() {
+    return instance()->ParallelTessellation;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const bool & PartParams::defaultParallelTessellation() {
+    const static bool def = true;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setParallelTessellation(const bool &v) {
+    instance()->handle->SetBool("ParallelTessellation",v);
+    instance()->ParallelTessellation = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeParallelTessellation() {
+    instance()->handle->RemoveBool("ParallelTessellation");
+}
+
+// Auto generated code (Tools/params_utils.py:288)
+const char *PartParams::docAsyncTessellationThreshold() {
+    return QT_TRANSLATE_NOOP("PartParams",
+"Tessellate shapes with at least this number of faces in a worker thread, showing\n"
+"their bounding box until done. Zero to disable.");
+}
+
+// Auto generated code (Tools/params_utils.py:294)
+const long & PartParams::getAsyncTessellationThreshold() {
+    return instance()->AsyncTessellationThreshold;
+}
+
+// Auto generated code (Tools/params_utils.py:300)
+const long & PartParams::defaultAsyncTessellationThreshold() {
+    const static long def = 0;
+    return def;
+}
+
+// Auto generated code (Tools/params_utils.py:307)
+void PartParams::setAsyncTessellationThreshold(const long &v) {
+    instance()->handle->SetInt("AsyncTessellationThreshold",v);
+    instance()->AsyncTessellationThreshold = v;
+}
+
+// Auto generated code (Tools/params_utils.py:314)
+void PartParams::removeAsyncTessellationThreshold() {
+    instance()->handle->RemoveInt("AsyncTessellationThreshold");
+}
 //[[[end]]]
 
 void PartParams::onMeshDeviationChanged() {
@@ -336,6 +336,45 @@ public:
     static const char *docSelectionPickRTree();
     //@}
 
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter SelectionPickBVH
+    ///
+    /// Use a bounding volume hierarchy over all triangles and line segments of a shape with
+    /// at least 'SelectionPickThreshold' indices to speed up picking. The hierarchy is built
+    /// on the first pick of the shape.
+    static const bool & getSelectionPickBVH();
+    static const bool & defaultSelectionPickBVH();
+    static void removeSelectionPickBVH();
+    static void setSelectionPickBVH(const bool &v);
+    static const char *docSelectionPickBVH();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter ParallelTessellation
+    ///
+    /// Tessellate the shapes for display using multiple threads.
+    static const bool & getParallelTessellation();
+    static const bool & defaultParallelTessellation();
+    static void removeParallelTessellation();
+    static void setParallelTessellation(const bool &v);
+    static const char *docParallelTessellation();
+    //@}
+
+    // Auto generated code (Tools/params_utils.py:122)
+    //@{
+    /// Accessor for parameter AsyncTessellationThreshold
+    ///
+    /// Tessellate shapes with at least this number of faces in a worker thread, showing
+    /// their bounding box until done. Zero to disable.
+    static const long & getAsyncTessellationThreshold();
+    static const long & defaultAsyncTessellationThreshold();
+    static void removeAsyncTessellationThreshold();
+    static void setAsyncTessellationThreshold(const long &v);
+    static const char *docAsyncTessellationThreshold();
+    //@}
+
 // Auto generated code (Tools/params_utils.py:150)
 }; // class PartParams
 } // namespace PartGui
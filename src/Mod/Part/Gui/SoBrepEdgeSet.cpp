@@ -103,6 +103,7 @@ void SoBrepEdgeSet::notify(SoNotList * list)
         }
         bboxPicker.clear();
         bboxMap.clear();
+        segmentBVH.clear();
     }
     SoIndexedLineSet::notify(list);
 }
@@ -659,7 +660,7 @@ void SoBrepEdgeSet::rayPick(SoRayPickAction *action) {
     static thread_local std::vector<int> results;
     results.clear();
 
-    if (bboxPicker.empty())
+    if (!PartParams::getSelectionPickBVH() && bboxPicker.empty())
         initBoundingBoxes(coords3d, numverts);
 
     auto pickSegment = [&](int idx) {
@@ -699,6 +700,25 @@ void SoBrepEdgeSet::rayPick(SoRayPickAction *action) {
         return false;
     };
 
+    if (PartParams::getSelectionPickBVH()) {
+        if (segmentBVH.size() != (std::size_t)numindices) {
+            std::vector<SbBox3f> boxes(numindices);
+            for (int i = 1; i < numindices; ++i) {
+                int vidx0 = cindices[i-1];
+                int vidx1 = cindices[i];
+                if (vidx0 < 0 || vidx0 >= numverts || vidx1 < 0 || vidx1 >= numverts)
+                    continue;
+                boxes[i].extendBy(coords3d[vidx0]);
+                boxes[i].extendBy(coords3d[vidx1]);
+            }
+            segmentBVH.init(boxes);
+        }
+        segmentBVH.rayPick(action, results);
+        for (int idx : results)
+            pickSegment(idx);
+        return;
+    }
+
     auto pick = [&](int bboxId) {
         auto &info = bboxMap[bboxId];
         if (!PartParams::getSelectionPickRTree() || threshold2 < 0 || info.count < threshold2) {
@@ -31,6 +31,7 @@
 #include <vector>
 #include <Gui/SoFCSelectionContext.h>
 #include <Mod/Part/PartGlobal.h>
+#include "BoundBoxBVH.h"
 #include "BoundBoxRayPick.h"
 
 class SoCoordinateElement;
@@ -97,6 +98,10 @@ private:
         BoundBoxRayPick picker;
     };
     std::vector<SegmentInfo> bboxMap;
+
+    // hierarchy of all line segments, indexed by the coordIndex position of
+    // the segment end, built on first pick
+    BoundBoxBVH segmentBVH;
 };
 
 } // namespace PartGui
@@ -362,6 +362,7 @@ SoBrepFaceSet::~SoBrepFaceSet()
 void SoBrepFaceSet::onPartIndexChange() {
     bboxPicker.clear();
     facePicker.clear();
+    triangleBVH.clear();
     indexOffset.clear();
     partIndexMap.clear();
 }
@@ -1274,6 +1275,7 @@ void SoBrepFaceSet::buildPartBBoxes(SoState *state) {
 
     bboxPicker.clear();
     facePicker.clear();
+    triangleBVH.clear();
 
     int numparts = partIndex.getNum();
     if(!numparts)
@@ -2768,6 +2770,42 @@ void SoBrepFaceSet::rayPick(SoRayPickAction *action) {
     static thread_local std::vector<int> results;
     results.clear();
 
+    if(PartParams::getSelectionPickBVH()) {
+        int numfaces = numindices/4;
+        if(triangleBVH.size() != (std::size_t)numfaces) {
+            std::vector<SbBox3f> boxes(numfaces);
+            for(int i=0;i<numfaces;++i) {
+                const int32_t *viptr = &cindices[i*4];
+                int v1 = viptr[0];
+                int v2 = viptr[1];
+                int v3 = viptr[2];
+                if (v1 < 0 || v2 < 0 || v3 < 0 ||
+                        v1 >= numverts || v2 >= numverts || v3 >= numverts)
+                    continue;
+                auto &box = boxes[i];
+                box.extendBy(coords3d[v1]);
+                box.extendBy(coords3d[v2]);
+                box.extendBy(coords3d[v3]);
+            }
+            triangleBVH.init(boxes);
+            FC_TIME_TRACE(t,"build bvh");
+        }
+        triangleBVH.rayPick(action, results);
+        for(int findex : results) {
+            // indexOffset holds the first face of each part, and the last
+            // entry the total face count
+            int id = std::upper_bound(indexOffset.begin(), indexOffset.end(), findex)
+                        - indexOffset.begin() - 1;
+            if(id<0 || id>=numparts)
+                continue;
+            if(ctx2 && !ctx2->isSelectAll() && !ctx2->selectionIndex.count(id))
+                continue;
+            this->generatePrimitivesRange(action,id,findex,findex*4,(findex+1)*4);
+        }
+        FC_TIME_TRACE(t,"pick bvh");
+        return;
+    }
+
     auto pick = [&](int id) {
         if(!PartParams::getSelectionPickRTree() || threshold2<=0 || pindices[id] <= threshold2) {
             this->generatePrimitivesRange(action,id,
@@ -33,6 +33,7 @@
 #include <memory>
 #include <vector>
 #include <Gui/SoFCSelectionContext.h>
+#include "BoundBoxBVH.h"
 #include "BoundBoxRayPick.h"
 #include <Mod/Part/PartGlobal.h>
 
@@ -191,6 +192,8 @@ private:
     BoundBoxRayPick bboxPicker;
     // map from part index to picker for sorting and querying bounding box per face within a part
     std::map<int, BoundBoxRayPick> facePicker;
+    // hierarchy of all triangles of the face set, built on first pick
+    BoundBoxBVH triangleBVH;
 
     // Define some VBO pointer for the current mesh
     class VBO;
@@ -30,6 +30,7 @@
 # include <BRepBuilderAPI_MakeVertex.hxx>
 # include <BRepExtrema_DistShapeShape.hxx>
 # include <BRepMesh_IncrementalMesh.hxx>
+# include <BRepTools.hxx>
 # include <gp_Trsf.hxx>
 # include <Precision.hxx>
 # include <Poly_Array1OfTriangle.hxx>
@@ -50,6 +51,7 @@
 # include <TopTools_IndexedMapOfShape.hxx>
 
 # include <QApplication>
+# include <QFutureWatcher>
 # include <QAction>
 # include <QMenu>
 # include <sstream>
@@ -76,6 +78,9 @@
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
 
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObserver.h>
@@ -144,6 +149,56 @@ App::PropertyQuantityConstraint::Constraints ViewProviderPartExt::angDeflectionR
 const char* ViewProviderPartExt::LightingEnums[]= {"One side","Two side",nullptr};
 const char* ViewProviderPartExt::DrawStyleEnums[]= {"Solid","Dashed","Dotted","Dashdot",nullptr};
 
+struct ViewProviderPartExt::TessellationData
+{
+    std::vector<SbVec3f> verts;  // nodes of the faces followed by the nodes of the free edges
+    std::vector<SbVec3f> norms;  // normals of the face nodes
+    std::vector<SbVec3f> points; // vertices
+    std::vector<int32_t> index;  // triangles, each ended by SO_END_FACE_INDEX
+    std::vector<int32_t> parts;  // number of triangles of each face
+    std::vector<int32_t> lines;  // edges, each ended by -1
+    std::vector<int32_t> seams;
+    int numFaces = 0;
+    int numEdges = 0;
+    int numTriangles = 0;
+    std::string error;
+};
+
+struct ViewProviderPartExt::AsyncTessellation
+{
+    QFutureWatcher<void> *watcher = nullptr;
+    std::shared_ptr<TessellationData> data;
+    Base::TimeInfo startTime;
+
+    // The mesh is computed on a copy, so the source shape never gets a
+    // triangulation. Remember what was meshed to reuse the result instead.
+    TopoDS_Shape shape;
+    double deflection = 0.0;
+    double angularDeflection = 0.0;
+    bool normalsFromUV = false;
+
+    bool matches(const TopoDS_Shape &s, double defl, double angDefl, bool uv) const
+    {
+        return shape.IsEqual(s) && deflection == defl
+            && angularDeflection == angDefl && normalsFromUV == uv;
+    }
+
+    void releaseWatcher()
+    {
+        if (watcher) {
+            watcher->disconnect();
+            watcher->deleteLater();
+            watcher = nullptr;
+        }
+    }
+
+    ~AsyncTessellation()
+    {
+        // The worker thread keeps its own reference to the data, and the result is discarded
+        releaseWatcher();
+    }
+};
+
 ViewProviderPartExt::ViewProviderPartExt()
 {
     static bool _inited;
@@ -1807,8 +1862,355 @@ static void registerShape(Part::TopoShape &shape, const Part::TopoShape &newshap
 }
 }
 
+void ViewProviderPartExt::tessellate(const TopoDS_Shape &cShape,
+                                     double deflection,
+                                     double AngDeflectionRads,
+                                     bool normalsFromUV,
+                                     bool parallel,
+                                     TessellationData &data)
+{
+    BRepMesh_IncrementalMesh(cShape, deflection, Standard_False, AngDeflectionRads,
+                             parallel ? Standard_True : Standard_False);
+
+    struct FaceMesh {
+        TopoDS_Face face;
+        Handle (Poly_Triangulation) mesh;
+        TopLoc_Location loc;
+        int index;
+        int nodeOffset;
+        int triaOffset;
+    };
+
+    // count triangles and nodes in the mesh, and assign the range of each face in the arrays
+    int numNodes = 0;
+    std::unordered_map<TopoDS_Shape, TopoDS_Face, Part::ShapeHasher, Part::ShapeHasher> faceEdges;
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(cShape, TopAbs_FACE, faceMap);
+    std::vector<FaceMesh> faces(faceMap.Extent());
+    for (int i=1; i <= faceMap.Extent(); i++) {
+        FaceMesh &faceMesh = faces[i-1];
+        faceMesh.face = TopoDS::Face(faceMap(i));
+        faceMesh.index = i-1;
+        faceMesh.nodeOffset = numNodes;
+        faceMesh.triaOffset = data.numTriangles;
+        faceMesh.mesh = Part::Tools::triangulationOfFace(faceMesh.face, faceMesh.loc, deflection, AngDeflectionRads);
+        // Note: we must also count empty faces
+        if (!faceMesh.mesh.IsNull()) {
+            data.numTriangles += faceMesh.mesh->NbTriangles();
+            numNodes          += faceMesh.mesh->NbNodes();
+        }
+
+        TopExp_Explorer xp;
+        for (xp.Init(faceMesh.face,TopAbs_EDGE);xp.More();xp.Next())
+            faceEdges.emplace(xp.Current(), faceMesh.face);
+        data.numFaces++;
+    }
+    int numNorms = numNodes;
+
+    // get an indexed map of edges
+    TopTools_IndexedMapOfShape edgeMap;
+    TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
+
+     // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
+    std::map<int, std::vector<int32_t> > lineSetMap;
+    std::set<int>          edgeIdxSet;
+
+    // count and index the edges
+    for (int i=1; i <= edgeMap.Extent(); i++) {
+        edgeIdxSet.insert(i);
+        data.numEdges++;
+
+        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
+        TopLoc_Location aLoc;
+
+        // handling of the free edge that are not associated to a face
+        // Note: The assumption that if for an edge BRep_Tool::Polygon3D
+        // returns a valid object is wrong. This e.g. happens for ruled
+        // surfaces which gets created by two edges or wires.
+        // So, we have to store the hashes of the edges associated to a face.
+        // If the hash of a given edge is not in this list we know it's really
+        // a free edge.
+        auto it = faceEdges.find(aEdge);
+        if (it != faceEdges.end()) {
+            if (BRep_Tool::IsClosed(aEdge, it->second))
+                data.seams.push_back(i-1);
+        } else {
+            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc, deflection, AngDeflectionRads);
+            if (!aPoly.IsNull()) {
+                int nbNodesInEdge = aPoly->NbNodes();
+                numNodes += nbNodesInEdge;
+            }
+        }
+    }
+
+    // create memory for the nodes and indexes, with the normal vectors preset to null vector
+    data.verts.resize(numNodes);
+    data.norms.assign(numNorms, SbVec3f(0.0,0.0,0.0));
+    data.index.resize(data.numTriangles*4);
+    data.parts.resize(data.numFaces);
+    SbVec3f* verts = data.verts.data();
+    SbVec3f* norms = data.norms.data();
+    int32_t* index = data.index.data();
+    int32_t* parts = data.parts.data();
+
+    // Each face writes to its own range of the arrays, so the faces are
+    // independent of each other and can be processed in parallel
+    auto fillFace = [&](const FaceMesh &faceMesh) {
+        const Handle (Poly_Triangulation) &mesh = faceMesh.mesh;
+        if (mesh.IsNull()) {
+            parts[faceMesh.index] = 0;
+            return;
+        }
+        const TopoDS_Face &actFace = faceMesh.face;
+        int faceNodeOffset = faceMesh.nodeOffset;
+        int faceTriaOffset = faceMesh.triaOffset;
+
+        // getting the transformation of the shape/face
+        gp_Trsf myTransf;
+        Standard_Boolean identity = true;
+        if (!faceMesh.loc.IsIdentity()) {
+            identity = false;
+            myTransf = faceMesh.loc.Transformation();
+        }
+
+        // getting size of node and triangle array of this face
+        int nbNodesInFace = mesh->NbNodes();
+        int nbTriInFace   = mesh->NbTriangles();
+        // check orientation
+        TopAbs_Orientation orient = actFace.Orientation();
+
+
+        // cycling through the poly mesh
+#if OCC_VERSION_HEX < 0x070600
+        const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
+        const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
+        TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
+#else
+        TColgp_Array1OfDir Normals (1, nbNodesInFace);
+#endif
+        if (normalsFromUV)
+            Part::Tools::getPointNormals(actFace, mesh, Normals);
+
+        for (int g=1;g<=nbTriInFace;g++) {
+            // Get the triangle
+            Standard_Integer N1,N2,N3;
+#if OCC_VERSION_HEX < 0x070600
+            Triangles(g).Get(N1,N2,N3);
+#else
+            mesh->Triangle(g).Get(N1,N2,N3);
+#endif
+
+            // change orientation of the triangle if the face is reversed
+            if ( orient != TopAbs_FORWARD ) {
+                Standard_Integer tmp = N1;
+                N1 = N2;
+                N2 = tmp;
+            }
+
+            // get the 3 points of this triangle
+#if OCC_VERSION_HEX < 0x070600
+            gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
+#else
+            gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
+#endif
+
+            // get the 3 normals of this triangle
+            gp_Vec NV1, NV2, NV3;
+            if (normalsFromUV) {
+                NV1.SetXYZ(Normals(N1).XYZ());
+                NV2.SetXYZ(Normals(N2).XYZ());
+                NV3.SetXYZ(Normals(N3).XYZ());
+            }
+            else {
+                gp_Vec v1(V1.X(),V1.Y(),V1.Z()),
+                       v2(V2.X(),V2.Y(),V2.Z()),
+                       v3(V3.X(),V3.Y(),V3.Z());
+                gp_Vec normal = (v2-v1)^(v3-v1);
+                NV1 = normal;
+                NV2 = normal;
+                NV3 = normal;
+            }
+
+            // transform the vertices and normals to the place of the face
+            if (!identity) {
+                V1.Transform(myTransf);
+                V2.Transform(myTransf);
+                V3.Transform(myTransf);
+                if (normalsFromUV) {
+                    NV1.Transform(myTransf);
+                    NV2.Transform(myTransf);
+                    NV3.Transform(myTransf);
+                }
+            }
+
+            // add the normals for all points of this triangle
+            norms[faceNodeOffset+N1-1] += SbVec3f(NV1.X(),NV1.Y(),NV1.Z());
+            norms[faceNodeOffset+N2-1] += SbVec3f(NV2.X(),NV2.Y(),NV2.Z());
+            norms[faceNodeOffset+N3-1] += SbVec3f(NV3.X(),NV3.Y(),NV3.Z());
+
+            // set the vertices
+            verts[faceNodeOffset+N1-1].setValue((float)(V1.X()),(float)(V1.Y()),(float)(V1.Z()));
+            verts[faceNodeOffset+N2-1].setValue((float)(V2.X()),(float)(V2.Y()),(float)(V2.Z()));
+            verts[faceNodeOffset+N3-1].setValue((float)(V3.X()),(float)(V3.Y()),(float)(V3.Z()));
+
+            // set the index vector with the 3 point indexes and the end delimiter
+            index[faceTriaOffset*4+4*(g-1)]   = faceNodeOffset+N1-1;
+            index[faceTriaOffset*4+4*(g-1)+1] = faceNodeOffset+N2-1;
+            index[faceTriaOffset*4+4*(g-1)+2] = faceNodeOffset+N3-1;
+            index[faceTriaOffset*4+4*(g-1)+3] = SO_END_FACE_INDEX;
+        }
+
+        // normalize all normals of this face
+        for (int i = 0; i < nbNodesInFace; i++)
+            norms[faceNodeOffset+i].normalize();
+
+        parts[faceMesh.index] = nbTriInFace; // new part
+    };
+
+    if (parallel && faces.size() > 1)
+        QtConcurrent::blockingMap(faces, fillFace);
+    else {
+        for (const FaceMesh &faceMesh : faces)
+            fillFace(faceMesh);
+    }
+
+    // handling the edges lying on the faces
+    for (const FaceMesh &faceMesh : faces) {
+        if (faceMesh.mesh.IsNull())
+            continue;
+        gp_Trsf myTransf;
+        Standard_Boolean identity = true;
+        if (!faceMesh.loc.IsIdentity()) {
+            identity = false;
+            myTransf = faceMesh.loc.Transformation();
+        }
+
+        TopExp_Explorer Exp;
+        for(Exp.Init(faceMesh.face,TopAbs_EDGE);Exp.More();Exp.Next()) {
+            const TopoDS_Edge &curEdge = TopoDS::Edge(Exp.Current());
+            // get the overall index of this edge
+            int edgeIndex = edgeMap.FindIndex(curEdge);
+            // already processed this index ?
+            if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
+
+                // this holds the indices of the edge's triangulation to the current polygon
+                Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, faceMesh.mesh, faceMesh.loc);
+                if (aPoly.IsNull())
+                    continue; // polygon does not exist
+
+                // getting the indexes of the edge polygon
+                const TColStd_Array1OfInteger& indices = aPoly->Nodes();
+                for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
+                    int nodeIndex = indices(i);
+                    int index = faceMesh.nodeOffset+nodeIndex-1;
+                    lineSetMap[edgeIndex].push_back(index);
+
+                    // usually the coordinates for this edge are already set by the
+                    // triangles of the face this edge belongs to. However, there are
+                    // rare cases where some points are only referenced by the polygon
+                    // but not by any triangle. Thus, we must apply the coordinates to
+                    // make sure that everything is properly set.
+#if OCC_VERSION_HEX < 0x070600
+                    gp_Pnt p(faceMesh.mesh->Nodes()(nodeIndex));
+#else
+                    gp_Pnt p(faceMesh.mesh->Node(nodeIndex));
+#endif
+                    if (!identity)
+                        p.Transform(myTransf);
+                    verts[index].setValue((float)(p.X()),(float)(p.Y()),(float)(p.Z()));
+                }
+
+                // remove the handled edge index from the set
+                edgeIdxSet.erase(edgeIndex);
+            }
+        }
+    }
+
+    // handling of the free edges
+    int faceNodeOffset = numNorms;
+    for (int i=1; i <= edgeMap.Extent(); i++) {
+        const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
+        Standard_Boolean identity = true;
+        gp_Trsf myTransf;
+        TopLoc_Location aLoc;
+
+        // handling of the free edge that are not associated to a face
+        if (!faceEdges.count(aEdge)) {
+            Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc, deflection, AngDeflectionRads);
+            if (!aPoly.IsNull()) {
+                if (!aLoc.IsIdentity()) {
+                    identity = false;
+                    myTransf = aLoc.Transformation();
+                }
+
+                const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
+                int nbNodesInEdge = aPoly->NbNodes();
+
+                gp_Pnt pnt;
+                for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
+                    pnt = aNodes(j);
+                    if (!identity)
+                        pnt.Transform(myTransf);
+                    int index = faceNodeOffset+j-1;
+                    verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
+                    lineSetMap[i].push_back(index);
+                }
+
+                faceNodeOffset += nbNodesInEdge;
+            }
+        }
+    }
+
+    // handling of the vertices
+    TopTools_IndexedMapOfShape vertexMap;
+    TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
+
+    int numPoints = vertexMap.Extent();
+    data.points.resize(numPoints);
+
+    for (int i=0; i<numPoints; i++) {
+        const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
+        gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
+        data.points[i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
+    }
+
+    for (std::map<int, std::vector<int32_t> >::iterator it = lineSetMap.begin(); it != lineSetMap.end(); ++it) {
+        data.lines.insert(data.lines.end(), it->second.begin(), it->second.end());
+        data.lines.push_back(-1);
+    }
+}
+
+void ViewProviderPartExt::applyTessellation(const TessellationData &data)
+{
+    auto setValues = [](auto &field, const auto &values) {
+        field.setNum(static_cast<int>(values.size()));
+        if (!values.empty())
+            field.setValues(0, static_cast<int>(values.size()), values.data());
+    };
+    setValues(coords->point, data.verts);
+    setValues(pcoords->point, data.points);
+    setValues(norm->vector, data.norms);
+    setValues(faceset->coordIndex, data.index);
+    setValues(faceset->partIndex, data.parts);
+    setValues(lineset->coordIndex, data.lines);
+    setValues(lineset->seamIndices, data.seams);
+
+    // printing some information
+    FC_TRACE("Shape tria info: Faces:" << data.numFaces << " Edges:" << data.numEdges 
+             << " Points:" << data.points.size() << " Nodes:" << data.verts.size()
+             << " Triangles:" << data.numTriangles << " IdxVec:" << data.lines.size());
+
+    // The material has to be checked again (#0001736)
+    setHighlightedFaces(DiffuseColor.getValues());
+    setHighlightedEdges(LineColorArray.getValues());
+    setHighlightedPoints(PointColorArray.getValue());
+}
+
 void ViewProviderPartExt::updateVisual()
 {
+    // discard any pending tessellation
+    asyncTessellation.reset();
+
     if (!getObject()
             || !getObject()->getDocument()
             || isRestoring())
@@ -1890,8 +2292,7 @@ void ViewProviderPartExt::updateVisual()
 
     // time measurement and book keeping
     Base::TimeInfo start_time;
-    int numTriangles=0,numNodes=0,numPoints=0,numNorms=0,numFaces=0,numEdges=0,numLines=0;
-    std::unordered_map<TopoDS_Shape, TopoDS_Face, Part::ShapeHasher, Part::ShapeHasher> faceEdges;
+    TessellationData data;
 
     try {
         // calculating the deflection value
@@ -1922,337 +2323,100 @@ void ViewProviderPartExt::updateVisual()
                         PartParams::getMeshAngularDeflection() : AngularDeflection.getValue()),
                       PartParams::getMinimumAngularDeflection()) / 180.0 * M_PI);
 
-        BRepMesh_IncrementalMesh(cShape,deflection,Standard_False, AngDeflectionRads,Standard_True);
-
-        // count triangles and nodes in the mesh
-        TopTools_IndexedMapOfShape faceMap;
-        TopExp::MapShapes(cShape, TopAbs_FACE, faceMap);
-        for (int i=1; i <= faceMap.Extent(); i++) {
-            TopoDS_Face face = TopoDS::Face(faceMap(i));
-            Handle (Poly_Triangulation) mesh = Part::Tools::triangulationOfFace(face, aLoc, deflection, AngDeflectionRads);
-            // Note: we must also count empty faces
-            if (!mesh.IsNull()) {
-                numTriangles += mesh->NbTriangles();
-                numNodes     += mesh->NbNodes();
-                numNorms     += mesh->NbNodes();
-            }
-
-            TopExp_Explorer xp;
-            for (xp.Init(face,TopAbs_EDGE);xp.More();xp.Next())
-                faceEdges.emplace(xp.Current(), face);
-            numFaces++;
-        }
-
-        // get an indexed map of edges
-        TopTools_IndexedMapOfShape edgeMap;
-        TopExp::MapShapes(cShape, TopAbs_EDGE, edgeMap);
-
-         // key is the edge number, value the coord indexes. This is needed to keep the same order as the edges.
-        std::map<int, std::vector<int32_t> > lineSetMap;
-        std::set<int>          edgeIdxSet;
-        std::vector<int32_t>   edgeVector;
-        std::vector<int32_t>   seamEdges;
-
-        // count and index the edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
-            edgeIdxSet.insert(i);
-            numEdges++;
-
-            const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            TopLoc_Location aLoc;
-
-            // handling of the free edge that are not associated to a face
-            // Note: The assumption that if for an edge BRep_Tool::Polygon3D
-            // returns a valid object is wrong. This e.g. happens for ruled
-            // surfaces which gets created by two edges or wires.
-            // So, we have to store the hashes of the edges associated to a face.
-            // If the hash of a given edge is not in this list we know it's really
-            // a free edge.
-            auto it = faceEdges.find(aEdge);
-            if (it != faceEdges.end()) {
-                if (BRep_Tool::IsClosed(aEdge, it->second))
-                    seamEdges.push_back(i-1);
-            } else {
-                Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc, deflection, AngDeflectionRads);
-                if (!aPoly.IsNull()) {
-                    int nbNodesInEdge = aPoly->NbNodes();
-                    numNodes += nbNodesInEdge;
-                }
-            }
+        if (asyncResult && asyncResult->matches(cShape, deflection, AngDeflectionRads, NormalsFromUV)) {
+            FC_TRACE(getFullName() << " reuse async tessellation");
+            VisualTouched = false;
+            applyTessellation(*asyncResult->data);
+            return;
         }
+        asyncResult.reset();
 
-        // create memory for the nodes and indexes
-        coords  ->point      .setNum(numNodes);
-        norm    ->vector     .setNum(numNorms);
-        faceset ->coordIndex .setNum(numTriangles*4);
-        faceset ->partIndex  .setNum(numFaces);
-        // get the raw memory for fast fill up
-        SbVec3f* verts = coords  ->point       .startEditing();
-        SbVec3f* norms = norm    ->vector      .startEditing();
-        int32_t* index = faceset ->coordIndex  .startEditing();
-        int32_t* parts = faceset ->partIndex   .startEditing();
-
-        // preset the normal vector with null vector
-        for (int i=0;i < numNorms;i++)
-            norms[i]= SbVec3f(0.0,0.0,0.0);
-
-        int ii = 0,faceNodeOffset=0,faceTriaOffset=0;
-        for (int i=1; i <= faceMap.Extent(); i++, ii++) {
-            TopLoc_Location aLoc;
-            const TopoDS_Face &actFace = TopoDS::Face(faceMap(i));
-            // get the mesh of the shape
-            Handle (Poly_Triangulation) mesh = Part::Tools::triangulationOfFace(actFace, aLoc, deflection, AngDeflectionRads);
-            if (mesh.IsNull()) {
-                parts[ii] = 0;
-                continue;
-            }
-
-            // getting the transformation of the shape/face
-            gp_Trsf myTransf;
-            Standard_Boolean identity = true;
-            if (!aLoc.IsIdentity()) {
-                identity = false;
-                myTransf = aLoc.Transformation();
+        bool parallel = PartParams::getParallelTessellation();
+        long asyncThreshold = PartParams::getAsyncTessellationThreshold();
+        if (asyncThreshold > 0
+                && cachedShape.countSubShapes(TopAbs_FACE) >= asyncThreshold
+                && !BRepTools::Triangulation(cShape, deflection))
+        {
+            // Mesh a copy of the topology in a worker thread, so that the
+            // shape of the object is not modified concurrently, and show the
+            // bounding box until the mesh is ready.
+            TopoDS_Shape shape = BRepBuilderAPI_Copy(cShape, Standard_False).Shape();
+            TessellationData box;
+            box.verts.resize(8);
+            for (int i=0; i<8; ++i) {
+                box.verts[i].setValue((float)(i & 1 ? xMax : xMin),
+                                      (float)(i & 2 ? yMax : yMin),
+                                      (float)(i & 4 ? zMax : zMin));
             }
-
-            // getting size of node and triangle array of this face
-            int nbNodesInFace = mesh->NbNodes();
-            int nbTriInFace   = mesh->NbTriangles();
-            // check orientation
-            TopAbs_Orientation orient = actFace.Orientation();
-
-
-            // cycling through the poly mesh
-#if OCC_VERSION_HEX < 0x070600
-            const Poly_Array1OfTriangle& Triangles = mesh->Triangles();
-            const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
-            TColgp_Array1OfDir Normals (Nodes.Lower(), Nodes.Upper());
-#else
-            int numNodes =  mesh->NbNodes();
-            TColgp_Array1OfDir Normals (1, numNodes);
-#endif
-            if (NormalsFromUV)
-                Part::Tools::getPointNormals(actFace, mesh, Normals);
-
-            for (int g=1;g<=nbTriInFace;g++) {
-                // Get the triangle
-                Standard_Integer N1,N2,N3;
-#if OCC_VERSION_HEX < 0x070600
-                Triangles(g).Get(N1,N2,N3);
-#else
-                mesh->Triangle(g).Get(N1,N2,N3);
-#endif
-
-                // change orientation of the triangle if the face is reversed
-                if ( orient != TopAbs_FORWARD ) {
-                    Standard_Integer tmp = N1;
-                    N1 = N2;
-                    N2 = tmp;
-                }
-
-                // get the 3 points of this triangle
-#if OCC_VERSION_HEX < 0x070600
-                gp_Pnt V1(Nodes(N1)), V2(Nodes(N2)), V3(Nodes(N3));
-#else
-                gp_Pnt V1(mesh->Node(N1)), V2(mesh->Node(N2)), V3(mesh->Node(N3));
-#endif
-
-                // get the 3 normals of this triangle
-                gp_Vec NV1, NV2, NV3;
-                if (NormalsFromUV) {
-                    NV1.SetXYZ(Normals(N1).XYZ());
-                    NV2.SetXYZ(Normals(N2).XYZ());
-                    NV3.SetXYZ(Normals(N3).XYZ());
+            box.lines = {0,1,3,2,0,-1, 4,5,7,6,4,-1, 0,4,-1, 1,5,-1, 2,6,-1, 3,7,-1};
+            applyTessellation(box);
+
+            asyncTessellation.reset(new AsyncTessellation);
+            auto result = std::make_shared<TessellationData>();
+            asyncTessellation->data = result;
+            asyncTessellation->shape = cShape;
+            asyncTessellation->deflection = deflection;
+            asyncTessellation->angularDeflection = AngDeflectionRads;
+            asyncTessellation->normalsFromUV = NormalsFromUV;
+            asyncTessellation->watcher = new QFutureWatcher<void>();
+            QObject::connect(asyncTessellation->watcher, &QFutureWatcher<void>::finished,
+                             asyncTessellation->watcher, [this]() {
+                // The watcher is deleted on any new update, so this is the current result
+                std::unique_ptr<AsyncTessellation> task(std::move(asyncTessellation));
+                if (!task->data->error.empty())
+                    FC_ERR("Cannot compute Inventor representation for the shape of "
+                           << pcObject->getFullName() << ": " << task->data->error);
+                FC_TRACE(getFullName() << " async update time: "
+                         << Base::TimeInfo::diffTimeF(task->startTime,Base::TimeInfo()));
+                applyTessellation(*task->data);
+                if (task->data->error.empty()) {
+                    task->releaseWatcher();
+                    asyncResult = std::move(task);
                 }
-                else {
-                    gp_Vec v1(V1.X(),V1.Y(),V1.Z()),
-                           v2(V2.X(),V2.Y(),V2.Z()),
-                           v3(V3.X(),V3.Y(),V3.Z());
-                    gp_Vec normal = (v2-v1)^(v3-v1);
-                    NV1 = normal;
-                    NV2 = normal;
-                    NV3 = normal;
+            });
+            bool normalsFromUV = NormalsFromUV;
+            asyncTessellation->watcher->setFuture(QtConcurrent::run([=]() {
+                try {
+                    tessellate(shape, deflection, AngDeflectionRads, normalsFromUV, parallel, *result);
                 }
-
-                // transform the vertices and normals to the place of the face
-                if (!identity) {
-                    V1.Transform(myTransf);
-                    V2.Transform(myTransf);
-                    V3.Transform(myTransf);
-                    if (NormalsFromUV) {
-                        NV1.Transform(myTransf);
-                        NV2.Transform(myTransf);
-                        NV3.Transform(myTransf);
-                    }
+                catch (Base::Exception &e) {
+                    *result = TessellationData();
+                    result->error = e.what();
                 }
-
-                // add the normals for all points of this triangle
-                norms[faceNodeOffset+N1-1] += SbVec3f(NV1.X(),NV1.Y(),NV1.Z());
-                norms[faceNodeOffset+N2-1] += SbVec3f(NV2.X(),NV2.Y(),NV2.Z());
-                norms[faceNodeOffset+N3-1] += SbVec3f(NV3.X(),NV3.Y(),NV3.Z());
-
-                // set the vertices
-                verts[faceNodeOffset+N1-1].setValue((float)(V1.X()),(float)(V1.Y()),(float)(V1.Z()));
-                verts[faceNodeOffset+N2-1].setValue((float)(V2.X()),(float)(V2.Y()),(float)(V2.Z()));
-                verts[faceNodeOffset+N3-1].setValue((float)(V3.X()),(float)(V3.Y()),(float)(V3.Z()));
-
-                // set the index vector with the 3 point indexes and the end delimiter
-                index[faceTriaOffset*4+4*(g-1)]   = faceNodeOffset+N1-1;
-                index[faceTriaOffset*4+4*(g-1)+1] = faceNodeOffset+N2-1;
-                index[faceTriaOffset*4+4*(g-1)+2] = faceNodeOffset+N3-1;
-                index[faceTriaOffset*4+4*(g-1)+3] = SO_END_FACE_INDEX;
-            }
-
-            parts[ii] = nbTriInFace; // new part
-
-            // handling the edges lying on this face
-            TopExp_Explorer Exp;
-            for(Exp.Init(actFace,TopAbs_EDGE);Exp.More();Exp.Next()) {
-                const TopoDS_Edge &curEdge = TopoDS::Edge(Exp.Current());
-                // get the overall index of this edge
-                int edgeIndex = edgeMap.FindIndex(curEdge);
-                edgeVector.push_back((int32_t)edgeIndex-1);
-                // already processed this index ?
-                if (edgeIdxSet.find(edgeIndex)!=edgeIdxSet.end()) {
-
-                    // this holds the indices of the edge's triangulation to the current polygon
-                    Handle(Poly_PolygonOnTriangulation) aPoly = BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
-                    if (aPoly.IsNull())
-                        continue; // polygon does not exist
-
-                    // getting the indexes of the edge polygon
-                    const TColStd_Array1OfInteger& indices = aPoly->Nodes();
-                    for (Standard_Integer i=indices.Lower();i <= indices.Upper();i++) {
-                        int nodeIndex = indices(i);
-                        int index = faceNodeOffset+nodeIndex-1;
-                        lineSetMap[edgeIndex].push_back(index);
-
-                        // usually the coordinates for this edge are already set by the
-                        // triangles of the face this edge belongs to. However, there are
-                        // rare cases where some points are only referenced by the polygon
-                        // but not by any triangle. Thus, we must apply the coordinates to
-                        // make sure that everything is properly set.
-#if OCC_VERSION_HEX < 0x070600
-                        gp_Pnt p(Nodes(nodeIndex));
-#else
-                        gp_Pnt p(mesh->Node(nodeIndex));
-#endif
-                        if (!identity)
-                            p.Transform(myTransf);
-                        verts[index].setValue((float)(p.X()),(float)(p.Y()),(float)(p.Z()));
-                    }
-
-                    // remove the handled edge index from the set
-                    edgeIdxSet.erase(edgeIndex);
+                catch (const Standard_Failure& e) {
+                    *result = TessellationData();
+                    result->error = e.GetMessageString();
                 }
-            }
-
-            edgeVector.push_back(-1);
-
-            // counting up the per Face offsets
-            faceNodeOffset += nbNodesInFace;
-            faceTriaOffset += nbTriInFace;
-        }
-
-        // handling of the free edges
-        for (int i=1; i <= edgeMap.Extent(); i++) {
-            const TopoDS_Edge& aEdge = TopoDS::Edge(edgeMap(i));
-            Standard_Boolean identity = true;
-            gp_Trsf myTransf;
-            TopLoc_Location aLoc;
-
-            // handling of the free edge that are not associated to a face
-            if (!faceEdges.count(aEdge)) {
-                Handle(Poly_Polygon3D) aPoly = Part::Tools::polygonOfEdge(aEdge, aLoc, deflection, AngDeflectionRads);
-                if (!aPoly.IsNull()) {
-                    if (!aLoc.IsIdentity()) {
-                        identity = false;
-                        myTransf = aLoc.Transformation();
-                    }
-
-                    const TColgp_Array1OfPnt& aNodes = aPoly->Nodes();
-                    int nbNodesInEdge = aPoly->NbNodes();
-
-                    gp_Pnt pnt;
-                    for (Standard_Integer j=1;j <= nbNodesInEdge;j++) {
-                        pnt = aNodes(j);
-                        if (!identity)
-                            pnt.Transform(myTransf);
-                        int index = faceNodeOffset+j-1;
-                        verts[index].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
-                        lineSetMap[i].push_back(index);
-                    }
-
-                    faceNodeOffset += nbNodesInEdge;
+                catch (...) {
+                    *result = TessellationData();
+                    result->error = "unknown exception";
                 }
-            }
-        }
-
-        // handling of the vertices
-        TopTools_IndexedMapOfShape vertexMap;
-        TopExp::MapShapes(cShape, TopAbs_VERTEX, vertexMap);
-
-        numPoints = vertexMap.Extent();
-        pcoords->point.setNum(numPoints);
-        verts = pcoords->point.startEditing();
-
-        for (int i=0; i<numPoints; i++) {
-            const TopoDS_Vertex& aVertex = TopoDS::Vertex(vertexMap(i+1));
-            gp_Pnt pnt = BRep_Tool::Pnt(aVertex);
-            verts[i].setValue((float)(pnt.X()),(float)(pnt.Y()),(float)(pnt.Z()));
-        }
-
-        // normalize all normals
-        for (int i = 0; i< numNorms ;i++)
-            norms[i].normalize();
-
-        std::vector<int32_t> lineSetCoords;
-        for (std::map<int, std::vector<int32_t> >::iterator it = lineSetMap.begin(); it != lineSetMap.end(); ++it) {
-            lineSetCoords.insert(lineSetCoords.end(), it->second.begin(), it->second.end());
-            lineSetCoords.push_back(-1);
+            }));
+            VisualTouched = false;
+            return;
         }
 
-        // preset the index vector size
-        numLines =  lineSetCoords.size();
-        lineset ->coordIndex .setNum(numLines);
-        int32_t* lines = lineset ->coordIndex  .startEditing();
-
-        int l=0;
-        for (std::vector<int32_t>::const_iterator it=lineSetCoords.begin();it!=lineSetCoords.end();++it,l++)
-            lines[l] = *it;
-
-        // end the editing of the nodes
-        coords  ->point       .finishEditing();
-        pcoords ->point       .finishEditing();
-        norm    ->vector      .finishEditing();
-        faceset ->coordIndex  .finishEditing();
-        faceset ->partIndex   .finishEditing();
-        lineset ->coordIndex  .finishEditing();
-        if (seamEdges.size())
-            lineset->seamIndices.setValues(0, seamEdges.size(), &seamEdges[0]);
+        tessellate(cShape, deflection, AngDeflectionRads, NormalsFromUV, parallel, data);
     }
     catch (Base::Exception &e) {
+        data = TessellationData();
         FC_ERR("Failed to compute Inventor representation for the shape of " << pcObject->getFullName() << ": " << e.what());
     }
     catch (const Standard_Failure& e) {
+        data = TessellationData();
         FC_ERR("Cannot compute Inventor representation for the shape of "
                << pcObject->getFullName() << ": " << e.GetMessageString());
     }
     catch (...) {
+        data = TessellationData();
         FC_ERR("Failed to compute Inventor representation for the shape of " << pcObject->getFullName());
     }
 
     // printing some information
     FC_TRACE(getFullName() << " update time: " << Base::TimeInfo::diffTimeF(start_time,Base::TimeInfo()));
-    FC_TRACE("Shape tria info: Faces:" << numFaces << " Edges:" << numEdges 
-             << " Points:" << numPoints << " Nodes:" << numNodes
-             << " Triangles:" << numTriangles << " IdxVec:" << numLines);
     VisualTouched = false;
 
-    // The material has to be checked again (#0001736)
-    setHighlightedFaces(DiffuseColor.getValues());
-    setHighlightedEdges(LineColorArray.getValues());
-    setHighlightedPoints(PointColorArray.getValue());
+    applyTessellation(data);
 }
 
 void ViewProviderPartExt::forceUpdate(bool enable) {
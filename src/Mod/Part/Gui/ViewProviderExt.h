@@ -24,6 +24,7 @@
 #define PARTGUI_VIEWPROVIDERPARTEXT_H
 
 #include <map>
+#include <memory>
 #include <Standard_math.hxx>
 
 #include <App/PropertyUnits.h>
@@ -239,6 +240,21 @@ private:
 
     Part::TopoShape cachedShape;
     boost::signals2::scoped_connection conn;
+
+    struct TessellationData;
+    struct AsyncTessellation;
+    // pending tessellation running in a worker thread
+    std::unique_ptr<AsyncTessellation> asyncTessellation;
+    // last finished tessellation, reused as long as the shape and settings are unchanged
+    std::unique_ptr<AsyncTessellation> asyncResult;
+
+    static void tessellate(const TopoDS_Shape &shape,
+                           double deflection,
+                           double angularDeflection,
+                           bool normalsFromUV,
+                           bool parallel,
+                           TessellationData &data);
+    void applyTessellation(const TessellationData &data);
 };
 
 }
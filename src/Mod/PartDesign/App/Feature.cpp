@@ -80,6 +80,15 @@ short Feature::mustExecute() const
     return Part::Feature::mustExecute();
 }
 
+bool Feature::canCacheShape() const {
+    return true;
+}
+
+std::string Feature::getShapeCacheData() const {
+    // Body::SingleSolid affects the result but is not stored in the feature
+    return allowMultiSolid() ? "1" : "0";
+}
+
 bool Feature::allowMultiSolid() const {
     auto body = getFeatureBody();
     return body && !body->SingleSolid.getValue();
@@ -97,6 +97,9 @@ public:
 
     TopoShape getSolid(const TopoShape &, bool force = true);    
 
+    bool canCacheShape() const override;
+    std::string getShapeCacheData() const override;
+
 protected:
 
     App::DocumentObjectExecReturn *recompute() override;
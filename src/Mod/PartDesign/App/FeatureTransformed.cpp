@@ -178,6 +178,11 @@ void Transformed::handleChangedPropertyType(Base::XMLReader &reader, const char
     }
 }
 
+bool Transformed::canCacheShape() const
+{
+    return false;
+}
+
 short Transformed::mustExecute() const
 {
     if (OriginalSubs.isTouched())
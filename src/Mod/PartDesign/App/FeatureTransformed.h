@@ -102,6 +102,9 @@ public:
 
     void getAddSubShape(std::vector<std::pair<Part::TopoShape, Type> > &shapes) override;
 
+    /// Not cacheable, because execute() also records the rejected transformations
+    bool canCacheShape() const override;
+
 protected:
     void handleChangedPropertyType(Base::XMLReader &reader, const char * TypeName, App::Property * prop) override;
     virtual void positionBySupport();
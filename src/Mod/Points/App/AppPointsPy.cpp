@@ -36,6 +36,7 @@
 
 #include "Points.h"
 #include "PointsAlgos.h"
+#include "PointsOctree.h"
 #include "PointsPy.h"
 #include "Properties.h"
 #include "Structured.h"
@@ -106,6 +107,7 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            reader->setOutOfCoreThreshold(PointsOctree::getOutOfCoreThreshold());
             reader->read(EncodedName);
 
             App::Document* pcDoc = App::GetApplication().newDocument();
@@ -222,6 +224,7 @@ private:
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            reader->setOutOfCoreThreshold(PointsOctree::getOutOfCoreThreshold());
             reader->read(EncodedName);
 
             App::Document* pcDoc = App::GetApplication().getDocument(DocName);
@@ -22,8 +22,10 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 # include <cmath>
 # include <iostream>
+# include <memory>
 # include <QtConcurrentMap>
 # include <boost/math/special_functions/fpclassify.hpp>
 #endif
@@ -37,6 +39,7 @@
 
 #include "Points.h"
 #include "PointsAlgos.h"
+#include "PointsOctree.h"
 
 
 #ifdef _MSC_VER
@@ -50,9 +53,43 @@ TYPESYSTEM_SOURCE(Points::PointKernel, Data::ComplexGeoData)
 
 PointKernel::PointKernel(const PointKernel& pts)
   : _Mtrx(pts._Mtrx)
-  , _Points(pts._Points)
+  , _Octree(pts._Octree)
 {
+    // the octree is never modified and can be shared
+    if (!_Octree)
+        _Points = pts._Points;
+}
+
+const std::vector<PointKernel::value_type>& PointKernel::getBasicPoints() const
+{
+    if (_Octree && _Points.size() != _Octree->size())
+        _Points.assign(_Octree->getPoints(), _Octree->getPoints() + _Octree->size());
+    return _Points;
+}
+
+const PointKernel::value_type* PointKernel::data() const
+{
+    return _Octree ? _Octree->getPoints() : _Points.data();
+}
+
+PointKernel::size_type PointKernel::size() const
+{
+    return _Octree ? _Octree->size() : _Points.size();
+}
+
+void PointKernel::setOctree(const std::shared_ptr<PointsOctree>& octree)
+{
+    _Octree = octree;
+    std::vector<value_type>().swap(_Points);
+}
 
+void PointKernel::detachOctree()
+{
+    if (_Octree) {
+        // load the points with the const overload, the other one detaches the octree
+        static_cast<const PointKernel*>(this)->getBasicPoints();
+        _Octree.reset();
+    }
 }
 
 const std::vector<const char*>& PointKernel::getElementTypes() const
@@ -83,6 +120,22 @@ Data::Segment* PointKernel::getSubElement(const char* /*Type*/, unsigned long /*
 
 void PointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
+    if (_Octree) {
+        // the transformed points need a new octree
+        PointsOctreeBuilder builder;
+        const value_type* points = _Octree->getPoints();
+        std::vector<value_type> block;
+        for (size_type i = 0; i < _Octree->size(); i += 65536) {
+            block.assign(points + i, points + std::min<size_type>(i + 65536, _Octree->size()));
+            QtConcurrent::blockingMap(block, [rclMat](value_type& value) {
+                rclMat.multVec(value, value);
+            });
+            builder.addPoints(block);
+        }
+        setOctree(builder.finish(true));
+        return;
+    }
+
     std::vector<value_type>& kernel = getBasicPoints();
 #ifdef _MSC_VER
     // Win32-only at the moment since ppl.h is a Microsoft library. Points is not using Qt so we cannot use QtConcurrent
@@ -106,7 +159,7 @@ Base::BoundBox3d PointKernel::getBoundBox()const
     // Thread-local bounding boxes
     Concurrency::combinable<Base::BoundBox3d> bbs;
     // Cannot use a const_point_iterator here as it is *not* a proper iterator (fails the for_each template)
-    Concurrency::parallel_for_each(_Points.begin(), _Points.end(), [this, &bbs](const value_type& value) {
+    Concurrency::parallel_for_each(data(), data() + size(), [this, &bbs](const value_type& value) {
         Base::Vector3d vertd(value.x, value.y, value.z);
         bbs.local().Add(this->_Mtrx * vertd);
     });
@@ -126,7 +179,11 @@ void PointKernel::operator = (const PointKernel& Kernel)
     if (this != &Kernel) {
         // copy the mesh structure
         setTransform(Kernel._Mtrx);
-        this->_Points = Kernel._Points;
+        this->_Octree = Kernel._Octree;
+        if (this->_Octree)
+            std::vector<value_type>().swap(this->_Points);
+        else
+            this->_Points = Kernel._Points;
     }
 }
 
@@ -167,12 +224,12 @@ void PointKernel::Save (Base::Writer &writer) const
 {
     if(writer.isForceXML()>1) {
         writer.Stream() << writer.ind()
-            << "<Points count=\"" << _Points.size() << "\" " 
+            << "<Points count=\"" << size() << "\" " 
             << "mtrx=\"" << _Mtrx.toString() << "\">\n";
         writer.incInd();
-        for(const auto &v : _Points)
-            writer.Stream() << "<P x=\"" << v.x << "\" y=\"" << v.y
-                << "\" z=\"" << v.z << "\"/>\n";
+        for(const value_type *v = data(), *end = data() + size(); v != end; ++v)
+            writer.Stream() << "<P x=\"" << v->x << "\" y=\"" << v->y
+                << "\" z=\"" << v->z << "\"/>\n";
         writer.decInd();
         writer.Stream() << writer.ind() << "</Points>\n";
     } else {
@@ -192,7 +249,7 @@ void PointKernel::SaveDocFile (Base::Writer &writer) const
     uint32_t uCt = (uint32_t)size();
     str << uCt;
     // store the data without transforming it
-    for (std::vector<value_type>::const_iterator it = _Points.begin(); it != _Points.end(); ++it) {
+    for (const value_type *it = data(), *end = data() + size(); it != end; ++it) {
         str << it->x << it->y << it->z;
     }
 }
@@ -225,16 +282,57 @@ void PointKernel::Restore(Base::XMLReader &reader)
 }
 
 void PointKernel::RestoreDocFile(Base::Reader &reader)
+{
+    _Octree = readPoints(reader, _Points, _OutOfCoreAllowed);
+}
+
+bool PointKernel::canRestoreDocFileInThread() const
+{
+    return true;
+}
+
+std::function<void()> PointKernel::restoreDocFileInThread(Base::Reader &reader)
+{
+    auto points = std::make_shared<std::vector<value_type>>();
+    std::shared_ptr<PointsOctree> octree = readPoints(reader, *points, _OutOfCoreAllowed);
+    return [this, points, octree]() {
+        this->_Points.swap(*points);
+        this->_Octree = octree;
+    };
+}
+
+std::shared_ptr<PointsOctree> PointKernel::readPoints(Base::Reader &reader, std::vector<value_type> &points,
+                                                      bool outOfCore)
 {
     Base::InputStream str(reader,boost::ends_with(reader.getFileName(),".bin"));
     uint32_t uCt = 0;
     str >> uCt;
-    _Points.resize(uCt);
+    if (outOfCore && uCt > PointsOctree::getOutOfCoreThreshold()) {
+        // stream the points of a very large cloud into an octree on disk
+        PointsOctreeBuilder builder;
+        std::vector<value_type> block;
+        block.reserve(65536);
+        for (unsigned long i=0; i < uCt; i++) {
+            float x, y, z;
+            str >> x >> y >> z;
+            block.emplace_back(x, y, z);
+            if (block.size() == block.capacity()) {
+                builder.addPoints(block);
+                block.clear();
+            }
+        }
+        builder.addPoints(block);
+        points.clear();
+        return builder.finish(true);
+    }
+
+    points.resize(uCt);
     for (unsigned long i=0; i < uCt; i++) {
         float x, y, z;
         str >> x >> y >> z;
-        _Points[i].Set(x,y,z);
+        points[i].Set(x,y,z);
     }
+    return nullptr;
 }
 
 void PointKernel::save(const char* file) const
@@ -251,7 +349,7 @@ void PointKernel::load(const char* file)
 void PointKernel::save(std::ostream& out) const
 {
     out << "# ASCII\n";
-    for (std::vector<value_type>::const_iterator it = _Points.begin(); it != _Points.end(); ++it) {
+    for (const value_type *it = data(), *end = data() + size(); it != end; ++it) {
         out << it->x << ' ' << it->y << ' ' << it->z << '\n';
     }
 }
@@ -260,7 +358,7 @@ void PointKernel::getPoints(std::vector<Base::Vector3d> &Points,
                             std::vector<Base::Vector3d> &/*Normals*/,
                             double /*Accuracy*/, uint16_t /*flags*/) const
 {
-    unsigned long ctpoints = _Points.size();
+    unsigned long ctpoints = size();
     Points.reserve(ctpoints);
     for (unsigned long i=0; i<ctpoints; i++) {
         Points.push_back(this->getPoint(i));
@@ -273,16 +371,17 @@ bool PointKernel::isSame(const Data::ComplexGeoData &_other) const
         return false;
     const auto &other = static_cast<const PointKernel &>(_other);
     return _Mtrx == other._Mtrx
-        && _Points == other._Points;
+        && size() == other.size()
+        && (data() == other.data() || std::equal(data(), data() + size(), other.data()));
 }
 
 // ----------------------------------------------------------------------------
 
 PointKernel::const_point_iterator::const_point_iterator
-(const PointKernel* kernel, std::vector<kernel_type>::const_iterator index)
+(const PointKernel* kernel, iter_type index)
   : _kernel(kernel), _p_it(index)
 {
-    if(_p_it != kernel->_Points.end())
+    if(_p_it != kernel->data() + kernel->size())
     {
         value_type vertd(_p_it->x, _p_it->y, _p_it->z);
         this->_point = _kernel->_Mtrx * vertd;
@@ -26,6 +26,7 @@
 
 #include <vector>
 #include <iterator>
+#include <memory>
 
 #include <App/ComplexGeoData.h>
 #include <App/PropertyGeo.h>
@@ -40,7 +41,13 @@
 namespace Points
 {
 
+class PointsOctree;
+
 /** Point kernel
+ * The points are either kept in memory or, for very large clouds, in a memory-mapped
+ * PointsOctree on disk. Out-of-core points are loaded into memory when an algorithm
+ * asks for the point vector and the kernel switches to the in-memory points when it
+ * gets modified.
  */
 class PointsExport PointKernel : public Data::ComplexGeoData
 {
@@ -81,13 +88,32 @@ public:
     inline void setTransform(const Base::Matrix4D& rclTrf) override{_Mtrx = rclTrf;}
     inline Base::Matrix4D getTransform() const override{return _Mtrx;}
     std::vector<value_type>& getBasicPoints()
-    { return this->_Points; }
-    const std::vector<value_type>& getBasicPoints() const
-    { return this->_Points; }
+    { detachOctree(); return this->_Points; }
+    const std::vector<value_type>& getBasicPoints() const;
     void setBasicPoints(const std::vector<value_type>& pts)
-    { this->_Points = pts; }
+    { this->_Octree.reset(); this->_Points = pts; }
     void swap(std::vector<value_type>& pts)
-    { this->_Points.swap(pts); }
+    { detachOctree(); this->_Points.swap(pts); }
+    /// Returns the untransformed points, either from memory or from the octree
+    const value_type* data() const;
+
+    /** @name Out-of-core points */
+    //@{
+    /// Replaces the points with the points of \a octree
+    void setOctree(const std::shared_ptr<PointsOctree>& octree);
+    /// Returns the octree holding the points or null if the points are in memory
+    const std::shared_ptr<PointsOctree>& getOctree() const
+    { return this->_Octree; }
+    bool isOutOfCore() const
+    { return this->_Octree != nullptr; }
+    /** Sets whether a large cloud may be restored into an octree. The octree reorders the
+     * points, so this must be disabled if their order matters.
+     */
+    void setOutOfCoreAllowed(bool on)
+    { this->_OutOfCoreAllowed = on; }
+    bool isOutOfCoreAllowed() const
+    { return this->_OutOfCoreAllowed; }
+    //@}
 
     void getPoints(std::vector<Base::Vector3d> &Points,
         std::vector<Base::Vector3d> &Normals,
@@ -103,6 +129,8 @@ public:
     void SaveDocFile (Base::Writer &writer) const override;
     void Restore(Base::XMLReader &reader) override;
     void RestoreDocFile(Base::Reader &reader) override;
+    bool canRestoreDocFileInThread() const override;
+    std::function<void()> restoreDocFileInThread(Base::Reader &reader) override;
     void save(const char* file) const;
     void save(std::ostream&) const;
     void load(const char* file);
@@ -111,34 +139,46 @@ public:
 
     virtual bool isSame(const Data::ComplexGeoData &other) const;
 
+private:
+    static std::shared_ptr<PointsOctree> readPoints(Base::Reader &reader, std::vector<value_type> &points,
+                                                    bool outOfCore);
+    /// Loads the out-of-core points into memory and releases the octree
+    void detachOctree();
+
 private:
     Base::Matrix4D _Mtrx;
-    std::vector<value_type> _Points;
+    // for an out-of-core kernel it holds a copy of the points once they are requested
+    mutable std::vector<value_type> _Points;
+    std::shared_ptr<PointsOctree> _Octree;
+    bool _OutOfCoreAllowed = true;
 
 public:
     /// number of points stored
-    size_type size() const {return this->_Points.size();}
+    size_type size() const;
     size_type countValid() const;
     std::vector<value_type> getValidPoints() const;
-    void resize(size_type n){_Points.resize(n);}
-    void reserve(size_type n){_Points.reserve(n);}
+    void resize(size_type n){detachOctree(); _Points.resize(n);}
+    void reserve(size_type n){detachOctree(); _Points.reserve(n);}
     inline void erase(size_type first, size_type last) {
+        detachOctree();
         _Points.erase(_Points.begin()+first,_Points.begin()+last);
     }
 
-    void clear(){_Points.clear();}
+    void clear(){_Octree.reset(); _Points.clear();}
 
 
     /// get the points
     inline const Base::Vector3d getPoint(const int idx) const {
-        return transformPointToOutside(_Points[idx]);
+        return transformPointToOutside(data()[idx]);
     }
     /// set the points
     inline void setPoint(const int idx,const Base::Vector3d& point) {
+        detachOctree();
         _Points[idx] = transformPointToInside(point);
     }
     /// insert the points
     inline void push_back(const Base::Vector3d& point) {
+        detachOctree();
         _Points.push_back(transformPointToInside(point));
     }
 
@@ -147,13 +187,13 @@ public:
     public:
         using kernel_type = PointKernel::value_type;
         using value_type = Base::Vector3d;
-        using iter_type = std::vector<kernel_type>::const_iterator;
-        using difference_type = iter_type::difference_type;
-        using iterator_category = iter_type::iterator_category;
+        using iter_type = const kernel_type*;
+        using difference_type = std::iterator_traits<iter_type>::difference_type;
+        using iterator_category = std::iterator_traits<iter_type>::iterator_category;
         using pointer = const value_type*;
         using reference = const value_type&;
 
-        const_point_iterator(const PointKernel*, std::vector<kernel_type>::const_iterator index);
+        const_point_iterator(const PointKernel*, iter_type index);
         const_point_iterator(const const_point_iterator& pi);
         //~const_point_iterator();
 
@@ -175,7 +215,7 @@ public:
         void dereference();
         const PointKernel* _kernel;
         value_type _point;
-        std::vector<kernel_type>::const_iterator _p_it;
+        iter_type _p_it;
     };
 
     using const_iterator = const_point_iterator;
@@ -184,9 +224,9 @@ public:
     /** @name Iterator */
     //@{
     const_point_iterator begin() const
-    { return const_point_iterator(this, _Points.begin()); }
+    { return const_point_iterator(this, data()); }
     const_point_iterator end() const
-    { return const_point_iterator(this, _Points.end()); }
+    { return const_point_iterator(this, data() + size()); }
     const_reverse_iterator rbegin() const
     { return const_reverse_iterator(end()); }
     const_reverse_iterator rend() const
@@ -25,6 +25,7 @@
 # ifdef FC_OS_LINUX
 #  include <unistd.h>
 # endif
+# include <limits>
 # include <memory>
 # include <sstream>
 
@@ -42,6 +43,7 @@
 #include <Base/Stream.h>
 
 #include "PointsAlgos.h"
+#include "PointsOctree.h"
 #include <E57Format.h>
 
 
@@ -122,6 +124,7 @@ Reader::Reader()
 {
     width = 0;
     height = 0;
+    outOfCoreThreshold = std::numeric_limits<std::size_t>::max();
 }
 
 Reader::~Reader()
@@ -140,6 +143,11 @@ const PointKernel& Reader::getPoints() const
     return points;
 }
 
+void Reader::setOutOfCoreThreshold(std::size_t threshold)
+{
+    outOfCoreThreshold = threshold;
+}
+
 bool Reader::hasProperties() const
 {
     return (hasIntensities() || hasColors() || hasNormals());
@@ -1304,11 +1312,13 @@ namespace {
 class E57ReaderImp
 {
 public:
-    E57ReaderImp(const std::string& filename, bool color, bool state, double distance)
+    E57ReaderImp(const std::string& filename, bool color, bool state, double distance,
+                 std::size_t threshold)
         : imfi(filename, "r")
         , useColor{color}
         , checkState{state}
         , minDistance{distance}
+        , outOfCoreThreshold{threshold}
     {
     }
 
@@ -1317,7 +1327,15 @@ public:
         e57::StructureNode root = imfi.root();
         if (root.isDefined("data3D")) {
             e57::VectorNode data3D(root.get("data3D"));
+            // stream the points of a very large scan into an octree on disk
+            if (countPoints(data3D) > outOfCoreThreshold) {
+                octree.reset(new PointsOctreeBuilder());
+            }
             readData3D(data3D);
+            if (octree) {
+                points.setOctree(octree->finish(true));
+                octree.reset();
+            }
         }
     }
 
@@ -1342,6 +1360,17 @@ public:
     }
 
 private:
+    std::size_t countPoints(const e57::VectorNode& data3D) const
+    {
+        std::size_t count = 0;
+        for (int child = 0; child < data3D.childCount(); ++child) {
+            e57::StructureNode scan_data(data3D.get(child));
+            e57::CompressedVectorNode cvn(scan_data.get("points"));
+            count += static_cast<std::size_t>(cvn.childCount());
+        }
+        return count;
+    }
+
     void readData3D(const  e57::VectorNode& data3D)
     {
         for (int child = 0; child < data3D.childCount(); ++child) {
@@ -1615,11 +1644,13 @@ private:
         unsigned cnt_pts = 0;
         Base::Vector3d pt, last;
         e57::CompressedVectorReader cvr(cvn.reader(proto.sdb));
-        bool hasColor = (proto.cnt_rgb == 3) && useColor;
-        bool hasItensity = proto.inty;
-        bool hasNormal = (proto.cnt_nor == 3);
+        // the per-point properties are not kept for out-of-core points
+        bool hasColor = (proto.cnt_rgb == 3) && useColor && !octree;
+        bool hasItensity = proto.inty && !octree;
+        bool hasNormal = (proto.cnt_nor == 3) && !octree;
         bool hasState = proto.inv_state && checkState;
         bool filter = false;
+        std::vector<Base::Vector3f> block;
 
         while ((count = cvr.read())) {
             for (size_t i = 0; i < count; ++i) {
@@ -1635,7 +1666,12 @@ private:
                         filter = true;
                     }
                 }
-                if (!filter) {
+                if (!filter && octree) {
+                    cnt_pts++;
+                    block.push_back(Base::convertTo<Base::Vector3f>(pt));
+                    last = pt;
+                }
+                else if (!filter) {
                     cnt_pts++;
                     points.push_back(pt);
                     last = pt;
@@ -1650,6 +1686,11 @@ private:
                     }
                 }
             }
+
+            if (octree) {
+                octree->addPoints(block);
+                block.clear();
+            }
         }
     }
 
@@ -1740,6 +1781,8 @@ private:
     bool useColor;
     bool checkState;
     double minDistance;
+    std::size_t outOfCoreThreshold;
+    std::unique_ptr<PointsOctreeBuilder> octree;
     const size_t buf_size = 1024;
     std::vector<App::Color> colors;
     std::vector<float> intensity;
@@ -1762,7 +1805,7 @@ E57Reader::~E57Reader()
 void E57Reader::read(const std::string& filename)
 {
     try {
-        E57ReaderImp reader(filename, useColor, checkState, minDistance);
+        E57ReaderImp reader(filename, useColor, checkState, minDistance, outOfCoreThreshold);
         reader.read();
         points = reader.getPoints();
         normals = reader.getNormals();
@@ -1897,7 +1940,7 @@ void PlyWriter::write(const std::string& filename)
 
     std::size_t numPoints = points.size();
     std::size_t numValid = 0;
-    const std::vector<Base::Vector3f>& pts = points.getBasicPoints();
+    const Base::Vector3f* pts = points.data();
     for (std::size_t i=0; i<numPoints; i++) {
         const Base::Vector3f& p = pts[i];
         if (!boost::math::isnan(p.x) &&
@@ -2059,7 +2102,7 @@ void PcdWriter::write(const std::string& filename)
     }
 
     std::size_t numPoints = points.size();
-    const std::vector<Base::Vector3f>& pts = points.getBasicPoints();
+    const Base::Vector3f* pts = points.data();
 
     Eigen::MatrixXd data(numPoints, fields.size());
 
@@ -54,6 +54,11 @@ public:
 
     void clear();
     const PointKernel& getPoints() const;
+    /** Files with more than \a threshold points are streamed into an out-of-core octree
+     * instead of being read into memory, if the reader supports it. Intensities, colors
+     * and normals are not read in this case.
+     */
+    void setOutOfCoreThreshold(std::size_t threshold);
     bool hasProperties() const;
     const std::vector<float>& getIntensities() const;
     bool hasIntensities() const;
@@ -71,6 +76,7 @@ protected:
     std::vector<App::Color> colors;
     std::vector<Base::Vector3f> normals;
     int width, height;
+    std::size_t outOfCoreThreshold;
 };
 
 class AscReader : public Reader
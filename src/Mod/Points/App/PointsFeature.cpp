@@ -26,7 +26,10 @@
 # include <vector>
 #endif
 
+#include <App/PropertyStandard.h>
+
 #include "PointsFeature.h"
+#include "Properties.h"
 
 
 using namespace Points;
@@ -60,6 +63,21 @@ App::DocumentObjectExecReturn *Feature::execute()
 void Feature::Restore(Base::XMLReader &reader)
 {
     GeoFeature::Restore(reader);
+    // the octree of a large cloud reorders its points
+    Points.setOutOfCoreAllowed(!keepPointOrder());
+}
+
+bool Feature::keepPointOrder() const
+{
+    std::vector<App::Property*> props;
+    getPropertyList(props);
+    for (auto prop : props) {
+        if (prop->isDerivedFrom(PropertyGreyValueList::getClassTypeId())
+         || prop->isDerivedFrom(PropertyNormalList::getClassTypeId())
+         || prop->isDerivedFrom(App::PropertyColorList::getClassTypeId()))
+            return true;
+    }
+    return false;
 }
 
 void Feature::RestoreDocFile(Base::Reader &reader)
@@ -75,6 +75,8 @@ public:
 protected:
     void onChanged(const App::Property* prop) override;
     //@}
+    /// Returns true if the restored points must keep their order, e.g. for per-point properties
+    virtual bool keepPointOrder() const;
 
 public:
     PropertyPointKernel Points; /**< The point kernel property. */
@@ -120,8 +120,6 @@ void PointsGrid::InitGrid ()
 {
   assert(_pclPoints);
 
-  unsigned long i, j;
-
   // Calculate grid lengths if not initialized
   //
   if ((_ulCtGridsX == 0) || (_ulCtGridsY == 0) || (_ulCtGridsZ == 0))
@@ -167,13 +165,7 @@ void PointsGrid::InitGrid ()
 
   // Create data structure
   _aulGrid.clear();
-  _aulGrid.resize(_ulCtGridsX);
-  for (i = 0; i < _ulCtGridsX; i++)
-  {
-    _aulGrid[i].resize(_ulCtGridsY);
-    for (j = 0; j < _ulCtGridsY; j++)
-      _aulGrid[i][j].resize(_ulCtGridsZ);
-  }
+  _aulGrid.resize(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ);
 }
 
 unsigned long PointsGrid::InSide (const Base::BoundBox3d &rclBB, std::vector<unsigned long> &raulElements, bool bDelDoubles) const
@@ -192,7 +184,7 @@ unsigned long PointsGrid::InSide (const Base::BoundBox3d &rclBB, std::vector<uns
     {
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
-        raulElements.insert(raulElements.end(), _aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+        raulElements.insert(raulElements.end(), GetCell(i, j, k).begin(), GetCell(i, j, k).end());
       }
     }
   }
@@ -226,7 +218,7 @@ unsigned long PointsGrid::InSide (const Base::BoundBox3d &rclBB, std::vector<uns
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
         if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2)
-          raulElements.insert(raulElements.end(), _aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+          raulElements.insert(raulElements.end(), GetCell(i, j, k).begin(), GetCell(i, j, k).end());
       }
     }
   }
@@ -257,7 +249,7 @@ unsigned long PointsGrid::InSide (const Base::BoundBox3d &rclBB, std::set<unsign
     {
       for (k = ulMinZ; k <= ulMaxZ; k++)
       {
-        raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+        raulElements.insert(GetCell(i, j, k).begin(), GetCell(i, j, k).end());
       }
     }
   }
@@ -486,7 +478,7 @@ void PointsGrid::SearchNearestFromPoint (const Base::Vector3d &rclPt, std::set<u
           for (unsigned long i = 0; i < _ulCtGridsY; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+              raclInd.insert(GetCell(nX, i, j).begin(), GetCell(nX, i, j).end());
           }
           nX++;
         }
@@ -500,7 +492,7 @@ void PointsGrid::SearchNearestFromPoint (const Base::Vector3d &rclPt, std::set<u
           for (unsigned long i = 0; i < _ulCtGridsY; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+              raclInd.insert(GetCell(nX, i, j).begin(), GetCell(nX, i, j).end());
           }
           nX++;
         }
@@ -514,7 +506,7 @@ void PointsGrid::SearchNearestFromPoint (const Base::Vector3d &rclPt, std::set<u
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+              raclInd.insert(GetCell(i, nY, j).begin(), GetCell(i, nY, j).end());
           }
           nY++;
         }
@@ -528,7 +520,7 @@ void PointsGrid::SearchNearestFromPoint (const Base::Vector3d &rclPt, std::set<u
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsZ; j++)
-              raclInd.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+              raclInd.insert(GetCell(i, nY, j).begin(), GetCell(i, nY, j).end());
           }
           nY--;
         }
@@ -542,7 +534,7 @@ void PointsGrid::SearchNearestFromPoint (const Base::Vector3d &rclPt, std::set<u
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsY; j++)
-              raclInd.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+              raclInd.insert(GetCell(i, j, nZ).begin(), GetCell(i, j, nZ).end());
           }
           nZ++;
         }
@@ -556,7 +548,7 @@ void PointsGrid::SearchNearestFromPoint (const Base::Vector3d &rclPt, std::set<u
           for (unsigned long i = 0; i < _ulCtGridsX; i++)
           {
             for (unsigned long j = 0; j < _ulCtGridsY; j++)
-              raclInd.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+              raclInd.insert(GetCell(i, j, nZ).begin(), GetCell(i, j, nZ).end());
           }
           nZ--;
         }
@@ -622,7 +614,7 @@ void PointsGrid::GetHull (unsigned long ulX, unsigned long ulY, unsigned long ul
 unsigned long PointsGrid::GetElements (unsigned long ulX, unsigned long ulY, unsigned long ulZ,
                                      std::set<unsigned long> &raclInd) const
 {
-  const std::set<unsigned long> &rclSet = _aulGrid[ulX][ulY][ulZ];
+  Base::GridCells<unsigned long>::Cell rclSet = GetCell(ulX, ulY, ulZ);
   if (!rclSet.empty())
   {
     raclInd.insert(rclSet.begin(), rclSet.end());
@@ -632,12 +624,13 @@ unsigned long PointsGrid::GetElements (unsigned long ulX, unsigned long ulY, uns
   return 0;
 }
 
-void PointsGrid::AddPoint (const Base::Vector3d &rclPt, unsigned long ulPtIndex, float /*fEpsilon*/)
+void PointsGrid::AddPoint (const Base::Vector3d &rclPt, unsigned long ulPtIndex,
+                           Base::GridCells<unsigned long>::Entries &raclEntries, float /*fEpsilon*/) const
 {
   unsigned long ulX, ulY, ulZ;
   Pos(Base::Vector3d(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
   if ( (ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ) )
-    _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
+    raclEntries.push_back({(ulX * _ulCtGridsY + ulY) * _ulCtGridsZ + ulZ, ulPtIndex});
 }
 
 void PointsGrid::Validate (const PointKernel &rclPoints)
@@ -687,12 +680,10 @@ void PointsGrid::RebuildGrid ()
   InitGrid();
 
   // Fill data structure
-
-  unsigned long i = 0;
-  for (PointKernel::const_iterator it = _pclPoints->begin(); it != _pclPoints->end(); ++it )
-  {
-    AddPoint(*it, i++);
-  }
+  _aulGrid.fill(_aulGrid.size(), _ulCtElements,
+                [this](unsigned long i, Base::GridCells<unsigned long>::Entries &entries) {
+    AddPoint(_pclPoints->getPoint(static_cast<int>(i)), i, entries);
+  });
 }
 
 void PointsGrid::Pos (const Base::Vector3d &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const
@@ -754,7 +745,7 @@ bool PointsGridIterator::InitOnRay (const Base::Vector3d &rclPt, const Base::Vec
   if (_rclGrid.GetBoundBox().IsInBox(rclPt))
   {  // determine the voxel by the starting point
     _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    raulElements.insert(raulElements.end(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).begin(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).end());
     _bValidRay = true;
   }
   else
@@ -767,7 +758,7 @@ bool PointsGridIterator::InitOnRay (const Base::Vector3d &rclPt, const Base::Vec
       else
         _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
 
-      raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+      raulElements.insert(raulElements.end(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).begin(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).end());
       _bValidRay = true;
     }
   }
@@ -818,7 +809,7 @@ bool PointsGridIterator::NextOnRay (std::vector<unsigned long> &raulElements)
   if (_bValidRay && _rclGrid.CheckPos(_ulX, _ulY, _ulZ))
   {
     GridElement pos(_ulX, _ulY, _ulZ); _cSearchPositions.insert(pos);
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    raulElements.insert(raulElements.end(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).begin(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).end());
   }
   else {
     _bValidRay = false;  // ray exited
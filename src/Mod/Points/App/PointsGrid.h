@@ -26,6 +26,7 @@
 #include <set>
 
 #include <Base/BoundBox.h>
+#include <Base/GridCells.h>
 #include <Base/Vector3D.h>
 
 #include "Points.h"
@@ -105,7 +106,10 @@ public:
   //@}
   /** Returns the number of elements in a given grid. */
   unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
-  { return _aulGrid[ulX][ulY][ulZ].size(); }
+  { return GetCell(ulX, ulY, ulZ).size(); }
+  /** Returns the number of bytes allocated for the grid elements. */
+  unsigned long GetMemoryUsage() const
+  { return _aulGrid.memoryUsage(); }
   /** Finds all points that lie in the same grid as the point \a rclPoint. */
   unsigned long FindElements(const Base::Vector3d &rclPoint, std::set<unsigned long>& aulElements) const;
   /** Validates the grid structure and rebuilds it if needed. */
@@ -138,9 +142,12 @@ protected:
   { return _pclPoints->size(); }
   /** Get the indices of all elements lying in the grids around a given grid with distance \a ulDistance. */
   void GetHull (unsigned long ulX, unsigned long ulY, unsigned long ulZ, unsigned long ulDistance, std::set<unsigned long> &raclInd) const;
+  /** Returns the elements of the given grid. */
+  Base::GridCells<unsigned long>::Cell GetCell (unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+  { return _aulGrid[(ulX * _ulCtGridsY + ulY) * _ulCtGridsZ + ulZ]; }
 
 protected:
-  std::vector<std::vector<std::vector<std::set<unsigned long> > > >  _aulGrid;   /**< Grid data structure. */
+  Base::GridCells<unsigned long> _aulGrid; /**< Grid data structure. */
   const PointKernel* _pclPoints;  /**< The point kernel. */
   unsigned long     _ulCtElements;/**< Number of grid elements for validation issues. */
   unsigned long     _ulCtGridsX;  /**< Number of grid elements in z. */
@@ -161,8 +168,9 @@ public:
 
 protected:
   /** Adds a new point element to the grid structure. \a rclPt is the geometric point and \a ulPtIndex
-   * the corresponding index in the point kernel. */
-  void AddPoint (const Base::Vector3d &rclPt, unsigned long ulPtIndex, float fEpsilon = 0.0f);
+   * the corresponding index in the point kernel. The point is added to \a raclEntries. */
+  void AddPoint (const Base::Vector3d &rclPt, unsigned long ulPtIndex,
+                 Base::GridCells<unsigned long>::Entries &raclEntries, float fEpsilon = 0.0f) const;
   /** Returns the grid numbers to the given point \a rclPoint. */
   void Pos(const Base::Vector3d &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const;
 };
@@ -182,7 +190,7 @@ public:
   /** Returns indices of the elements in the current grid. */
   void GetElements (std::vector<unsigned long> &raulElements) const
   {
-    raulElements.insert(raulElements.end(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(), _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+    raulElements.insert(raulElements.end(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).begin(), _rclGrid.GetCell(_ulX, _ulY, _ulZ).end());
   }
   /** @name Iteration */
   //@{
@@ -0,0 +1,566 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <cstring>
+# include <queue>
+#endif
+
+#include <QFile>
+
+#include <App/Application.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+
+#include "PointsOctree.h"
+
+
+using namespace Points;
+
+namespace {
+
+static_assert(sizeof(Base::Vector3f) == 3 * sizeof(float), "Points are stored as three floats");
+
+const char OctreeMagic[8] = {'F', 'C', 'O', 'C', 'T', 'R', 'E', 'E'};
+const uint32_t OctreeVersion = 1;
+const int MaxDepth = 21;
+const uint64_t MaxCell = (uint64_t(1) << MaxDepth) - 1;
+
+/// Spreads the lower 21 bits of \a v so that there are two zero bits between them
+uint64_t SpreadBits(uint64_t v)
+{
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8)  & 0x100f00f00f00f00fULL;
+    v = (v | v << 4)  & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2)  & 0x1249249249249249ULL;
+    return v;
+}
+
+/// Computes the Morton code of a point within the cube of the octree
+class MortonCode
+{
+public:
+    explicit MortonCode(const Base::BoundBox3f& box)
+      : base(box.MinX, box.MinY, box.MinZ)
+      , scale(0.0f)
+    {
+        float length = std::max(box.LengthX(), std::max(box.LengthY(), box.LengthZ()));
+        if (length > 0.0f)
+            scale = static_cast<float>(MaxCell + 1) / length;
+    }
+    uint64_t operator()(const Base::Vector3f& p) const
+    {
+        return SpreadBits(cell(p.x - base.x)) |
+              (SpreadBits(cell(p.y - base.y)) << 1) |
+              (SpreadBits(cell(p.z - base.z)) << 2);
+    }
+    /// The index of the child cell at \a depth that contains the point with the code \a code
+    static int digit(uint64_t code, int depth)
+    {
+        return static_cast<int>((code >> (3 * (MaxDepth - 1 - depth))) & 7);
+    }
+
+private:
+    uint64_t cell(float value) const
+    {
+        float c = value * scale;
+        if (!(c > 0.0f))
+            return 0;
+        return std::min(static_cast<uint64_t>(c), MaxCell);
+    }
+
+private:
+    Base::Vector3f base;
+    float scale;
+};
+
+using Record = std::pair<uint64_t, Base::Vector3f>;
+
+bool CompareCode(const Record& r1, const Record& r2)
+{
+    return r1.first < r2.first;
+}
+
+void WritePoints(std::ostream& str, const Base::Vector3f* points, std::size_t count)
+{
+    str.write(reinterpret_cast<const char*>(points),
+              static_cast<std::streamsize>(count * sizeof(Base::Vector3f)));
+}
+
+/// Reads the points of a sorted run in blocks
+class RunReader
+{
+public:
+    RunReader(const std::string& filename, std::size_t first, std::size_t count)
+      : str(Base::FileInfo(filename), std::ios::in | std::ios::binary)
+      , remaining(count)
+    {
+        str.seekg(static_cast<std::streamoff>(first * sizeof(Base::Vector3f)));
+    }
+    bool next(Base::Vector3f& point)
+    {
+        if (pos == buffer.size()) {
+            std::size_t count = std::min<std::size_t>(remaining, 16384);
+            if (count == 0)
+                return false;
+            buffer.resize(count);
+            str.read(reinterpret_cast<char*>(buffer.data()),
+                     static_cast<std::streamsize>(count * sizeof(Base::Vector3f)));
+            if (!str)
+                throw Base::FileException("Failed to read point buffer");
+            remaining -= count;
+            pos = 0;
+        }
+        point = buffer[pos++];
+        return true;
+    }
+
+private:
+    Base::ifstream str;
+    std::size_t remaining;
+    std::vector<Base::Vector3f> buffer;
+    std::size_t pos = 0;
+};
+
+}
+
+// ----------------------------------------------------------------------------
+
+PointsOctree::PointsOctree()
+  : _temporary(false)
+  , _map(nullptr)
+  , _numPoints(0)
+  , _points(nullptr)
+  , _samples(nullptr)
+{
+}
+
+PointsOctree::~PointsOctree()
+{
+    close();
+}
+
+bool PointsOctree::open(const std::string& filename, bool temporary)
+{
+    close();
+
+    _file.reset(new QFile(QString::fromUtf8(filename.c_str())));
+    if (!_file->open(QIODevice::ReadOnly) || _file->size() < static_cast<qint64>(sizeof(Header))) {
+        _file.reset();
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(_file->size());
+    const unsigned char* map = _file->map(0, _file->size());
+    if (!map) {
+        _file.reset();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, map, sizeof(Header));
+    std::size_t endPoints = sizeof(Header) + header.numPoints * sizeof(Base::Vector3f);
+    std::size_t endSamples = endPoints + header.numSamples * sizeof(Base::Vector3f);
+    bool valid = std::memcmp(header.magic, OctreeMagic, sizeof(OctreeMagic)) == 0 &&
+                 header.version == OctreeVersion && endSamples <= size &&
+                 (header.numNodes == 0 || header.nodeOffset >= endSamples) &&
+                 header.nodeOffset + header.numNodes * sizeof(Node) <= size;
+    if (!valid) {
+        _file->unmap(const_cast<unsigned char*>(map));
+        _file.reset();
+        return false;
+    }
+
+    _fileName = filename;
+    _temporary = temporary;
+    _map = map;
+    _numPoints = header.numPoints;
+    _points = reinterpret_cast<const Base::Vector3f*>(map + sizeof(Header));
+    _samples = reinterpret_cast<const Base::Vector3f*>(map + endPoints);
+    _nodes.resize(header.numNodes);
+    if (header.numNodes > 0)
+        std::memcpy(_nodes.data(), map + header.nodeOffset, header.numNodes * sizeof(Node));
+    _boundBox = header.numPoints > 0 ? toBoundBox(header.box) : Base::BoundBox3f();
+    return true;
+}
+
+void PointsOctree::close()
+{
+    if (_map)
+        _file->unmap(const_cast<unsigned char*>(_map));
+    _file.reset();
+    if (_temporary && !_fileName.empty())
+        Base::FileInfo(_fileName).deleteFile();
+
+    _fileName.clear();
+    _temporary = false;
+    _map = nullptr;
+    _numPoints = 0;
+    _points = nullptr;
+    _samples = nullptr;
+    _nodes.clear();
+    _boundBox = Base::BoundBox3f();
+}
+
+Base::BoundBox3f PointsOctree::toBoundBox(const float box[6])
+{
+    return Base::BoundBox3f(box[0], box[1], box[2], box[3], box[4], box[5]);
+}
+
+void PointsOctree::getLevelOfDetail(std::size_t budget,
+                                    const std::function<float(const Base::BoundBox3f&)>& size,
+                                    std::vector<Chunk>& chunks) const
+{
+    if (_nodes.empty())
+        return;
+
+    auto cost = [](const Node& node) -> std::size_t {
+        return node.numChildren > 0 ? node.sampleCount : node.count;
+    };
+
+    float rootSize = size(toBoundBox(_nodes.front().box));
+    if (rootSize < 0.0f)
+        return;
+
+    // refine the nodes in order of their projected size
+    std::priority_queue<std::pair<float, uint32_t>> candidates;
+    std::vector<std::pair<float, uint32_t>> children;
+    std::vector<uint32_t> selected;
+    std::size_t total = cost(_nodes.front());
+    candidates.emplace(rootSize, 0);
+    while (!candidates.empty()) {
+        std::pair<float, uint32_t> item = candidates.top();
+        candidates.pop();
+
+        const Node& node = _nodes[item.second];
+        bool refine = node.numChildren > 0 && item.first * item.first > node.sampleCount;
+        std::size_t childCost = 0;
+        children.clear();
+        if (refine) {
+            for (uint32_t i = node.firstChild; i < node.firstChild + node.numChildren; i++) {
+                float childSize = size(toBoundBox(_nodes[i].box));
+                if (childSize >= 0.0f) {
+                    children.emplace_back(childSize, i);
+                    childCost += cost(_nodes[i]);
+                }
+            }
+            refine = total - node.sampleCount + childCost <= budget;
+        }
+
+        if (refine) {
+            total = total - node.sampleCount + childCost;
+            for (const auto& it : children)
+                candidates.push(it);
+        }
+        else {
+            selected.push_back(item.second);
+        }
+    }
+
+    // keep the file order to access the mapped memory in sequence
+    std::sort(selected.begin(), selected.end());
+    chunks.reserve(chunks.size() + selected.size());
+    for (uint32_t index : selected) {
+        const Node& node = _nodes[index];
+        if (node.numChildren > 0)
+            chunks.push_back({_samples + node.sample, node.sampleCount});
+        else
+            chunks.push_back({_points + node.first, static_cast<std::size_t>(node.count)});
+    }
+}
+
+std::size_t PointsOctree::getOutOfCoreThreshold()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Points");
+    return hGrp->GetUnsigned("OutOfCoreThreshold", 50000000UL);
+}
+
+// ----------------------------------------------------------------------------
+
+PointsOctreeBuilder::PointsOctreeBuilder()
+  : PointsOctreeBuilder(App::Application::getTempFileName("PointsOctree"))
+{
+}
+
+PointsOctreeBuilder::PointsOctreeBuilder(const std::string& filename)
+  : _fileName(filename)
+  , _numPoints(0)
+  , _numSamples(0)
+{
+}
+
+PointsOctreeBuilder::~PointsOctreeBuilder()
+{
+    _buffer.reset();
+    for (const char* ext : {".buf", ".run", ".smp"}) {
+        Base::FileInfo fi(_fileName + ext);
+        if (fi.exists())
+            fi.deleteFile();
+    }
+}
+
+void PointsOctreeBuilder::addPoint(const Base::Vector3f& point)
+{
+    if (std::isnan(point.x) || std::isnan(point.y) || std::isnan(point.z))
+        return;
+    _boundBox.Add(point);
+    _points.push_back(point);
+    _numPoints++;
+    if (_points.size() == RunSize)
+        flush();
+}
+
+void PointsOctreeBuilder::addPoints(const std::vector<Base::Vector3f>& points)
+{
+    addPoints(points.data(), points.size());
+}
+
+void PointsOctreeBuilder::addPoints(const Base::Vector3f* points, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++)
+        addPoint(points[i]);
+}
+
+void PointsOctreeBuilder::flush()
+{
+    if (!_buffer) {
+        _buffer.reset(new Base::ofstream(Base::FileInfo(_fileName + ".buf"),
+                                         std::ios::out | std::ios::trunc | std::ios::binary));
+    }
+    WritePoints(*_buffer, _points.data(), _points.size());
+    if (!*_buffer)
+        throw Base::FileException("Failed to write point buffer", (_fileName + ".buf").c_str());
+    _points.clear();
+}
+
+void PointsOctreeBuilder::writeSorted(std::vector<Base::Vector3f>& points, std::ostream& str) const
+{
+    MortonCode code(_boundBox);
+    std::vector<Record> records;
+    records.reserve(points.size());
+    for (const auto& it : points)
+        records.emplace_back(code(it), it);
+    std::sort(records.begin(), records.end(), CompareCode);
+    for (std::size_t i = 0; i < records.size(); i++)
+        points[i] = records[i].second;
+    WritePoints(str, points.data(), points.size());
+}
+
+void PointsOctreeBuilder::mergeRuns(std::ostream& str)
+{
+    // sort the buffered points in runs of at most RunSize points
+    std::string runName = _fileName + ".run";
+    std::size_t numRuns = (_numPoints + RunSize - 1) / RunSize;
+    {
+        Base::ifstream buffer(Base::FileInfo(_fileName + ".buf"), std::ios::in | std::ios::binary);
+        Base::ofstream runs(Base::FileInfo(runName), std::ios::out | std::ios::trunc | std::ios::binary);
+        for (std::size_t i = 0; i < numRuns; i++) {
+            _points.resize(std::min(RunSize, _numPoints - i * RunSize));
+            buffer.read(reinterpret_cast<char*>(_points.data()),
+                        static_cast<std::streamsize>(_points.size() * sizeof(Base::Vector3f)));
+            if (!buffer)
+                throw Base::FileException("Failed to read point buffer", (_fileName + ".buf").c_str());
+            writeSorted(_points, runs);
+        }
+        if (!runs)
+            throw Base::FileException("Failed to write point runs", runName.c_str());
+    }
+    std::vector<Base::Vector3f>().swap(_points);
+    Base::FileInfo(_fileName + ".buf").deleteFile();
+
+    // merge the runs
+    MortonCode code(_boundBox);
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::vector<Base::Vector3f> current(numRuns);
+    using Entry = std::pair<uint64_t, std::size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heads;
+    for (std::size_t i = 0; i < numRuns; i++) {
+        std::size_t first = i * RunSize;
+        readers.emplace_back(new RunReader(runName, first, std::min(RunSize, _numPoints - first)));
+        if (readers.back()->next(current[i]))
+            heads.emplace(code(current[i]), i);
+    }
+
+    std::vector<Base::Vector3f> block;
+    block.reserve(65536);
+    while (!heads.empty()) {
+        std::size_t run = heads.top().second;
+        heads.pop();
+        block.push_back(current[run]);
+        if (block.size() == block.capacity()) {
+            WritePoints(str, block.data(), block.size());
+            block.clear();
+        }
+        if (readers[run]->next(current[run]))
+            heads.emplace(code(current[run]), run);
+    }
+    WritePoints(str, block.data(), block.size());
+
+    readers.clear();
+    Base::FileInfo(runName).deleteFile();
+}
+
+void PointsOctreeBuilder::buildNode(const Base::Vector3f* points, std::ostream& samples,
+                                    uint32_t index, std::size_t first, std::size_t count, int depth)
+{
+    PointsOctree::Node node{};
+    node.first = first;
+    node.count = count;
+
+    Base::BoundBox3f box;
+    if (count <= LeafSize || depth == MaxDepth) {
+        for (std::size_t i = first; i < first + count; i++)
+            box.Add(points[i]);
+    }
+    else {
+        // the samples are spread evenly over the range that is sorted in Morton order
+        node.sample = _numSamples;
+        node.sampleCount = static_cast<uint32_t>(SampleSize);
+        for (std::size_t i = 0; i < SampleSize; i++) {
+            const Base::Vector3f& point = points[first + (i * count) / SampleSize];
+            WritePoints(samples, &point, 1);
+        }
+        _numSamples += SampleSize;
+
+        // split the range by the child cells the points belong to
+        MortonCode code(_boundBox);
+        std::size_t bounds[9];
+        bounds[0] = first;
+        bounds[8] = first + count;
+        for (int c = 1; c < 8; c++) {
+            std::size_t lo = bounds[c - 1], hi = first + count;
+            while (lo < hi) {
+                std::size_t mid = lo + (hi - lo) / 2;
+                if (MortonCode::digit(code(points[mid]), depth) < c)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            bounds[c] = lo;
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        for (int c = 0; c < 8; c++) {
+            if (bounds[c + 1] > bounds[c])
+                ranges.emplace_back(bounds[c], bounds[c + 1] - bounds[c]);
+        }
+
+        node.firstChild = static_cast<uint32_t>(_nodes.size());
+        node.numChildren = static_cast<uint32_t>(ranges.size());
+        _nodes.resize(_nodes.size() + ranges.size());
+        for (std::size_t i = 0; i < ranges.size(); i++) {
+            uint32_t child = node.firstChild + static_cast<uint32_t>(i);
+            buildNode(points, samples, child, ranges[i].first, ranges[i].second, depth + 1);
+            box.Add(PointsOctree::toBoundBox(_nodes[child].box));
+        }
+    }
+
+    node.box[0] = box.MinX; node.box[1] = box.MinY; node.box[2] = box.MinZ;
+    node.box[3] = box.MaxX; node.box[4] = box.MaxY; node.box[5] = box.MaxZ;
+    _nodes[index] = node;
+}
+
+std::shared_ptr<PointsOctree> PointsOctreeBuilder::finish(bool temporary)
+{
+    PointsOctree::Header header{};
+    std::memcpy(header.magic, OctreeMagic, sizeof(OctreeMagic));
+    header.version = OctreeVersion;
+    header.numPoints = _numPoints;
+    if (_numPoints > 0) {
+        header.box[0] = _boundBox.MinX; header.box[1] = _boundBox.MinY; header.box[2] = _boundBox.MinZ;
+        header.box[3] = _boundBox.MaxX; header.box[4] = _boundBox.MaxY; header.box[5] = _boundBox.MaxZ;
+    }
+
+    // write the points in Morton order
+    {
+        Base::ofstream str(Base::FileInfo(_fileName), std::ios::out | std::ios::trunc | std::ios::binary);
+        str.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (_buffer) {
+            flush();
+            _buffer.reset();
+            mergeRuns(str);
+        }
+        else {
+            writeSorted(_points, str);
+            std::vector<Base::Vector3f>().swap(_points);
+        }
+        if (!str)
+            throw Base::FileException("Failed to write octree", _fileName.c_str());
+    }
+
+    // build the nodes on the mapped points, the samples go to a separate file first
+    std::string sampleName = _fileName + ".smp";
+    {
+        PointsOctree octree;
+        if (!octree.open(_fileName))
+            throw Base::FileException("Failed to map octree", _fileName.c_str());
+        Base::ofstream samples(Base::FileInfo(sampleName), std::ios::out | std::ios::trunc | std::ios::binary);
+        _nodes.clear();
+        _numSamples = 0;
+        if (_numPoints > 0) {
+            _nodes.resize(1);
+            buildNode(octree.getPoints(), samples, 0, 0, _numPoints, 0);
+        }
+        if (!samples)
+            throw Base::FileException("Failed to write octree samples", sampleName.c_str());
+    }
+
+    // append the samples and the nodes and complete the header
+    {
+        Base::ofstream str(Base::FileInfo(_fileName), std::ios::in | std::ios::out | std::ios::binary);
+        str.seekp(0, std::ios::end);
+        Base::ifstream samples(Base::FileInfo(sampleName), std::ios::in | std::ios::binary);
+        if (_numSamples > 0)
+            str << samples.rdbuf();
+        samples.close();
+        Base::FileInfo(sampleName).deleteFile();
+
+        std::size_t offset = sizeof(header) + (_numPoints + _numSamples) * sizeof(Base::Vector3f);
+        std::size_t padding = (8 - offset % 8) % 8;
+        const char zeros[8] = {};
+        str.write(zeros, static_cast<std::streamsize>(padding));
+        str.write(reinterpret_cast<const char*>(_nodes.data()),
+                  static_cast<std::streamsize>(_nodes.size() * sizeof(PointsOctree::Node)));
+
+        header.numSamples = _numSamples;
+        header.numNodes = _nodes.size();
+        header.nodeOffset = offset + padding;
+        str.seekp(0, std::ios::beg);
+        str.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!str)
+            throw Base::FileException("Failed to write octree", _fileName.c_str());
+    }
+    _nodes.clear();
+
+    auto octree = std::make_shared<PointsOctree>();
+    if (!octree->open(_fileName, temporary))
+        throw Base::FileException("Failed to map octree", _fileName.c_str());
+    return octree;
+}
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTS_OCTREE_H
+#define POINTS_OCTREE_H
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+#include <Mod/Points/PointsGlobal.h>
+
+
+class QFile;
+
+namespace Points {
+
+/**
+ * The PointsOctree class gives access to a point cloud that is stored in a file on disk and
+ * that is mapped into memory, so that clouds that are larger than the main memory can be
+ * handled. The points are sorted in Morton order and each node of the octree refers to a
+ * consecutive range of them. The inner nodes additionally keep a subset of their points as
+ * samples that are used as level of detail.
+ * The file is written by PointsOctreeBuilder.
+ */
+class PointsExport PointsOctree
+{
+public:
+    /// A consecutive range of points
+    struct Chunk
+    {
+        const Base::Vector3f* points;
+        std::size_t count;
+    };
+
+    PointsOctree();
+    ~PointsOctree();
+    PointsOctree(const PointsOctree&) = delete;
+    PointsOctree& operator=(const PointsOctree&) = delete;
+
+    /** Maps the octree file \a filename into memory. If \a temporary is true the file is
+     * removed when the octree is closed.
+     * \return true on success and false otherwise
+     */
+    bool open(const std::string& filename, bool temporary = false);
+    /// Unmaps the file
+    void close();
+    bool isOpen() const
+    { return _map != nullptr; }
+    const std::string& getFileName() const
+    { return _fileName; }
+
+    /// Returns the number of points
+    std::size_t size() const
+    { return _numPoints; }
+    /// Returns all points in Morton order
+    const Base::Vector3f* getPoints() const
+    { return _points; }
+    /// Returns the bounding box of the points
+    const Base::BoundBox3f& getBoundBox() const
+    { return _boundBox; }
+    /// Returns the number of nodes of the tree
+    std::size_t countNodes() const
+    { return _nodes.size(); }
+
+    /** Selects the points to display for a limited budget of points. \a size returns the
+     * projected size of a box in pixels or a negative value if the box is not visible. Starting
+     * with the samples of the root node the node with the largest projected size is replaced by
+     * its children as long as the budget isn't exhausted and its samples cover more than a pixel
+     * each. The leaves contribute all of their points.
+     */
+    void getLevelOfDetail(std::size_t budget,
+                          const std::function<float(const Base::BoundBox3f&)>& size,
+                          std::vector<Chunk>& chunks) const;
+
+    /// The number of points up to which the import of a point cloud is kept in memory
+    static std::size_t getOutOfCoreThreshold();
+
+private:
+    friend class PointsOctreeBuilder;
+
+    /// The node as stored in the file
+    struct Node
+    {
+        float box[6];
+        uint64_t first;
+        uint64_t count;
+        uint64_t sample;
+        uint32_t sampleCount;
+        uint32_t firstChild;
+        uint32_t numChildren;
+        uint32_t reserved;
+    };
+    /// The file header
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t numPoints;
+        uint64_t numSamples;
+        uint64_t numNodes;
+        uint64_t nodeOffset;
+        float box[6];
+    };
+
+    static Base::BoundBox3f toBoundBox(const float box[6]);
+
+private:
+    std::string _fileName;
+    bool _temporary;
+    std::unique_ptr<QFile> _file;
+    const unsigned char* _map;
+    std::size_t _numPoints;
+    const Base::Vector3f* _points;
+    const Base::Vector3f* _samples;
+    std::vector<Node> _nodes;
+    Base::BoundBox3f _boundBox;
+};
+
+/**
+ * The PointsOctreeBuilder class collects an arbitrary number of points and writes them as
+ * octree file that can be opened with PointsOctree. The points are buffered in a file on
+ * disk, so that only a bounded amount of memory is used. When finishing, the buffer file is
+ * sorted in runs that are merged to the octree file.
+ * Points with NaN coordinates are skipped.
+ */
+class PointsExport PointsOctreeBuilder
+{
+public:
+    /// Construction. The octree is written to a temporary file
+    PointsOctreeBuilder();
+    /// Construction. The octree is written to \a filename
+    explicit PointsOctreeBuilder(const std::string& filename);
+    ~PointsOctreeBuilder();
+    PointsOctreeBuilder(const PointsOctreeBuilder&) = delete;
+    PointsOctreeBuilder& operator=(const PointsOctreeBuilder&) = delete;
+
+    void addPoint(const Base::Vector3f&);
+    void addPoints(const std::vector<Base::Vector3f>&);
+    void addPoints(const Base::Vector3f* points, std::size_t count);
+    /// Returns the number of added points
+    std::size_t size() const
+    { return _numPoints; }
+
+    /** Writes the octree file and returns the opened octree. If \a temporary is true the file
+     * is removed when the octree gets destroyed. Throws a Base::FileException if the files
+     * can't be written.
+     */
+    std::shared_ptr<PointsOctree> finish(bool temporary);
+
+    /// The maximum number of points of a leaf
+    static const std::size_t LeafSize = 32768;
+    /// The maximum number of samples of an inner node
+    static const std::size_t SampleSize = 4096;
+    /// The number of points that are sorted in memory at once
+    static const std::size_t RunSize = 4194304;
+
+private:
+    void flush();
+    void writeSorted(std::vector<Base::Vector3f>& points, std::ostream&) const;
+    void mergeRuns(std::ostream&);
+    void buildNode(const Base::Vector3f* points, std::ostream& samples, uint32_t index,
+                   std::size_t first, std::size_t count, int depth);
+
+private:
+    std::string _fileName;
+    std::unique_ptr<std::ofstream> _buffer;
+    std::vector<Base::Vector3f> _points;
+    std::size_t _numPoints;
+    Base::BoundBox3f _boundBox;
+    std::vector<PointsOctree::Node> _nodes;
+    std::size_t _numSamples;
+};
+
+} // namespace Points
+
+
+#endif // POINTS_OCTREE_H
@@ -40,8 +40,11 @@
 // STL
 # include <algorithm>
 # include <cmath>
+# include <cstring>
 # include <iostream>
+# include <limits>
 # include <memory>
+# include <queue>
 # include <set>
 # include <sstream>
 # include <vector>
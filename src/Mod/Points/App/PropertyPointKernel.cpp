@@ -142,7 +142,7 @@ void PropertyPointKernel::Paste(const App::Property &from)
 
 unsigned int PropertyPointKernel::getMemSize () const
 {
-    return sizeof(Base::Vector3f) * this->_cPoints->size();
+    return this->_cPoints->getMemSize();
 }
 
 PointKernel* PropertyPointKernel::startEditing()
@@ -184,6 +184,11 @@ void PropertyPointKernel::removeIndices( const std::vector<unsigned long>& uIndi
     setValue(kernel);
 }
 
+void PropertyPointKernel::setOutOfCoreAllowed(bool on)
+{
+    _cPoints->setOutOfCoreAllowed(on);
+}
+
 void PropertyPointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
@@ -86,6 +86,8 @@ public:
     /// Transform the real 3d point kernel
     void transformGeometry(const Base::Matrix4D &rclMat) override;
     void removeIndices( const std::vector<unsigned long>& );
+    /// Sets whether a large cloud may be restored into an octree
+    void setOutOfCoreAllowed(bool on);
     //@}
 
 private:
@@ -55,6 +55,12 @@ public:
         return "PointsGui::ViewProviderStructured";
     }
     //@}
+
+protected:
+    /// The points are ordered in a Width x Height grid
+    bool keepPointOrder() const override {
+        return true;
+    }
 };
 
 using StructuredCustom = App::FeatureCustomT<Structured>;
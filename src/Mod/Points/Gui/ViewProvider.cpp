@@ -25,8 +25,14 @@
 # include <limits>
 # include <boost/math/special_functions/fpclassify.hpp>
 
+# include <Inventor/SbBox3f.h>
+# include <Inventor/actions/SoGLRenderAction.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
+# include <Inventor/elements/SoViewportRegionElement.h>
+# include <Inventor/elements/SoViewVolumeElement.h>
 # include <Inventor/errors/SoDebugError.h>
 # include <Inventor/events/SoMouseButtonEvent.h>
+# include <Inventor/nodes/SoCallback.h>
 # include <Inventor/nodes/SoCamera.h>
 # include <Inventor/nodes/SoCoordinate3.h>
 # include <Inventor/nodes/SoDrawStyle.h>
@@ -35,8 +41,10 @@
 # include <Inventor/nodes/SoMaterialBinding.h>
 # include <Inventor/nodes/SoNormal.h>
 # include <Inventor/nodes/SoPointSet.h>
+# include <Inventor/sensors/SoOneShotSensor.h>
 #endif
 
+#include <App/Application.h>
 #include <App/Document.h>
 #include <Base/Vector3D.h>
 #include <Gui/Application.h>
@@ -52,6 +60,25 @@
 using namespace PointsGui;
 using namespace Points;
 
+namespace {
+/// Copies the points of the chunks to the coordinate node and returns their number
+std::size_t SetPoints(SoCoordinate3* coords, const std::vector<PointsOctree::Chunk>& chunks)
+{
+    std::size_t count = 0;
+    for (const auto& it : chunks)
+        count += it.count;
+
+    coords->point.setNum(static_cast<int>(count));
+    SbVec3f* vec = coords->point.startEditing();
+    for (const auto& it : chunks) {
+        for (std::size_t i = 0; i < it.count; i++, vec++)
+            vec->setValue(it.points[i].x, it.points[i].y, it.points[i].z);
+    }
+    coords->point.finishEditing();
+    return count;
+}
+}
+
 
 PROPERTY_SOURCE_ABSTRACT(PointsGui::ViewProviderPoints, Gui::ViewProviderGeometryObject)
 
@@ -346,10 +373,27 @@ ViewProviderScattered::ViewProviderScattered()
 {
     pcPoints = new SoPointSet();
     pcPoints->ref();
+
+    // the level of detail of out-of-core points is selected when rendering and the points
+    // are set afterwards because the scene must not be changed while it's traversed
+    pcLevelOfDetail = new SoCallback();
+    pcLevelOfDetail->ref();
+    pcLevelOfDetail->setCallback([](void* data, SoAction* action) {
+        static_cast<ViewProviderScattered*>(data)->selectLevelOfDetail(action);
+    }, this);
+    pcLevelOfDetailSensor = new SoOneShotSensor([](void* data, SoSensor*) {
+        static_cast<ViewProviderScattered*>(data)->setLevelOfDetail();
+    }, this);
+
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Points");
+    pointBudget = hGrp->GetUnsigned("PointBudget", 5000000UL);
 }
 
 ViewProviderScattered::~ViewProviderScattered()
 {
+    delete pcLevelOfDetailSensor;
+    pcLevelOfDetail->unref();
     pcPoints->unref();
 }
 
@@ -363,6 +407,7 @@ void ViewProviderScattered::attach(App::DocumentObject* pcObj)
     pcHighlight->subElementName = "Main";
 
     // Highlight for selection
+    pcHighlight->addChild(pcLevelOfDetail);
     pcHighlight->addChild(pcPointsCoord);
     pcHighlight->addChild(pcPoints);
 
@@ -403,6 +448,10 @@ void ViewProviderScattered::updateData(const App::Property* prop)
 {
     ViewProviderPoints::updateData(prop);
     if (prop->getTypeId() == Points::PropertyPointKernel::getClassTypeId()) {
+        octree = static_cast<const Points::PropertyPointKernel*>(prop)->getValue().getOctree();
+        chunks.clear();
+        pcLevelOfDetailSensor->unschedule();
+
         ViewProviderPointsBuilder builder;
         builder.createPoints(prop, pcPointsCoord, pcPoints);
 
@@ -420,6 +469,47 @@ void ViewProviderScattered::updateData(const App::Property* prop)
     }
 }
 
+void ViewProviderScattered::selectLevelOfDetail(SoAction* action)
+{
+    if (!octree || !action->isOfType(SoGLRenderAction::getClassTypeId()))
+        return;
+
+    // the boxes of the octree are in the local coordinate system
+    SoState* state = action->getState();
+    SbViewVolume vv = SoViewVolumeElement::get(state);
+    vv.transform(SoModelMatrixElement::get(state).inverse());
+    SbVec2s size = SoViewportRegionElement::get(state).getViewportSizePixels();
+    float pixels = std::max(size[0], size[1]);
+
+    std::vector<PointsOctree::Chunk> selection;
+    octree->getLevelOfDetail(pointBudget, [&](const Base::BoundBox3f& box) {
+        SbBox3f bbox(box.MinX, box.MinY, box.MinZ, box.MaxX, box.MaxY, box.MaxZ);
+        if (!vv.intersect(bbox))
+            return -1.0f;
+        float scale = vv.getWorldToScreenScale(bbox.getCenter(), 1.0f);
+        if (scale <= 0.0f)
+            return pixels;
+        return box.CalcDiagonalLength() / scale * pixels;
+    }, selection);
+
+    bool changed = selection.size() != chunks.size() ||
+        !std::equal(selection.begin(), selection.end(), chunks.begin(),
+                    [](const PointsOctree::Chunk& c1, const PointsOctree::Chunk& c2) {
+            return c1.points == c2.points && c1.count == c2.count;
+        });
+    if (changed) {
+        chunks.swap(selection);
+        pcLevelOfDetailSensor->schedule();
+    }
+}
+
+void ViewProviderScattered::setLevelOfDetail()
+{
+    if (!octree)
+        return;
+    pcPoints->numPoints = static_cast<int>(SetPoints(pcPointsCoord, chunks));
+}
+
 void ViewProviderScattered::cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer &Viewer)
 {
     // create the polygon from the picked points
@@ -663,6 +753,18 @@ void ViewProviderPointsBuilder::createPoints(const App::Property* prop, SoCoordi
     const Points::PropertyPointKernel* prop_points = static_cast<const Points::PropertyPointKernel*>(prop);
     const Points::PointKernel& cPts = prop_points->getValue();
 
+    // out-of-core points get a view independent preview with an even density
+    if (cPts.isOutOfCore()) {
+        const Points::PointsOctree& octree = *cPts.getOctree();
+        float length = octree.getBoundBox().CalcDiagonalLength();
+        std::vector<Points::PointsOctree::Chunk> chunks;
+        octree.getLevelOfDetail(1000000, [length](const Base::BoundBox3f& box) {
+            return length > 0.0f ? 1000.0f * box.CalcDiagonalLength() / length : 0.0f;
+        }, chunks);
+        points->numPoints = static_cast<int>(SetPoints(coords, chunks));
+        return;
+    }
+
     coords->point.setNum(cPts.size());
     SbVec3f* vec = coords->point.startEditing();
 
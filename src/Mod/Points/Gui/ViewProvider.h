@@ -23,14 +23,19 @@
 #ifndef POINTSGUI_VIEWPROVIDERPOINTS_H
 #define POINTSGUI_VIEWPROVIDERPOINTS_H
 
+#include <memory>
 #include <Inventor/SbVec2f.h>
 
 #include <Gui/ViewProviderBuilder.h>
 #include <Gui/ViewProviderGeometryObject.h>
 #include <Gui/ViewProviderPythonFeature.h>
+#include <Mod/Points/App/PointsOctree.h>
 #include <Mod/Points/PointsGlobal.h>
 
 
+class SoAction;
+class SoCallback;
+class SoOneShotSensor;
 class SoSwitch;
 class SoPointSet;
 class SoIndexedPointSet;
@@ -116,6 +121,9 @@ private:
 /**
  * The ViewProviderScattered class creates
  * a node representing the scattered point cloud.
+ * Out-of-core point clouds are displayed with the level of detail that fits to the view.
+ * The points are selected when rendering and are limited to the point budget that is set
+ * by the parameter PointBudget.
  * @author Werner Mayer
  */
 class PointsGuiExport ViewProviderScattered : public ViewProviderPoints
@@ -136,9 +144,20 @@ public:
 
 protected:
     void cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer &Viewer) override;
+    /// Selects the out-of-core points for the view of the render action
+    void selectLevelOfDetail(SoAction*);
+    /// Sets the selected out-of-core points to the coordinate node
+    void setLevelOfDetail();
 
 protected:
     SoPointSet          * pcPoints;
+    SoCallback          * pcLevelOfDetail;
+    SoOneShotSensor     * pcLevelOfDetailSensor;
+
+private:
+    std::shared_ptr<Points::PointsOctree> octree;
+    std::vector<Points::PointsOctree::Chunk> chunks;
+    std::size_t pointBudget;
 };
 
 /**
@@ -35,6 +35,7 @@
 #include <TopoDS_Edge.hxx>
 #endif
 
+#include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -79,7 +80,12 @@ Sketch::Sketch()
       defaultSolver(GCS::DogLeg),
       defaultSolverRedundant(GCS::DogLeg),
       debugMode(GCS::Minimal)
-{}
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Sketcher/SolverAdvanced");
+    GCSsys.parallelSolving = hGrp->GetBool("ParallelSolving", false);
+    GCSsys.solverThreads = hGrp->GetInt("SolverThreadCount", 0);
+}
 
 Sketch::~Sketch()
 {
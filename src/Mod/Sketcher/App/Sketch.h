@@ -610,6 +610,19 @@ public:
     {
         return GCSsys.qrAlgorithm;
     }
+    inline void setParallelSolving(bool parallel, int threads = 0)
+    {
+        GCSsys.parallelSolving = parallel;
+        GCSsys.solverThreads = threads;
+    }
+    inline void setLinearSolver(GCS::LinearSolver solver)
+    {
+        GCSsys.linearSolver = solver;
+    }
+    inline GCS::LinearSolver getLinearSolver()
+    {
+        return GCSsys.linearSolver;
+    }
     inline void setQRPivotThreshold(double val)
     {
         GCSsys.qrpivotThreshold = val;
@@ -0,0 +1,320 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <cmath>
+
+#include "ConstraintBatch.h"
+
+
+namespace GCS
+{
+
+namespace
+{
+// number of parameters of the supported constraint types, in the order they are grouped
+struct GroupType
+{
+    ConstraintType type;
+    int slots;
+};
+const GroupType groupTypes[] = {
+    {P2PDistance, 5},
+    {PointOnLine, 6},
+    {TangentCircumf, 6},
+    {Equal, 2},
+};
+}// namespace
+
+ConstraintBatch::ConstraintBatch(std::vector<Constraint*>& clist,
+                                 const MAP_pD_pD& pmap,
+                                 VEC_D& pvals)
+    : count(0)
+{
+    std::vector<bool> batched(clist.size(), false);
+    for (const GroupType& type : groupTypes) {
+        Group g;
+        g.type = type.type;
+        g.slots = type.slots;
+        for (int row = 0; row < int(clist.size()); ++row) {
+            Constraint* constr = clist[row];
+            if (constr->getTypeId() != g.type)
+                continue;
+            batched[row] = true;
+            g.constrs.push_back(constr);
+            g.rows.push_back(row);
+            double data = 0.;
+            if (g.type == Equal)
+                data = static_cast<ConstraintEqual*>(constr)->getRatio();
+            else if (g.type == TangentCircumf)
+                data = static_cast<ConstraintTangentCircumf*>(constr)->getInternal() ? 1. : 0.;
+            g.data.push_back(data);
+        }
+        int n = g.size();
+        if (n == 0)
+            continue;
+        count += n;
+
+        // the constraints point to their original parameters, redirect them the same way as
+        // Constraint::redirectParams() does
+        g.params.resize(g.slots * n);
+        std::vector<int> columns(g.slots * n);
+        for (int i = 0; i < n; ++i) {
+            VEC_pD params = g.constrs[i]->params();
+            for (int k = 0; k < g.slots; ++k) {
+                double* param = params[k];
+                int column = -1;
+                MAP_pD_pD::const_iterator it = pmap.find(param);
+                if (it != pmap.end()) {
+                    param = it->second;
+                    column = int(param - pvals.data());
+                }
+                g.params[k * n + i] = param;
+                columns[k * n + i] = column;
+            }
+        }
+        // one entry per distinct column of each constraint, with all the slots contributing to
+        // it, so that the derivatives are summed in the same order as in grad()
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < g.slots; ++k) {
+                int column = columns[k * n + i];
+                bool seen = false;
+                for (int j = 0; j < k && !seen; ++j)
+                    seen = (columns[j * n + i] == column);
+                if (column < 0 || seen)
+                    continue;
+                Entry e {i, column, 0};
+                for (int j = k; j < g.slots; ++j) {
+                    if (columns[j * n + i] == column)
+                        e.slots |= 1 << j;
+                }
+                g.entries.push_back(e);
+            }
+        }
+        g.values.resize(g.slots * n);
+        g.derivs.resize(g.slots * n);
+        g.scales.resize(n);
+        g.errors.resize(n);
+        groups.push_back(std::move(g));
+    }
+    for (int row = 0; row < int(clist.size()); ++row) {
+        if (!batched[row])
+            others.push_back(row);
+    }
+    updateScales();
+}
+
+void ConstraintBatch::updateScales()
+{
+    for (Group& g : groups) {
+        for (int i = 0; i < g.size(); ++i)
+            g.scales[i] = g.constrs[i]->getScale();
+    }
+}
+
+void ConstraintBatch::gather(Group& g)
+{
+    const int n = g.size();
+    double* const* params = g.params.data();
+    double* values = g.values.data();
+    for (int j = 0; j < g.slots * n; ++j)
+        values[j] = *params[j];
+}
+
+void ConstraintBatch::calcErrors(Group& g)
+{
+    const int n = g.size();
+    const double* v = g.values.data();
+    const double* scale = g.scales.data();
+    const double* data = g.data.data();
+    double* err = g.errors.data();
+
+    switch (g.type) {
+        case P2PDistance: {
+            const double *p1x = v, *p1y = v + n, *p2x = v + 2 * n, *p2y = v + 3 * n;
+            const double* dist = v + 4 * n;
+            for (int i = 0; i < n; ++i) {
+                double dx = (p1x[i] - p2x[i]);
+                double dy = (p1y[i] - p2y[i]);
+                double d = sqrt(dx * dx + dy * dy);
+                err[i] = scale[i] * (d - dist[i]);
+            }
+        } break;
+        case PointOnLine: {
+            const double *p0x = v, *p0y = v + n, *p1x = v + 2 * n, *p1y = v + 3 * n;
+            const double *p2x = v + 4 * n, *p2y = v + 5 * n;
+            for (int i = 0; i < n; ++i) {
+                double x0 = p0x[i], x1 = p1x[i], x2 = p2x[i];
+                double y0 = p0y[i], y1 = p1y[i], y2 = p2y[i];
+                double dx = x2 - x1;
+                double dy = y2 - y1;
+                double d = sqrt(dx * dx + dy * dy);
+                double area = -x0 * dy + y0 * dx + x1 * y2 - x2 * y1;
+                err[i] = scale[i] * area / d;
+            }
+        } break;
+        case TangentCircumf: {
+            const double *c1x = v, *c1y = v + n, *c2x = v + 2 * n, *c2y = v + 3 * n;
+            const double *r1 = v + 4 * n, *r2 = v + 5 * n;
+            for (int i = 0; i < n; ++i) {
+                double dx = (c1x[i] - c2x[i]);
+                double dy = (c1y[i] - c2y[i]);
+                double r = data[i] != 0. ? std::abs(r1[i] - r2[i]) : (r1[i] + r2[i]);
+                err[i] = scale[i] * (sqrt(dx * dx + dy * dy) - r);
+            }
+        } break;
+        case Equal: {
+            const double *p1 = v, *p2 = v + n;
+            for (int i = 0; i < n; ++i)
+                err[i] = scale[i] * (p1[i] - data[i] * (p2[i]));
+        } break;
+        default:
+            break;
+    }
+}
+
+void ConstraintBatch::calcDerivs(Group& g)
+{
+    const int n = g.size();
+    const double* v = g.values.data();
+    const double* data = g.data.data();
+    double* dv = g.derivs.data();
+
+    switch (g.type) {
+        case P2PDistance: {
+            const double *p1x = v, *p1y = v + n, *p2x = v + 2 * n, *p2y = v + 3 * n;
+            for (int i = 0; i < n; ++i) {
+                double dx = (p1x[i] - p2x[i]);
+                double dy = (p1y[i] - p2y[i]);
+                double d = sqrt(dx * dx + dy * dy);
+                dv[i] = dx / d;
+                dv[n + i] = dy / d;
+                dv[2 * n + i] = -dx / d;
+                dv[3 * n + i] = -dy / d;
+                dv[4 * n + i] = -1.;
+            }
+        } break;
+        case PointOnLine: {
+            const double *p0x = v, *p0y = v + n, *p1x = v + 2 * n, *p1y = v + 3 * n;
+            const double *p2x = v + 4 * n, *p2y = v + 5 * n;
+            for (int i = 0; i < n; ++i) {
+                double x0 = p0x[i], x1 = p1x[i], x2 = p2x[i];
+                double y0 = p0y[i], y1 = p1y[i], y2 = p2y[i];
+                double dx = x2 - x1;
+                double dy = y2 - y1;
+                double d2 = dx * dx + dy * dy;
+                double d = sqrt(d2);
+                double area = -x0 * dy + y0 * dx + x1 * y2 - x2 * y1;
+                dv[i] = (y1 - y2) / d;
+                dv[n + i] = (x2 - x1) / d;
+                dv[2 * n + i] = ((y2 - y0) * d + (dx / d) * area) / d2;
+                dv[3 * n + i] = ((x0 - x2) * d + (dy / d) * area) / d2;
+                dv[4 * n + i] = ((y0 - y1) * d - (dx / d) * area) / d2;
+                dv[5 * n + i] = ((x1 - x0) * d - (dy / d) * area) / d2;
+            }
+        } break;
+        case TangentCircumf: {
+            const double *c1x = v, *c1y = v + n, *c2x = v + 2 * n, *c2y = v + 3 * n;
+            const double *r1 = v + 4 * n, *r2 = v + 5 * n;
+            for (int i = 0; i < n; ++i) {
+                double dx = (c1x[i] - c2x[i]);
+                double dy = (c1y[i] - c2y[i]);
+                double d = sqrt(dx * dx + dy * dy);
+                dv[i] = dx / d;
+                dv[n + i] = dy / d;
+                dv[2 * n + i] = -dx / d;
+                dv[3 * n + i] = -dy / d;
+                if (data[i] != 0.) {
+                    dv[4 * n + i] = (r1[i] > r2[i]) ? -1 : 1;
+                    dv[5 * n + i] = (r1[i] > r2[i]) ? 1 : -1;
+                }
+                else {
+                    dv[4 * n + i] = -1;
+                    dv[5 * n + i] = -1;
+                }
+            }
+        } break;
+        case Equal: {
+            for (int i = 0; i < n; ++i) {
+                dv[i] = 1.;
+                dv[n + i] = -1.;
+            }
+        } break;
+        default:
+            break;
+    }
+}
+
+double ConstraintBatch::entryValue(const Group& g, const Entry& e) const
+{
+    // same accumulation as in grad(), the parameter may appear in several slots
+    const int n = g.size();
+    double deriv = 0.;
+    for (int k = 0; k < g.slots; ++k) {
+        if (e.slots & (1 << k))
+            deriv += g.derivs[k * n + e.index];
+    }
+    return g.scales[e.index] * deriv;
+}
+
+void ConstraintBatch::calcResidual(Eigen::VectorXd& r)
+{
+    for (Group& g : groups) {
+        gather(g);
+        calcErrors(g);
+        for (int i = 0; i < g.size(); ++i)
+            r[g.rows[i]] = g.errors[i];
+    }
+}
+
+void ConstraintBatch::calcJacobi(Eigen::MatrixXd& jacobi)
+{
+    for (Group& g : groups) {
+        gather(g);
+        calcDerivs(g);
+        for (const Entry& e : g.entries)
+            jacobi(g.rows[e.index], e.column) = entryValue(g, e);
+    }
+}
+
+void ConstraintBatch::calcJacobi(std::vector<Eigen::Triplet<double>>& triplets)
+{
+    for (Group& g : groups) {
+        gather(g);
+        calcDerivs(g);
+        for (const Entry& e : g.entries)
+            triplets.emplace_back(g.rows[e.index], e.column, entryValue(g, e));
+    }
+}
+
+void ConstraintBatch::calcJacobi(double* values, const std::vector<int>& positions)
+{
+    std::vector<int>::const_iterator position = positions.begin();
+    for (Group& g : groups) {
+        gather(g);
+        calcDerivs(g);
+        for (const Entry& e : g.entries)
+            values[*position++] = entryValue(g, e);
+    }
+}
+
+}// namespace GCS
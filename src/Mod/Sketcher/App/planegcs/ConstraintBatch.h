@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/****************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PLANEGCS_CONSTRAINTBATCH_H
+#define PLANEGCS_CONSTRAINTBATCH_H
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+#include "Constraints.h"
+
+
+namespace GCS
+{
+
+// Batched evaluation of the errors and gradients of the most common constraint types
+//
+// The constraints of a subsystem are grouped by type into structure of arrays buffers. On each
+// evaluation the parameters are gathered into contiguous arrays, and the errors and derivatives
+// of a whole group are computed in plain loops without virtual calls and without comparing
+// parameter pointers. The formulas and the order of the floating point operations are the same
+// as in error() and grad() of the constraints, so the results are identical to the per
+// constraint evaluation.
+class ConstraintBatch
+{
+public:
+    // pmap redirects the constraint parameters to pvals, whose indices are the columns of the
+    // jacobi. The constraints must point to their original parameters.
+    ConstraintBatch(std::vector<Constraint*>& clist, const MAP_pD_pD& pmap, VEC_D& pvals);
+
+    // rows of the constraints of the subsystem not evaluated by the batch
+    const std::vector<int>& otherRows() const
+    {
+        return others;
+    }
+    int size() const
+    {
+        return count;
+    }
+
+    // Read the scales of the constraints, must be called after rescaling them
+    void updateScales();
+
+    // Only the rows of the batched constraints are set
+    void calcResidual(Eigen::VectorXd& r);
+    // The jacobi must be sized and zeroed
+    void calcJacobi(Eigen::MatrixXd& jacobi);
+    // The triplets are always appended in the same order, the values can be then updated
+    // in place given the position of each triplet in the values array of the sparse jacobi
+    void calcJacobi(std::vector<Eigen::Triplet<double>>& triplets);
+    void calcJacobi(double* values, const std::vector<int>& positions);
+
+private:
+    struct Entry
+    {
+        int index; // constraint index within the group
+        int column;// column of the jacobi
+        int slots; // bit mask of the parameter slots redirected to the column
+    };
+
+    struct Group
+    {
+        ConstraintType type;
+        int slots;// number of parameters of each constraint
+        std::vector<Constraint*> constrs;
+        std::vector<int> rows;
+        std::vector<double> data;// ratio of Equal, 1 for internal TangentCircumf
+        std::vector<Entry> entries;
+        // slot major arrays, the entry of slot k of constraint i is at [k * size() + i]
+        std::vector<double*> params;
+        std::vector<double> values;
+        std::vector<double> derivs;// derivatives without scale
+        std::vector<double> scales;
+        std::vector<double> errors;
+
+        int size() const
+        {
+            return static_cast<int>(rows.size());
+        }
+    };
+
+    void gather(Group& g);
+    void calcErrors(Group& g);
+    void calcDerivs(Group& g);
+    double entryValue(const Group& g, const Entry& e) const;
+
+private:
+    std::vector<Group> groups;
+    std::vector<int> others;
+    int count;
+};
+
+}// namespace GCS
+
+#endif// PLANEGCS_CONSTRAINTBATCH_H
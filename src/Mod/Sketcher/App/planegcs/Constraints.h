@@ -163,6 +163,11 @@ public:
         return internalAlignment;
     }
 
+    double getScale() const
+    {
+        return scale;
+    }
+
     virtual ConstraintType getTypeId();
     virtual void rescale(double coef = 1.);
     virtual double error();
@@ -192,6 +197,10 @@ private:
 
 public:
     ConstraintEqual(double* p1, double* p2, double p1p2ratio = 1.0);
+    double getRatio() const
+    {
+        return ratio;
+    }
     ConstraintType getTypeId() override;
     void rescale(double coef = 1.) override;
     double error() override;
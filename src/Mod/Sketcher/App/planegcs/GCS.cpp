@@ -54,6 +54,7 @@
 #include <future>
 #include <iostream>
 #include <limits>
+#include <thread>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -460,6 +461,7 @@ System::System()
       hasDiagnosis(false),
       isInit(false),
       emptyDiagnoseMatrix(true),
+      iterations(0),
       maxIter(100),
       maxIterRedundant(100),
       sketchSizeMultiplier(false),
@@ -468,6 +470,10 @@ System::System()
       convergenceRedundant(1e-10),
       qrAlgorithm(EigenSparseQR),
       dogLegGaussStep(FullPivLU),
+      linearSolver(DenseSolver),
+      parallelSolving(false),
+      solverThreads(0),
+      batchedConstraints(true),
       qrpivotThreshold(1E-13),
       debugMode(Minimal),
       LM_eps(1E-10),
@@ -1724,15 +1730,37 @@ void System::initSolution(Algorithm alg)
 
         subSystems.push_back(nullptr);
         subSystemsAux.push_back(nullptr);
-        if (!clist0.empty())
+        if (!clist0.empty()) {
             subSystems[cid] = new SubSystem(clist0, plists[cid], reductionmaps[cid]);
-        if (!clist1.empty())
+            subSystems[cid]->setBatched(batchedConstraints);
+        }
+        if (!clist1.empty()) {
             subSystemsAux[cid] = new SubSystem(clist1, plists[cid], reductionmaps[cid]);
+            subSystemsAux[cid]->setBatched(batchedConstraints);
+        }
     }
+    componentSolutions.assign(subSystems.size(), ComponentSolution());
 
     isInit = true;
 }
 
+void System::getComponentInput(int cid, VEC_D& input)
+{
+    input.clear();
+    for (VEC_pD::const_iterator param = plists[cid].begin(); param != plists[cid].end(); ++param)
+        input.push_back(**param);
+    for (std::vector<Constraint*>::const_iterator constr = clists[cid].begin();
+         constr != clists[cid].end();
+         ++constr) {
+        std::map<Constraint*, VEC_pD>::const_iterator it = c2p.find(*constr);
+        if (it == c2p.end())
+            continue;
+        for (VEC_pD::const_iterator param = it->second.begin(); param != it->second.end();
+             ++param)
+            input.push_back(**param);
+    }
+}
+
 void System::setReference()
 {
     reference.clear();
@@ -1764,21 +1792,82 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
         return Failed;
 
     bool isReset = false;
+    iterations = 0;
     // return success by default in order to permit coincidence constraints to be applied
     // even if no other system has to be solved
     int res = Success;
+
+    // Skip the components that are unchanged since they last converged, e.g. the clusters not
+    // affected by a dragged point, and only restore their solution.
+    std::vector<int> pending;
+    std::vector<VEC_D> inputs(subSystems.size());
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
+        if (!subSystems[cid] && !subSystemsAux[cid])
+            continue;
+        if (!isReset) {
             resetToReference();
             isReset = true;
         }
+        getComponentInput(cid, inputs[cid]);
+        ComponentSolution& cached = componentSolutions[cid];
+        if (cached.valid && cached.isRedundantsolving == isRedundantsolving
+            && cached.isFine == isFine && cached.alg == alg && cached.input == inputs[cid]) {
+            if (subSystems[cid])
+                subSystems[cid]->setParams(cached.x);
+            if (subSystemsAux[cid])
+                subSystemsAux[cid]->setParams(cached.xAux);
+            continue;
+        }
+        cached.valid = false;
+        pending.push_back(cid);
+    }
+
+    // The components share no parameters, so they can be solved concurrently
+    std::vector<int> results(subSystems.size(), Success);
+    auto solveComponent = [&](int cid) {
         if (subSystems[cid] && subSystemsAux[cid])
-            res = std::max(res,
-                           solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
+            results[cid] = solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving);
         else if (subSystems[cid])
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
-        else if (subSystemsAux[cid])
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+            results[cid] = solve(subSystems[cid], isFine, alg, isRedundantsolving);
+        else
+            results[cid] = solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
+    };
+
+    int threads = solverThreads > 0 ? solverThreads : int(std::thread::hardware_concurrency());
+    threads = std::min(threads, int(pending.size()));
+    // per iteration logging is not meant to be interleaved
+    if (parallelSolving && debugMode != IterationLevel && threads > 1) {
+        std::atomic<std::size_t> next(0);
+        auto worker = [&]() {
+            for (std::size_t i = next++; i < pending.size(); i = next++)
+                solveComponent(pending[i]);
+        };
+        std::vector<std::future<void>> futures;
+        for (int i = 1; i < threads; ++i)
+            futures.push_back(std::async(std::launch::async, worker));
+        worker();
+        for (std::future<void>& future : futures)
+            future.get();
+    }
+    else {
+        for (int cid : pending)
+            solveComponent(cid);
+    }
+
+    for (int cid : pending) {
+        res = std::max(res, results[cid]);
+        if (results[cid] != Success)
+            continue;
+        ComponentSolution& cached = componentSolutions[cid];
+        cached.valid = true;
+        cached.isRedundantsolving = isRedundantsolving;
+        cached.isFine = isFine;
+        cached.alg = alg;
+        cached.input = std::move(inputs[cid]);
+        if (subSystems[cid])
+            subSystems[cid]->getParams(cached.x);
+        if (subSystemsAux[cid])
+            subSystemsAux[cid]->getParams(cached.xAux);
     }
     if (res == Success) {
         for (std::set<Constraint*>::const_iterator constr = redundant.begin();
@@ -1943,10 +2032,22 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd e(csize),
         e_new(csize);// vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);// Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    Eigen::MatrixXd J;// Jacobi of the subsystem, sized by calcJacobi
+    Eigen::MatrixXd A;
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
 
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    bool sparse = (linearSolver == SparseSolver);
+    Eigen::SparseMatrix<double> Jsp, Asp, Asp_aug, Isp;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt;
+    if (sparse) {
+        Isp.resize(xsize, xsize);
+        Isp.setIdentity();
+    }
+#else
+    bool sparse = false;
+#endif
+
     subsys->redirectParams();
 
     subsys->getParams(x);
@@ -1990,15 +2091,27 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         }
 
         // J^T J, J^T e
-        subsys->calcJacobi(J);
-        ;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse) {
+            subsys->calcJacobi(Jsp);
+
+            Asp = Jsp.transpose() * Jsp;
+            g = Jsp.transpose() * e;
+            diag_A = Asp.diagonal();
+        }
+        else
+#endif
+        {
+            subsys->calcJacobi(J);
 
-        A = J.transpose() * J;
-        g = J.transpose() * e;
+            A = J.transpose() * J;
+            g = J.transpose() * e;
+            diag_A = A.diagonal();// save diagonal entries so that augmentation can be later
+                                  // canceled
+        }
 
         // Compute ||J^T e||_inf
         double g_inf = g.lpNorm<Eigen::Infinity>();
-        diag_A = A.diagonal();// save diagonal entries so that augmentation can be later canceled
 
         // check for convergence
         if (g_inf <= eps1) {
@@ -2014,13 +2127,37 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         // determine increment using adaptive damping
         int k = 0;
         while (k < 50) {
-            // augment normal equations A = A+uI
-            for (int i = 0; i < xsize; ++i)
-                A(i, i) += mu;
-
-            // solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
-            double rel_error = (A * h - g).norm() / g.norm();
+            double rel_error;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (sparse) {
+                // augment normal equations A = A+uI
+                Asp_aug = Asp + mu * Isp;
+
+                // The sparsity pattern does not change during the solving, so the
+                // symbolic analysis is only done once.
+                if (iter == 0 && k == 0)
+                    ldlt.analyzePattern(Asp_aug);
+                ldlt.factorize(Asp_aug);
+
+                // solve augmented functions A*h=-g
+                if (ldlt.info() == Eigen::Success) {
+                    h = ldlt.solve(g);
+                    rel_error = (Asp_aug * h - g).norm() / g.norm();
+                }
+                else
+                    rel_error = std::numeric_limits<double>::infinity();
+            }
+            else
+#endif
+            {
+                // augment normal equations A = A+uI
+                for (int i = 0; i < xsize; ++i)
+                    A(i, i) += mu;
+
+                // solve augmented functions A*h=-g
+                h = A.fullPivLu().solve(g);
+                rel_error = (A * h - g).norm() / g.norm();
+            }
 
             // check if solving works
             if (rel_error < 1e-5) {
@@ -2068,8 +2205,10 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
             mu *= nu;
             nu *= 2.0;
-            for (int i = 0; i < xsize; ++i)// restore diagonal J^T J entries
-                A(i, i) = diag_A(i);
+            if (!sparse) {
+                for (int i = 0; i < xsize; ++i)// restore diagonal J^T J entries
+                    A(i, i) = diag_A(i);
+            }
 
             k++;
         }
@@ -2092,6 +2231,8 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
     if (iter >= maxIterNumber)
         stop = 5;
 
+    iterations += iter;
+
     subsys->revertParams();
 
     return (stop == 1) ? Success : Failed;
@@ -2128,6 +2269,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
                        ? "FullPivLU"
                        : (dogLegGaussStep == LeastNormFullPivLU ? "LeastNormFullPivLU"
                                                                 : "LeastNormLdlt"))
+               << ", linearSolver: " << (linearSolver == SparseSolver ? "Sparse" : "Dense")
                << ", xsize: " << xsize << ", csize: " << csize << ", maxIter: " << maxIterNumber
                << "\n";
 
@@ -2137,17 +2279,48 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    Eigen::MatrixXd Jx, Jx_new;// sized by calcJacobi, unused by the sparse solver
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    bool sparse = (linearSolver == SparseSolver);
+    Eigen::SparseMatrix<double> Jsp, Jsp_new;
+    Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> sqr;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt;
+    bool analyzed = false;
+#else
+    bool sparse = false;
+#endif
+
+    // products with the dense or sparse jacobi
+    auto jacobiTimes = [&](const Eigen::VectorXd& v) -> Eigen::VectorXd {
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse)
+            return Jsp * v;
+#endif
+        return Jx * v;
+    };
+    auto jacobiTransposeTimes = [&](const Eigen::VectorXd& v) -> Eigen::VectorXd {
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse)
+            return Jsp.transpose() * v;
+#endif
+        return Jx.transpose() * v;
+    };
+
     subsys->redirectParams();
 
     double err;
     subsys->getParams(x);
     subsys->calcResidual(fx, err);
-    subsys->calcJacobi(Jx);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    if (sparse)
+        subsys->calcJacobi(Jsp);
+    else
+#endif
+        subsys->calcJacobi(Jx);
 
-    g = Jx.transpose() * (-fx);
+    g = jacobiTransposeTimes(-fx);
 
     // get the infinity norm fx_inf and g_inf
     double g_inf = g.lpNorm<Eigen::Infinity>();
@@ -2175,25 +2348,51 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         }
         else {
             // get the steepest descent direction
-            alpha = g.squaredNorm() / (Jx * g).squaredNorm();
+            alpha = g.squaredNorm() / jacobiTimes(g).squaredNorm();
             h_sd = alpha * g;
 
             // get the gauss-newton step
             // http://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
             // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
-            switch (dogLegGaussStep) {
-                case FullPivLU:
-                    h_gn = Jx.fullPivLu().solve(-fx);
-                    break;
-                case LeastNormFullPivLU:
-                    h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
-                    break;
-                case LeastNormLdlt:
-                    h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
-                    break;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (sparse) {
+                // Least norm solution J^T (J J^T)^-1 (-fx). The sparsity pattern does not
+                // change during the solving, so the symbolic analysis is only done once.
+                // SparseQR is rank revealing but much slower, so it is only used if the
+                // Cholesky factorization fails on a rank deficient jacobi.
+                Eigen::SparseMatrix<double> JJt = Jsp * Jsp.transpose();
+                if (!analyzed) {
+                    ldlt.analyzePattern(JJt);
+                    analyzed = true;
+                }
+                ldlt.factorize(JJt);
+                bool solved = false;
+                if (ldlt.info() == Eigen::Success) {
+                    h_gn = Jsp.transpose() * ldlt.solve(-fx);
+                    solved = h_gn.allFinite();
+                }
+                if (!solved) {
+                    sqr.compute(Jsp);
+                    h_gn = sqr.solve(-fx);
+                }
+            }
+            else
+#endif
+            {
+                switch (dogLegGaussStep) {
+                    case FullPivLU:
+                        h_gn = Jx.fullPivLu().solve(-fx);
+                        break;
+                    case LeastNormFullPivLU:
+                        h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
+                        break;
+                    case LeastNormLdlt:
+                        h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
+                        break;
+                }
             }
 
-            double rel_error = (Jx * h_gn + fx).norm() / fx.norm();
+            double rel_error = (jacobiTimes(h_gn) + fx).norm() / fx.norm();
             if (rel_error > 1e15)
                 break;
 
@@ -2241,20 +2440,30 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         x_new = x + h_dl;
         subsys->setParams(x_new);
         subsys->calcResidual(fx_new, err_new);
-        subsys->calcJacobi(Jx_new);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse)
+            subsys->calcJacobi(Jsp_new);
+        else
+#endif
+            subsys->calcJacobi(Jx_new);
 
         // calculate the linear model and the update ratio
-        double dL = err - 0.5 * (fx + Jx * h_dl).squaredNorm();
+        double dL = err - 0.5 * (fx + jacobiTimes(h_dl)).squaredNorm();
         double dF = err - err_new;
         double rho = dL / dF;
 
         if (dF > 0 && dL > 0) {
             x = x_new;
-            Jx = Jx_new;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (sparse)
+                Jsp.swap(Jsp_new);
+            else
+#endif
+                Jx = Jx_new;
             fx = fx_new;
             err = err_new;
 
-            g = Jx.transpose() * (-fx);
+            g = jacobiTransposeTimes(-fx);
 
             // get infinity norms
             g_inf = g.lpNorm<Eigen::Infinity>();
@@ -2292,6 +2501,8 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         iter++;
     }
 
+    iterations += iter;
+
     subsys->revertParams();
 
     if (debugMode == IterationLevel) {
@@ -5519,6 +5730,7 @@ void System::clearSubSystems()
     free(subSystemsAux);
     subSystems.clear();
     subSystemsAux.clear();
+    componentSolutions.clear();
 }
 
 double lineSearch(SubSystem* subsys, Eigen::VectorXd& xdir)
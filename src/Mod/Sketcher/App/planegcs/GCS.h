@@ -23,6 +23,8 @@
 #ifndef PLANEGCS_GCS_H
 #define PLANEGCS_GCS_H
 
+#include <atomic>
+
 #include <Eigen/QR>
 
 #include "../../SketcherGlobal.h"
@@ -78,6 +80,18 @@ enum QRAlgorithm
     EigenSparseQR = 1
 };
 
+// Matrix representation of the Jacobian used by the DogLeg and LevenbergMarquardt solvers.
+// SparseSolver assembles a sparse Jacobian from the constraint parameter lists and solves the
+// linear systems with sparse factorizations, which is much faster for large sketches where each
+// constraint only involves few parameters. DogLeg then always takes the least norm Gauss step
+// (SimplicialLDLT, falling back to SparseQR for rank deficient systems) regardless of
+// dogLegGaussStep.
+enum LinearSolver
+{
+    DenseSolver = 0,
+    SparseSolver = 1
+};
+
 enum DebugMode
 {
     NoDebug = 0,
@@ -143,6 +157,24 @@ private:
 
     bool emptyDiagnoseMatrix;// false only if there is at least one driving constraint.
 
+    std::atomic<int> iterations;// iterations of the LM/DL solvers spent in the last solve()
+
+    // Converged solution of a decoupled component. It is reused by solve() as long as the
+    // values of the component parameters and of all parameters of its constraints (e.g.
+    // dimensions, positions of dragged points) are the same as when it was solved, and it is
+    // solved with the same algorithm and tolerance.
+    struct ComponentSolution
+    {
+        bool valid = false;
+        bool isRedundantsolving = false;
+        bool isFine = true;
+        Algorithm alg = DogLeg;
+        VEC_D input;
+        Eigen::VectorXd x, xAux;// solutions of subSystems[cid] and subSystemsAux[cid]
+    };
+    std::vector<ComponentSolution> componentSolutions;
+    void getComponentInput(int cid, VEC_D& input);
+
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
@@ -205,6 +237,10 @@ public:
     double convergenceRedundant;
     QRAlgorithm qrAlgorithm;
     DogLegGaussStep dogLegGaussStep;
+    LinearSolver linearSolver;
+    bool parallelSolving;// solve decoupled components concurrently
+    int solverThreads;   // maximum threads used by parallelSolving, 0 for hardware concurrency
+    bool batchedConstraints;// evaluate the common constraint types in batches
     double qrpivotThreshold;
     DebugMode debugMode;
     double LM_eps;
@@ -464,6 +500,10 @@ protected:
             return constraint->getTag() == tagID;
         });
     }
+    int _getIterationCount() const
+    {
+        return iterations;
+    }
 };
 
 
@@ -20,6 +20,7 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 
@@ -31,14 +32,16 @@ namespace GCS
 
 // SubSystem
 SubSystem::SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params)
-    : clist(clist_)
+    : clist(clist_),
+      redirected(false)
 {
     MAP_pD_pD dummymap;
     initialize(params, dummymap);
 }
 
 SubSystem::SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params, MAP_pD_pD& reductionmap)
-    : clist(clist_)
+    : clist(clist_),
+      redirected(false)
 {
     initialize(params, reductionmap);
 }
@@ -128,6 +131,21 @@ void SubSystem::initialize(VEC_pD& params, MAP_pD_pD& reductionmap)
     }
 }
 
+void SubSystem::setBatched(bool enable)
+{
+    batch.reset();
+    if (enable) {
+        // the batch redirects the original parameters of the constraints by itself
+        if (redirected)
+            revertParams();
+        batch.reset(new ConstraintBatch(clist, pmap, pvals));
+        if (batch->size() == 0)
+            batch.reset();
+    }
+    jacobiOuter.clear();
+    jacobiInner.clear();
+}
+
 void SubSystem::redirectParams()
 {
     // copying values to pvals
@@ -140,12 +158,16 @@ void SubSystem::redirectParams()
         (*constr)->revertParams();// this line will normally not be necessary
         (*constr)->redirectParams(pmap);
     }
+    redirected = true;
+    if (batch)
+        batch->updateScales();
 }
 
 void SubSystem::revertParams()
 {
     for (std::vector<Constraint*>::iterator constr = clist.begin(); constr != clist.end(); ++constr)
         (*constr)->revertParams();
+    redirected = false;
 }
 
 void SubSystem::getParamMap(MAP_pD_pD& pmapOut)
@@ -217,6 +239,13 @@ void SubSystem::calcResidual(Eigen::VectorXd& r)
 {
     assert(r.size() == csize);
 
+    if (useBatch()) {
+        batch->calcResidual(r);
+        for (int i : batch->otherRows())
+            r[i] = clist[i]->error();
+        return;
+    }
+
     int i = 0;
     for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
          ++constr, i++) {
@@ -228,6 +257,15 @@ void SubSystem::calcResidual(Eigen::VectorXd& r, double& err)
 {
     assert(r.size() == csize);
 
+    if (useBatch()) {
+        calcResidual(r);
+        err = 0.;
+        for (int i = 0; i < csize; i++)
+            err += r[i] * r[i];
+        err *= 0.5;
+        return;
+    }
+
     int i = 0;
     err = 0.;
     for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
@@ -267,7 +305,87 @@ void SubSystem::calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi)
 
 void SubSystem::calcJacobi(Eigen::MatrixXd& jacobi)
 {
-    calcJacobi(plist, jacobi);
+    if (!useBatch()) {
+        calcJacobi(plist, jacobi);
+        return;
+    }
+
+    // plist[j] is redirected to pvals[j]
+    jacobi.setZero(csize, psize);
+    batch->calcJacobi(jacobi);
+    for (int i : batch->otherRows()) {
+        for (int j = 0; j < psize; j++)
+            jacobi(i, j) = clist[i]->grad(&pvals[j]);
+    }
+}
+
+bool SubSystem::hasJacobiPattern(const Eigen::SparseMatrix<double>& jacobi) const
+{
+    return jacobi.isCompressed() && jacobi.rows() == csize && jacobi.cols() == psize
+        && jacobi.nonZeros() == int(jacobiInner.size()) && !jacobiInner.empty()
+        && std::equal(jacobiOuter.begin(), jacobiOuter.end(), jacobi.outerIndexPtr())
+        && std::equal(jacobiInner.begin(), jacobiInner.end(), jacobi.innerIndexPtr());
+}
+
+void SubSystem::calcJacobi(Eigen::SparseMatrix<double>& jacobi)
+{
+    // The sparsity pattern does not change, so with the batch the values of a jacobi computed
+    // before are updated in place
+    if (useBatch() && hasJacobiPattern(jacobi)) {
+        double* values = jacobi.valuePtr();
+        batch->calcJacobi(values, jacobiPositions);
+        for (std::vector<JacobiEntry>::const_iterator e = jacobiEntries.begin();
+             e != jacobiEntries.end();
+             ++e)
+            values[e->position] = e->constr->grad(e->param);
+        return;
+    }
+
+    // The constraint parameters in c2p point to pvals, whose indices are the
+    // column indices of the jacobi. All entries of the adjacency list are
+    // stored, even if the gradient is zero at the current point, so that the
+    // sparsity pattern stays the same during the whole solving process.
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(c2p.size() * 4);
+    std::vector<int> rows;
+    if (useBatch()) {
+        batch->calcJacobi(triplets);
+        rows = batch->otherRows();
+    }
+    else {
+        rows.resize(csize);
+        for (int i = 0; i < csize; i++)
+            rows[i] = i;
+    }
+    std::size_t batchSize = triplets.size();
+    for (int i : rows) {
+        std::map<Constraint*, VEC_pD>::const_iterator it = c2p.find(clist[i]);
+        if (it == c2p.end())
+            continue;
+        for (VEC_pD::const_iterator p = it->second.begin(); p != it->second.end(); ++p)
+            triplets.emplace_back(i, int(*p - pvals.data()), clist[i]->grad(*p));
+    }
+    jacobi.resize(csize, psize);
+    jacobi.setFromTriplets(triplets.begin(), triplets.end());
+    jacobi.makeCompressed();
+
+    if (useBatch()) {
+        // remember where each triplet is stored, there are no duplicated entries
+        jacobiOuter.assign(jacobi.outerIndexPtr(), jacobi.outerIndexPtr() + psize + 1);
+        jacobiInner.assign(jacobi.innerIndexPtr(), jacobi.innerIndexPtr() + jacobi.nonZeros());
+        jacobiPositions.clear();
+        jacobiEntries.clear();
+        for (std::size_t k = 0; k < triplets.size(); k++) {
+            const Eigen::Triplet<double>& t = triplets[k];
+            const int* first = jacobi.innerIndexPtr() + jacobi.outerIndexPtr()[t.col()];
+            const int* last = jacobi.innerIndexPtr() + jacobi.outerIndexPtr()[t.col() + 1];
+            int position = int(std::lower_bound(first, last, t.row()) - jacobi.innerIndexPtr());
+            if (k < batchSize)
+                jacobiPositions.push_back(position);
+            else
+                jacobiEntries.push_back({position, clist[t.row()], &pvals[t.col()]});
+        }
+    }
 }
 
 void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
@@ -27,7 +27,11 @@
 #undef max
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
+#include <memory>
+
+#include "ConstraintBatch.h"
 #include "Constraints.h"
 
 
@@ -45,6 +49,24 @@ private:
                    //        JacobianMatrix jacobi;  // jacobi matrix of the residuals
     std::map<Constraint*, VEC_pD> c2p;              // constraint to parameter adjacency list
     std::map<double*, std::vector<Constraint*>> p2c;// parameter to constraint adjacency list
+    std::unique_ptr<ConstraintBatch> batch;// batched evaluation of the common constraints
+    bool redirected;                        // the constraints point to pvals
+    // sparsity pattern of the last sparse jacobi computed with the batch, and the positions of
+    // its entries in the values array
+    struct JacobiEntry
+    {
+        int position;
+        Constraint* constr;
+        double* param;
+    };
+    std::vector<int> jacobiOuter, jacobiInner;
+    std::vector<int> jacobiPositions;// entries computed by the batch
+    std::vector<JacobiEntry> jacobiEntries;// entries of the other constraints
+    bool hasJacobiPattern(const Eigen::SparseMatrix<double>& jacobi) const;
+    bool useBatch() const
+    {
+        return batch && redirected;
+    }
     void initialize(VEC_pD& params, MAP_pD_pD& reductionmap);// called by the constructors
 public:
     SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params);
@@ -60,6 +82,14 @@ public:
         return csize;
     };
 
+    // Evaluate the residual and the jacobi of the supported constraint types in batches while
+    // the parameters are redirected
+    void setBatched(bool enable);
+    bool isBatched() const
+    {
+        return batch != nullptr;
+    }
+
     void redirectParams();
     void revertParams();
 
@@ -78,6 +108,9 @@ public:
     void calcResidual(Eigen::VectorXd& r, double& err);
     void calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi);
     void calcJacobi(Eigen::MatrixXd& jacobi);
+    // sparse jacobi of the subsystem parameters, only the entries of the parameters
+    // a constraint depends on are stored
+    void calcJacobi(Eigen::SparseMatrix<double>& jacobi);
     void calcGrad(VEC_pD& params, Eigen::VectorXd& grad);
     void calcGrad(Eigen::VectorXd& grad);
 
@@ -49,6 +49,7 @@
 #define DEFAULT_SOLVER_DEBUG 1      // None=0, Minimal=1, IterationLevel=2
 #define MAX_ITER_MULTIPLIER false
 #define DEFAULT_DOGLEG_GAUSS_STEP 0   // FullPivLU = 0, LeastNormFullPivLU = 1, LeastNormLdlt = 2
+#define DEFAULT_LINEAR_SOLVER 0     // Dense = 0, Sparse = 1
 
 using namespace SketcherGui;
 using namespace Gui::TaskView;
@@ -67,6 +68,7 @@ TaskSketcherSolverAdvanced::TaskSketcherSolverAdvanced(ViewProviderSketch *sketc
 
     ui->comboBoxDefaultSolver->onRestore();
     ui->comboBoxDogLegGaussStep->onRestore();
+    ui->comboBoxLinearSolver->onRestore();
     ui->spinBoxMaxIter->onRestore();
     ui->checkBoxSketchSizeMultiplier->onRestore();
     ui->lineEditConvergence->onRestore();
@@ -91,6 +93,8 @@ void TaskSketcherSolverAdvanced::setupConnections()
             this, &TaskSketcherSolverAdvanced::onComboBoxDefaultSolverCurrentIndexChanged);
     connect(ui->comboBoxDogLegGaussStep, qOverload<int>(&QComboBox::currentIndexChanged),
             this, &TaskSketcherSolverAdvanced::onComboBoxDogLegGaussStepCurrentIndexChanged);
+    connect(ui->comboBoxLinearSolver, qOverload<int>(&QComboBox::currentIndexChanged),
+            this, &TaskSketcherSolverAdvanced::onComboBoxLinearSolverCurrentIndexChanged);
     connect(ui->spinBoxMaxIter, qOverload<int>(&QSpinBox::valueChanged),
             this, &TaskSketcherSolverAdvanced::onSpinBoxMaxIterValueChanged);
     connect(ui->checkBoxSketchSizeMultiplier, &QCheckBox::stateChanged,
@@ -446,6 +450,12 @@ void TaskSketcherSolverAdvanced::onComboBoxDogLegGaussStepCurrentIndexChanged(in
     updateDefaultMethodParameters();
 }
 
+void TaskSketcherSolverAdvanced::onComboBoxLinearSolverCurrentIndexChanged(int index)
+{
+    ui->comboBoxLinearSolver->onSave();
+    const_cast<Sketcher::Sketch &>(sketchView->getSketchObject()->getSolvedSketch()).setLinearSolver((GCS::LinearSolver) index);
+}
+
 void TaskSketcherSolverAdvanced::onSpinBoxMaxIterValueChanged(int i)
 {
     ui->spinBoxMaxIter->onSave();
@@ -569,6 +579,7 @@ void TaskSketcherSolverAdvanced::onPushButtonDefaultsClicked(bool checked/* = fa
     // Set other settings
     hGrp->SetInt("DefaultSolver",DEFAULT_SOLVER);
     hGrp->SetInt("DogLegGaussStep",DEFAULT_DOGLEG_GAUSS_STEP);
+    hGrp->SetInt("LinearSolver",DEFAULT_LINEAR_SOLVER);
 
     hGrp->SetInt("RedundantDefaultSolver",DEFAULT_RSOLVER);
     hGrp->SetInt("MaxIter",MAX_ITER);
@@ -583,6 +594,7 @@ void TaskSketcherSolverAdvanced::onPushButtonDefaultsClicked(bool checked/* = fa
 
     ui->comboBoxDefaultSolver->onRestore();
     ui->comboBoxDogLegGaussStep->onRestore();
+    ui->comboBoxLinearSolver->onRestore();
     ui->spinBoxMaxIter->onRestore();
     ui->checkBoxSketchSizeMultiplier->onRestore();
     ui->lineEditConvergence->onRestore();
@@ -611,6 +623,7 @@ void TaskSketcherSolverAdvanced::updateSketchObject()
     const_cast<Sketcher::Sketch &>(sketchView->getSketchObject()->getSolvedSketch()).setMaxIter(ui->spinBoxMaxIter->value());
     const_cast<Sketcher::Sketch &>(sketchView->getSketchObject()->getSolvedSketch()).defaultSolver = static_cast<GCS::Algorithm>(ui->comboBoxDefaultSolver->currentIndex());
     const_cast<Sketcher::Sketch &>(sketchView->getSketchObject()->getSolvedSketch()).setDogLegGaussStep((GCS::DogLegGaussStep) ui->comboBoxDogLegGaussStep->currentIndex());
+    const_cast<Sketcher::Sketch &>(sketchView->getSketchObject()->getSolvedSketch()).setLinearSolver((GCS::LinearSolver) ui->comboBoxLinearSolver->currentIndex());
 
     updateDefaultMethodParameters();
     updateRedundantMethodParameters();
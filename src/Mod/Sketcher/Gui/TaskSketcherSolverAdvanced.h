@@ -48,6 +48,7 @@ private:
     void setupConnections();
     void onComboBoxDefaultSolverCurrentIndexChanged(int index);
     void onComboBoxDogLegGaussStepCurrentIndexChanged(int index);
+    void onComboBoxLinearSolverCurrentIndexChanged(int index);
     void onSpinBoxMaxIterValueChanged(int i);
     void onCheckBoxSketchSizeMultiplierStateChanged(int state);
     void onLineEditConvergenceEditingFinished();
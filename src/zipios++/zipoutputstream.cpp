@@ -59,6 +59,11 @@ void ZipOutputStream::putNextEntry( const ZipCDirEntry &entry ) {
   ozf->putNextEntry( entry ) ;
 }
 
+void ZipOutputStream::putRawEntry( const ZipCDirEntry &entry,
+                                   const char *data, std::streamsize size ) {
+  ozf->putRawEntry( entry, data, size ) ;
+}
+
 void ZipOutputStream::putNextEntry(const std::string& entryName) {
   putNextEntry( ZipCDirEntry(entryName));
 }
@@ -10,6 +10,9 @@
 #include "ziphead.h"
 #include "zipoutputstreambuf.h"
 
+// Indicates the availability of ZipOutputStream::putRawEntry()
+#define ZIPIOS_HAS_RAW_ENTRY
+
 namespace zipios {
 
 /** \anchor ZipOutputStream_anchor
@@ -49,6 +52,10 @@ public:
   */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes a complete entry with already compressed data.
+      \see ZipOutputStreambuf::putRawEntry() */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data, std::streamsize size ) ;
+
   /** \anchor ZipOutputStream_putnextentry2_anchor
       Begins writing the next entry.
   */
@@ -49,6 +49,15 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes a complete entry with data that has already been compressed
+      (or is stored) by the caller. The size, compressed size, crc and
+      storage method of the entry must be set. The entry data is written
+      as is and the entry is closed afterwards.
+      @param entry the entry header information.
+      @param data the compressed entry data.
+      @param size the size of the compressed entry data. */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data, std::streamsize size ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
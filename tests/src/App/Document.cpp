@@ -0,0 +1,387 @@
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/DocumentObject.h>
+#include <App/DocumentParams.h>
+#include <App/PropertyLinks.h>
+#include <App/PropertyStandard.h>
+
+#include "InitApplication.h"
+
+// NOLINTBEGIN(readability-named-parameter,readability-magic-numbers)
+
+namespace tests
+{
+
+/// Feature adding its input to the output of its source, safe to execute in a worker thread
+class ThreadedFeature: public App::DocumentObject
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(tests::ThreadedFeature);
+
+public:
+    ThreadedFeature()
+    {
+        ADD_PROPERTY(Input, (0));
+        ADD_PROPERTY(Source, (nullptr));
+        ADD_PROPERTY_TYPE(Output, (0), "", App::Prop_Output, "");
+    }
+
+    bool canRecomputeInThread() const override
+    {
+        return true;
+    }
+
+    App::DocumentObjectExecReturn* execute() override
+    {
+        executedIn = std::this_thread::get_id();
+        ++executeCount;
+        long value = Input.getValue();
+        if (auto source = dynamic_cast<ThreadedFeature*>(Source.getValue())) {
+            value += source->Output.getValue();
+        }
+        Output.setValue(value);
+        return App::DocumentObject::StdReturn;
+    }
+
+    App::PropertyInteger Input;
+    App::PropertyLink Source;
+    App::PropertyInteger Output;
+    std::thread::id executedIn;
+    int executeCount {};
+};
+
+PROPERTY_SOURCE(tests::ThreadedFeature, App::DocumentObject)
+
+}  // namespace tests
+
+class ParallelRecomputeTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        tests::ThreadedFeature::init();
+    }
+
+    void SetUp() override
+    {
+        _parallel = App::DocumentParams::getParallelRecompute();
+        _threadCount = App::DocumentParams::getRecomputeThreadCount();
+        App::DocumentParams::setParallelRecompute(true);
+        App::DocumentParams::setRecomputeThreadCount(4);
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+        App::DocumentParams::setParallelRecompute(_parallel);
+        App::DocumentParams::setRecomputeThreadCount(_threadCount);
+    }
+
+    tests::ThreadedFeature* addFeature(long input, App::DocumentObject* source = nullptr)
+    {
+        auto feature =
+            static_cast<tests::ThreadedFeature*>(_doc->addObject("tests::ThreadedFeature"));
+        feature->Input.setValue(input);
+        feature->Source.setValue(source);
+        return feature;
+    }
+
+    App::Document* getDocument() const
+    {
+        return _doc;
+    }
+
+private:
+    std::string _docName;
+    App::Document* _doc {};
+    bool _parallel {};
+    long _threadCount {};
+};
+
+TEST_F(ParallelRecomputeTest, independentFeaturesRunInWorkers)
+{
+    // Arrange
+    std::vector<tests::ThreadedFeature*> features;
+    for (int i = 0; i < 8; ++i) {
+        features.push_back(addFeature(i));
+    }
+
+    // Act
+    getDocument()->recompute();
+
+    // Assert
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(features[i]->Output.getValue(), i);
+        EXPECT_FALSE(features[i]->isTouched());
+        EXPECT_NE(features[i]->executedIn, std::this_thread::get_id());
+    }
+}
+
+TEST_F(ParallelRecomputeTest, dependentFeaturesMatchSerial)
+{
+    // Arrange
+    std::vector<tests::ThreadedFeature*> features;
+    for (int i = 0; i < 4; ++i) {
+        auto base = addFeature(i);
+        features.push_back(addFeature(10, addFeature(100, base)));
+    }
+
+    // Act
+    getDocument()->recompute();
+
+    // Assert
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(features[i]->Output.getValue(), 110 + i);
+    }
+}
+
+TEST_F(ParallelRecomputeTest, beforeChangeIsSignaledInMainThread)
+{
+    // Arrange
+    std::vector<tests::ThreadedFeature*> features;
+    for (int i = 0; i < 4; ++i) {
+        features.push_back(addFeature(i + 1));
+    }
+    std::vector<std::pair<std::thread::id, long>> signaled;
+    auto conn = getDocument()->signalBeforeChangeObject.connect(
+        [&signaled](const App::DocumentObject&, const App::Property& prop) {
+            if (auto propInt = dynamic_cast<const App::PropertyInteger*>(&prop)) {
+                if (strcmp(prop.getName(), "Output") == 0) {
+                    signaled.emplace_back(std::this_thread::get_id(), propInt->getValue());
+                }
+            }
+        });
+
+    // Act
+    getDocument()->recompute();
+    conn.disconnect();
+
+    // Assert
+    ASSERT_EQ(signaled.size(), features.size());
+    for (const auto& entry : signaled) {
+        EXPECT_EQ(entry.first, std::this_thread::get_id());
+        EXPECT_EQ(entry.second, 0);  // value before change
+    }
+}
+
+TEST_F(ParallelRecomputeTest, undoRestoresOutput)
+{
+    // Arrange
+    std::vector<tests::ThreadedFeature*> features;
+    for (int i = 0; i < 4; ++i) {
+        features.push_back(addFeature(i));
+    }
+    getDocument()->recompute();
+    getDocument()->setUndoMode(1);
+
+    // Act
+    getDocument()->openTransaction("change");
+    for (auto feature : features) {
+        feature->Input.setValue(feature->Input.getValue() + 10);
+    }
+    getDocument()->recompute();
+    getDocument()->commitTransaction();
+    int outputAfterRecompute = features[0]->Output.getValue();
+    getDocument()->undo();
+
+    // Assert
+    EXPECT_EQ(outputAfterRecompute, 10);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(features[i]->Input.getValue(), i);
+        EXPECT_EQ(features[i]->Output.getValue(), i);
+    }
+}
+
+class DependencyOrderTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        tests::ThreadedFeature::init();
+    }
+
+    void SetUp() override
+    {
+        _parallel = App::DocumentParams::getParallelRecompute();
+        _cache = App::DocumentParams::getCacheDependencyOrder();
+        App::DocumentParams::setParallelRecompute(false);
+        App::DocumentParams::setCacheDependencyOrder(true);
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+        App::DocumentParams::setParallelRecompute(_parallel);
+        App::DocumentParams::setCacheDependencyOrder(_cache);
+    }
+
+    tests::ThreadedFeature* addFeature(App::DocumentObject* source = nullptr)
+    {
+        auto feature =
+            static_cast<tests::ThreadedFeature*>(_doc->addObject("tests::ThreadedFeature"));
+        feature->Input.setValue(1);
+        feature->Source.setValue(source);
+        return feature;
+    }
+
+    /// Add unrelated objects so that a few changes are repaired locally instead of a rebuild
+    void addFillers(int count)
+    {
+        for (int i = 0; i < count; ++i) {
+            addFeature();
+        }
+    }
+
+    /// Sort all objects using the cached order, which also brings the order up to date
+    std::vector<App::DocumentObject*> sortAll() const
+    {
+        return _doc->getDependencyList(_doc->getObjects(), App::Document::DepSort);
+    }
+
+    /// Check that all objects are placed after their dependencies
+    static bool isSorted(const std::vector<App::DocumentObject*>& objs)
+    {
+        std::unordered_map<App::DocumentObject*, std::size_t> index;
+        for (std::size_t i = 0; i < objs.size(); ++i) {
+            index[objs[i]] = i;
+        }
+        for (std::size_t i = 0; i < objs.size(); ++i) {
+            for (auto dep : objs[i]->getOutList()) {
+                auto it = index.find(dep);
+                if (it == index.end() || it->second >= i) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    App::Document* getDocument() const
+    {
+        return _doc;
+    }
+
+private:
+    std::string _docName;
+    App::Document* _doc {};
+    bool _parallel {};
+    bool _cache {};
+};
+
+TEST_F(DependencyOrderTest, rebuildDependencyOrderSortsAll)
+{
+    // Arrange
+    auto first = addFeature();
+    auto second = addFeature(first);
+    auto third = addFeature(second);
+    first->Source.setValue(addFeature());
+
+    // Act
+    auto objs = sortAll();
+
+    // Assert
+    EXPECT_EQ(objs.size(), 4);
+    EXPECT_TRUE(isSorted(objs));
+    EXPECT_EQ(objs.back(), third);
+}
+
+TEST_F(DependencyOrderTest, reorderDependencyOnNewLink)
+{
+    // Arrange
+    addFillers(20);
+    auto obj = addFeature();
+    auto dep = addFeature();
+    sortAll();
+
+    // Act
+    obj->Source.setValue(dep);
+    auto objs = getDocument()->getDependencyList({obj}, App::Document::DepSort);
+
+    // Assert
+    ASSERT_EQ(objs.size(), 2);
+    EXPECT_EQ(objs[0], dep);
+    EXPECT_EQ(objs[1], obj);
+    EXPECT_TRUE(isSorted(sortAll()));
+}
+
+TEST_F(DependencyOrderTest, reorderDependencyMovesChain)
+{
+    // Arrange
+    auto obj = addFeature();
+    addFillers(20);
+    auto last = addFeature();
+    auto middle = addFeature(last);
+    auto dep = addFeature(middle);
+    auto other = addFeature(obj);
+    sortAll();
+
+    // Act
+    obj->Source.setValue(dep);
+    auto objs = sortAll();
+    getDocument()->recompute();
+
+    // Assert
+    EXPECT_TRUE(isSorted(objs));
+    EXPECT_EQ(obj->Output.getValue(), 4);
+    EXPECT_EQ(other->Output.getValue(), 5);
+}
+
+TEST_F(DependencyOrderTest, rebuildAfterRemoval)
+{
+    // Arrange
+    std::vector<App::DocumentObject*> objs;
+    App::DocumentObject* prev = nullptr;
+    for (int i = 0; i < 10; ++i) {
+        prev = addFeature(prev);
+        objs.push_back(prev);
+    }
+    sortAll();
+
+    // Act
+    auto last = static_cast<tests::ThreadedFeature*>(objs.back());
+    last->Source.setValue(objs[3]);
+    for (int i = 4; i < 9; ++i) {
+        getDocument()->removeObject(objs[i]->getNameInDocument());
+    }
+    auto sorted = sortAll();
+
+    // Assert
+    EXPECT_EQ(sorted.size(), 5);
+    EXPECT_TRUE(isSorted(sorted));
+}
+
+TEST_F(DependencyOrderTest, recomputeOnlyTouched)
+{
+    // Arrange
+    std::vector<tests::ThreadedFeature*> features;
+    for (int i = 0; i < 20; ++i) {
+        features.push_back(addFeature());
+    }
+    auto dependent = addFeature(features[5]);
+    getDocument()->recompute();
+
+    // Act
+    features[5]->Input.setValue(2);
+    getDocument()->recompute();
+
+    // Assert
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(features[i]->executeCount, i == 5 ? 2 : 1);
+    }
+    EXPECT_EQ(dependent->executeCount, 2);
+    EXPECT_EQ(dependent->Output.getValue(), 3);
+}
+
+// NOLINTEND(readability-named-parameter,readability-magic-numbers)
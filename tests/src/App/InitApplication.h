@@ -0,0 +1,24 @@
+#ifndef TEST_INIT_APPLICATION_H
+#define TEST_INIT_APPLICATION_H
+
+#include <array>
+
+#include <App/Application.h>
+
+namespace tests
+{
+
+/// Initialize the application once for tests that need documents
+inline void initApplication()
+{
+    if (App::Application::GetARGC() == 0) {
+        constexpr int argc = 1;
+        std::array<const char*, argc> argv {"FreeCAD"};
+        App::Application::Config()["ExeName"] = "FreeCAD";
+        App::Application::init(argc, const_cast<char**>(argv.data()));  // NOLINT
+    }
+}
+
+}  // namespace tests
+
+#endif  // TEST_INIT_APPLICATION_H
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "gtest/gtest.h"
+
+#include <Base/Functional.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+TEST(ForEachChunk, emptyRange)  // NOLINT
+{
+    // Arrange
+    int calls = 0;
+
+    // Act
+    std::size_t chunks = Base::forEachChunk(0, [&calls](std::size_t, std::size_t, std::size_t) {
+        ++calls;
+    });
+
+    // Assert
+    EXPECT_EQ(chunks, 0);
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(ForEachChunk, smallRangeSingleChunk)  // NOLINT
+{
+    // Arrange
+    std::vector<std::size_t> ranges;
+
+    // Act
+    std::size_t chunks =
+        Base::forEachChunk(100, [&ranges](std::size_t chunk, std::size_t begin, std::size_t end) {
+            ranges.insert(ranges.end(), {chunk, begin, end});
+        });
+
+    // Assert
+    EXPECT_EQ(chunks, 1);
+    EXPECT_EQ(ranges, (std::vector<std::size_t> {0, 0, 100}));
+}
+
+TEST(ForEachChunk, coversRangeOnce)  // NOLINT
+{
+    // Arrange
+    constexpr std::size_t count {100003};
+    std::vector<int> visits(count, 0);
+    std::vector<std::pair<std::size_t, std::size_t>> ranges(Base::countChunks(count, 1000));
+    std::mutex mutex;
+
+    // Act
+    std::size_t chunks = Base::forEachChunk(
+        count,
+        [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                ++visits[i];
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ranges[chunk] = {begin, end};
+        },
+        1000);
+
+    // Assert
+    EXPECT_EQ(chunks, ranges.size());
+    EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), count);
+    std::size_t next = 0;
+    for (const auto& range : ranges) {
+        EXPECT_EQ(range.first, next);
+        EXPECT_GE(range.second - range.first, std::min<std::size_t>(1000, count - next));
+        next = range.second;
+    }
+    EXPECT_EQ(next, count);
+}
+
+TEST(ForEachChunk, rethrowsException)  // NOLINT
+{
+    // Arrange
+    std::atomic<int> calls {0};
+    auto func = [&calls](std::size_t chunk, std::size_t, std::size_t) {
+        ++calls;
+        if (chunk == 1) {
+            throw std::runtime_error("chunk failed");
+        }
+    };
+
+    // Act & Assert
+    EXPECT_THROW(Base::forEachChunk(100000, func, 100), std::runtime_error);
+    EXPECT_GE(calls.load(), 2);
+}
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "gtest/gtest.h"
+
+#include <Base/GridCells.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+
+using Cells = Base::GridCells<unsigned long>;
+
+class GridCellsTest: public ::testing::Test
+{
+protected:
+    // Assigns each element to a few neighbouring cells, like a facet overlapping its grid
+    static void addElement(unsigned long index, std::size_t numCells, Cells::Entries& entries)
+    {
+        std::size_t cell = (index * 7919UL) % numCells;
+        std::size_t count = 1 + index % 3;
+        for (std::size_t i = 0; i < count && cell + i < numCells; i++) {
+            entries.push_back({cell + i, index});
+        }
+    }
+
+    static std::vector<Cells::Entries> makeEntries(unsigned long numElements,
+                                                   std::size_t numCells,
+                                                   std::size_t numLists)
+    {
+        std::vector<Cells::Entries> lists(numLists);
+        unsigned long chunk = (numElements + numLists - 1) / numLists;
+        for (unsigned long i = 0; i < numElements; i++) {
+            addElement(i, numCells, lists[i / chunk]);
+        }
+        return lists;
+    }
+};
+
+TEST_F(GridCellsTest, emptyCells)  // NOLINT
+{
+    // Arrange
+    Cells cells;
+
+    // Act
+    cells.resize(4);
+
+    // Assert
+    EXPECT_EQ(cells.size(), 4);
+    EXPECT_EQ(cells.countIndices(), 0);
+    EXPECT_TRUE(cells[0].empty());
+    EXPECT_TRUE(cells[3].empty());
+}
+
+TEST_F(GridCellsTest, clear)  // NOLINT
+{
+    // Arrange
+    Cells cells;
+    cells.assign(4, makeEntries(10, 4, 1));
+
+    // Act
+    cells.clear();
+
+    // Assert
+    EXPECT_EQ(cells.size(), 0);
+    EXPECT_EQ(cells.countIndices(), 0);
+    EXPECT_EQ(cells.memoryUsage(), 0);
+}
+
+TEST_F(GridCellsTest, assignMatchesSets)  // NOLINT
+{
+    // Arrange
+    constexpr std::size_t numCells {97};
+    auto lists = makeEntries(1000, numCells, 5);
+    std::vector<std::set<unsigned long>> sets(numCells);
+    for (const auto& list : lists) {
+        for (const auto& entry : list) {
+            sets[entry.cell].insert(entry.index);
+        }
+    }
+    Cells cells;
+
+    // Act
+    cells.assign(numCells, lists);
+
+    // Assert
+    ASSERT_EQ(cells.size(), numCells);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < numCells; i++) {
+        auto cell = cells[i];
+        EXPECT_EQ(cell.size(), sets[i].size());
+        EXPECT_TRUE(std::equal(cell.begin(), cell.end(), sets[i].begin(), sets[i].end()));
+        total += cell.size();
+    }
+    EXPECT_EQ(cells.countIndices(), total);
+}
+
+TEST_F(GridCellsTest, fillMatchesAssign)  // NOLINT
+{
+    // Arrange
+    constexpr std::size_t numCells {1009};
+    constexpr unsigned long numElements {100000};
+    Cells serial;
+    serial.assign(numCells, makeEntries(numElements, numCells, 1));
+    Cells cells;
+
+    // Act
+    cells.fill(numCells, numElements, [](unsigned long index, Cells::Entries& entries) {
+        addElement(index, numCells, entries);
+    });
+
+    // Assert
+    ASSERT_EQ(cells.size(), numCells);
+    EXPECT_EQ(cells.countIndices(), serial.countIndices());
+    for (std::size_t i = 0; i < numCells; i++) {
+        EXPECT_TRUE(
+            std::equal(cells[i].begin(), cells[i].end(), serial[i].begin(), serial[i].end()));
+    }
+}
+
+// Set FREECAD_BASE_BENCHMARK to run it
+TEST_F(GridCellsTest, benchmarkBuild)  // NOLINT
+{
+    if (!std::getenv("FREECAD_BASE_BENCHMARK")) {
+        GTEST_SKIP() << "set FREECAD_BASE_BENCHMARK to run the benchmark";
+    }
+
+    // Arrange
+    using Clock = std::chrono::steady_clock;
+    auto msecs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+    constexpr unsigned long numElements {500000};
+    constexpr std::size_t numX {40}, numY {40}, numZ {40};
+    constexpr std::size_t numCells {numX * numY * numZ};
+
+    // Act
+    auto start = Clock::now();
+    std::vector<std::vector<std::vector<std::set<unsigned long>>>> grid(numX);
+    for (auto& plane : grid) {
+        plane.resize(numY);
+        for (auto& row : plane) {
+            row.resize(numZ);
+        }
+    }
+    for (unsigned long i = 0; i < numElements; i++) {
+        Cells::Entries entries;
+        addElement(i, numCells, entries);
+        for (const auto& entry : entries) {
+            std::size_t x = entry.cell / (numY * numZ);
+            std::size_t y = (entry.cell / numZ) % numY;
+            grid[x][y][entry.cell % numZ].insert(i);
+        }
+    }
+    double setTime = msecs(start);
+
+    start = Clock::now();
+    Cells cells;
+    cells.assign(numCells, makeEntries(numElements, numCells, 16));
+    double cellsTime = msecs(start);
+
+    // Assert
+    std::size_t setEntries = 0;
+    for (std::size_t i = 0; i < numCells; i++) {
+        const auto& set = grid[i / (numY * numZ)][(i / numZ) % numY][i % numZ];
+        setEntries += set.size();
+        ASSERT_TRUE(std::equal(cells[i].begin(), cells[i].end(), set.begin(), set.end()));
+    }
+    // a tree node holds the value plus three pointers and the color
+    std::size_t setMemory = numCells * sizeof(std::set<unsigned long>)
+        + setEntries * (sizeof(unsigned long) + 4 * sizeof(void*));
+    std::cout << setEntries << " entries in " << numCells << " cells\n"
+              << "  std::set:  " << setTime << " ms, " << setMemory / (1024 * 1024) << " MB\n"
+              << "  GridCells: " << cellsTime << " ms, " << cells.memoryUsage() / (1024 * 1024)
+              << " MB\n";
+}
@@ -3,11 +3,14 @@
 #include "gtest/gtest.h"
 
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Reader.h"
 #include <array>
 #include <filesystem>
 #include <fmt/format.h>
 #include <fstream>
+#include <iterator>
+#include <thread>
 
 namespace fs = std::filesystem;
 
@@ -210,3 +213,230 @@ TEST_F(ReaderTest, readDataNotStarted)
     // Assert
     EXPECT_EQ(-1, bytesRead);// Because we didn't call beginCharStream
 }
+
+namespace
+{
+
+/// A persistent object with an additional file, which may be decoded in a worker thread
+class RestoredFile: public Base::Persistence
+{
+public:
+    enum class Failure
+    {
+        None,
+        Error,
+        Abort
+    };
+
+    explicit RestoredFile(bool threaded, Failure failure = Failure::None)
+        : threaded(threaded)
+        , failure(failure)
+    {}
+
+    unsigned int getMemSize() const override
+    {
+        return 0;
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+
+    bool canRestoreDocFileInThread() const override
+    {
+        return threaded;
+    }
+
+    void RestoreDocFile(Base::Reader& reader) override
+    {
+        content = readAll(reader);
+        decodeThread = std::this_thread::get_id();
+        applyThread = std::this_thread::get_id();
+        appliedAt = counter++;
+    }
+
+    std::function<void()> restoreDocFileInThread(Base::Reader& reader) override
+    {
+        std::string data = readAll(reader);
+        if (failure == Failure::Error) {
+            throw Base::RuntimeError("cannot decode " + reader.getFileName());
+        }
+        if (failure == Failure::Abort) {
+            throw Base::AbortException("decoding aborted");
+        }
+        auto thread = std::this_thread::get_id();
+        return [this, data, thread]() {
+            content = data;
+            decodeThread = thread;
+            applyThread = std::this_thread::get_id();
+            appliedAt = counter++;
+        };
+    }
+
+    static std::string readAll(std::istream& str)
+    {
+        return {std::istreambuf_iterator<char>(str), std::istreambuf_iterator<char>()};
+    }
+
+    bool threaded;
+    Failure failure;
+    std::string content;
+    std::thread::id decodeThread;
+    std::thread::id applyThread;
+    int appliedAt = -1;
+
+    // order in which the files were restored
+    static int counter;
+};
+
+int RestoredFile::counter = 0;
+
+}  // namespace
+
+class ThreadedRestoreTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        xercesc_3_2::XMLPlatformUtils::Initialize();
+        RestoredFile::counter = 0;
+    }
+
+    static std::string fileName(std::size_t index)
+    {
+        return fmt::format("File{}.dat", index);
+    }
+
+    /// The content of a file, big enough to keep several workers busy at once
+    static std::string fileContent(std::size_t index)
+    {
+        return fmt::format("File{}:", index) + std::string(20000 + index, char('a' + index % 26));
+    }
+
+    /// Saves a project archive with a file for each of \a files and restores it
+    static void restore(std::vector<std::unique_ptr<RestoredFile>>& files, int threadCount)
+    {
+        std::ostringstream out;
+        {
+            Base::ZipWriter writer(out);
+            writer.putNextEntry("Document.xml");
+            writer.Stream() << R"(<?xml version="1.0" encoding="UTF-8"?><Document/>)";
+            for (std::size_t i = 0; i < files.size(); ++i) {
+                writer.putNextEntry(fileName(i).c_str());
+                writer.Stream() << fileContent(i);
+            }
+        }
+
+        std::istringstream in(out.str());
+        zipios::ZipInputStream zip(in);
+        Base::ZipReader reader(zip, "Document.FCStd");
+        Base::XMLReader xmlReader(reader);
+        xmlReader.setRestoreThreadCount(threadCount);
+        xmlReader.readElement("Document");
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            xmlReader.addFile(fileName(i), files[i].get());
+        }
+        xmlReader.readFiles();
+    }
+};
+
+TEST_F(ThreadedRestoreTest, applyInFileOrder)
+{
+    // Arrange
+    std::vector<std::unique_ptr<RestoredFile>> files;
+    for (int i = 0; i < 50; ++i) {
+        files.push_back(std::make_unique<RestoredFile>(true));
+    }
+
+    // Act
+    restore(files, 4);
+
+    // Assert
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(fileContent(i), files[i]->content);
+        EXPECT_EQ(int(i), files[i]->appliedAt);
+        EXPECT_NE(std::this_thread::get_id(), files[i]->decodeThread);
+        EXPECT_EQ(std::this_thread::get_id(), files[i]->applyThread);
+    }
+}
+
+TEST_F(ThreadedRestoreTest, disabledByThreadCount)
+{
+    // Arrange
+    std::vector<std::unique_ptr<RestoredFile>> files;
+    for (int i = 0; i < 5; ++i) {
+        files.push_back(std::make_unique<RestoredFile>(true));
+    }
+
+    // Act
+    restore(files, 0);
+
+    // Assert
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        EXPECT_EQ(fileContent(i), files[i]->content);
+        EXPECT_EQ(std::this_thread::get_id(), files[i]->decodeThread);
+    }
+}
+
+TEST_F(ThreadedRestoreTest, mixedEntries)
+{
+    // Arrange
+    std::vector<std::unique_ptr<RestoredFile>> files;
+    for (int i = 0; i < 30; ++i) {
+        files.push_back(std::make_unique<RestoredFile>(i % 3 != 0));
+    }
+
+    // Act
+    restore(files, 2);
+
+    // Assert
+    int lastApplied = -1;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const auto& file = *files[i];
+        EXPECT_EQ(fileContent(i), file.content);
+        EXPECT_EQ(std::this_thread::get_id(), file.applyThread);
+        if (file.threaded) {
+            EXPECT_NE(std::this_thread::get_id(), file.decodeThread);
+            // only the threaded files are applied in the file order
+            EXPECT_GT(file.appliedAt, lastApplied);
+            lastApplied = file.appliedAt;
+        }
+        else {
+            EXPECT_EQ(std::this_thread::get_id(), file.decodeThread);
+        }
+    }
+}
+
+TEST_F(ThreadedRestoreTest, decodeErrorSkipsFile)
+{
+    // Arrange
+    std::vector<std::unique_ptr<RestoredFile>> files;
+    files.push_back(std::make_unique<RestoredFile>(true));
+    files.push_back(std::make_unique<RestoredFile>(true, RestoredFile::Failure::Error));
+    files.push_back(std::make_unique<RestoredFile>(true));
+
+    // Act
+    restore(files, 2);
+
+    // Assert
+    EXPECT_EQ(fileContent(0), files[0]->content);
+    EXPECT_TRUE(files[1]->content.empty());
+    EXPECT_EQ(-1, files[1]->appliedAt);
+    EXPECT_EQ(fileContent(2), files[2]->content);
+}
+
+TEST_F(ThreadedRestoreTest, decodeAbortRaisedInCaller)
+{
+    // Arrange
+    std::vector<std::unique_ptr<RestoredFile>> files;
+    for (int i = 0; i < 6; ++i) {
+        files.push_back(std::make_unique<RestoredFile>(true));
+    }
+    files[3]->failure = RestoredFile::Failure::Abort;
+
+    // Act / Assert
+    EXPECT_THROW(restore(files, 2), Base::AbortException);
+    EXPECT_EQ(fileContent(0), files[0]->content);
+    EXPECT_TRUE(files[3]->content.empty());
+    EXPECT_TRUE(files[5]->content.empty());
+}
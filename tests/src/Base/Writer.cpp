@@ -4,6 +4,8 @@
 
 #include "Base/Exception.h"
 #include "Base/Writer.h"
+#include <iterator>
+#include <sstream>
 
 // Writer is designed to be a base class, so for testing we actually instantiate a StringWriter,
 // which is derived from it
@@ -116,3 +118,120 @@ TEST_F(WriterTest, charStream)
     // Assert
     EXPECT_EQ(&streamA, &streamB);
 }
+
+class ZipWriterTest : public ::testing::Test {
+protected:
+    /// Returns the content of a PNG file that deflate could still shrink, so that it is only
+    /// stored because of its signature
+    static std::string thumbnail()
+    {
+        return "\x89PNG" + std::string(1000, 'x');
+    }
+
+    static std::string writeArchive(int threadCount, long long storeThreshold)
+    {
+        std::ostringstream out;
+        {
+            Base::ZipWriter writer(out);
+            writer.setThreadCount(threadCount);
+            writer.setStoreThreshold(storeThreshold);
+            writer.putNextEntry("Document.xml");
+            writer.Stream() << "<Document/>";
+            writer.putNextEntry("Large.brp");
+            writer.Stream() << std::string(200000, 'x');
+            writer.putNextEntry("Thumbnail.png");
+            writer.Stream() << thumbnail();
+        }
+        return out.str();
+    }
+
+    static void checkEntry(zipios::ZipInputStream& zip,
+                           const zipios::ConstEntryPointer& entry,
+                           const std::string& name,
+                           const std::string& content,
+                           zipios::StorageMethod method)
+    {
+        ASSERT_TRUE(entry);
+        EXPECT_EQ(name, entry->getName());
+        EXPECT_EQ(method, entry->getMethod());
+        std::string data {std::istreambuf_iterator<char>(zip), std::istreambuf_iterator<char>()};
+        EXPECT_EQ(content, data);
+    }
+};
+
+TEST_F(ZipWriterTest, parallelCompression)
+{
+    // Arrange
+    std::istringstream in(writeArchive(2, -1));
+
+    // Act
+    zipios::ZipInputStream zip(in);
+
+    // Assert
+    checkEntry(zip, zip.getNextEntry(), "Large.brp", std::string(200000, 'x'), zipios::DEFLATED);
+    checkEntry(zip, zip.getNextEntry(), "Thumbnail.png", thumbnail(), zipios::STORED);
+}
+
+TEST_F(ZipWriterTest, storeUncompressed)
+{
+    // Arrange
+    std::istringstream in(writeArchive(2, 100000));
+
+    // Act
+    zipios::ZipInputStream zip(in);
+    std::string document {std::istreambuf_iterator<char>(zip), std::istreambuf_iterator<char>()};
+
+    // Assert
+    EXPECT_EQ("<Document/>", document);
+    checkEntry(zip, zip.getNextEntry(), "Large.brp", std::string(200000, 'x'), zipios::STORED);
+    checkEntry(zip, zip.getNextEntry(), "Thumbnail.png", thumbnail(), zipios::STORED);
+}
+
+TEST_F(ZipWriterTest, storeCompressedData)
+{
+    // Arrange
+    std::ostringstream out;
+    {
+        Base::ZipWriter writer(out);
+        writer.setThreadCount(2);
+        writer.setStoreThreshold(0);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        writer.putNextEntry("Thumbnail.png");
+        writer.Stream() << thumbnail();
+        writer.putNextEntry("Thumbnail.dat");
+        writer.Stream() << thumbnail().substr(4);
+    }
+    std::istringstream in(out.str());
+
+    // Act
+    zipios::ZipInputStream zip(in);
+
+    // Assert
+    checkEntry(zip, zip.getNextEntry(), "Thumbnail.png", thumbnail(), zipios::STORED);
+    checkEntry(zip, zip.getNextEntry(), "Thumbnail.dat", thumbnail().substr(4), zipios::DEFLATED);
+}
+
+TEST_F(ZipWriterTest, sameContentAsSequential)
+{
+    // Arrange
+    std::istringstream parallel(writeArchive(4, -1));
+    std::istringstream sequential(writeArchive(0, -1));
+
+    // Act
+    zipios::ZipInputStream zipA(parallel);
+    zipios::ZipInputStream zipB(sequential);
+    std::string documentA {std::istreambuf_iterator<char>(zipA), std::istreambuf_iterator<char>()};
+    std::string documentB {std::istreambuf_iterator<char>(zipB), std::istreambuf_iterator<char>()};
+
+    // Assert
+    EXPECT_EQ(documentB, documentA);
+    for (int i = 0; i < 2; ++i) {
+        auto entryA = zipA.getNextEntry();
+        auto entryB = zipB.getNextEntry();
+        ASSERT_TRUE(entryA && entryB);
+        EXPECT_EQ(entryB->getName(), entryA->getName());
+        EXPECT_EQ(entryB->getSize(), entryA->getSize());
+        EXPECT_EQ(entryB->getCrc(), entryA->getCrc());
+    }
+}
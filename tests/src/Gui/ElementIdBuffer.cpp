@@ -0,0 +1,208 @@
+#include "gtest/gtest.h"
+
+#include "Gui/ElementIdBuffer.h"
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace
+{
+
+Base::Polygon2d createPolygon(std::initializer_list<Base::Vector2d> points)
+{
+    Base::Polygon2d polygon;
+    for (const auto& pnt : points) {
+        polygon.Add(pnt);
+    }
+    return polygon;
+}
+
+Base::Polygon2d createBox(double minX, double minY, double maxX, double maxY)
+{
+    return createPolygon({Base::Vector2d(minX, minY),
+                          Base::Vector2d(maxX, minY),
+                          Base::Vector2d(maxX, maxY),
+                          Base::Vector2d(minX, maxY)});
+}
+
+/// Draws the square [minX, maxX] x [minY, maxY] at depth \a z as two triangles
+void addSquare(Gui::ElementIdBuffer& buffer,
+               double minX,
+               double minY,
+               double maxX,
+               double maxY,
+               double z,
+               uint32_t id)
+{
+    buffer.addTriangle(Base::Vector3d(minX, minY, z),
+                       Base::Vector3d(maxX, minY, z),
+                       Base::Vector3d(maxX, maxY, z),
+                       id);
+    buffer.addTriangle(Base::Vector3d(minX, minY, z),
+                       Base::Vector3d(maxX, maxY, z),
+                       Base::Vector3d(minX, maxY, z),
+                       id);
+}
+
+using Ids = std::vector<uint32_t>;
+
+}  // namespace
+
+TEST(ElementIdBuffer, degeneratedPolygon)
+{
+    // Arrange
+    auto polygon = createPolygon({Base::Vector2d(0.1, 0.1), Base::Vector2d(0.9, 0.9)});
+
+    // Act
+    Gui::ElementIdBuffer buffer(polygon, 100, 100, false);
+    buffer.addPoint(Base::Vector3d(0.5, 0.5, 0.5), 1);
+
+    // Assert
+    EXPECT_TRUE(buffer.isEmpty());
+    EXPECT_FALSE(buffer.intersects(Base::BoundBox2d(0.0, 0.0, 1.0, 1.0)));
+    EXPECT_TRUE(buffer.getIds().empty());
+}
+
+TEST(ElementIdBuffer, polygonOutsideViewport)
+{
+    // Arrange
+    auto polygon = createBox(1.5, 1.5, 2.0, 2.0);
+
+    // Act
+    Gui::ElementIdBuffer buffer(polygon, 100, 100, false);
+
+    // Assert
+    EXPECT_TRUE(buffer.isEmpty());
+}
+
+TEST(ElementIdBuffer, intersects)
+{
+    // Arrange
+    Gui::ElementIdBuffer buffer(createBox(0.2, 0.2, 0.4, 0.4), 100, 100, false);
+
+    // Act / Assert
+    EXPECT_FALSE(buffer.isEmpty());
+    EXPECT_TRUE(buffer.intersects(Base::BoundBox2d(0.3, 0.3, 0.35, 0.35)));
+    EXPECT_TRUE(buffer.intersects(Base::BoundBox2d(0.0, 0.0, 1.0, 1.0)));
+    EXPECT_TRUE(buffer.intersects(Base::BoundBox2d(0.1, 0.1, 0.25, 0.25)));
+    EXPECT_FALSE(buffer.intersects(Base::BoundBox2d(0.5, 0.5, 0.6, 0.6)));
+    EXPECT_FALSE(buffer.intersects(Base::BoundBox2d(0.0, 0.5, 1.0, 0.6)));
+}
+
+TEST(ElementIdBuffer, polygonMask)
+{
+    // Arrange
+    // Lasso covering the lower left half of the viewport
+    auto polygon = createPolygon(
+        {Base::Vector2d(0.0, 0.0), Base::Vector2d(1.0, 0.0), Base::Vector2d(0.0, 1.0)});
+    Gui::ElementIdBuffer buffer(polygon, 100, 100, false);
+
+    // Act
+    buffer.addPoint(Base::Vector3d(0.1, 0.1, 0.5), 1);
+    buffer.addPoint(Base::Vector3d(0.9, 0.9, 0.5), 2);
+    addSquare(buffer, 0.7, 0.7, 0.9, 0.9, 0.5, 3);
+    addSquare(buffer, 0.4, 0.4, 0.6, 0.6, 0.5, 4);
+    buffer.addLine(Base::Vector3d(0.6, 0.9, 0.5), Base::Vector3d(0.9, 0.6, 0.5), 5);
+    buffer.addLine(Base::Vector3d(-1.0, 0.2, 0.5), Base::Vector3d(2.0, 0.2, 0.5), 6);
+
+    // Assert
+    // the square 4 and the line 6 cross the diagonal, while 2, 3 and 5 are only
+    // inside the bounding box of the polygon
+    EXPECT_EQ(buffer.getIds(), Ids({1, 4, 6}));
+}
+
+TEST(ElementIdBuffer, hitModeKeepsHiddenElements)
+{
+    // Arrange
+    Gui::ElementIdBuffer buffer(createBox(0.2, 0.2, 0.4, 0.4), 100, 100, false);
+
+    // Act
+    addSquare(buffer, 0.0, 0.0, 1.0, 1.0, 0.2, 1);
+    addSquare(buffer, 0.25, 0.25, 0.35, 0.35, 0.5, 2);
+
+    // Assert
+    EXPECT_EQ(buffer.getIds(), Ids({1, 2}));
+}
+
+TEST(ElementIdBuffer, depthTestDropsHiddenElements)
+{
+    // Arrange
+    Gui::ElementIdBuffer buffer(createBox(0.2, 0.2, 0.4, 0.4), 100, 100, true);
+
+    // Act
+    addSquare(buffer, 0.0, 0.0, 1.0, 1.0, 0.2, 1);
+    addSquare(buffer, 0.25, 0.25, 0.35, 0.35, 0.5, 2);
+    addSquare(buffer, 0.3, 0.3, 0.5, 0.5, 0.1, 3);
+
+    // Assert
+    EXPECT_EQ(buffer.getIds(), Ids({1, 3}));
+}
+
+TEST(ElementIdBuffer, depthTestIgnoresDrawingOrder)
+{
+    // Arrange
+    Gui::ElementIdBuffer buffer(createBox(0.2, 0.2, 0.4, 0.4), 100, 100, true);
+
+    // Act
+    addSquare(buffer, 0.25, 0.25, 0.35, 0.35, 0.5, 2);
+    addSquare(buffer, 0.0, 0.0, 1.0, 1.0, 0.2, 1);
+
+    // Assert
+    EXPECT_EQ(buffer.getIds(), Ids({1}));
+}
+
+TEST(ElementIdBuffer, depthTestLinesWinOverFaces)
+{
+    // Arrange
+    Gui::ElementIdBuffer buffer(createBox(0.2, 0.2, 0.4, 0.4), 100, 100, true);
+
+    // Act
+    addSquare(buffer, 0.0, 0.0, 1.0, 1.0, 0.5, 1);
+    buffer.addLine(Base::Vector3d(0.0, 0.3, 0.5), Base::Vector3d(1.0, 0.3, 0.5), 2);
+    buffer.addPoint(Base::Vector3d(0.25, 0.25, 0.5), 3);
+    buffer.addPoint(Base::Vector3d(0.35, 0.35, 0.6), 4);
+
+    // Assert
+    EXPECT_EQ(buffer.getIds(), Ids({1, 2, 3}));
+}
+
+TEST(ElementIdBuffer, depthOutsideViewVolume)
+{
+    // Arrange
+    Gui::ElementIdBuffer buffer(createBox(0.2, 0.2, 0.4, 0.4), 100, 100, false);
+
+    // Act
+    addSquare(buffer, 0.0, 0.0, 1.0, 1.0, -0.5, 1);
+    addSquare(buffer, 0.0, 0.0, 1.0, 1.0, 1.5, 2);
+
+    // Assert
+    EXPECT_TRUE(buffer.getIds().empty());
+}
+
+TEST(ElementIdBuffer, subPixelElements)
+{
+    // Arrange
+    Gui::ElementIdBuffer buffer(createBox(0.2, 0.2, 0.4, 0.4), 100, 100, true);
+
+    // Act
+    // smaller than a pixel and not covering any pixel center
+    buffer.addTriangle(Base::Vector3d(0.3001, 0.3001, 0.5),
+                       Base::Vector3d(0.3003, 0.3001, 0.5),
+                       Base::Vector3d(0.3001, 0.3003, 0.5),
+                       1);
+    buffer.addLine(Base::Vector3d(0.2501, 0.2501, 0.5), Base::Vector3d(0.2502, 0.2502, 0.5), 2);
+    // edge on triangle
+    buffer.addTriangle(Base::Vector3d(0.22, 0.38, 0.5),
+                       Base::Vector3d(0.26, 0.38, 0.5),
+                       Base::Vector3d(0.30, 0.38, 0.5),
+                       3);
+    // outside of the polygon
+    buffer.addTriangle(Base::Vector3d(0.6001, 0.6001, 0.5),
+                       Base::Vector3d(0.6003, 0.6001, 0.5),
+                       Base::Vector3d(0.6001, 0.6003, 0.5),
+                       4);
+
+    // Assert
+    EXPECT_EQ(buffer.getIds(), Ids({1, 2, 3}));
+}
+
+// NOLINTEND(readability-magic-numbers)
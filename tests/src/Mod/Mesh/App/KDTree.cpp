@@ -0,0 +1,161 @@
+#include "gtest/gtest.h"
+
+#include <cfloat>
+#include <random>
+
+#include <Mod/Mesh/App/Core/KDTree.h>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace
+{
+
+std::vector<Base::Vector3f> createPoints(std::size_t count, float size, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(0.0F, size);
+    std::vector<Base::Vector3f> points(count);
+    for (auto& pnt : points) {
+        pnt.Set(coord(rng), coord(rng), coord(rng));
+    }
+    return points;
+}
+
+/// Runs the single point query for each of \a points
+void findEach(const MeshCore::MeshKDTree& tree,
+              const std::vector<Base::Vector3f>& points,
+              float maxDist,
+              std::vector<MeshCore::PointIndex>& indices,
+              std::vector<float>& dist)
+{
+    indices.clear();
+    dist.clear();
+    for (const auto& pnt : points) {
+        Base::Vector3f nearest;
+        float distance {};
+        MeshCore::PointIndex index = tree.FindNearest(pnt, maxDist, nearest, distance);
+        indices.push_back(index);
+        dist.push_back(index == MeshCore::POINT_INDEX_MAX ? FLT_MAX : distance);
+    }
+}
+
+}  // namespace
+
+class MeshKDTreeTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _tree.AddPoints(createPoints(2000, 100.0F, 1));
+        _tree.Optimize();
+    }
+
+    const MeshCore::MeshKDTree& getTree() const
+    {
+        return _tree;
+    }
+
+private:
+    MeshCore::MeshKDTree _tree;
+};
+
+TEST_F(MeshKDTreeTest, batchMatchesSingleQueries)
+{
+    // Arrange
+    // more queries than a chunk, so that the batch is also split across threads
+    auto queries = createPoints(30000, 100.0F, 2);
+    std::vector<MeshCore::PointIndex> expectedIndices;
+    std::vector<float> expectedDist;
+    findEach(getTree(), queries, 10.0F, expectedIndices, expectedDist);
+
+    // Act
+    std::vector<MeshCore::PointIndex> indices;
+    std::vector<float> dist;
+    getTree().FindNearest(queries, 10.0F, indices, dist);
+
+    // Assert
+    EXPECT_EQ(indices, expectedIndices);
+    EXPECT_EQ(dist, expectedDist);
+}
+
+TEST_F(MeshKDTreeTest, batchBeyondMaxDist)
+{
+    // Arrange
+    std::vector<Base::Vector3f> queries = {Base::Vector3f(50.0F, 50.0F, 50.0F),
+                                           Base::Vector3f(500.0F, 500.0F, 500.0F),
+                                           Base::Vector3f(-200.0F, 50.0F, 50.0F),
+                                           Base::Vector3f(50.0F, 50.0F, 50.0F)};
+    std::vector<MeshCore::PointIndex> expectedIndices;
+    std::vector<float> expectedDist;
+    findEach(getTree(), queries, 20.0F, expectedIndices, expectedDist);
+
+    // Act
+    std::vector<MeshCore::PointIndex> indices;
+    std::vector<float> dist;
+    getTree().FindNearest(queries, 20.0F, indices, dist);
+
+    // Assert
+    EXPECT_EQ(indices, expectedIndices);
+    EXPECT_EQ(dist, expectedDist);
+    EXPECT_NE(indices[0], MeshCore::POINT_INDEX_MAX);
+    EXPECT_EQ(indices[1], MeshCore::POINT_INDEX_MAX);
+    EXPECT_EQ(dist[1], FLT_MAX);
+    EXPECT_EQ(indices[2], MeshCore::POINT_INDEX_MAX);
+    EXPECT_EQ(dist[2], FLT_MAX);
+    EXPECT_EQ(indices[3], indices[0]);
+}
+
+TEST_F(MeshKDTreeTest, batchWithPointArray)
+{
+    // Arrange
+    auto queries = createPoints(100, 100.0F, 3);
+    MeshCore::MeshPointArray points;
+    for (const auto& pnt : queries) {
+        points.push_back(MeshCore::MeshPoint(pnt));
+    }
+    std::vector<MeshCore::PointIndex> expectedIndices;
+    std::vector<float> expectedDist;
+    findEach(getTree(), queries, 10.0F, expectedIndices, expectedDist);
+
+    // Act
+    std::vector<MeshCore::PointIndex> indices;
+    std::vector<float> dist;
+    getTree().FindNearest(points, 10.0F, indices, dist);
+
+    // Assert
+    EXPECT_EQ(indices, expectedIndices);
+    EXPECT_EQ(dist, expectedDist);
+}
+
+TEST_F(MeshKDTreeTest, batchWithoutQueries)
+{
+    // Arrange
+    std::vector<MeshCore::PointIndex> indices(3, 0);
+    std::vector<float> dist(3, 0.0F);
+
+    // Act
+    getTree().FindNearest(std::vector<Base::Vector3f>(), 10.0F, indices, dist);
+
+    // Assert
+    EXPECT_TRUE(indices.empty());
+    EXPECT_TRUE(dist.empty());
+}
+
+TEST(MeshKDTree, batchOnEmptyTree)
+{
+    // Arrange
+    MeshCore::MeshKDTree tree;
+    auto queries = createPoints(10, 100.0F, 4);
+
+    // Act
+    std::vector<MeshCore::PointIndex> indices;
+    std::vector<float> dist;
+    tree.FindNearest(queries, 10.0F, indices, dist);
+
+    // Assert
+    EXPECT_TRUE(tree.IsEmpty());
+    EXPECT_EQ(indices, std::vector<MeshCore::PointIndex>(queries.size(), MeshCore::POINT_INDEX_MAX));
+    EXPECT_EQ(dist, std::vector<float>(queries.size(), FLT_MAX));
+}
+
+// NOLINTEND(readability-magic-numbers)
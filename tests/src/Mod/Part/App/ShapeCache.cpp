@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Interpreter.h>
+#include <Mod/Part/App/FeaturePartBox.h>
+#include <Mod/Part/App/PartParams.h>
+#include <Mod/Part/App/ShapeCache.h>
+
+#include "../../../App/InitApplication.h"
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+class ShapeCacheTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        Base::Interpreter().runString("import Part");
+    }
+
+    void SetUp() override
+    {
+        _enabled = Part::PartParams::getEnableShapeCache();
+        _diskLimit = Part::PartParams::getShapeCacheDiskLimit();
+        Part::PartParams::setEnableShapeCache(true);
+        Part::PartParams::setShapeCacheDiskLimit(0);
+        Part::ShapeCache::instance().clear();
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+        _box = static_cast<Part::Box*>(_doc->addObject("Part::Box"));
+        _doc->recompute();
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+        Part::ShapeCache::instance().clear();
+        Part::PartParams::setEnableShapeCache(_enabled);
+        Part::PartParams::setShapeCacheDiskLimit(_diskLimit);
+    }
+
+    App::Document* getDocument() const
+    {
+        return _doc;
+    }
+
+    Part::Box* getBox() const
+    {
+        return _box;
+    }
+
+private:
+    std::string _docName;
+    App::Document* _doc {};
+    Part::Box* _box {};
+    bool _enabled {};
+    long _diskLimit {};
+};
+
+TEST_F(ShapeCacheTest, hitAfterRecompute)
+{
+    // Arrange
+    auto& cache = Part::ShapeCache::instance();
+    auto key = cache.getKey(getBox());
+
+    // Act
+    bool restored = cache.restore(key, getBox());
+
+    // Assert
+    EXPECT_FALSE(key.empty());
+    EXPECT_TRUE(restored);
+    EXPECT_FALSE(getBox()->Shape.getShape().isNull());
+}
+
+TEST_F(ShapeCacheTest, missOnChangedInput)
+{
+    // Arrange
+    auto& cache = Part::ShapeCache::instance();
+    auto key = cache.getKey(getBox());
+
+    // Act
+    getBox()->Length.setValue(20.0);
+    auto changedKey = cache.getKey(getBox());
+
+    // Assert
+    EXPECT_NE(key, changedKey);
+    EXPECT_FALSE(cache.restore(changedKey, getBox()));
+}
+
+TEST_F(ShapeCacheTest, hitAfterRevertingInput)
+{
+    // Arrange
+    auto& cache = Part::ShapeCache::instance();
+    auto key = cache.getKey(getBox());
+    getBox()->Length.setValue(20.0);
+    getDocument()->recompute();
+
+    // Act
+    getBox()->Length.setValue(10.0);
+    getDocument()->recompute();
+
+    // Assert
+    EXPECT_EQ(cache.getKey(getBox()), key);
+    EXPECT_DOUBLE_EQ(getBox()->Shape.getShape().getBoundBox().LengthX(), 10.0);
+}
+
+TEST_F(ShapeCacheTest, missAfterClear)
+{
+    // Arrange
+    auto& cache = Part::ShapeCache::instance();
+    auto key = cache.getKey(getBox());
+
+    // Act
+    cache.clear();
+
+    // Assert
+    EXPECT_FALSE(cache.restore(key, getBox()));
+}
+
+TEST_F(ShapeCacheTest, diskWriteDeferredToFlush)
+{
+    // Arrange
+    auto& cache = Part::ShapeCache::instance();
+    Part::PartParams::setShapeCacheDiskLimit(16);
+    getBox()->Height.setValue(30.0);
+    getDocument()->recompute();
+    auto key = cache.getKey(getBox());
+
+    // Act
+    cache.clear();
+    bool restoredBeforeFlush = cache.restore(key, getBox());
+    getBox()->Height.setValue(40.0);
+    getDocument()->recompute();
+    auto flushedKey = cache.getKey(getBox());
+    cache.flush(getDocument());
+    cache.clear();
+    bool restoredAfterFlush = cache.restore(flushedKey, getBox());
+    cache.clear(true);
+
+    // Assert
+    EXPECT_FALSE(restoredBeforeFlush);
+    EXPECT_TRUE(restoredAfterFlush);
+}
+
+// NOLINTEND(readability-magic-numbers)
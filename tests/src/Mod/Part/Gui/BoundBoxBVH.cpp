@@ -0,0 +1,289 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <Inventor/SbViewportRegion.h>
+#include <Inventor/SoDB.h>
+#include <Inventor/actions/SoRayPickAction.h>
+#include <Inventor/nodes/SoCallback.h>
+#include <Inventor/nodes/SoSeparator.h>
+
+#include <Mod/Part/Gui/BoundBoxBVH.h>
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace
+{
+
+/// Collects the boxes hit by a ray pick, either through the hierarchy or by testing all boxes
+struct PickData
+{
+    const PartGui::BoundBoxBVH* bvh = nullptr;
+    const std::vector<SbBox3f>* boxes = nullptr;
+    std::vector<int> results;
+};
+
+void pickCallback(void* data, SoAction* action)
+{
+    if (!action->isOfType(SoRayPickAction::getClassTypeId())) {
+        return;
+    }
+    auto pick = static_cast<PickData*>(data);
+    auto rayPick = static_cast<SoRayPickAction*>(action);
+    rayPick->setObjectSpace();
+    if (pick->bvh) {
+        pick->bvh->rayPick(rayPick, pick->results);
+    }
+    else {
+        for (int i = 0, count = (int)pick->boxes->size(); i < count; ++i) {
+            const auto& box = (*pick->boxes)[i];
+            if (!box.isEmpty() && rayPick->intersect(box, TRUE)) {
+                pick->results.push_back(i);
+            }
+        }
+    }
+}
+
+/// Applies a ray pick along the negative z axis through \a x, \a y to the scene
+std::vector<int> pickAt(PickData& data, float x, float y)
+{
+    auto root = new SoSeparator;
+    root->ref();
+    auto callback = new SoCallback;
+    callback->setCallback(pickCallback, &data);
+    root->addChild(callback);
+
+    data.results.clear();
+    SoRayPickAction action(SbViewportRegion(100, 100));
+    action.setRay(SbVec3f(x, y, 100.0F), SbVec3f(0.0F, 0.0F, -1.0F));
+    action.apply(root);
+    root->unref();
+
+    std::vector<int> results = data.results;
+    std::sort(results.begin(), results.end());
+    return results;
+}
+
+std::vector<int> pickBVH(const PartGui::BoundBoxBVH& bvh, float x, float y)
+{
+    PickData data;
+    data.bvh = &bvh;
+    return pickAt(data, x, y);
+}
+
+std::vector<int> pickAll(const std::vector<SbBox3f>& boxes, float x, float y)
+{
+    PickData data;
+    data.boxes = &boxes;
+    return pickAt(data, x, y);
+}
+
+/// Returns the boxes of the triangles of a wavy surface with \a n x \a n cells
+std::vector<SbBox3f> createSurface(int n)
+{
+    auto height = [](int i, int j) {
+        return std::sin(float(i) * 0.05F) * std::cos(float(j) * 0.05F);
+    };
+    std::vector<SbBox3f> boxes;
+    boxes.reserve(2 * n * n);
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            SbVec3f p00(float(i), float(j), height(i, j));
+            SbVec3f p10(float(i + 1), float(j), height(i + 1, j));
+            SbVec3f p01(float(i), float(j + 1), height(i, j + 1));
+            SbVec3f p11(float(i + 1), float(j + 1), height(i + 1, j + 1));
+            SbBox3f box1(p00, p00);
+            box1.extendBy(p10);
+            box1.extendBy(p11);
+            SbBox3f box2(p00, p00);
+            box2.extendBy(p11);
+            box2.extendBy(p01);
+            boxes.push_back(box1);
+            boxes.push_back(box2);
+        }
+    }
+    return boxes;
+}
+
+}  // namespace
+
+class BoundBoxBVHTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        SoDB::init();
+    }
+
+    /// Returns a grid of small boxes with gaps in between
+    static std::vector<SbBox3f> createGrid(int n, float offset = 0.0F)
+    {
+        std::vector<SbBox3f> boxes;
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                float x = float(i) * 10.0F + offset;
+                float y = float(j) * 10.0F;
+                boxes.emplace_back(x, y, -1.0F, x + 1.0F, y + 1.0F, 1.0F);
+            }
+        }
+        return boxes;
+    }
+};
+
+TEST_F(BoundBoxBVHTest, emptyTree)
+{
+    // Arrange
+    PartGui::BoundBoxBVH bvh;
+
+    // Act
+    bvh.init({});
+
+    // Assert
+    EXPECT_TRUE(bvh.empty());
+    EXPECT_EQ(bvh.size(), 0U);
+    EXPECT_TRUE(pickBVH(bvh, 0.5F, 0.5F).empty());
+}
+
+TEST_F(BoundBoxBVHTest, buildKeepsBoxCount)
+{
+    // Arrange
+    auto boxes = createGrid(20);
+
+    // Act
+    PartGui::BoundBoxBVH bvh;
+    bvh.init(boxes);
+
+    // Assert
+    EXPECT_FALSE(bvh.empty());
+    EXPECT_EQ(bvh.size(), boxes.size());
+}
+
+TEST_F(BoundBoxBVHTest, queryMatchesAllBoxes)
+{
+    // Arrange
+    auto boxes = createGrid(20);
+    PartGui::BoundBoxBVH bvh;
+    bvh.init(boxes);
+
+    // Act / Assert
+    for (int j = 0; j < 20; j += 3) {
+        for (int i = 0; i < 20; i += 3) {
+            float x = float(i) * 10.0F + 0.5F;
+            float y = float(j) * 10.0F + 0.5F;
+            auto results = pickBVH(bvh, x, y);
+            EXPECT_EQ(results, pickAll(boxes, x, y));
+            EXPECT_TRUE(std::binary_search(results.begin(), results.end(), j * 20 + i));
+        }
+    }
+    EXPECT_EQ(pickBVH(bvh, 5.5F, 5.5F), pickAll(boxes, 5.5F, 5.5F));
+    EXPECT_TRUE(pickBVH(bvh, -50.0F, -50.0F).empty());
+}
+
+TEST_F(BoundBoxBVHTest, skipEmptyBoxes)
+{
+    // Arrange
+    std::vector<SbBox3f> boxes(3);
+    boxes[0].setBounds(0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 1.0F);
+    boxes[2].setBounds(0.0F, 0.0F, 2.0F, 1.0F, 1.0F, 3.0F);
+
+    // Act
+    PartGui::BoundBoxBVH bvh;
+    bvh.init(boxes);
+
+    // Assert
+    EXPECT_EQ(bvh.size(), 3U);
+    EXPECT_EQ(pickBVH(bvh, 0.5F, 0.5F), std::vector<int>({0, 2}));
+}
+
+TEST_F(BoundBoxBVHTest, coincidentBoxes)
+{
+    // Arrange
+    std::vector<SbBox3f> boxes(50, SbBox3f(0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 1.0F));
+
+    // Act
+    PartGui::BoundBoxBVH bvh;
+    bvh.init(boxes);
+
+    // Assert
+    EXPECT_EQ(pickBVH(bvh, 0.5F, 0.5F).size(), boxes.size());
+}
+
+TEST_F(BoundBoxBVHTest, clearInvalidates)
+{
+    // Arrange
+    PartGui::BoundBoxBVH bvh;
+    bvh.init(createGrid(10));
+
+    // Act
+    bvh.clear();
+
+    // Assert
+    EXPECT_TRUE(bvh.empty());
+    EXPECT_EQ(bvh.size(), 0U);
+    EXPECT_TRUE(pickBVH(bvh, 0.5F, 0.5F).empty());
+}
+
+TEST_F(BoundBoxBVHTest, initReplacesBoxes)
+{
+    // Arrange
+    PartGui::BoundBoxBVH bvh;
+    bvh.init(createGrid(10));
+    auto moved = createGrid(10, 5.0F);
+
+    // Act
+    bvh.init(moved);
+
+    // Assert
+    EXPECT_EQ(bvh.size(), moved.size());
+    EXPECT_TRUE(pickBVH(bvh, 0.5F, 0.5F).empty());
+    EXPECT_EQ(pickBVH(bvh, 5.5F, 0.5F), std::vector<int>({0}));
+    EXPECT_EQ(pickBVH(bvh, 5.5F, 0.5F), pickAll(moved, 5.5F, 0.5F));
+}
+
+// Replays a mouse path over a surface of two million triangles, as when preselecting
+// on a large shape. Set FREECAD_PART_BENCHMARK to run it.
+TEST_F(BoundBoxBVHTest, mousePathBenchmark)
+{
+    if (!std::getenv("FREECAD_PART_BENCHMARK")) {
+        GTEST_SKIP() << "set FREECAD_PART_BENCHMARK to run the benchmark";
+    }
+
+    // Arrange
+    const int n = 1000;
+    const int steps = 2000;
+    auto boxes = createSurface(n);
+    std::vector<SbVec2f> path;
+    for (int i = 0; i < steps; ++i) {
+        float t = float(i) / float(steps) * 6.2831853F;
+        path.emplace_back(float(n) * (0.5F + 0.45F * std::sin(3.0F * t)),
+                          float(n) * (0.5F + 0.45F * std::sin(2.0F * t)));
+    }
+
+    // Act
+    auto start = std::chrono::steady_clock::now();
+    PartGui::BoundBoxBVH bvh;
+    bvh.init(boxes);
+    auto built = std::chrono::steady_clock::now();
+    std::size_t hits = 0;
+    for (const auto& pos : path) {
+        hits += pickBVH(bvh, pos[0], pos[1]).size();
+    }
+    auto replayed = std::chrono::steady_clock::now();
+
+    // Assert
+    for (int i = 0; i < steps; i += steps / 10) {
+        EXPECT_EQ(pickBVH(bvh, path[i][0], path[i][1]), pickAll(boxes, path[i][0], path[i][1]));
+    }
+    EXPECT_GE(hits, path.size());
+
+    using ms = std::chrono::duration<double, std::milli>;
+    std::cout << "BoundBoxBVH: " << boxes.size() << " boxes, build "
+              << ms(built - start).count() << " ms, " << steps << " picks "
+              << ms(replayed - built).count() << " ms" << std::endl;
+}
+
+// NOLINTEND(readability-magic-numbers)
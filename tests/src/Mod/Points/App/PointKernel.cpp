@@ -0,0 +1,280 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/FileInfo.h>
+#include <Base/Interpreter.h>
+#include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsFeature.h>
+#include <Mod/Points/App/PointsOctree.h>
+#include <Mod/Points/App/Properties.h>
+#include <Mod/Points/App/Structured.h>
+
+#include "../../../App/InitApplication.h"
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+namespace
+{
+
+std::vector<Base::Vector3f> createGrid(int width, int height)
+{
+    std::vector<Base::Vector3f> points;
+    points.reserve(width * height);
+    for (int j = 0; j < height; j++) {
+        for (int i = 0; i < width; i++) {
+            points.emplace_back(float(i), float(j), float((i * 7 + j * 3) % 5));
+        }
+    }
+    return points;
+}
+
+std::vector<Base::Vector3f> sorted(std::vector<Base::Vector3f> points)
+{
+    std::sort(points.begin(), points.end(), [](const Base::Vector3f& a, const Base::Vector3f& b) {
+        return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+    });
+    return points;
+}
+
+std::shared_ptr<Points::PointsOctree> createOctree(const std::vector<Base::Vector3f>& points)
+{
+    Points::PointsOctreeBuilder builder;
+    builder.addPoints(points);
+    return builder.finish(true);
+}
+
+}  // namespace
+
+class PointKernelTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        Base::Interpreter().runString("import Points");
+    }
+
+    void SetUp() override
+    {
+        _points = createGrid(40, 30);
+        _kernel.setOctree(createOctree(_points));
+    }
+
+    const std::vector<Base::Vector3f>& getPoints() const
+    {
+        return _points;
+    }
+
+    Points::PointKernel& getKernel()
+    {
+        return _kernel;
+    }
+
+private:
+    std::vector<Base::Vector3f> _points;
+    Points::PointKernel _kernel;
+};
+
+TEST_F(PointKernelTest, octreeKeepsAllPoints)
+{
+    // Arrange
+    const Points::PointKernel& kernel = getKernel();
+
+    // Act
+    const auto& points = kernel.getBasicPoints();
+
+    // Assert
+    EXPECT_TRUE(kernel.isOutOfCore());
+    EXPECT_EQ(kernel.size(), getPoints().size());
+    EXPECT_EQ(sorted(points), sorted(getPoints()));
+}
+
+TEST_F(PointKernelTest, nonConstAccessDetachesOctree)
+{
+    // Arrange
+    auto expected = sorted(getPoints());
+
+    // Act
+    auto& points = getKernel().getBasicPoints();
+
+    // Assert
+    EXPECT_FALSE(getKernel().isOutOfCore());
+    EXPECT_EQ(sorted(points), expected);
+}
+
+TEST_F(PointKernelTest, setPointDetachesOctree)
+{
+    // Arrange
+    auto& kernel = getKernel();
+    Base::Vector3d pnt(100.0, 200.0, 300.0);
+
+    // Act
+    kernel.setPoint(5, pnt);
+
+    // Assert
+    EXPECT_FALSE(kernel.isOutOfCore());
+    EXPECT_EQ(kernel.size(), getPoints().size());
+    EXPECT_EQ(kernel.getPoint(5), pnt);
+}
+
+TEST_F(PointKernelTest, pushBackDetachesOctree)
+{
+    // Arrange
+    auto& kernel = getKernel();
+    Base::Vector3d pnt(-1.0, -2.0, -3.0);
+
+    // Act
+    kernel.push_back(pnt);
+
+    // Assert
+    EXPECT_FALSE(kernel.isOutOfCore());
+    EXPECT_EQ(kernel.size(), getPoints().size() + 1);
+    EXPECT_EQ(kernel.getPoint(int(getPoints().size())), pnt);
+}
+
+TEST_F(PointKernelTest, resizeDetachesOctree)
+{
+    // Arrange
+    auto& kernel = getKernel();
+
+    // Act
+    kernel.resize(10);
+
+    // Assert
+    EXPECT_FALSE(kernel.isOutOfCore());
+    EXPECT_EQ(kernel.size(), 10U);
+}
+
+TEST_F(PointKernelTest, copySharesOctree)
+{
+    // Arrange
+    Points::PointKernel copy(getKernel());
+
+    // Act
+    copy.push_back(Base::Vector3d(-1.0, -2.0, -3.0));
+
+    // Assert
+    EXPECT_FALSE(copy.isOutOfCore());
+    EXPECT_TRUE(getKernel().isOutOfCore());
+    EXPECT_EQ(getKernel().size(), getPoints().size());
+}
+
+class PointsRestoreTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        Base::Interpreter().runString("import Points");
+    }
+
+    void SetUp() override
+    {
+        _hGrp = App::GetApplication().GetUserParameter().GetGroup("BaseApp")
+            ->GetGroup("Preferences")->GetGroup("Mod/Points");
+        _threshold = _hGrp->GetUnsigned("OutOfCoreThreshold", 50000000UL);
+        _hGrp->SetUnsigned("OutOfCoreThreshold", 100);
+        _fileName = App::Application::getTempFileName("PointsRestore") + ".FCStd";
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+        Base::FileInfo(_fileName).deleteFile();
+        _hGrp->SetUnsigned("OutOfCoreThreshold", _threshold);
+    }
+
+    App::Document* getDocument() const
+    {
+        return _doc;
+    }
+
+    /// Saves and reopens the document and returns the restored object \a name
+    template<typename T>
+    T* reload(const char* name)
+    {
+        _doc->saveAs(_fileName.c_str());
+        App::GetApplication().closeDocument(_docName.c_str());
+        _doc = App::GetApplication().openDocument(_fileName.c_str(), false);
+        _docName = _doc->getName();
+        return dynamic_cast<T*>(_doc->getObject(name));
+    }
+
+private:
+    Base::Reference<ParameterGrp> _hGrp;
+    unsigned long _threshold {};
+    std::string _fileName;
+    std::string _docName;
+    App::Document* _doc {};
+};
+
+TEST_F(PointsRestoreTest, largeCloudIsOutOfCore)
+{
+    // Arrange
+    auto points = createGrid(40, 30);
+    auto feature = static_cast<Points::Feature*>(getDocument()->addObject("Points::Feature", "Cloud"));
+    feature->Points.startEditing()->setBasicPoints(points);
+    feature->Points.finishEditing();
+
+    // Act
+    auto restored = reload<Points::Feature>("Cloud");
+
+    // Assert
+    ASSERT_NE(restored, nullptr);
+    const auto& kernel = restored->Points.getValue();
+    EXPECT_TRUE(kernel.isOutOfCore());
+    EXPECT_EQ(sorted(kernel.getBasicPoints()), sorted(points));
+}
+
+TEST_F(PointsRestoreTest, structuredCloudKeepsOrder)
+{
+    // Arrange
+    auto points = createGrid(40, 30);
+    auto feature = static_cast<Points::Structured*>(getDocument()->addObject("Points::Structured", "Cloud"));
+    feature->Width.setValue(40);
+    feature->Height.setValue(30);
+    feature->Points.startEditing()->setBasicPoints(points);
+    feature->Points.finishEditing();
+
+    // Act
+    auto restored = reload<Points::Structured>("Cloud");
+
+    // Assert
+    ASSERT_NE(restored, nullptr);
+    const auto& kernel = restored->Points.getValue();
+    EXPECT_FALSE(kernel.isOutOfCore());
+    EXPECT_EQ(kernel.getBasicPoints(), points);
+}
+
+TEST_F(PointsRestoreTest, perPointPropertyKeepsOrder)
+{
+    // Arrange
+    auto points = createGrid(40, 30);
+    std::vector<float> intensity(points.size());
+    for (std::size_t i = 0; i < intensity.size(); i++) {
+        intensity[i] = float(i);
+    }
+    auto feature = static_cast<Points::Feature*>(getDocument()->addObject("Points::FeatureCustom", "Cloud"));
+    feature->Points.startEditing()->setBasicPoints(points);
+    feature->Points.finishEditing();
+    auto prop = static_cast<Points::PropertyGreyValueList*>(
+        feature->addDynamicProperty("Points::PropertyGreyValueList", "Intensity"));
+    prop->setValues(intensity);
+
+    // Act
+    auto restored = reload<Points::Feature>("Cloud");
+
+    // Assert
+    ASSERT_NE(restored, nullptr);
+    const auto& kernel = restored->Points.getValue();
+    EXPECT_FALSE(kernel.isOutOfCore());
+    EXPECT_EQ(kernel.getBasicPoints(), points);
+}
+
+// NOLINTEND(readability-magic-numbers)
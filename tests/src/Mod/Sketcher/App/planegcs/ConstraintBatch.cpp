@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "gtest/gtest.h"
+
+#include "Mod/Sketcher/App/planegcs/GCS.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+class ConstraintBatchTest: public ::testing::Test
+{
+protected:
+    class SystemTest: public GCS::System
+    {
+    public:
+        int getIterationCount() const
+        {
+            return _getIterationCount();
+        }
+    };
+
+    /** Create constraints of all the batched types
+     *
+     * Each block shares its parameters with the previous one, some parameters
+     * are used twice by the same constraint, and every fifth radius is not a
+     * variable of the subsystem.
+     */
+    void makeConstraints(int blockCount)
+    {
+        values.resize(blockCount * 8 + 8);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] = 1.0 + 0.37 * std::sin(1.3 * double(i)) + 0.01 * double(i);
+        }
+        for (int i = 0; i < blockCount; ++i) {
+            double* v = &values[i * 8];
+            GCS::Point p0(&v[0], &v[1]);
+            GCS::Point p1(&v[8], &v[9]);
+            GCS::Point p2(&v[4], &v[5]);
+            constrs.emplace_back(new GCS::ConstraintP2PDistance(p0, p1, &v[2]));
+            constrs.emplace_back(new GCS::ConstraintPointOnLine(p2, p0, p1));
+            constrs.emplace_back(
+                new GCS::ConstraintTangentCircumf(p0, p2, &v[6], &v[7], i % 2 == 0));
+            constrs.emplace_back(new GCS::ConstraintEqual(&v[3], &v[11], i % 3 == 0 ? 1.0 : 0.5));
+            // the same parameter twice
+            constrs.emplace_back(new GCS::ConstraintEqual(&v[3], &v[3]));
+            constrs.emplace_back(new GCS::ConstraintPointOnLine(p0, p0, p1));
+            // a constraint type evaluated by the constraint itself
+            constrs.emplace_back(new GCS::ConstraintP2PAngle(p0, p1, &v[2]));
+            constrs.back()->rescale(0.5);
+            for (int j = 0; j < 8; ++j) {
+                if (j != 6 || i % 5 != 0) {
+                    params.push_back(&v[j]);
+                }
+            }
+        }
+        for (auto& constr : constrs) {
+            clist.push_back(constr.get());
+        }
+    }
+
+    static bool sameBits(const double* a, const double* b, std::size_t count)
+    {
+        return std::memcmp(a, b, count * sizeof(double)) == 0;
+    }
+
+    std::vector<double> values;
+    std::vector<std::unique_ptr<GCS::Constraint>> constrs;
+    std::vector<GCS::Constraint*> clist;
+    GCS::VEC_pD params;
+};
+
+TEST_F(ConstraintBatchTest, batchMatchesPerConstraint)  // NOLINT
+{
+    // Arrange
+    makeConstraints(50);
+    GCS::SubSystem batched(clist, params);
+    GCS::SubSystem single(clist, params);
+    batched.setBatched(true);
+    Eigen::VectorXd r1(batched.cSize()), r2(single.cSize());
+    Eigen::MatrixXd J1, J2;
+    Eigen::SparseMatrix<double> S1, S2;
+    double err1 {}, err2 {};
+
+    // Act
+    batched.redirectParams();
+    batched.calcResidual(r1, err1);
+    batched.calcJacobi(J1);
+    batched.calcJacobi(S1);
+    batched.revertParams();
+    single.redirectParams();
+    single.calcResidual(r2, err2);
+    single.calcJacobi(J2);
+    single.calcJacobi(S2);
+    single.revertParams();
+
+    // Assert
+    EXPECT_TRUE(batched.isBatched());
+    EXPECT_FALSE(single.isBatched());
+    EXPECT_TRUE(sameBits(r1.data(), r2.data(), r1.size()));
+    EXPECT_TRUE(sameBits(&err1, &err2, 1));
+    ASSERT_EQ(J1.rows(), J2.rows());
+    ASSERT_EQ(J1.cols(), J2.cols());
+    EXPECT_TRUE(sameBits(J1.data(), J2.data(), J1.size()));
+    ASSERT_EQ(S1.nonZeros(), S2.nonZeros());
+    EXPECT_TRUE(sameBits(S1.valuePtr(), S2.valuePtr(), S1.nonZeros()));
+    EXPECT_TRUE(std::equal(S1.innerIndexPtr(), S1.innerIndexPtr() + S1.nonZeros(),
+                           S2.innerIndexPtr()));
+}
+
+TEST_F(ConstraintBatchTest, solveMatchesPerConstraint)  // NOLINT
+{
+    // Arrange
+    constexpr int circleCount {30};
+    std::vector<double> results[2];
+    int iterations[2] {};
+    int status[2] {};
+
+    // Act
+    for (int run = 0; run < 2; ++run) {
+        // a chain of circles tangent to each other with their centers on the x axis, and a
+        // point on each circle at the height of its center
+        std::vector<double> v(circleCount * 6 + 5, 0.0);
+        double* axis = &v[circleCount * 6];
+        axis[2] = 1.0;
+        GCS::Point axis0(&axis[0], &axis[1]);
+        GCS::Point axis1(&axis[2], &axis[3]);
+        GCS::VEC_pD unknowns;
+        std::vector<GCS::Point> centers;
+        std::vector<GCS::Point> points;
+        for (int i = 0; i < circleCount; ++i) {
+            double* c = &v[i * 6];
+            double noise = 0.1 * std::sin(1.7 * i + 0.3);
+            c[0] = 3.0 * i + noise;
+            c[1] = noise;
+            c[2] = 1.0 + noise;
+            c[3] = 1.0 + 0.1 * (i % 4);
+            c[4] = c[0] + 1.0;
+            c[5] = -noise;
+            centers.emplace_back(&c[0], &c[1]);
+            points.emplace_back(&c[4], &c[5]);
+            unknowns.insert(unknowns.end(), {&c[0], &c[1], &c[2], &c[4], &c[5]});
+        }
+        SystemTest system;
+        system.batchedConstraints = (run == 0);
+        for (int i = 0; i < circleCount; ++i) {
+            double* c = &v[i * 6];
+            system.addConstraintEqual(&c[2], &c[3], i + 1);
+            system.addConstraintPointOnLine(centers[i], axis0, axis1, i + 1);
+            if (i == 0) {
+                system.addConstraintEqual(&c[0], &axis[4], i + 1);
+            }
+            else {
+                system.addConstraintTangentCircumf(
+                    centers[i - 1], centers[i], &v[i * 6 - 4], &c[2], false, i + 1);
+            }
+            system.addConstraintP2PDistance(centers[i], points[i], &c[2], i + 1);
+            system.addConstraintEqual(&c[5], &c[1], i + 1);
+        }
+        system.declareUnknowns(unknowns);
+        system.initSolution();
+        status[run] = system.solve(true, GCS::DogLeg);
+        iterations[run] = system.getIterationCount();
+        system.applySolution();
+        results[run] = v;
+    }
+
+    // Assert
+    EXPECT_EQ(GCS::Success, status[0]);
+    EXPECT_EQ(status[0], status[1]);
+    EXPECT_EQ(iterations[0], iterations[1]);
+    EXPECT_TRUE(sameBits(results[0].data(), results[1].data(), results[0].size()));
+}
+
+// Set FREECAD_SKETCHER_BENCHMARK to run it
+TEST_F(ConstraintBatchTest, benchmarkEvaluation)  // NOLINT
+{
+    if (!std::getenv("FREECAD_SKETCHER_BENCHMARK")) {
+        GTEST_SKIP() << "set FREECAD_SKETCHER_BENCHMARK to run the benchmark";
+    }
+    constexpr int repeat {20};
+    using Clock = std::chrono::steady_clock;
+    auto msecs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    for (int blockCount : {200, 2000}) {
+        // Arrange
+        constrs.clear();
+        clist.clear();
+        params.clear();
+        makeConstraints(blockCount);
+        GCS::SubSystem batched(clist, params);
+        GCS::SubSystem single(clist, params);
+        batched.setBatched(true);
+        Eigen::VectorXd r1(batched.cSize()), r2(single.cSize());
+        Eigen::MatrixXd J1, J2;
+        Eigen::SparseMatrix<double> S1, S2;
+        bool dense = blockCount < 1000;
+
+        // Act
+        auto measure = [&](GCS::SubSystem& subsys,
+                           Eigen::VectorXd& r,
+                           Eigen::MatrixXd& J,
+                           Eigen::SparseMatrix<double>& S) {
+            double times[3] {};
+            subsys.redirectParams();
+            auto start = Clock::now();
+            for (int i = 0; i < repeat; ++i) {
+                subsys.calcResidual(r);
+            }
+            times[0] = msecs(start) / repeat;
+            start = Clock::now();
+            for (int i = 0; i < repeat; ++i) {
+                subsys.calcJacobi(S);
+            }
+            times[1] = msecs(start) / repeat;
+            if (dense) {
+                start = Clock::now();
+                subsys.calcJacobi(J);
+                times[2] = msecs(start);
+            }
+            subsys.revertParams();
+            std::cout << "residual " << times[0] << " ms, sparse jacobi " << times[1] << " ms";
+            if (dense) {
+                std::cout << ", dense jacobi " << times[2] << " ms";
+            }
+            std::cout << "\n";
+        };
+        std::cout << clist.size() << " constraints\n  Per constraint: ";
+        measure(single, r2, J2, S2);
+        std::cout << "  Batched:        ";
+        measure(batched, r1, J1, S1);
+
+        // Assert
+        EXPECT_TRUE(sameBits(r1.data(), r2.data(), r1.size()));
+        ASSERT_EQ(S1.nonZeros(), S2.nonZeros());
+        EXPECT_TRUE(sameBits(S1.valuePtr(), S2.valuePtr(), S1.nonZeros()));
+        ASSERT_EQ(J1.size(), J2.size());
+        EXPECT_TRUE(sameBits(J1.data(), J2.data(), J1.size()));
+    }
+}
@@ -3,12 +3,16 @@
 #include "gtest/gtest.h"
 
 #include "Mod/Sketcher/App/planegcs/GCS.h"
+#include <cmath>
 
 class SystemTest : public GCS::System{
 public:
     size_t getNumberOfConstraints(int tagID = -1) {
         return _getNumberOfConstraints(tagID);
     }
+    int getIterationCount() const {
+        return _getIterationCount();
+    }
 };
 
 class GCSTest: public ::testing::Test
@@ -29,6 +33,40 @@ protected:
         return _system.get();
     }
 
+    /// Add the given number of decoupled lines, each with a fixed start point and
+    /// constrained length and angle. Return the unknown parameters.
+    GCS::VEC_pD addLines(int count)
+    {
+        _values.assign(count * 6, 0.0);
+        GCS::VEC_pD unknowns;
+        for (int i = 0; i < count; ++i) {
+            double* v = &_values[i * 6];
+            v[0] = i;        // start x, fixed
+            v[1] = 0.0;      // start y, fixed
+            v[2] = i + 0.5;  // end x
+            v[3] = 0.5;      // end y
+            v[4] = 1.0;      // length
+            v[5] = 0.1 * i;  // angle
+            GCS::Point start(&v[0], &v[1]);
+            GCS::Point end(&v[2], &v[3]);
+            System()->addConstraintP2PDistance(start, end, &v[4], i);
+            System()->addConstraintP2PAngle(start, end, &v[5], i);
+            unknowns.push_back(end.x);
+            unknowns.push_back(end.y);
+        }
+        return unknowns;
+    }
+
+    /// Return the distance of the end point of the given line from its expected position
+    double lineError(int i)
+    {
+        const double* v = &_values[i * 6];
+        return std::hypot(v[2] - v[0] - v[4] * std::cos(v[5]),
+                          v[3] - v[1] - v[4] * std::sin(v[5]));
+    }
+
+    std::vector<double> _values;
+
 private:
     std::unique_ptr<SystemTest> _system;
 };
@@ -48,3 +86,80 @@ TEST_F(GCSTest, clearConstraints) // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+TEST_F(GCSTest, solveComponentsInParallel) // NOLINT
+{
+    // Arrange
+    const int numLines {100};
+    GCS::VEC_pD unknowns = addLines(numLines);
+    System()->declareUnknowns(unknowns);
+    System()->parallelSolving = true;
+    System()->solverThreads = 4;
+    System()->initSolution();
+
+    // Act
+    int result = System()->solve();
+    System()->applySolution();
+
+    // Assert
+    EXPECT_EQ(GCS::Success, result);
+    for (int i = 0; i < numLines; ++i) {
+        EXPECT_NEAR(0.0, lineError(i), 1e-8);
+    }
+}
+
+TEST_F(GCSTest, reuseConvergedComponents) // NOLINT
+{
+    // Arrange
+    const int numLines {10};
+    GCS::VEC_pD unknowns = addLines(numLines);
+    System()->declareUnknowns(unknowns);
+    System()->initSolution();
+    System()->solve();
+    int iterationsAll = System()->getIterationCount();
+
+    // Act
+    System()->solve();
+    int iterationsNone = System()->getIterationCount();
+    _values[3 * 6 + 4] = 2.0; // change the length of one line
+    int result = System()->solve();
+    int iterationsOne = System()->getIterationCount();
+    System()->applySolution();
+
+    // Assert
+    EXPECT_EQ(GCS::Success, result);
+    EXPECT_EQ(0, iterationsNone);
+    EXPECT_GT(iterationsOne, 0);
+    EXPECT_LT(iterationsOne, iterationsAll);
+    for (int i = 0; i < numLines; ++i) {
+        EXPECT_NEAR(0.0, lineError(i), 1e-8);
+    }
+}
+
+TEST_F(GCSTest, resolveComponentsWithOtherSettings) // NOLINT
+{
+    // Arrange
+    const int numLines {10};
+    GCS::VEC_pD unknowns = addLines(numLines);
+    System()->declareUnknowns(unknowns);
+    System()->initSolution();
+    System()->solve(false, GCS::DogLeg);
+
+    // Act
+    System()->solve(true, GCS::DogLeg);
+    int iterationsFine = System()->getIterationCount();
+    System()->solve(true, GCS::LevenbergMarquardt);
+    int iterationsLM = System()->getIterationCount();
+    int result = System()->solve(true, GCS::LevenbergMarquardt);
+    int iterationsReused = System()->getIterationCount();
+    System()->applySolution();
+
+    // Assert
+    EXPECT_EQ(GCS::Success, result);
+    EXPECT_GT(iterationsFine, 0);
+    EXPECT_GT(iterationsLM, 0);
+    EXPECT_EQ(0, iterationsReused);
+    for (int i = 0; i < numLines; ++i) {
+        EXPECT_NEAR(0.0, lineError(i), 1e-8);
+    }
+}
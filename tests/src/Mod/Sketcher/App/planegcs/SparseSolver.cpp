@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "gtest/gtest.h"
+
+#include "Mod/Sketcher/App/planegcs/GCS.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+class SparseSolverTest: public ::testing::Test
+{
+protected:
+    class SystemTest: public GCS::System
+    {
+    public:
+        int getIterationCount() const
+        {
+            return _getIterationCount();
+        }
+    };
+
+    struct Result
+    {
+        int status;
+        int iterations;
+        double msecs;
+        double maxError;
+    };
+
+    /** Generate a sketch of a polyline with the given number of lines
+     *
+     * Each line has its own end points joined to the next line with coincident
+     * constraints, and is fully constrained by its length and angle, the way the
+     * sketcher builds the solver system. The start point of the first line is
+     * fixed. The initial positions are perturbed from the solution.
+     */
+    void makeSketch(SystemTest& system, int lineCount)
+    {
+        values.assign(lineCount * 6, 0.0);
+        expected.assign((lineCount + 1) * 2, 0.0);
+        GCS::VEC_pD unknowns;
+        std::vector<GCS::Point> points(lineCount * 2);
+        double x = 0.0;
+        double y = 0.0;
+        expected[0] = x;
+        expected[1] = y;
+        for (int i = 0; i < lineCount; ++i) {
+            double* v = &values[i * 6];
+            double length = 1.0 + 0.01 * (i % 10);
+            double angle = 0.3 * std::sin(0.1 * i);
+            double noise = 0.2 * std::sin(1.7 * i + 0.3);
+            v[0] = x + noise;
+            v[1] = y - noise;
+            x += length * std::cos(angle);
+            y += length * std::sin(angle);
+            v[2] = x - noise;
+            v[3] = y + noise;
+            v[4] = length;
+            v[5] = angle;
+            expected[i * 2 + 2] = x;
+            expected[i * 2 + 3] = y;
+
+            GCS::Point& start = points[i * 2];
+            GCS::Point& end = points[i * 2 + 1];
+            start = GCS::Point(&v[0], &v[1]);
+            end = GCS::Point(&v[2], &v[3]);
+            if (i == 0) {
+                v[0] = v[1] = 0.0;
+            }
+            else {
+                unknowns.push_back(start.x);
+                unknowns.push_back(start.y);
+                const GCS::Point& prev = points[i * 2 - 1];
+                system.addConstraintEqual(prev.x, start.x, i);
+                system.addConstraintEqual(prev.y, start.y, i);
+            }
+            unknowns.push_back(end.x);
+            unknowns.push_back(end.y);
+            system.addConstraintP2PDistance(start, end, &v[4], i);
+            system.addConstraintP2PAngle(start, end, &v[5], i);
+        }
+        system.declareUnknowns(unknowns);
+    }
+
+    Result solve(int lineCount, GCS::Algorithm alg, GCS::LinearSolver linearSolver)
+    {
+        using Clock = std::chrono::steady_clock;
+        SystemTest system;
+        system.linearSolver = linearSolver;
+        makeSketch(system, lineCount);
+        system.initSolution(alg);
+
+        auto start = Clock::now();
+        Result result {};
+        result.status = system.solve(true, alg);
+        result.msecs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        result.iterations = system.getIterationCount();
+        system.applySolution();
+
+        for (int i = 0; i < lineCount; ++i) {
+            double* v = &values[i * 6];
+            result.maxError = std::max(result.maxError, std::abs(v[2] - expected[i * 2 + 2]));
+            result.maxError = std::max(result.maxError, std::abs(v[3] - expected[i * 2 + 3]));
+        }
+        return result;
+    }
+
+    void compare(int lineCount, GCS::Algorithm alg, bool report = false)
+    {
+        Result dense = solve(lineCount, alg, GCS::DenseSolver);
+        Result sparse = solve(lineCount, alg, GCS::SparseSolver);
+
+        if (report) {
+            std::cout << (alg == GCS::DogLeg ? "DogLeg" : "LevenbergMarquardt") << ", "
+                      << lineCount << " lines\n"
+                      << "  Dense:  " << dense.msecs << " ms, " << dense.iterations
+                      << " iterations\n"
+                      << "  Sparse: " << sparse.msecs << " ms, " << sparse.iterations
+                      << " iterations\n";
+        }
+
+        EXPECT_EQ(GCS::Success, dense.status);
+        EXPECT_EQ(GCS::Success, sparse.status);
+        EXPECT_NEAR(0.0, dense.maxError, 1e-6);
+        EXPECT_NEAR(0.0, sparse.maxError, 1e-6);
+    }
+
+    std::vector<double> values;
+    std::vector<double> expected;
+};
+
+TEST_F(SparseSolverTest, sparseJacobiMatchesDense)  // NOLINT
+{
+    // Arrange
+    SystemTest system;
+    makeSketch(system, 20);
+    std::vector<GCS::Constraint*> clist;
+    GCS::VEC_pD params;
+    for (std::size_t i = 0; i < values.size(); i += 6) {
+        params.push_back(&values[i + 2]);
+        params.push_back(&values[i + 3]);
+    }
+    GCS::Point start(&values[0], &values[1]);
+    GCS::Point end(&values[2], &values[3]);
+    GCS::Point next(&values[8], &values[9]);
+    GCS::ConstraintP2PDistance distance(start, end, &values[4]);
+    GCS::ConstraintP2PAngle angle(end, next, &values[5]);
+    clist.push_back(&distance);
+    clist.push_back(&angle);
+    GCS::SubSystem subsys(clist, params);
+    Eigen::MatrixXd dense;
+    Eigen::SparseMatrix<double> sparse;
+
+    // Act
+    subsys.redirectParams();
+    subsys.calcJacobi(dense);
+    subsys.calcJacobi(sparse);
+    subsys.revertParams();
+
+    // Assert
+    ASSERT_EQ(dense.rows(), sparse.rows());
+    ASSERT_EQ(dense.cols(), sparse.cols());
+    EXPECT_EQ(6, sparse.nonZeros());
+    EXPECT_TRUE(dense.isApprox(Eigen::MatrixXd(sparse)));
+}
+
+TEST_F(SparseSolverTest, sparseDogLegMatchesDense)  // NOLINT
+{
+    compare(20, GCS::DogLeg);
+}
+
+TEST_F(SparseSolverTest, sparseLevenbergMarquardtMatchesDense)  // NOLINT
+{
+    compare(20, GCS::LevenbergMarquardt);
+}
+
+// Set FREECAD_SKETCHER_BENCHMARK to run the benchmarks
+TEST_F(SparseSolverTest, benchmarkDogLeg)  // NOLINT
+{
+    if (!std::getenv("FREECAD_SKETCHER_BENCHMARK")) {
+        GTEST_SKIP() << "set FREECAD_SKETCHER_BENCHMARK to run the benchmark";
+    }
+    for (int lineCount : {50, 100, 200}) {
+        compare(lineCount, GCS::DogLeg, true);
+    }
+}
+
+TEST_F(SparseSolverTest, benchmarkLevenbergMarquardt)  // NOLINT
+{
+    if (!std::getenv("FREECAD_SKETCHER_BENCHMARK")) {
+        GTEST_SKIP() << "set FREECAD_SKETCHER_BENCHMARK to run the benchmark";
+    }
+    for (int lineCount : {50, 100, 200}) {
+        compare(lineCount, GCS::LevenbergMarquardt, true);
+    }
+}